@@ -0,0 +1,50 @@
+#!/bin/sh
+
+# Builds the offline tools (the game itself is win32 + gl only, see win64_build.bat). Needs clang: g++ doesn't allow
+# members with constructors (v2, v3) in anonymous structs, which my_math.h's vector unions rely on
+
+cwd=$(cd "$(dirname "$0")" && pwd)
+
+CXX=${CXX:-clang++}
+
+# Debug/Development build
+CommonCompilerFlags="-std=c++17 -g -O0 -mavx2 -mfma -fms-extensions -Wno-microsoft -Wno-unused-value -Wno-writable-strings"
+
+GameIncludePaths="-I $cwd/third_party/boagz/include -I $cwd/third_party/boagz/src -I $cwd/third_party/stb/include"
+
+mkdir -p "$cwd/bin"
+cd "$cwd/bin" || exit 1
+
+# Build rig cooker and re-cook rigs (game falls back to the .json files if a .rig is missing or out of date)
+$CXX ../source/rig_cooker.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -o rig_cooker || exit 1
+./rig_cooker ../data/yellow_god.atlas ../data/yellow_god.json ../data/yellow_god.rig 72
+
+# Build tile cooker and re-cut the stage background (game falls back to a blank stage if the .tiles file is missing or out of date)
+$CXX ../source/tile_cooker.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -o tile_cooker || exit 1
+./tile_cooker ../data/4k.jpg ../data/4k.tiles 256
+
+# Build render replay tool (replays a capture from the game, see RENDER_CAPTURE_FRAMES in win64_test.cpp, without needing a gpu)
+$CXX ../source/render_replay.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -o render_replay || exit 1
+
+# Build skeleton world transform benchmark, reads cache misses from the cpu's counters where the machine exposes them
+# (./skeleton_bench ../data/yellow_god.atlas ../data/yellow_god.json)
+$CXX ../source/skeleton_bench.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -O2 -o skeleton_bench || exit 1
+
+# Build json parsing benchmark, logs process peak RSS after each file (cd .. && ./bin/json_bench)
+$CXX ../source/json_bench.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -O2 -o json_bench || exit 1
+
+# Build and run the render capture round trip check. Leaves a capture of its frames behind for render_replay
+$CXX ../source/render_capture_check.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -o render_capture_check || exit 1
+./render_capture_check ../data/arial.ttf render_capture_check.rcap || exit 1
+
+# Build and run the render sort check (order entries are drawn in, see RenderSortKey)
+$CXX ../source/render_sort_check.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -o render_sort_check || exit 1
+./render_sort_check || exit 1
+
+# Build and run the render frame queue check (game/render thread hand off, see render_frame_queue.h)
+$CXX ../source/render_frame_queue_check.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -pthread -o render_frame_queue_check || exit 1
+./render_frame_queue_check || exit 1
+
+# Build and run the texture mip chain check (levels have to be sized the way gl expects, see texture_cache.h)
+$CXX ../source/texture_mip_check.cpp $CommonCompilerFlags $GameIncludePaths -DDEVELOPMENT_BUILD=1 -o texture_mip_check || exit 1
+./texture_mip_check ../data/4k.jpg ../data/1080p.jpg || exit 1
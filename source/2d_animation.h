@@ -2,6 +2,7 @@
 #define ANIMATION_INCLUDE
 
 #include <string.h>
+#include <immintrin.h>
 #include "2d_skeleton.h"
 #include "2d_collision_detection.h"
 #include "json.h"
@@ -22,7 +23,7 @@ struct RotationTimeline
 {
     RotationTimeline() = default;
     
-    f32 (*GetTransformationVal)(RotationTimeline, i32);
+    f32 (*GetTransformationVal)(RotationTimeline*, i32);
     b exists { false };
     Array<f32, 10> times;
     Array<CurveType, 10> curves;
@@ -34,7 +35,7 @@ struct TranslationTimeline
 {
     TranslationTimeline() = default;
     
-    v2 (*GetTransformationVal)(TranslationTimeline, i32);
+    v2 (*GetTransformationVal)(TranslationTimeline*, i32);
     b exists { false };
     Array<f32, 10> times;
     Array<CurveType, 10> curves;
@@ -46,7 +47,7 @@ struct ScaleTimeline
 {
     ScaleTimeline() = default;
     
-    v2 (*GetTransformationVal)(ScaleTimeline, i32);
+    v2 (*GetTransformationVal)(ScaleTimeline*, i32);
     b exists { false };
     Array<f32, 10> times;
     Array<CurveType, 10> curves;
@@ -54,19 +55,35 @@ struct ScaleTimeline
     i32 timesCount {}, curvesCount {}, scaleCount {};
 };
 
-f32 GetTransformationVal_RotationTimeline(RotationTimeline rotationTimeline, i32 keyFrameIndex)
+f32 GetTransformationVal_RotationTimeline(RotationTimeline* rotationTimeline, i32 keyFrameIndex)
 {
-    return rotationTimeline.angles[keyFrameIndex];
+    return rotationTimeline->angles[keyFrameIndex];
 };
 
-v2 GetTransformationVal_TranslationTimeline(TranslationTimeline translationTimeline, i32 keyFrameIndex)
+v2 GetTransformationVal_TranslationTimeline(TranslationTimeline* translationTimeline, i32 keyFrameIndex)
 {
-    return translationTimeline.translations[keyFrameIndex];
+    return translationTimeline->translations[keyFrameIndex];
 };
 
-v2 GetTransformationVal_ScaleTimeline(ScaleTimeline scaleTimeline, i32 keyFrameIndex)
+v2 GetTransformationVal_ScaleTimeline(ScaleTimeline* scaleTimeline, i32 keyFrameIndex)
 {
-    return scaleTimeline.scales[keyFrameIndex];
+    return scaleTimeline->scales[keyFrameIndex];
+};
+
+//Fixed rate every clip gets resampled at when baked. Sampling a baked clip is then just an indexed lerp between
+//two neighbouring poses instead of a keyframe search per bone timeline
+#define BAKED_CLIP_SAMPLE_RATE 60.0f
+
+struct Baked_Clip
+{
+    f32 sampleRate {};
+    i32 sampleCount {};
+    i32 boneCount {};
+    
+    //Stored one full pose after another ([sampleIndex * boneCount + boneIndex]) so sampling any time only touches
+    //two contiguous rows per stream
+    f32* boneRotations { nullptr };
+    v2* boneTranslations { nullptr };
 };
 
 enum class PlayBackStatus
@@ -79,72 +96,141 @@ enum class PlayBackStatus
     HOLD
 };
 
+struct Animation;
+
+//Interned animation name. Hash names once (at load/init time) and pass these around instead of strings
+struct AnimID
+{
+    ui32 hash {};
+};
+
+inline AnimID AnimIDFromName(const char* animName)
+{
+    //32 bit FNV-1a
+    ui32 hash { 2166136261u };
+    for (i32 i {}; animName[i] != 0; ++i)
+    {
+        hash ^= (ui8)animName[i];
+        hash *= 16777619u;
+    };
+    
+    if (hash == 0) //0 marks an empty slot in the anim map
+        hash = 1;
+    
+    return AnimID { hash };
+};
+
+struct AnimationMix
+{
+    Animation* anim_to { nullptr };
+    f32 mixTimeDuration {};
+};
+
+//Immutable clip data. Built once in InitAnimData and then only ever referenced (by pointer) from the anim queues of
+//fighters sharing the same anim data. All per-fighter playback info lives in AnimationPlayback/AnimationQueue instead
 struct Animation
 {
     Animation() = default;
     
     const char* name { nullptr };
+    AnimID id {};
     f32 totalTime {};
+    bgz::DbgArray<HitBox, 10> hitBoxes;
+    bgz::DbgArray<AnimationMix, 10> animsToTransitionTo;
+    const Skeleton_Setup* skelSetup { nullptr }; //Bone lengths are needed when picking a rotation direction between keyframes
+    i32 boneCount {};
+    Array<RotationTimeline, 20> boneRotationTimelines;
+    Array<TranslationTimeline, 20> boneTranslationTimelines;
+    Array<ScaleTimeline, 20> boneScaleTimelines;
+    Baked_Clip bakedClip;
+};
+
+struct AnimationPose
+{
+    Array<f32, 20> boneRotations;
+    Array<v2, 20> boneTranslations;
+};
+
+//Small per-fighter playback state of a single clip. This is what gets queued up and copied around, never the clip itself
+struct AnimationPlayback
+{
+    AnimationPlayback() = default;
+    
+    Animation* anim { nullptr };
     f32 currentTime {};
-    f32 mixTimeDuration {};
     f32 currentMixTime {};
     f32 initialTimeLeftInAnimAtMixingStart {};
     PlayBackStatus status { PlayBackStatus::DEFAULT };
     b repeat { false };
     b hasEnded { false };
     b MixingStarted { false };
-    bgz::DbgArray<HitBox, 10> hitBoxes;
-    bgz::DbgArray<Animation*, 10> animsToTransitionTo;
-    Array<Bone*, 20> bones;
-    Array<RotationTimeline, 20> boneRotationTimelines;
-    Array<TranslationTimeline, 20> boneTranslationTimelines;
-    Array<ScaleTimeline, 20> boneScaleTimelines;
-    Array<f32, 20> boneRotations;
-    Array<v2, 20> boneTranslations;
 };
 
+struct AnimationMap_Slot
+{
+    ui32 idHash {}; //0 == empty
+    i32 animIndex {};
+};
+
+//Animations are stored densely in insertion order, with an open addressing (linear probing) table of AnimIDs on the side
 struct AnimationMap
 {
     bgz::Dynam_Array<Animation> animations {};
-    bgz::Dynam_Array<i32> keys {};
+    AnimationMap_Slot* slots { nullptr };
+    i32 slotCount {}; //Always a power of 2
 };
 
 void InitAnimMap(AnimationMap&& animMap, bgz::Memory_Partition&& memPart, i32 size)
 {
     bgz::Init(&animMap.animations, size);
-    bgz::Init(&animMap.keys, size);
+    
+    //Keep load factor at or below 50% so probe chains stay short
+    animMap.slotCount = 1;
+    while (animMap.slotCount < size * 2)
+        animMap.slotCount *= 2;
+    
+    animMap.slots = PushType(&memPart, AnimationMap_Slot, animMap.slotCount);
+    memset(animMap.slots, 0, sizeof(AnimationMap_Slot) * animMap.slotCount);
 };
 
 void InsertAnimation(AnimationMap&& animMap, const char* animName, Animation anim)
 {
-    i32 uniqueID {};
-    for (i32 i {}; animName[i] != 0; ++i)
-        uniqueID += animName[i];
+    BGZ_ASSERT(bgz::Size(&animMap.animations) < animMap.slotCount / 2);//, "Anim map is full!");
+    
+    anim.id = AnimIDFromName(animName);
+    
+    i32 slotIndex = (i32)(anim.id.hash & (ui32)(animMap.slotCount - 1));
+    while (animMap.slots[slotIndex].idHash != 0)
+    {
+        //Two different names hashing to the same 32 bit value would make one of them unreachable by AnimID, so catch it here
+        BGZ_ASSERT(animMap.slots[slotIndex].idHash != anim.id.hash);//, "Duplicate animation name or AnimID hash collision!");
+        slotIndex = (slotIndex + 1) & (animMap.slotCount - 1);
+    };
     
-    bgz::Push(animMap.keys, uniqueID);
+    animMap.slots[slotIndex].idHash = anim.id.hash;
+    animMap.slots[slotIndex].animIndex = (i32)bgz::Size(&animMap.animations);
     bgz::Push(animMap.animations, anim);
 };
 
-Animation* GetAnimation(AnimationMap animMap, const char* animName)
+Animation* GetAnimation(AnimationMap animMap, AnimID animID)
 {
-    i32 uniqueID {};
-    for (i32 i {}; animName[i] != 0; ++i)
-        uniqueID += animName[i];
-    
-    i32 keyIndex { -1 };
-    for (i32 i {}; i < bgz::Size(&animMap.keys); ++i)
+    i32 slotIndex = (i32)(animID.hash & (ui32)(animMap.slotCount - 1));
+    while (animMap.slots[slotIndex].idHash != 0)
     {
-        if (uniqueID == animMap.keys[i])
-        {
-            keyIndex = i;
-            break;
-        }
+        if (animMap.slots[slotIndex].idHash == animID.hash)
+            return &animMap.animations[animMap.slots[slotIndex].animIndex];
+        
+        slotIndex = (slotIndex + 1) & (animMap.slotCount - 1);
     };
     
-    if (keyIndex == -1)
-        BGZ_ASSERT(1 < 0);//, "Animation name is either incorrect or requested animation doesn't exist!");
-    
-    return &animMap.animations[keyIndex];
+    BGZ_ASSERT(1 < 0);//, "Animation name is either incorrect or requested animation doesn't exist!");
+    return nullptr;
+};
+
+//Hashes the name, so keep this to load/init time code. Per frame code should hold on to an AnimID instead
+Animation* GetAnimation(AnimationMap animMap, const char* animName)
+{
+    return GetAnimation(animMap, AnimIDFromName(animName));
 };
 
 struct AnimationData
@@ -159,298 +245,526 @@ struct AnimationQueue
     AnimationQueue() = default;
     
     b hasIdleAnim { false };
-    Animation idleAnim;
-    Ring_Buffer<Animation, 10> queuedAnimations;
+    AnimationPlayback idleAnim;
+    Ring_Buffer<AnimationPlayback, 10> queuedAnimations;
+    AnimationPose pose; //Output of UpdateAnimationState
+    AnimationPose poseAtMixingStart;
 };
 
-void InitAnimData(AnimationData&& animData, bgz::Memory_Partition&& memPart, const char* animDataJsonFilePath, Skeleton skel);
-void MixAnimations(AnimationData&& animData, const char* anim_from, const char* anim_to);
-void CopyAnimation(Animation src, Animation&& dest);
-void SetIdleAnimation(AnimationQueue&& animQueue, const AnimationData animData, const char* animName);
+#if DEVELOPMENT_BUILD
+//Bytes of animation data copied around by the anim queue and per frame update. Reset by the game every frame
+global_variable i64 animBytesCopied_thisFrame {};
+#define COUNT_ANIM_BYTES_COPIED(numBytes) animBytesCopied_thisFrame += (i64)(numBytes)
+#else
+#define COUNT_ANIM_BYTES_COPIED(numBytes)
+#endif
+
+//False if an animation doesn't fit an Animation's fixed storage (too many bones, key frames or hit boxes) or the json is malformed
+b InitAnimData(AnimationData&& animData, bgz::Memory_Partition&& memPart, const char* animDataJsonFilePath, Skeleton skel);
+void MixAnimations(AnimationData&& animData, const char* anim_from, const char* anim_to, f32 mixDuration);
+void SetIdleAnimation(AnimationQueue&& animQueue, const AnimationData animData, AnimID animID);
 void CreateAnimationsFromJsonFile(AnimationData&& animData, const char* jsonFilePath);
-Animation UpdateAnimationState(AnimationQueue&& animQueue, f32 prevFrameDT);
-void QueueAnimation(AnimationQueue&& animQueue, const AnimationData animData, const char* animName, PlayBackStatus status);
+AnimationPlayback UpdateAnimationState(AnimationQueue&& animQueue, f32 prevFrameDT);
+void ApplyAnimationToSkeleton(Skeleton&& skel, const AnimationPose* pose);
+void QueueAnimation(AnimationQueue&& animQueue, const AnimationData animData, AnimID animID, PlayBackStatus status);
+void BakeAnimationClips(AnimationData&& animData, bgz::Memory_Partition&& memPart, f32 sampleRate);
+void SampleBakedClip(Baked_Clip clip, f32 currentAnimRunTime, f32* boneRotations, v2* boneTranslations);
+void SampleBakedClip_Batch(Baked_Clip clip, const AnimationPlayback* playbacks, i32 instanceCount, AnimationPose* poses);
+#if DEVELOPMENT_BUILD
+void BenchmarkAnimationSamplers(AnimationData animData, const char* dataName, i32 posesToSamplePerAnim);
+void BenchmarkBatchPoseSampling(Animation* clip, bgz::Memory_Partition&& memPart);
+void BenchmarkAnimationLookup(AnimationData animData, bgz::Memory_Partition&& memPart, i32 lookupsPerAnim);
+#endif
 
 #endif
 
 #ifdef ANIMATION_IMPL
 
-void InitAnimData(AnimationData&& animData, bgz::Memory_Partition&& memPart, const char* animDataJsonFilePath, Skeleton skel)
+local_func CurveType _ReadKeyFrameCurve(Json_Reader* reader)
 {
-    i32 length;
+    //Bezier curves come through as numbers/arrays and aren't supported yet so they play back linear
+    const char* keyFrameCurve = Json_readString(reader, "");
+    return StringCmp(keyFrameCurve, "stepped") ? CurveType::STEPPED : CurveType::LINEAR;
+};
+
+//Timelines have fixed key frame storage. Key frames past it are skipped and false is returned
+local_func b _ReadRotationTimeline(RotationTimeline* boneRotationTimeline, Json_Reader* reader)
+{
+    boneRotationTimeline->exists = true;
+    boneRotationTimeline->GetTransformationVal = &GetTransformationVal_RotationTimeline;
     
-    const char* jsonFile = (const char*)globalPlatformServices->ReadEntireFile($(length), animDataJsonFilePath);
+    b fitsInStorage { true };
+    Json_beginArray(reader);
+    while (Json_nextElement(reader))
+    {
+        if (boneRotationTimeline->timesCount == boneRotationTimeline->times.Size())
+        {
+            fitsInStorage = false;
+            Json_skipValue(reader);
+            continue;
+        };
+        
+        f32 time {}, angle {};
+        CurveType curve { CurveType::LINEAR };
+        
+        const char* key;
+        Json_beginObject(reader);
+        while (Json_nextKey(reader, &key))
+        {
+            if (StringCmp(key, "time"))
+                time = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "angle"))
+                angle = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "curve"))
+                curve = _ReadKeyFrameCurve(reader);
+            else
+                Json_skipValue(reader);
+        };
+        
+        boneRotationTimeline->times[boneRotationTimeline->timesCount++] = time;
+        boneRotationTimeline->angles[boneRotationTimeline->anglesCount++] = angle;
+        boneRotationTimeline->curves[boneRotationTimeline->curvesCount++] = curve;
+    };
     
-    Json* root {};
-    root = Json_create(jsonFile);
-    Json* animations = Json_getItem(root, "animations"); /* clang-format off */BGZ_ASSERT(animations);//, "Unable to return valid json object!"); /* clang-format on */
+    return fitsInStorage;
+};
+
+local_func b _ReadTranslationTimeline(TranslationTimeline* boneTranslationTimeline, Json_Reader* reader)
+{
+    boneTranslationTimeline->exists = true;
+    boneTranslationTimeline->GetTransformationVal = &GetTransformationVal_TranslationTimeline;
     
-    InitAnimMap($(animData.animMap), $(memPart), 20);
+    b fitsInStorage { true };
+    Json_beginArray(reader);
+    while (Json_nextElement(reader))
+    {
+        if (boneTranslationTimeline->timesCount == boneTranslationTimeline->times.Size())
+        {
+            fitsInStorage = false;
+            Json_skipValue(reader);
+            continue;
+        };
+        
+        f32 time {};
+        v2 translation {};
+        CurveType curve { CurveType::LINEAR };
+        
+        const char* key;
+        Json_beginObject(reader);
+        while (Json_nextKey(reader, &key))
+        {
+            if (StringCmp(key, "time"))
+                time = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "x"))
+                translation.x = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "y"))
+                translation.y = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "curve"))
+                curve = _ReadKeyFrameCurve(reader);
+            else
+                Json_skipValue(reader);
+        };
+        
+        boneTranslationTimeline->times[boneTranslationTimeline->timesCount++] = time;
+        boneTranslationTimeline->translations[boneTranslationTimeline->translationCount++] = translation;
+        boneTranslationTimeline->curves[boneTranslationTimeline->curvesCount++] = curve;
+    };
     
-    i32 animIndex {};
-    for (Json* currentAnimation_json = animations ? animations->child : 0; currentAnimation_json; currentAnimation_json = currentAnimation_json->next, ++animIndex)
+    return fitsInStorage;
+};
+
+//Reads an animation's "slots" section. Every slot timeline in there is treated as a collision box ("box-<bone name>")
+//turning on at its first attachment key frame and off at its second. Ones past what an animation holds are skipped and
+//false is returned
+local_func b _ReadHitBoxes(Animation* anim, Json_Reader* reader, bgz::Memory_Partition* memPart)
+{
+    b fitsInStorage { true };
+    const char* slotName;
+    Json_beginObject(reader);
+    while (Json_nextKey(reader, &slotName))
     {
-        Animation newAnimation {};
-        InsertAnimation($(animData.animMap), currentAnimation_json->name, newAnimation);
-        Animation* anim = GetAnimation(animData.animMap, currentAnimation_json->name);
+        if (anim->hitBoxes.length == anim->hitBoxes.Capacity())
+        {
+            fitsInStorage = false;
+            Json_skipValue(reader);
+            continue;
+        };
         
-        anim->name = currentAnimation_json->name;
+        HitBox* hitBox = &anim->hitBoxes.Push();
+        *hitBox = HitBox {};
         
-        for (i32 i {}; i < anim->bones.Size(); ++i)
-            anim->bones[i] = &skel.bones[i];
+        //Get bone name collision box is attached to by cutting out "box-" prefix
+        hitBox->boneName = PushString(memPart, strlen(slotName) > 4 ? slotName + 4 : "");
         
-        Json* bonesOfAnimation = Json_getItem(currentAnimation_json, "bones");
-        i32 boneIndex_json {};
-        f32 maxTimeOfAnimation {};
-        for (Json* currentBone = bonesOfAnimation ? bonesOfAnimation->child : 0; currentBone; currentBone = currentBone->next, ++boneIndex_json)
+        const char* timelineName;
+        Json_beginObject(reader);
+        while (Json_nextKey(reader, &timelineName))
         {
-            i32 boneIndex {};
-            while (boneIndex < anim->bones.Size())
+            if (NOT StringCmp(timelineName, "attachment"))
             {
-                if (StringCmp(anim->bones[boneIndex]->name, currentBone->name))
-                    break;
-                else
-                    ++boneIndex;
+                Json_skipValue(reader);
+                continue;
             };
             
-            Json* rotateTimeline_json = Json_getItem(currentBone, "rotate");
-            Json* translateTimeline_json = Json_getItem(currentBone, "translate");
-            Json* scaleTimeline_json = Json_getItem(currentBone, "scale");
-            
-            if (rotateTimeline_json)
+            f32 keyFrameTimes[2] {};
+            i32 keyFrameIndex {};
+            Json_beginArray(reader);
+            for (; Json_nextElement(reader); ++keyFrameIndex)
             {
-                RotationTimeline* boneRotationTimeline = &anim->boneRotationTimelines[boneIndex];
-                boneRotationTimeline->exists = true;
-                boneRotationTimeline->GetTransformationVal = &GetTransformationVal_RotationTimeline;
-                
-                i32 keyFrameIndex {};
-                for (Json* jsonKeyFrame = rotateTimeline_json ? rotateTimeline_json->child : 0; jsonKeyFrame; jsonKeyFrame = jsonKeyFrame->next, ++keyFrameIndex)
+                const char* key;
+                Json_beginObject(reader);
+                while (Json_nextKey(reader, &key))
                 {
-                    boneRotationTimeline->times[boneRotationTimeline->timesCount++] = Json_getFloat(jsonKeyFrame, "time", 0.0f);
-                    boneRotationTimeline->angles[boneRotationTimeline->anglesCount++] = Json_getFloat(jsonKeyFrame, "angle", 0.0f);
-                    
-                    const char* keyFrameCurve = Json_getString(jsonKeyFrame, "curve", "");
-                    if (StringCmp(keyFrameCurve, "stepped"))
-                        boneRotationTimeline->curves[boneRotationTimeline->curvesCount++] = CurveType::STEPPED;
+                    if (StringCmp(key, "time") && keyFrameIndex < 2)
+                        keyFrameTimes[keyFrameIndex] = Json_readFloat(reader, 0.0f);
                     else
-                        boneRotationTimeline->curves[boneRotationTimeline->curvesCount++] = CurveType::LINEAR;
+                        Json_skipValue(reader);
                 };
-                
-                f32 maxTimeOfRotationTimeline = boneRotationTimeline->times[boneRotationTimeline->timesCount - 1];
-                
-                if (maxTimeOfRotationTimeline > maxTimeOfAnimation)
-                    maxTimeOfAnimation = maxTimeOfRotationTimeline;
             };
             
-            if (translateTimeline_json)
+            hitBox->timeUntilHitBoxIsActivated = keyFrameTimes[0];
+            hitBox->duration = keyFrameTimes[1] - keyFrameTimes[0];
+        };
+    };
+    
+    return fitsInStorage;
+};
+
+//Every deform timeline's verts go in one array that grows with however many the json has
+struct _Deformed_Verts
+{
+    const char* slotName { nullptr };
+    i32 firstVert {};
+    i32 count {};
+};
+
+//Reads the first key frame's vertices of every deform timeline in the default skin
+local_func void _ReadDeforms(bgz::Dynam_Array<_Deformed_Verts>&& deforms, bgz::Dynam_Array<v2>&& deformedVerts, Json_Reader* reader)
+{
+    const char* skinName;
+    Json_beginObject(reader);
+    while (Json_nextKey(reader, &skinName))
+    {
+        if (NOT StringCmp(skinName, "default"))
+        {
+            Json_skipValue(reader);
+            continue;
+        };
+        
+        const char* slotName;
+        Json_beginObject(reader);
+        while (Json_nextKey(reader, &slotName))
+        {
+            _Deformed_Verts newDeform {};
+            newDeform.slotName = slotName;
+            newDeform.firstVert = (i32)bgz::Size(&deformedVerts);
+            bgz::Push(deforms, newDeform);
+            _Deformed_Verts* deform = &bgz::LastElem(&deforms);
+            
+            const char* attachmentName;
+            Json_beginObject(reader);
+            while (Json_nextKey(reader, &attachmentName))
             {
-                TranslationTimeline* boneTranslationTimeline = &anim->boneTranslationTimelines[boneIndex];
-                boneTranslationTimeline->exists = true;
-                boneTranslationTimeline->GetTransformationVal = &GetTransformationVal_TranslationTimeline;
-                
                 i32 keyFrameIndex {};
-                for (Json* jsonKeyFrame = translateTimeline_json ? translateTimeline_json->child : 0; jsonKeyFrame; jsonKeyFrame = jsonKeyFrame->next, ++keyFrameIndex)
+                Json_beginArray(reader);
+                for (; Json_nextElement(reader); ++keyFrameIndex)
                 {
-                    boneTranslationTimeline->times[boneTranslationTimeline->timesCount++] = Json_getFloat(jsonKeyFrame, "time", 0.0f);
-                    boneTranslationTimeline->translations[boneTranslationTimeline->translationCount++] = { 0.0f, 0.0f };
-                    
-                    boneTranslationTimeline->translations[keyFrameIndex].x = Json_getFloat(jsonKeyFrame, "x", 0.0f);
-                    boneTranslationTimeline->translations[keyFrameIndex].y = Json_getFloat(jsonKeyFrame, "y", 0.0f);
-                    
-                    const char* keyFrameCurve = Json_getString(jsonKeyFrame, "curve", "");
-                    if (StringCmp(keyFrameCurve, "stepped"))
-                        boneTranslationTimeline->curves[boneTranslationTimeline->curvesCount++] = CurveType::STEPPED;
-                    else
-                        boneTranslationTimeline->curves[boneTranslationTimeline->curvesCount++] = CurveType::LINEAR;
+                    const char* key;
+                    Json_beginObject(reader);
+                    while (Json_nextKey(reader, &key))
+                    {
+                        if (StringCmp(key, "vertices") && keyFrameIndex == 0 && deform->count == 0)
+                        {
+                            Json_beginArray(reader);
+                            while (Json_nextElement(reader))
+                            {
+                                v2 vert {};
+                                vert.x = Json_readFloat(reader, 0.0f);
+                                Json_nextElement(reader);
+                                vert.y = Json_readFloat(reader, 0.0f);
+                                
+                                bgz::Push(deformedVerts, vert);
+                                ++deform->count;
+                            };
+                        }
+                        else
+                        {
+                            Json_skipValue(reader);
+                        };
+                    };
                 };
-                
-                f32 maxTimeOfTranslationTimeline = boneTranslationTimeline->times[boneTranslationTimeline->timesCount - 1];
-                
-                if (maxTimeOfTranslationTimeline > maxTimeOfAnimation)
-                    maxTimeOfAnimation = maxTimeOfTranslationTimeline;
-            };
-            
-            if (scaleTimeline_json)
-            {
-                //Implement
             };
         };
-        
-        { //Setup hit boxes for anim if any
-            Json* collisionBoxesOfAnimation_json = Json_getItem(currentAnimation_json, "slots");
-            
-            if (collisionBoxesOfAnimation_json)
+    };
+};
+
+//Collision box verts are the setup pose verts offset by the animation's deform
+local_func void _SizeHitBox(HitBox* hitBox, const Skeleton_Setup* skelSetup, const _Deformed_Verts* deform, bgz::Dynam_Array<v2> deformedVerts)
+{
+    BGZ_ASSERT(skelSetup->originalCollisionBoxVerts);//, "Cooked rigs don't keep collision box verts, their hit boxes are already sized!");
+    bgz::Dynam_Array<v2>* originalCollisionBoxVerts = &skelSetup->originalCollisionBoxVerts[GetBoneIndex(skelSetup, hitBox->boneName)];
+    i32 numVerts = (i32)bgz::Size(originalCollisionBoxVerts);
+    BGZ_ASSERT(numVerts >= 3 && numVerts <= deform->count);//, "Deform doesn't match the collision box it's deforming!");
+    
+    //Size and position only need the first three corners
+    v2 finalCollsionBoxVertCoords[3];
+    for (i32 i {}; i < 3; ++i)
+        finalCollsionBoxVertCoords[i] = (*originalCollisionBoxVerts)[i] + deformedVerts[deform->firstVert + i];
+    
+    v2 vector0_1 = finalCollsionBoxVertCoords[0] - finalCollsionBoxVertCoords[1];
+    v2 vector1_2 = finalCollsionBoxVertCoords[1] - finalCollsionBoxVertCoords[2];
+    
+    hitBox->size.width = Magnitude(vector0_1);
+    hitBox->size.height = Magnitude(vector1_2);
+    hitBox->worldPosOffset = { (finalCollsionBoxVertCoords[0].x + finalCollsionBoxVertCoords[2].x) / 2.0f,
+        (finalCollsionBoxVertCoords[0].y + finalCollsionBoxVertCoords[2].y) / 2.0f };
+};
+
+//Returns false if the animation has more key frames or hit boxes than its fixed storage holds
+local_func b _ReadAnimation(Animation* anim, Json_Reader* reader, Skeleton skel, bgz::Memory_Partition* memPart)
+{
+    bgz::Dynam_Array<_Deformed_Verts> deforms;
+    bgz::Dynam_Array<v2> deformedVerts;
+    bgz::Init(&deforms, 8);
+    bgz::Init(&deformedVerts, 32);
+    f32 maxTimeOfAnimation {};
+    b fitsInStorage { true };
+    
+    const char* key;
+    Json_beginObject(reader);
+    while (Json_nextKey(reader, &key))
+    {
+        if (StringCmp(key, "bones"))
+        {
+            const char* boneName;
+            Json_beginObject(reader);
+            while (Json_nextKey(reader, &boneName))
             {
-                i32 hitBoxIndex {};
-                for (Json* currentCollisionBox_json = collisionBoxesOfAnimation_json ? collisionBoxesOfAnimation_json->child : 0; currentCollisionBox_json; currentCollisionBox_json = currentCollisionBox_json->next, ++hitBoxIndex)
+                i32 boneIndex = GetBoneIndex(skel.setup, boneName);
+                BGZ_ASSERT(boneIndex != -1);//, "Animation references a bone the skeleton doesn't have!");
+                
+                const char* timelineName;
+                Json_beginObject(reader);
+                while (Json_nextKey(reader, &timelineName))
                 {
-                    anim->hitBoxes.Push() = HitBox {};
-                    anim->hitBoxes[hitBoxIndex].boneName = CallocType(heap, char, 100);
-                    
-                    { //Get bone name collision box is attached to by cutting out "box-" prefix
-                        char boneName[100] = {};
-                        i32 j { 0 };
-                        for (i32 i = 4; i < strlen(currentCollisionBox_json->name); ++i, ++j)
-                            boneName[j] = currentCollisionBox_json->name[i];
-                        
-                        memcpy(anim->hitBoxes[hitBoxIndex].boneName, boneName, strlen(boneName));
-                    };
-                    
-                    Json* collisionBoxTimeline_json = Json_getItem(currentCollisionBox_json, "attachment");
-                    Json* keyFrame1_json = collisionBoxTimeline_json->child;
-                    Json* keyFrame2_json = collisionBoxTimeline_json->child->next;
-                    
-                    f32 time1 = Json_getFloat(keyFrame1_json, "time", 0.0f);
-                    f32 time2 = Json_getFloat(keyFrame2_json, "time", 0.0f);
-                    
-                    anim->hitBoxes[hitBoxIndex].timeUntilHitBoxIsActivated = time1;
-                    anim->hitBoxes[hitBoxIndex].duration = time2 - time1;
-                    
+                    if (StringCmp(timelineName, "rotate"))
                     {
-                        bgz::ScopedMemory scopeMemory(&memPart);
-                        
-                        bgz::Dynam_Array<v2> adjustedCollisionBoxVerts, finalCollsionBoxVertCoords;
-                        bgz::Init(&adjustedCollisionBoxVerts, 20);
-                        bgz::Init(&finalCollsionBoxVertCoords, 20);
-                        
-                        Json* collisionBoxDeformTimeline_json = Json_getItem(currentAnimation_json, "deform");
-                        Json* deformKeyFrame_json = collisionBoxDeformTimeline_json->child->child->child->child;
-                        Json* deformedVerts_json = Json_getItem(deformKeyFrame_json, "vertices")->child;
-                        
-                        Bone* bone = GetBoneFromSkeleton(&skel, anim->hitBoxes[hitBoxIndex].boneName);
-                        i32 numVerts = (i32)bgz::Size(&bone->originalCollisionBoxVerts);
-                        for (i32 i {}; i < numVerts; ++i)
-                        {
-                            //Read in adjusted/deformed vert data from individual animation json info
-                            bgz::Push(adjustedCollisionBoxVerts, v2 { deformedVerts_json->valueFloat, deformedVerts_json->next->valueFloat });
-                            deformedVerts_json = deformedVerts_json->next->next;
-                            
-                            //Transform original verts into new transformed vert positions based on anim deformed verts
-                            v2 finalVertCoord = bone->originalCollisionBoxVerts[i] + adjustedCollisionBoxVerts[i];
-                            bgz::Push(finalCollsionBoxVertCoords, finalVertCoord);
-                        };
+                        RotationTimeline* boneRotationTimeline = &anim->boneRotationTimelines[boneIndex];
+                        if (NOT _ReadRotationTimeline(boneRotationTimeline, reader))
+                            fitsInStorage = false;
                         
-                        v2 vector0_1 = finalCollsionBoxVertCoords[0] - finalCollsionBoxVertCoords[1];
-                        v2 vector1_2 = finalCollsionBoxVertCoords[1] - finalCollsionBoxVertCoords[2];
+                        if (boneRotationTimeline->timesCount > 0)
+                            maxTimeOfAnimation = Max(maxTimeOfAnimation, boneRotationTimeline->times[boneRotationTimeline->timesCount - 1]);
+                    }
+                    else if (StringCmp(timelineName, "translate"))
+                    {
+                        TranslationTimeline* boneTranslationTimeline = &anim->boneTranslationTimelines[boneIndex];
+                        if (NOT _ReadTranslationTimeline(boneTranslationTimeline, reader))
+                            fitsInStorage = false;
                         
-                        anim->hitBoxes[hitBoxIndex].size.width = Magnitude(vector0_1);
-                        anim->hitBoxes[hitBoxIndex].size.height = Magnitude(vector1_2);
-                        anim->hitBoxes[hitBoxIndex].worldPosOffset = { (finalCollsionBoxVertCoords[0].x + finalCollsionBoxVertCoords[2].x) / 2.0f,
-                            (finalCollsionBoxVertCoords[0].y + finalCollsionBoxVertCoords[2].y) / 2.0f };
+                        if (boneTranslationTimeline->timesCount > 0)
+                            maxTimeOfAnimation = Max(maxTimeOfAnimation, boneTranslationTimeline->times[boneTranslationTimeline->timesCount - 1]);
+                    }
+                    else //Scale timelines not implemented yet
+                    {
+                        Json_skipValue(reader);
                     };
-                }
+                };
             };
         }
+        else if (StringCmp(key, "slots"))
+        {
+            if (NOT _ReadHitBoxes(anim, reader, memPart))
+                fitsInStorage = false;
+        }
+        else if (StringCmp(key, "deform"))
+        {
+            _ReadDeforms($(deforms), $(deformedVerts), reader);
+        }
+        else
+        {
+            Json_skipValue(reader);
+        };
+    };
+    
+    //"deform" can come before or after "slots" so hit boxes are sized once the whole animation is read. A hit box
+    //without its own deform timeline uses the animation's first one
+    for (i32 hitBoxIndex {}; hitBoxIndex < anim->hitBoxes.length; ++hitBoxIndex)
+    {
+        HitBox* hitBox = &anim->hitBoxes[hitBoxIndex];
+        BGZ_ASSERT(bgz::Size(&deforms) > 0);//, "Animation with collision boxes has no deform timelines!");
         
-        anim->totalTime = maxTimeOfAnimation;
+        const _Deformed_Verts* deform = &deforms[0];
+        for (i32 deformIndex {}; deformIndex < bgz::Size(&deforms); ++deformIndex)
+        {
+            if (strncmp(deforms[deformIndex].slotName, "box-", 4) == 0 && StringCmp(deforms[deformIndex].slotName + 4, hitBox->boneName))
+            {
+                deform = &deforms[deformIndex];
+                break;
+            };
+        };
+        
+        _SizeHitBox(hitBox, skel.setup, deform, deformedVerts);
     };
+    
+    kv_destroy(deforms.elems);
+    kv_destroy(deformedVerts.elems);
+    
+    anim->totalTime = maxTimeOfAnimation;
+    
+    return fitsInStorage;
 };
 
-void MixAnimations(AnimationData&& animData, const char* animName_from, const char* animName_to, f32 mixDuration)
+//Streams through the mapped json once, only looking at the "animations" section. Timelines are read straight into each
+//animation so no json tree is built, and nothing points into the text afterwards so it's unmapped before returning
+b InitAnimData(AnimationData&& animData, bgz::Memory_Partition&& memPart, const char* animDataJsonFilePath, Skeleton skel)
 {
-    Animation* anim_from = GetAnimation(animData.animMap, animName_from);
-    
-    Animation anim_to {};
+    i32 length;
     
-    CopyAnimation(*GetAnimation(animData.animMap, animName_to), $(anim_to));
+    //Copy on write, strings get terminated in place
+    char* jsonFile = (char*)globalPlatformServices->MapEntireFile($(length), animDataJsonFilePath);
+    BGZ_ASSERT(jsonFile);//, "Unable to read animation json!");
     
-    BGZ_ASSERT(anim_from->totalTime > mixDuration);//, "passing a mix time that is too long!");
+    InitAnimMap($(animData.animMap), $(memPart), 20);
     
-    anim_to.mixTimeDuration = mixDuration;
+    Json_Reader reader = Json_reader(jsonFile);
+    b fitsInStorage { true };
     
-    if (anim_from->animsToTransitionTo.length > 0)
+    const char* key;
+    Json_beginObject(&reader);
+    while (Json_nextKey(&reader, &key))
     {
-        for (i32 i {}; i < anim_from->animsToTransitionTo.length; ++i)
+        if (NOT StringCmp(key, "animations"))
         {
-            BGZ_ASSERT(NOT StringCmp(anim_from->animsToTransitionTo[i]->name, anim_to.name));// "Duplicate mix animation tyring to be set");
+            Json_skipValue(&reader);
+            continue;
         };
         
-        anim_from->animsToTransitionTo.Push() = MallocType(heap, Animation, 1);
-        CopyAnimation(anim_to, $(*anim_from->animsToTransitionTo[anim_from->animsToTransitionTo.length - 1]));
-    }
-    else
-    {
-        anim_from->animsToTransitionTo.Push() = MallocType(heap, Animation, 1);
-        CopyAnimation(anim_to, $(*anim_from->animsToTransitionTo[anim_from->animsToTransitionTo.length - 1]));
-    }
+        const char* animName;
+        Json_beginObject(&reader);
+        while (Json_nextKey(&reader, &animName))
+        {
+            const char* name = PushString(&memPart, animName);
+            
+            Animation newAnimation {};
+            InsertAnimation($(animData.animMap), name, newAnimation);
+            Animation* anim = &bgz::LastElem(&animData.animMap.animations);
+            
+            anim->name = name;
+            
+            anim->skelSetup = skel.setup;
+            anim->boneCount = skel.boneCount;
+            
+            b animFits { skel.boneCount <= anim->boneRotationTimelines.Size() };
+            if (animFits)
+                animFits = _ReadAnimation(anim, &reader, skel, &memPart);
+            else
+            {
+                anim->boneCount = 0;
+                Json_skipValue(&reader);
+            };
+            
+            if (NOT animFits)
+            {
+                BGZ_CONSOLE("Animation %s in %s has more bones, key frames or hit boxes than an animation can hold\n", name, animDataJsonFilePath);
+                fitsInStorage = false;
+            };
+        };
+    };
+    
+    b jsonIsValid = NOT Json_readerFailed(&reader);
+    BGZ_ASSERT(jsonIsValid);//, "Malformed animation json!");
+    
+    globalPlatformServices->UnmapFile((void*)jsonFile);
+    
+    return fitsInStorage && jsonIsValid;
 };
 
-void CopyAnimation(Animation src, Animation&& dest)
+void MixAnimations(AnimationData&& animData, const char* animName_from, const char* animName_to, f32 mixDuration)
 {
-    dest = src;
+    Animation* anim_from = GetAnimation(animData.animMap, animName_from);
+    Animation* anim_to = GetAnimation(animData.animMap, animName_to);
+    
+    BGZ_ASSERT(anim_from->totalTime > mixDuration);//, "passing a mix time that is too long!");
     
-    for (i32 boneIndex {}; boneIndex < src.bones.Size(); ++boneIndex)
+    for (i32 i {}; i < anim_from->animsToTransitionTo.length; ++i)
     {
-        CopyArray(src.boneTranslationTimelines[boneIndex].times, $(dest.boneTranslationTimelines[boneIndex].times));
-        CopyArray(src.boneTranslationTimelines[boneIndex].translations, $(dest.boneTranslationTimelines[boneIndex].translations));
-        CopyArray(src.boneRotationTimelines[boneIndex].times, $(dest.boneRotationTimelines[boneIndex].times));
-        CopyArray(src.boneRotationTimelines[boneIndex].angles, $(dest.boneRotationTimelines[boneIndex].angles));
+        BGZ_ASSERT(anim_from->animsToTransitionTo[i].anim_to != anim_to);// "Duplicate mix animation tyring to be set");
     };
+    
+    AnimationMix* mix = &anim_from->animsToTransitionTo.Push();
+    mix->anim_to = anim_to;
+    mix->mixTimeDuration = mixDuration;
 };
 
-void SetIdleAnimation(AnimationQueue&& animQueue, const AnimationData animData, const char* animName)
+void SetIdleAnimation(AnimationQueue&& animQueue, const AnimationData animData, AnimID animID)
 {
-    Animation* sourceAnim = GetAnimation(animData.animMap, animName);
+    AnimationPlayback idleAnim {};
+    idleAnim.anim = GetAnimation(animData.animMap, animID);
+    idleAnim.status = PlayBackStatus::IDLE;
     
-    Animation destAnim;
-    CopyAnimation(*sourceAnim, $(destAnim));
+    animQueue.idleAnim = idleAnim;
+    animQueue.hasIdleAnim = true;
     
-    destAnim.status = PlayBackStatus::IDLE;
-    animQueue.idleAnim = destAnim;
-    
-    animQueue.queuedAnimations.PushBack(destAnim);
+    animQueue.queuedAnimations.PushBack(idleAnim);
+    COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
 };
 
-void QueueAnimation(AnimationQueue&& animQueue, const AnimationData animData, const char* animName, PlayBackStatus playBackStatus)
+void QueueAnimation(AnimationQueue&& animQueue, const AnimationData animData, AnimID animID, PlayBackStatus playBackStatus)
 {
     BGZ_ASSERT(playBackStatus != PlayBackStatus::IDLE);//, "Not suppose to set an IDLE status");
     
-    Animation* sourceAnim = GetAnimation(animData.animMap, animName);
+    Animation* sourceAnim = GetAnimation(animData.animMap, animID);
     
-    Animation* nextAnim = animQueue.queuedAnimations.GetNextElem();
-    const char* nextAnimName { "" };
+    AnimationPlayback* nextAnim = animQueue.queuedAnimations.GetNextElem();
+    Animation* nextAnimClip { nullptr };
     if (nextAnim)
-        nextAnimName = nextAnim->name;
+        nextAnimClip = nextAnim->anim;
     
-    if (NOT animQueue.queuedAnimations.full && NOT StringCmp(sourceAnim->name, nextAnimName))
+    if (NOT animQueue.queuedAnimations.full && sourceAnim != nextAnimClip)
     {
-        Animation destAnim;
-        CopyAnimation(*sourceAnim, $(destAnim));
-        
-        destAnim.status = playBackStatus;
+        AnimationPlayback newAnim {};
+        newAnim.anim = sourceAnim;
+        newAnim.status = playBackStatus;
         
         switch (playBackStatus)
         {
             case PlayBackStatus::DEFAULT: {
-                animQueue.queuedAnimations.PushBack(destAnim);
+                animQueue.queuedAnimations.PushBack(newAnim);
+                COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
             }
             break;
             
             case PlayBackStatus::IMMEDIATE: {
                 animQueue.queuedAnimations.Reset();
-                animQueue.queuedAnimations.PushBack(destAnim);
+                animQueue.queuedAnimations.PushBack(newAnim);
+                COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
             }
             break;
             
             case PlayBackStatus::IMMEDIATE_NOREPEAT: {
-                if(NOT StringCmp(animQueue.queuedAnimations.GetFirstElem()->name, animName))
+                AnimationPlayback* currentAnim = animQueue.queuedAnimations.GetFirstElem();
+                if(NOT currentAnim || currentAnim->anim != sourceAnim)
                 {
                     animQueue.queuedAnimations.Reset();
-                    animQueue.queuedAnimations.PushBack(destAnim);
+                    animQueue.queuedAnimations.PushBack(newAnim);
+                    COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
                 };
                 
             }break;
             
             case PlayBackStatus::NEXT: {
                 animQueue.queuedAnimations.ClearRemaining();
-                animQueue.queuedAnimations.PushBack(destAnim);
+                animQueue.queuedAnimations.PushBack(newAnim);
+                COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
             }
             break;
             
             case PlayBackStatus::HOLD: {
                 if (animQueue.queuedAnimations.Empty())
                 {
-                    animQueue.queuedAnimations.PushBack(destAnim);
+                    animQueue.queuedAnimations.PushBack(newAnim);
+                    COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
                     animQueue.queuedAnimations.GetFirstElem()->repeat = true;
                 }
                 else if (animQueue.queuedAnimations.GetFirstElem()->repeat == true)
@@ -460,7 +774,8 @@ void QueueAnimation(AnimationQueue&& animQueue, const AnimationData animData, co
                 else
                 {
                     animQueue.queuedAnimations.Reset();
-                    animQueue.queuedAnimations.PushBack(destAnim);
+                    animQueue.queuedAnimations.PushBack(newAnim);
+                    COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
                     animQueue.queuedAnimations.GetFirstElem()->repeat = true;
                 };
             }
@@ -473,20 +788,20 @@ void QueueAnimation(AnimationQueue&& animQueue, const AnimationData animData, co
 
 //Returns lower keyFrame of range(e.g. if range is between 0 - 1 then keyFrame number 0 is returned)
 template <typename TransformationTimelineType>
-i32 _CurrentActiveKeyFrame(TransformationTimelineType transformationTimelineOfBone, f32 currentAnimRuntime)
+i32 _CurrentActiveKeyFrame(TransformationTimelineType* transformationTimelineOfBone, f32 currentAnimRuntime)
 {
-    BGZ_ASSERT(transformationTimelineOfBone.exists);//, "Trying to get keyframes from a timeline that does not exist");
+    BGZ_ASSERT(transformationTimelineOfBone->exists);//, "Trying to get keyframes from a timeline that does not exist");
     
     i32 result {};
-    i32 keyFrameCount = (i32)transformationTimelineOfBone.timesCount - 1;
+    i32 keyFrameCount = (i32)transformationTimelineOfBone->timesCount - 1;
     
     f32 keyFrameTime0 {};
-    f32 keyFrameTime1 = transformationTimelineOfBone.times[keyFrameCount];
+    f32 keyFrameTime1 = transformationTimelineOfBone->times[keyFrameCount];
     
     while (keyFrameCount)
     {
-        keyFrameTime0 = transformationTimelineOfBone.times[keyFrameCount - 1];
-        keyFrameTime1 = transformationTimelineOfBone.times[keyFrameCount];
+        keyFrameTime0 = transformationTimelineOfBone->times[keyFrameCount - 1];
+        keyFrameTime1 = transformationTimelineOfBone->times[keyFrameCount];
         
         if (keyFrameTime0 <= currentAnimRuntime && keyFrameTime1 > currentAnimRuntime)
         {
@@ -511,43 +826,43 @@ struct TransformationRangeResult
 };
 
 template <typename TransformationType, typename TransformationTimelineType>
-TransformationRangeResult<TransformationType> _GetTransformationRangeFromKeyFrames(TransformationTimelineType transformationTimelineOfBone, f32 currentAnimRunTime)
+TransformationRangeResult<TransformationType> _GetTransformationRangeFromKeyFrames(TransformationTimelineType* transformationTimelineOfBone, f32 currentAnimRunTime)
 {
-    BGZ_ASSERT(transformationTimelineOfBone.timesCount != 0);// "Can't get translations range from timeline w/ no keyframes!");
+    BGZ_ASSERT(transformationTimelineOfBone->timesCount != 0);// "Can't get translations range from timeline w/ no keyframes!");
     
     TransformationRangeResult<TransformationType> result {};
     
-    i32 firstKeyFrame { 0 }, lastKeyFrame { (i32)transformationTimelineOfBone.timesCount - 1 };
-    if (transformationTimelineOfBone.timesCount == 1)
+    i32 firstKeyFrame { 0 }, lastKeyFrame { (i32)transformationTimelineOfBone->timesCount - 1 };
+    if (transformationTimelineOfBone->timesCount == 1)
     {
-        if (currentAnimRunTime >= transformationTimelineOfBone.times[firstKeyFrame])
+        if (currentAnimRunTime >= transformationTimelineOfBone->times[firstKeyFrame])
         {
-            result.transformation0 = transformationTimelineOfBone.GetTransformationVal(transformationTimelineOfBone, firstKeyFrame);
+            result.transformation0 = transformationTimelineOfBone->GetTransformationVal(transformationTimelineOfBone, firstKeyFrame);
             result.transformation1 = result.transformation0;
             result.percentToLerp = 1.0f;
         };
     }
-    else if (currentAnimRunTime >= transformationTimelineOfBone.times[firstKeyFrame] && currentAnimRunTime < transformationTimelineOfBone.times[lastKeyFrame])
+    else if (currentAnimRunTime >= transformationTimelineOfBone->times[firstKeyFrame] && currentAnimRunTime < transformationTimelineOfBone->times[lastKeyFrame])
     {
         i32 activeKeyFrameIndex = _CurrentActiveKeyFrame(transformationTimelineOfBone, currentAnimRunTime);
         BGZ_ASSERT(activeKeyFrameIndex != lastKeyFrame);//, "Should never be returning the last keyframe of timeline here!");
         
-        switch (transformationTimelineOfBone.curves[activeKeyFrameIndex])
+        switch (transformationTimelineOfBone->curves[activeKeyFrameIndex])
         {
             case CurveType::STEPPED: {
-                result.transformation0 = transformationTimelineOfBone.GetTransformationVal(transformationTimelineOfBone, activeKeyFrameIndex);
-                result.transformation1 = transformationTimelineOfBone.GetTransformationVal(transformationTimelineOfBone, activeKeyFrameIndex + 1);
+                result.transformation0 = transformationTimelineOfBone->GetTransformationVal(transformationTimelineOfBone, activeKeyFrameIndex);
+                result.transformation1 = transformationTimelineOfBone->GetTransformationVal(transformationTimelineOfBone, activeKeyFrameIndex + 1);
                 
                 result.percentToLerp = 0.0f;
             }
             break;
             
             case CurveType::LINEAR: {
-                result.transformation0 = transformationTimelineOfBone.GetTransformationVal(transformationTimelineOfBone, activeKeyFrameIndex);
-                result.transformation1 = transformationTimelineOfBone.GetTransformationVal(transformationTimelineOfBone, activeKeyFrameIndex + 1);
+                result.transformation0 = transformationTimelineOfBone->GetTransformationVal(transformationTimelineOfBone, activeKeyFrameIndex);
+                result.transformation1 = transformationTimelineOfBone->GetTransformationVal(transformationTimelineOfBone, activeKeyFrameIndex + 1);
                 
-                f32 time0 = transformationTimelineOfBone.times[activeKeyFrameIndex];
-                f32 time1 = transformationTimelineOfBone.times[activeKeyFrameIndex + 1];
+                f32 time0 = transformationTimelineOfBone->times[activeKeyFrameIndex];
+                f32 time1 = transformationTimelineOfBone->times[activeKeyFrameIndex + 1];
                 
                 f32 diff0 = time1 - time0;
                 f32 diff1 = currentAnimRunTime - time0;
@@ -558,9 +873,9 @@ TransformationRangeResult<TransformationType> _GetTransformationRangeFromKeyFram
             InvalidDefaultCase;
         }
     }
-    else if (currentAnimRunTime >= transformationTimelineOfBone.times[lastKeyFrame])
+    else if (currentAnimRunTime >= transformationTimelineOfBone->times[lastKeyFrame])
     {
-        result.transformation0 = transformationTimelineOfBone.GetTransformationVal(transformationTimelineOfBone, lastKeyFrame);
+        result.transformation0 = transformationTimelineOfBone->GetTransformationVal(transformationTimelineOfBone, lastKeyFrame);
         result.transformation1 = result.transformation0;
         result.percentToLerp = 1.0f;
     }
@@ -569,22 +884,24 @@ TransformationRangeResult<TransformationType> _GetTransformationRangeFromKeyFram
 };
 
 template <typename transformationRangeType, typename TransformTimelineType>
-TransformationRangeResult<transformationRangeType> _GetTransformationRangeFromKeyFrames(Animation* anim, TransformTimelineType boneRotationTimeline_originalAnim, TransformTimelineType boneRotationTimeline_nextAnim, f32 currentAnimRunTime, transformationRangeType initialTransformForMixing)
+TransformationRangeResult<transformationRangeType> _GetTransformationRangeFromKeyFrames(AnimationPlayback* anim, TransformTimelineType* boneRotationTimeline_originalAnim, TransformTimelineType* boneRotationTimeline_nextAnim, f32 currentAnimRunTime, transformationRangeType initialTransformForMixing)
 {
     TransformationRangeResult<transformationRangeType> result {};
     
     result.transformation0 = initialTransformForMixing;
     result.transformation1 = transformationRangeType {};
     
-    if ((boneRotationTimeline_originalAnim.exists && boneRotationTimeline_nextAnim.exists && boneRotationTimeline_nextAnim.times[0] > 0.0f) || (boneRotationTimeline_originalAnim.exists && NOT boneRotationTimeline_nextAnim.exists))
+    b nextAnimTimelineExists = boneRotationTimeline_nextAnim && boneRotationTimeline_nextAnim->exists;
+    
+    if ((boneRotationTimeline_originalAnim->exists && nextAnimTimelineExists && boneRotationTimeline_nextAnim->times[0] > 0.0f) || (boneRotationTimeline_originalAnim->exists && NOT nextAnimTimelineExists))
     {
         //Leave transformation1 at default 0 value
     }
     
-    else if ((boneRotationTimeline_originalAnim.exists && boneRotationTimeline_nextAnim.exists) || (boneRotationTimeline_originalAnim.exists && NOT boneRotationTimeline_nextAnim.exists))
+    else if ((boneRotationTimeline_originalAnim->exists && nextAnimTimelineExists) || (boneRotationTimeline_originalAnim->exists && NOT nextAnimTimelineExists))
     {
         i32 firstKeyFrame_index = 0;
-        result.transformation1 = boneRotationTimeline_nextAnim.GetTransformationVal(boneRotationTimeline_nextAnim, firstKeyFrame_index);
+        result.transformation1 = boneRotationTimeline_nextAnim->GetTransformationVal(boneRotationTimeline_nextAnim, firstKeyFrame_index);
     }
     
     result.percentToLerp = anim->currentMixTime / anim->initialTimeLeftInAnimAtMixingStart;
@@ -592,9 +909,64 @@ TransformationRangeResult<transformationRangeType> _GetTransformationRangeFromKe
     return result;
 };
 
-Animation UpdateAnimationState(AnimationQueue&& animQueue, f32 prevFrameDT)
+f32 _DetermineRotationAmountAndDirection(TransformationRangeResult<f32> rotationRange, f32 boneLength)
 {
-    auto InitializeMixingData = [](Animation&& anim, f32 prevFrameDT, f32 amountOfTimeLeftInAnim) -> void {
+    f32 amountOfRotation {};
+    
+    v2 boneVector_frame0 = { boneLength * CosR(rotationRange.transformation0), boneLength * SinR(rotationRange.transformation0) };
+    v2 boneVector_frame1 = { boneLength * CosR(rotationRange.transformation1), boneLength * SinR(rotationRange.transformation1) };
+    f32 directionOfRotation = CrossProduct(boneVector_frame0, boneVector_frame1);
+    
+    if (directionOfRotation > 0) //Rotate counter-clockwise
+    {
+        if (rotationRange.transformation0 < rotationRange.transformation1)
+        {
+            amountOfRotation = Lerp(rotationRange.transformation0, rotationRange.transformation1, rotationRange.percentToLerp);
+        }
+        else
+        {
+            ConvertPositiveToNegativeAngle_Radians($(rotationRange.transformation0));
+            amountOfRotation = Lerp(rotationRange.transformation0, rotationRange.transformation1, rotationRange.percentToLerp);
+        }
+    }
+    else //Rotate clockwise
+    {
+        if (rotationRange.transformation0 < rotationRange.transformation1)
+        {
+            ConvertPositiveToNegativeAngle_Radians($(rotationRange.transformation1));
+            amountOfRotation = Lerp(rotationRange.transformation0, rotationRange.transformation1, rotationRange.percentToLerp);
+        }
+        else
+        {
+            amountOfRotation = Lerp(rotationRange.transformation0, rotationRange.transformation1, rotationRange.percentToLerp);
+        }
+    }
+    
+    return amountOfRotation;
+};
+
+//Non-mixing pose of a single bone straight from the keyframe timelines. Used for un-baked clips and to bake clips at load time
+void _SampleBoneFromKeyFrames(Animation* anim, i32 boneIndex, f32 currentAnimRunTime, f32&& amountOfRotation, v2&& amountOfTranslation)
+{
+    amountOfRotation = 0.0f;
+    amountOfTranslation = { 0.0f, 0.0f };
+    
+    if (anim->boneTranslationTimelines[boneIndex].exists)
+    {
+        TransformationRangeResult<v2> translationRange = _GetTransformationRangeFromKeyFrames<v2, TranslationTimeline>(&anim->boneTranslationTimelines[boneIndex], currentAnimRunTime);
+        amountOfTranslation = Lerp(translationRange.transformation0, translationRange.transformation1, translationRange.percentToLerp);
+    };
+    
+    if (anim->boneRotationTimelines[boneIndex].exists)
+    {
+        TransformationRangeResult<f32> rotationRange = _GetTransformationRangeFromKeyFrames<f32, RotationTimeline>(&anim->boneRotationTimelines[boneIndex], currentAnimRunTime);
+        amountOfRotation = _DetermineRotationAmountAndDirection(rotationRange, anim->skelSetup->boneLengths[boneIndex]);
+    };
+};
+
+AnimationPlayback UpdateAnimationState(AnimationQueue&& animQueue, f32 prevFrameDT)
+{
+    auto InitializeMixingData = [](AnimationPlayback&& anim, AnimationQueue&& animQueue, f32 prevFrameDT, f32 amountOfTimeLeftInAnim) -> void {
         anim.currentMixTime += prevFrameDT;
         
         if (NOT anim.MixingStarted)
@@ -602,11 +974,8 @@ Animation UpdateAnimationState(AnimationQueue&& animQueue, f32 prevFrameDT)
             anim.initialTimeLeftInAnimAtMixingStart = amountOfTimeLeftInAnim;
             anim.MixingStarted = true;
             
-            for (i32 boneIndex {}; boneIndex < anim.bones.Size(); ++boneIndex)
-            {
-                anim.bones[boneIndex]->initialRotationForMixing = anim.boneRotations[boneIndex];
-                anim.bones[boneIndex]->initialTranslationForMixing = anim.boneTranslations[boneIndex];
-            }
+            animQueue.poseAtMixingStart = animQueue.pose;
+            COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPose));
         }
         
         if (anim.currentMixTime > anim.initialTimeLeftInAnimAtMixingStart)
@@ -616,136 +985,108 @@ Animation UpdateAnimationState(AnimationQueue&& animQueue, f32 prevFrameDT)
         }
     };
     
-    auto DetermineRotationAmountAndDirection = [](TransformationRangeResult<f32> rotationRange, f32 boneLength) -> f32 {
-        f32 amountOfRotation {};
-        
-        v2 boneVector_frame0 = { boneLength * CosR(rotationRange.transformation0), boneLength * SinR(rotationRange.transformation0) };
-        v2 boneVector_frame1 = { boneLength * CosR(rotationRange.transformation1), boneLength * SinR(rotationRange.transformation1) };
-        f32 directionOfRotation = CrossProduct(boneVector_frame0, boneVector_frame1);
-        
-        if (directionOfRotation > 0) //Rotate counter-clockwise
-        {
-            if (rotationRange.transformation0 < rotationRange.transformation1)
-            {
-                amountOfRotation = Lerp(rotationRange.transformation0, rotationRange.transformation1, rotationRange.percentToLerp);
-            }
-            else
-            {
-                ConvertPositiveToNegativeAngle_Radians($(rotationRange.transformation0));
-                amountOfRotation = Lerp(rotationRange.transformation0, rotationRange.transformation1, rotationRange.percentToLerp);
-            }
-        }
-        else //Rotate clockwise
-        {
-            if (rotationRange.transformation0 < rotationRange.transformation1)
-            {
-                ConvertPositiveToNegativeAngle_Radians($(rotationRange.transformation1));
-                amountOfRotation = Lerp(rotationRange.transformation0, rotationRange.transformation1, rotationRange.percentToLerp);
-            }
-            else
-            {
-                amountOfRotation = Lerp(rotationRange.transformation0, rotationRange.transformation1, rotationRange.percentToLerp);
-            }
-        }
-        
-        return amountOfRotation;
-    };
-    
     if (animQueue.queuedAnimations.Empty())
+    {
         animQueue.queuedAnimations.PushBack(animQueue.idleAnim);
+        COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
+    };
     
-    Animation* anim = animQueue.queuedAnimations.GetFirstElem();
+    AnimationPlayback* anim = animQueue.queuedAnimations.GetFirstElem();
     BGZ_ASSERT(anim);//, "No animation returned!");
     
+    Animation* clip = anim->anim;
+    AnimationPose* pose = &animQueue.pose;
+    AnimationPlayback* nextAnimInQueue = animQueue.queuedAnimations.GetNextElem();
+    
     { //Check if mixing needs to be activated
-        f32 amountOfTimeLeftInAnim = anim->totalTime - anim->currentTime;
-        Animation* nextAnimInQueue = animQueue.queuedAnimations.GetNextElem();
+        f32 amountOfTimeLeftInAnim = clip->totalTime - anim->currentTime;
         if (nextAnimInQueue)
         {
-            for (i32 animIndex {}; animIndex < anim->animsToTransitionTo.length; ++animIndex)
+            for (i32 animIndex {}; animIndex < clip->animsToTransitionTo.length; ++animIndex)
             {
-                if (StringCmp(anim->animsToTransitionTo[animIndex]->name, nextAnimInQueue->name))
+                if (clip->animsToTransitionTo[animIndex].anim_to == nextAnimInQueue->anim)
                 {
-                    if (amountOfTimeLeftInAnim <= anim->animsToTransitionTo[animIndex]->mixTimeDuration)
+                    if (amountOfTimeLeftInAnim <= clip->animsToTransitionTo[animIndex].mixTimeDuration)
                     {
-                        InitializeMixingData($(*anim), prevFrameDT, amountOfTimeLeftInAnim);
+                        InitializeMixingData($(*anim), $(animQueue), prevFrameDT, amountOfTimeLeftInAnim);
                     }
                 }
             };
         };
     };
     
-    f32 maxTimeOfAnimation {};
-    for (i32 boneIndex {}; boneIndex < anim->bones.Size(); ++boneIndex)
+    if (NOT anim->MixingStarted && clip->bakedClip.sampleCount > 0)
     {
-        const Bone* bone = anim->bones[boneIndex];
-        
-        //Gather transformation timelines
-        v2 amountOfTranslation { 0.0f, 0.0f };
-        f32 amountOfRotation { 0.0f };
-        TranslationTimeline translationTimelineOfBone = anim->boneTranslationTimelines[boneIndex];
-        RotationTimeline rotationTimelineOfBone = anim->boneRotationTimelines[boneIndex];
-        ScaleTimeline scaleTimelineOfBone = anim->boneScaleTimelines[boneIndex];
-        
-        Animation* nextAnimInQueue = animQueue.queuedAnimations.GetNextElem();
-        
-        { //Translation Timeline
-            if (anim->MixingStarted)
-            {
-                BGZ_ASSERT(anim->animsToTransitionTo.length > 0);//, "No transition animation for mixing has been set!");
-                
-                TranslationTimeline nextAnimTranslationTimeline {};
-                if (nextAnimInQueue)
-                    nextAnimTranslationTimeline = nextAnimInQueue->boneTranslationTimelines[boneIndex];
-                
-                TransformationRangeResult<v2> translationRange = _GetTransformationRangeFromKeyFrames<v2, TranslationTimeline>(anim, translationTimelineOfBone, nextAnimTranslationTimeline, anim->currentTime, anim->bones[boneIndex]->initialTranslationForMixing);
-                amountOfTranslation = Lerp(translationRange.transformation0, translationRange.transformation1, translationRange.percentToLerp);
-            }
-            else
-            {
-                if (translationTimelineOfBone.exists)
+        SampleBakedClip(clip->bakedClip, anim->currentTime, pose->boneRotations.elements, pose->boneTranslations.elements);
+    }
+    else
+    {
+        for (i32 boneIndex {}; boneIndex < clip->boneCount; ++boneIndex)
+        {
+            f32 boneLength = clip->skelSetup->boneLengths[boneIndex];
+            
+            
+            //Gather transformation timelines
+            v2 amountOfTranslation { 0.0f, 0.0f };
+            f32 amountOfRotation { 0.0f };
+            TranslationTimeline* translationTimelineOfBone = &clip->boneTranslationTimelines[boneIndex];
+            RotationTimeline* rotationTimelineOfBone = &clip->boneRotationTimelines[boneIndex];
+            
+            { //Translation Timeline
+                if (anim->MixingStarted)
                 {
-                    TransformationRangeResult<v2> translationRange = _GetTransformationRangeFromKeyFrames<v2, TranslationTimeline>(translationTimelineOfBone, anim->currentTime);
+                    BGZ_ASSERT(clip->animsToTransitionTo.length > 0);//, "No transition animation for mixing has been set!");
+                    
+                    TranslationTimeline* nextAnimTranslationTimeline { nullptr };
+                    if (nextAnimInQueue)
+                        nextAnimTranslationTimeline = &nextAnimInQueue->anim->boneTranslationTimelines[boneIndex];
+                    
+                    TransformationRangeResult<v2> translationRange = _GetTransformationRangeFromKeyFrames<v2, TranslationTimeline>(anim, translationTimelineOfBone, nextAnimTranslationTimeline, anim->currentTime, animQueue.poseAtMixingStart.boneTranslations[boneIndex]);
                     amountOfTranslation = Lerp(translationRange.transformation0, translationRange.transformation1, translationRange.percentToLerp);
+                }
+                else
+                {
+                    if (translationTimelineOfBone->exists)
+                    {
+                        TransformationRangeResult<v2> translationRange = _GetTransformationRangeFromKeyFrames<v2, TranslationTimeline>(translationTimelineOfBone, anim->currentTime);
+                        amountOfTranslation = Lerp(translationRange.transformation0, translationRange.transformation1, translationRange.percentToLerp);
+                    };
                 };
-            };
-        }
-        
-        { //Rotation Timeline
-            if (anim->MixingStarted)
-            {
-                BGZ_ASSERT(anim->animsToTransitionTo.length > 0);//, "No transition animation for mixing has been set!");
-                
-                RotationTimeline nextAnimRotationTimeline {};
-                if (nextAnimInQueue)
-                    nextAnimRotationTimeline = nextAnimInQueue->boneRotationTimelines[boneIndex];
-                
-                TransformationRangeResult<f32> rotationRange = _GetTransformationRangeFromKeyFrames<f32, RotationTimeline>(anim, rotationTimelineOfBone, nextAnimRotationTimeline, anim->currentTime, anim->bones[boneIndex]->initialRotationForMixing);
-                amountOfRotation = DetermineRotationAmountAndDirection(rotationRange, bone->length);
             }
-            else
-            {
-                if (StringCmp(bone->name, "right-bicep"))
-                    int x {};
-                
-                if (rotationTimelineOfBone.exists)
+            
+            { //Rotation Timeline
+                if (anim->MixingStarted)
                 {
-                    TransformationRangeResult<f32> rotationRange = _GetTransformationRangeFromKeyFrames<f32, RotationTimeline>(rotationTimelineOfBone, anim->currentTime);
-                    amountOfRotation = DetermineRotationAmountAndDirection(rotationRange, bone->length);
+                    BGZ_ASSERT(clip->animsToTransitionTo.length > 0);//, "No transition animation for mixing has been set!");
+                    
+                    RotationTimeline* nextAnimRotationTimeline { nullptr };
+                    if (nextAnimInQueue)
+                        nextAnimRotationTimeline = &nextAnimInQueue->anim->boneRotationTimelines[boneIndex];
+                    
+                    TransformationRangeResult<f32> rotationRange = _GetTransformationRangeFromKeyFrames<f32, RotationTimeline>(anim, rotationTimelineOfBone, nextAnimRotationTimeline, anim->currentTime, animQueue.poseAtMixingStart.boneRotations[boneIndex]);
+                    amountOfRotation = _DetermineRotationAmountAndDirection(rotationRange, boneLength);
+                }
+                else
+                {
+                    if (rotationTimelineOfBone->exists)
+                    {
+                        TransformationRangeResult<f32> rotationRange = _GetTransformationRangeFromKeyFrames<f32, RotationTimeline>(rotationTimelineOfBone, anim->currentTime);
+                        amountOfRotation = _DetermineRotationAmountAndDirection(rotationRange, boneLength);
+                    };
                 };
-            };
-        }
-        
-        { //Scale timeline
-            //Implement
-        }
-        
-        anim->boneRotations[boneIndex] = amountOfRotation;
-        anim->boneTranslations[boneIndex] = amountOfTranslation;
+            }
+            
+            { //Scale timeline
+                //Implement
+            }
+            
+            pose->boneRotations[boneIndex] = amountOfRotation;
+            pose->boneTranslations[boneIndex] = amountOfTranslation;
+        };
     };
     
-    Animation result;
-    CopyAnimation(*anim, $(result));
+    AnimationPlayback result = *anim;
+    COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
     
     if (anim->hasEnded)
     {
@@ -756,19 +1097,22 @@ Animation UpdateAnimationState(AnimationQueue&& animQueue, f32 prevFrameDT)
         animQueue.queuedAnimations.RemoveElem();
         
         if (animQueue.queuedAnimations.Empty())
+        {
             animQueue.queuedAnimations.PushBack(animQueue.idleAnim);
+            COUNT_ANIM_BYTES_COPIED(sizeof(AnimationPlayback));
+        };
     };
     
     //Update anim playback time
     f32 prevFrameAnimTime = anim->currentTime;
     anim->currentTime += prevFrameDT;
-    if (anim->currentTime > anim->totalTime)
+    if (anim->currentTime > clip->totalTime)
     {
-        f32 diff = anim->currentTime - anim->totalTime;
+        f32 diff = anim->currentTime - clip->totalTime;
         anim->currentTime -= diff;
         anim->hasEnded = true;
     }
-    else if (anim->currentTime == anim->totalTime)
+    else if (anim->currentTime == clip->totalTime)
     {
         anim->hasEnded = true;
     }
@@ -776,18 +1120,375 @@ Animation UpdateAnimationState(AnimationQueue&& animQueue, f32 prevFrameDT)
     return result;
 };
 
-void ApplyAnimationToSkeleton(Skeleton&& skel, Animation anim)
+void ApplyAnimationToSkeleton(Skeleton&& skel, const AnimationPose* pose)
 {
     ResetBonesToSetupPose($(skel));
     
-    for (i32 boneIndex {}; boneIndex < bgz::Size(&skel.bones); ++boneIndex)
+    for (i32 boneIndex {}; boneIndex < skel.boneCount; ++boneIndex)
     {
-        f32 boneRotationToAdd = anim.boneRotations[boneIndex];
-        skel.bones[boneIndex].parentBoneSpace.rotation += boneRotationToAdd;
+        skel.pose.rotations_parentBoneSpace[boneIndex] += pose->boneRotations.elements[boneIndex];
+        skel.pose.translations_parentBoneSpace[boneIndex] += pose->boneTranslations.elements[boneIndex];
+    };
+};
+
+//Resamples every clip's keyframe timelines into a dense, fixed rate pose table. Needs to be done after all unit conversions
+//and height adjustments have been applied to the keyframes since the baked poses are what gets played back from then on
+void BakeAnimationClips(AnimationData&& animData, bgz::Memory_Partition&& memPart, f32 sampleRate = BAKED_CLIP_SAMPLE_RATE)
+{
+    BGZ_ASSERT(sampleRate > 0.0f);//, "Need a valid sample rate to bake clips!");
+    
+    for (i32 animIndex {}; animIndex < bgz::Size(&animData.animMap.animations); ++animIndex)
+    {
+        Animation* anim = &animData.animMap.animations[animIndex];
+        
+        if (NOT anim->name || anim->bakedClip.sampleCount > 0) //Clips shared between fighters only need baking once
+            continue;
+        
+        Baked_Clip* clip = &anim->bakedClip;
+        clip->sampleRate = sampleRate;
+        clip->boneCount = anim->boneCount;
+        clip->sampleCount = CeilF32ToI32(anim->totalTime * sampleRate) + 1;
+        if (clip->sampleCount < 2) //Always have a pair of samples to lerp between
+            clip->sampleCount = 2;
+        
+        clip->boneRotations = PushType(&memPart, f32, clip->sampleCount * clip->boneCount);
+        clip->boneTranslations = PushType(&memPart, v2, clip->sampleCount * clip->boneCount);
         
-        v2 boneTranslationToAdd = anim.boneTranslations[boneIndex];
-        skel.bones[boneIndex].parentBoneSpace.translation += boneTranslationToAdd;
+        for (i32 sampleIndex {}; sampleIndex < clip->sampleCount; ++sampleIndex)
+        {
+            f32 sampleTime = Min((f32)sampleIndex / sampleRate, anim->totalTime);
+            
+            f32* rotations = clip->boneRotations + (sampleIndex * clip->boneCount);
+            v2* translations = clip->boneTranslations + (sampleIndex * clip->boneCount);
+            for (i32 boneIndex {}; boneIndex < clip->boneCount; ++boneIndex)
+            {
+                _SampleBoneFromKeyFrames(anim, boneIndex, sampleTime, $(rotations[boneIndex]), $(translations[boneIndex]));
+                
+                //Keyframe rotations can flip between positive and negative ranges from one key to the next. Keep each
+                //sample within half a turn of the previous one so lerping between baked samples takes the short way around
+                if (sampleIndex > 0)
+                {
+                    f32 prevRotation = rotations[boneIndex - clip->boneCount];
+                    while (rotations[boneIndex] - prevRotation > PI)
+                        rotations[boneIndex] -= 2.0f * PI;
+                    while (rotations[boneIndex] - prevRotation < -PI)
+                        rotations[boneIndex] += 2.0f * PI;
+                };
+            };
+        };
+    };
+};
+
+void SampleBakedClip(Baked_Clip clip, f32 currentAnimRunTime, f32* boneRotations, v2* boneTranslations)
+{
+    BGZ_ASSERT(clip.sampleCount > 1);//, "Trying to sample a clip that hasn't been baked!");
+    
+    f32 samplePos = Max(0.0f, Min(currentAnimRunTime * clip.sampleRate, (f32)(clip.sampleCount - 1)));
+    i32 sampleIndex = (i32)Min(samplePos, (f32)(clip.sampleCount - 2));
+    f32 percentToLerp = samplePos - (f32)sampleIndex;
+    
+    const f32* rotations0 = clip.boneRotations + (sampleIndex * clip.boneCount);
+    const f32* rotations1 = rotations0 + clip.boneCount;
+    const v2* translations0 = clip.boneTranslations + (sampleIndex * clip.boneCount);
+    const v2* translations1 = translations0 + clip.boneCount;
+    
+    for (i32 boneIndex {}; boneIndex < clip.boneCount; ++boneIndex)
+    {
+        boneRotations[boneIndex] = rotations0[boneIndex] + percentToLerp * (rotations1[boneIndex] - rotations0[boneIndex]);
+        boneTranslations[boneIndex].x = translations0[boneIndex].x + percentToLerp * (translations1[boneIndex].x - translations0[boneIndex].x);
+        boneTranslations[boneIndex].y = translations0[boneIndex].y + percentToLerp * (translations1[boneIndex].y - translations0[boneIndex].y);
+    };
+};
+
+//Samples many playback states of the same baked clip in one pass, one instance per SIMD lane, writing one pose per
+//instance into the contiguous poses buffer (which ApplyAnimationToSkeleton can read from directly). Mixing playbacks
+//aren't supported here since they need the keyframe path
+void SampleBakedClip_Batch(Baked_Clip clip, const AnimationPlayback* playbacks, i32 instanceCount, AnimationPose* poses)
+{
+    BGZ_ASSERT(clip.sampleCount > 1);//, "Trying to sample a clip that hasn't been baked!");
+    BGZ_ASSERT(clip.boneCount <= poses[0].boneRotations.Size());//, "Clip has more bones than a pose can hold!");
+    for (i32 laneIndex {}; laneIndex < instanceCount; ++laneIndex)
+        BGZ_ASSERT(NOT playbacks[laneIndex].MixingStarted && playbacks[laneIndex].anim && playbacks[laneIndex].anim->bakedClip.boneRotations == clip.boneRotations
+                   && playbacks[laneIndex].anim->bakedClip.boneCount == clip.boneCount);//, "All batched playbacks need to share one un-mixed clip!");
+    
+    i32 instanceIndex {};
+    
+#if __AVX2__
+    { //8 instances at a time
+        __m256 zero = _mm256_set1_ps(0.0f);
+        __m256 sampleRate = _mm256_set1_ps(clip.sampleRate);
+        __m256 maxSamplePos = _mm256_set1_ps((f32)(clip.sampleCount - 1));
+        __m256 maxFirstSampleIndex = _mm256_set1_ps((f32)(clip.sampleCount - 2));
+        __m256i boneCount = _mm256_set1_epi32(clip.boneCount);
+        const f32* translationsAsFloats = (const f32*)clip.boneTranslations;
+        
+        for (; instanceIndex + 8 <= instanceCount; instanceIndex += 8)
+        {
+            const AnimationPlayback* lanes = playbacks + instanceIndex;
+            
+            __m256 currentTimes = _mm256_set_ps(lanes[7].currentTime, lanes[6].currentTime, lanes[5].currentTime, lanes[4].currentTime,
+                                                lanes[3].currentTime, lanes[2].currentTime, lanes[1].currentTime, lanes[0].currentTime);
+            
+            //Same clamping as SampleBakedClip so both paths produce identical poses
+            __m256 samplePos = _mm256_max_ps(zero, _mm256_min_ps(_mm256_mul_ps(currentTimes, sampleRate), maxSamplePos));
+            __m256i sampleIndex = _mm256_cvttps_epi32(_mm256_min_ps(samplePos, maxFirstSampleIndex));
+            __m256 percentToLerp = _mm256_sub_ps(samplePos, _mm256_cvtepi32_ps(sampleIndex));
+            
+            __m256i poseOffsets0 = _mm256_mullo_epi32(sampleIndex, boneCount);
+            __m256i poseOffsets1 = _mm256_add_epi32(poseOffsets0, boneCount);
+            
+            for (i32 boneIndex {}; boneIndex < clip.boneCount; ++boneIndex)
+            {
+                __m256i boneIndices = _mm256_set1_epi32(boneIndex);
+                __m256i elemIndices0 = _mm256_add_epi32(poseOffsets0, boneIndices);
+                __m256i elemIndices1 = _mm256_add_epi32(poseOffsets1, boneIndices);
+                
+                __m256 rotations0 = _mm256_i32gather_ps(clip.boneRotations, elemIndices0, 4);
+                __m256 rotations1 = _mm256_i32gather_ps(clip.boneRotations, elemIndices1, 4);
+                
+                //Translations are stored as interleaved x,y floats
+                __m256i xIndices0 = _mm256_slli_epi32(elemIndices0, 1);
+                __m256i xIndices1 = _mm256_slli_epi32(elemIndices1, 1);
+                __m256 translations0_x = _mm256_i32gather_ps(translationsAsFloats, xIndices0, 4);
+                __m256 translations1_x = _mm256_i32gather_ps(translationsAsFloats, xIndices1, 4);
+                __m256 translations0_y = _mm256_i32gather_ps(translationsAsFloats + 1, xIndices0, 4);
+                __m256 translations1_y = _mm256_i32gather_ps(translationsAsFloats + 1, xIndices1, 4);
+                
+                f32 rotations[8], translations_x[8], translations_y[8];
+                _mm256_storeu_ps(rotations, _mm256_add_ps(rotations0, _mm256_mul_ps(percentToLerp, _mm256_sub_ps(rotations1, rotations0))));
+                _mm256_storeu_ps(translations_x, _mm256_add_ps(translations0_x, _mm256_mul_ps(percentToLerp, _mm256_sub_ps(translations1_x, translations0_x))));
+                _mm256_storeu_ps(translations_y, _mm256_add_ps(translations0_y, _mm256_mul_ps(percentToLerp, _mm256_sub_ps(translations1_y, translations0_y))));
+                
+                AnimationPose* lanePoses = poses + instanceIndex;
+                for (i32 lane {}; lane < 8; ++lane)
+                {
+                    lanePoses[lane].boneRotations.elements[boneIndex] = rotations[lane];
+                    lanePoses[lane].boneTranslations.elements[boneIndex] = { translations_x[lane], translations_y[lane] };
+                };
+            };
+        };
     };
+#endif
+    
+    //Scalar fallback and whatever doesn't fill up a full set of lanes
+    for (; instanceIndex < instanceCount; ++instanceIndex)
+        SampleBakedClip(clip, playbacks[instanceIndex].currentTime, poses[instanceIndex].boneRotations.elements, poses[instanceIndex].boneTranslations.elements);
 };
 
+#if DEVELOPMENT_BUILD
+//Samples every baked clip of the anim data with both the keyframe sampler and the baked sampler and logs poses/sec for each,
+//along with the largest difference found between the two so any baking error shows up next to the speedup
+void BenchmarkAnimationSamplers(AnimationData animData, const char* dataName, i32 posesToSamplePerAnim)
+{
+    f64 keyFrameSamplerSecs {}, bakedSamplerSecs {};
+    i64 posesSampled {};
+    f32 maxRotationError {}, maxTranslationError {};
+    f32 checkSum {}; //Keeps the optimizer from throwing away sampling work
+    
+    for (i32 animIndex {}; animIndex < bgz::Size(&animData.animMap.animations); ++animIndex)
+    {
+        Animation* anim = &animData.animMap.animations[animIndex];
+        
+        if (NOT anim->name || anim->bakedClip.sampleCount == 0)
+            continue;
+        
+        f32 timeStep = anim->totalTime / (f32)posesToSamplePerAnim;
+        i32 boneCount = anim->bakedClip.boneCount;
+        Array<f32, 20> keyFrameRotations {}, bakedRotations {};
+        Array<v2, 20> keyFrameTranslations {}, bakedTranslations {};
+        
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 poseIndex {}; poseIndex < posesToSamplePerAnim; ++poseIndex)
+        {
+            for (i32 boneIndex {}; boneIndex < boneCount; ++boneIndex)
+                _SampleBoneFromKeyFrames(anim, boneIndex, (f32)poseIndex * timeStep, $(keyFrameRotations[boneIndex]), $(keyFrameTranslations[boneIndex]));
+            
+            checkSum += keyFrameRotations[0];
+        };
+        keyFrameSamplerSecs += globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 poseIndex {}; poseIndex < posesToSamplePerAnim; ++poseIndex)
+        {
+            SampleBakedClip(anim->bakedClip, (f32)poseIndex * timeStep, bakedRotations.elements, bakedTranslations.elements);
+            
+            checkSum += bakedRotations[0];
+        };
+        bakedSamplerSecs += globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        posesSampled += posesToSamplePerAnim;
+        
+        { //Compare both samplers at a handful of times across the clip
+            for (i32 poseIndex {}; poseIndex < posesToSamplePerAnim; poseIndex += (posesToSamplePerAnim / 64) + 1)
+            {
+                f32 time = (f32)poseIndex * timeStep;
+                SampleBakedClip(anim->bakedClip, time, bakedRotations.elements, bakedTranslations.elements);
+                
+                for (i32 boneIndex {}; boneIndex < boneCount; ++boneIndex)
+                {
+                    _SampleBoneFromKeyFrames(anim, boneIndex, time, $(keyFrameRotations[boneIndex]), $(keyFrameTranslations[boneIndex]));
+                    
+                    f32 rotationError = Mod(AbsoluteValFloat(bakedRotations[boneIndex] - keyFrameRotations[boneIndex]), 2.0f * PI);
+                    rotationError = Min(rotationError, (2.0f * PI) - rotationError);
+                    f32 translationError = Magnitude(bakedTranslations[boneIndex] - keyFrameTranslations[boneIndex]);
+                    maxRotationError = Max(maxRotationError, rotationError);
+                    maxTranslationError = Max(maxTranslationError, translationError);
+                };
+            };
+        };
+    };
+    
+    if (posesSampled)
+    {
+        f64 keyFramePosesPerSec = (f64)posesSampled / keyFrameSamplerSecs;
+        f64 bakedPosesPerSec = (f64)posesSampled / bakedSamplerSecs;
+        BGZ_CONSOLE("Anim sampler bench (%s): keyframe %.0f poses/sec, baked %.0f poses/sec (%.2fx), max error rot %f trans %f (checksum %f)\n",
+                    dataName, keyFramePosesPerSec, bakedPosesPerSec, bakedPosesPerSec / keyFramePosesPerSec, maxRotationError, maxTranslationError, checkSum);
+    };
+};
+
+//Compares sampling N instances of one clip one at a time against SampleBakedClip_Batch at a few instance counts
+void BenchmarkBatchPoseSampling(Animation* clip, bgz::Memory_Partition&& memPart)
+{
+    BGZ_ASSERT(clip->bakedClip.sampleCount > 1);//, "Batch sampling needs a baked clip!");
+    
+    Array<i32, 4> instanceCounts = { 1, 8, 64, 512 };
+    i32 posesToSample = 1 << 20;
+    
+    for (i32 countIndex {}; countIndex < instanceCounts.Size(); ++countIndex)
+    {
+        bgz::ScopedMemory scopeMemory(&memPart);
+        
+        i32 instanceCount = instanceCounts[countIndex];
+        i32 iterations = posesToSample / instanceCount;
+        AnimationPlayback* playbacks = PushType(&memPart, AnimationPlayback, instanceCount);
+        AnimationPose* singlePoses = PushType(&memPart, AnimationPose, instanceCount);
+        AnimationPose* batchPoses = PushType(&memPart, AnimationPose, instanceCount);
+        
+        for (i32 i {}; i < instanceCount; ++i)
+        {
+            playbacks[i] = AnimationPlayback {};
+            playbacks[i].anim = clip;
+            playbacks[i].currentTime = clip->totalTime * ((f32)((i * 7919) % 1000) / 1000.0f); //Spread instances across the clip
+        };
+        
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 iteration {}; iteration < iterations; ++iteration)
+        {
+            for (i32 i {}; i < instanceCount; ++i)
+                SampleBakedClip(clip->bakedClip, playbacks[i].currentTime, singlePoses[i].boneRotations.elements, singlePoses[i].boneTranslations.elements);
+        };
+        f64 singleSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 iteration {}; iteration < iterations; ++iteration)
+            SampleBakedClip_Batch(clip->bakedClip, playbacks, instanceCount, batchPoses);
+        f64 batchSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        //The compiler is free to fuse the scalar path's multiply-adds differently from the simd one, so only expect them within rounding
+        f32 maxError {};
+        for (i32 i {}; i < instanceCount; ++i)
+        {
+            for (i32 boneIndex {}; boneIndex < clip->bakedClip.boneCount; ++boneIndex)
+            {
+                maxError = Max(maxError, AbsoluteValFloat(singlePoses[i].boneRotations.elements[boneIndex] - batchPoses[i].boneRotations.elements[boneIndex]));
+                maxError = Max(maxError, AbsoluteValFloat(singlePoses[i].boneTranslations.elements[boneIndex].x - batchPoses[i].boneTranslations.elements[boneIndex].x));
+                maxError = Max(maxError, AbsoluteValFloat(singlePoses[i].boneTranslations.elements[boneIndex].y - batchPoses[i].boneTranslations.elements[boneIndex].y));
+            };
+        };
+        
+        f64 posesSampled = (f64)iterations * (f64)instanceCount;
+        BGZ_CONSOLE("Batch pose sampling (%s, %d instances): single %.0f poses/sec, batch %.0f poses/sec (%.2fx), poses match: %s (max difference %g)\n",
+                    clip->name, instanceCount, posesSampled / singleSecs, posesSampled / batchSecs, singleSecs / batchSecs, maxError <= 1e-4f ? "yes" : "NO",
+                    (f64)maxError);
+    };
+};
+
+//Checks that anagram names (which the old char sum keys mapped to the same key) get distinct AnimIDs, then compares
+//AnimID lookups against hashing the name + a linear key scan the way lookups used to happen every input frame
+void BenchmarkAnimationLookup(AnimationData animData, bgz::Memory_Partition&& memPart, i32 lookupsPerAnim)
+{
+    { //Anagram collisions
+        const char* anagramNames[] = { "jab-left", "left-jab", "kick-low", "low-kick", "cross-right", "right-cross" };
+        i32 anagramCount = (i32)(sizeof(anagramNames) / sizeof(anagramNames[0]));
+        
+        bgz::ScopedMemory scopeMemory(&memPart);
+        
+        AnimationMap anagramMap {};
+        InitAnimMap($(anagramMap), $(memPart), anagramCount);
+        for (i32 i {}; i < anagramCount; ++i)
+        {
+            Animation anim {};
+            anim.name = anagramNames[i];
+            InsertAnimation($(anagramMap), anagramNames[i], anim);
+        };
+        
+        b allFound { true };
+        for (i32 i {}; i < anagramCount; ++i)
+        {
+            Animation* anim = GetAnimation(anagramMap, AnimIDFromName(anagramNames[i]));
+            if (NOT anim || NOT StringCmp(anim->name, anagramNames[i]))
+                allFound = false;
+        };
+        
+        BGZ_ASSERT(allFound);//, "Anagram animation names resolved to the wrong animation!");
+        BGZ_CONSOLE("Anim lookup anagram test (%d names): %s\n", anagramCount, allFound ? "passed" : "FAILED");
+        
+        kv_destroy(anagramMap.animations.elems);
+    };
+    
+    { //Lookup throughput
+        bgz::ScopedMemory scopeMemory(&memPart);
+        
+        i32 animCount = (i32)bgz::Size(&animData.animMap.animations);
+        AnimID* animIDs = PushType(&memPart, AnimID, animCount);
+        i32* charSumKeys = PushType(&memPart, i32, animCount);
+        for (i32 i {}; i < animCount; ++i)
+        {
+            Animation* anim = &animData.animMap.animations[i];
+            animIDs[i] = anim->id;
+            
+            charSumKeys[i] = 0;
+            for (i32 charIndex {}; anim->name[charIndex] != 0; ++charIndex)
+                charSumKeys[i] += anim->name[charIndex];
+        };
+        
+        i64 checkSum {};
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 lookup {}; lookup < lookupsPerAnim; ++lookup)
+        {
+            for (i32 animIndex {}; animIndex < animCount; ++animIndex)
+            {
+                const char* animName = animData.animMap.animations[animIndex].name;
+                i32 key {};
+                for (i32 charIndex {}; animName[charIndex] != 0; ++charIndex)
+                    key += animName[charIndex];
+                
+                for (i32 keyIndex {}; keyIndex < animCount; ++keyIndex)
+                {
+                    if (key == charSumKeys[keyIndex])
+                    {
+                        checkSum += keyIndex;
+                        break;
+                    }
+                };
+            };
+        };
+        f64 charSumSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 lookup {}; lookup < lookupsPerAnim; ++lookup)
+        {
+            for (i32 animIndex {}; animIndex < animCount; ++animIndex)
+                checkSum += (i64)(GetAnimation(animData.animMap, animIDs[animIndex]) - &animData.animMap.animations[0]);
+        };
+        f64 animIDSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        f64 lookups = (f64)lookupsPerAnim * (f64)animCount;
+        BGZ_CONSOLE("Anim lookup bench (%d anims): char sum + scan %.0f lookups/sec, AnimID %.0f lookups/sec (%.2fx) (checksum %lld)\n",
+                    animCount, lookups / charSumSecs, lookups / animIDSecs, charSumSecs / animIDSecs, checkSum);
+    };
+};
+#endif
+
 #endif
\ No newline at end of file
@@ -71,7 +71,7 @@ void UpdateCollisionBoxWorldPos_BasedOnCenterPoint(Collision_Box&& collisionBox,
     collisionBox.bounds.maxCorner.y = collisionBox.pos_worldSpace.y + (collisionBox.size.y / 2.0f);
 };
 
-local_func b CheckForFighterCollisions_AxisAligned(Collision_Box& fighter1Box, Collision_Box fighter2Box)
+b CheckForFighterCollisions_AxisAligned(Collision_Box& fighter1Box, Collision_Box fighter2Box)
 {
     // Exit returning NO intersection between bounding boxes
     if (fighter1Box.bounds.maxCorner.x < fighter2Box.bounds.minCorner.x || fighter1Box.bounds.minCorner.x > fighter2Box.bounds.maxCorner.x)
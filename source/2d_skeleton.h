@@ -13,28 +13,40 @@ struct Region_Attachment
     AtlasRegion region_image;
 };
 
-struct Bone
+//Cold, load time data. Only read while loading, resetting to the setup pose and by animation code
+struct Skeleton_Setup
 {
-    Bone() = default;
-    
-    Transform parentBoneSpace;
-    Transform worldSpace;
-    f32 initialRotation_parentBoneSpace {};
-    v2 initialPos_parentBoneSpace {};
-    v2 initialTranslationForMixing {};
-    f32 initialRotationForMixing {};
-    f32 length {};
-    Bone* parentBone { nullptr };
-    bgz::Dynam_Array<v2> originalCollisionBoxVerts;
-    bgz::Dynam_Array<Bone*> childBones;
-    b isRoot { false };
-    const char* name { nullptr };
+    i32 boneCount {};
+    const char** boneNames { nullptr };
+    i16* parentBoneIndices { nullptr }; //-1 for the root. Bones are stored parent before child so a parent index is always less than the bone's own index
+    f32* boneLengths { nullptr };
+    f32* initialRotations_parentBoneSpace { nullptr };
+    v2* initialPositions_parentBoneSpace { nullptr };
+    bgz::Dynam_Array<v2>* originalCollisionBoxVerts { nullptr }; //Null for cooked rigs, only needed to size hit boxes while parsing the json
+    
+    //Set by the first fighter using this setup (see InitFighter). Fighters sharing setup data have to match these
+    f32 adjustedToFighterHeight {};
+    b adjustedToFlipX { false };
+};
+
+//Hot, per frame bone data as a struct of arrays. All arrays are carved out of one block (poseBlock) so a skeleton's pose
+//can be copied with a single memcpy
+struct Skeleton_Pose
+{
+    f32* rotations_parentBoneSpace { nullptr };
+    v2* translations_parentBoneSpace { nullptr };
+    v2* scales_parentBoneSpace { nullptr };
+    mat2x3* worldSpaceMatrices { nullptr }; //Parent chain's transforms composed with the bone's parent bone space transform
+    f32* summedRotations { nullptr }; //Bone's rotation plus all of its parents' rotations
+    f32* worldSpaceRotations { nullptr };
+    v2* worldSpaceTranslations { nullptr };
+    v2* worldSpaceScales { nullptr };
 };
 
 struct Slot
 {
     char* name { nullptr };
-    Bone* bone { nullptr };
+    i32 boneIndex { -1 };
     Region_Attachment regionAttachment {};
 };
 
@@ -42,308 +54,558 @@ struct Skeleton
 {
     Skeleton() = default;
     
-    bgz::Dynam_Array<Bone> bones;
+    Skeleton_Setup* setup { nullptr };
+    i32 boneCount {};
+    Skeleton_Pose pose {};
+    void* poseBlock { nullptr };
+    sizet poseBlockSize {};
     bgz::Dynam_Array<Slot> slots;
     f32 width {}, height {};
 };
 
 void InitSkel(Skeleton&& skel, bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath);
-Bone InitBone(bgz::Memory_Partition&& memPart);
-Bone* GetBoneFromSkeleton(Skeleton* skeleton, char* boneName);
+i32 GetBoneIndex(const Skeleton_Setup* setup, const char* boneName);
 void ResetBonesToSetupPose(Skeleton&& skeleton);
-Skeleton CopySkeleton(Skeleton src);
+Skeleton CopySkeleton(Skeleton src, bgz::Memory_Partition&& memPart);
+void UpdateSkeletonBoneWorldTransforms(Skeleton&& fighterSkel, v2 fighterWorldPos);
+#if DEVELOPMENT_BUILD
+void BenchmarkSkeletonWorldTransforms(Skeleton* shippedSkel, const char* shippedSkelName, bgz::Memory_Partition&& memPart, i32 updatesPerSkeleton);
+#endif
 
 #endif
 
 #ifdef SKELETON_IMPL
 
-Bone InitBone(bgz::Memory_Partition&& memPart)
+local_func sizet _SkeletonPoseBlockSize(i32 boneCount)
 {
-    Bone bone{};
-    Init(&bone.originalCollisionBoxVerts, 10);
-    Init(&bone.childBones, 5);
+    return (sizet)boneCount * ((sizeof(f32) * 3) + (sizeof(v2) * 4) + sizeof(mat2x3));
+};
+
+local_func void _PointPoseArraysAt(Skeleton_Pose&& pose, void* poseBlock, i32 boneCount)
+{
+    ui8* at = (ui8*)poseBlock;
+    pose.worldSpaceMatrices = (mat2x3*)at; at += sizeof(mat2x3) * boneCount;
+    pose.rotations_parentBoneSpace = (f32*)at; at += sizeof(f32) * boneCount;
+    pose.translations_parentBoneSpace = (v2*)at; at += sizeof(v2) * boneCount;
+    pose.scales_parentBoneSpace = (v2*)at; at += sizeof(v2) * boneCount;
+    pose.summedRotations = (f32*)at; at += sizeof(f32) * boneCount;
+    pose.worldSpaceRotations = (f32*)at; at += sizeof(f32) * boneCount;
+    pose.worldSpaceTranslations = (v2*)at; at += sizeof(v2) * boneCount;
+    pose.worldSpaceScales = (v2*)at; at += sizeof(v2) * boneCount;
     
-    return bone;
+    BGZ_ASSERT((sizet)(at - (ui8*)poseBlock) == _SkeletonPoseBlockSize(boneCount));//, "Pose arrays don't match the pose block size!");
 };
 
-void InitSkel(Skeleton&& skel, bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath)
+local_func void _InitSkeletonData(Skeleton&& skel, bgz::Memory_Partition&& memPart, i32 boneCount)
 {
-    i32 length;
+    skel.boneCount = boneCount;
     
-    const char* skeletonJson = (const char*)globalPlatformServices->ReadEntireFile($(length), jsonFilePath);
+    skel.setup = PushType(&memPart, Skeleton_Setup, 1);
+    *skel.setup = Skeleton_Setup {};
+    skel.setup->boneCount = boneCount;
+    skel.setup->boneNames = PushType(&memPart, const char*, boneCount);
+    skel.setup->parentBoneIndices = PushType(&memPart, i16, boneCount);
+    skel.setup->boneLengths = PushType(&memPart, f32, boneCount);
+    skel.setup->initialRotations_parentBoneSpace = PushType(&memPart, f32, boneCount);
+    skel.setup->initialPositions_parentBoneSpace = PushType(&memPart, v2, boneCount);
+    skel.setup->originalCollisionBoxVerts = PushType(&memPart, bgz::Dynam_Array<v2>, boneCount);
     
-    Atlas* atlas = CreateAtlasFromFile(atlasFilePath, 0);
+    skel.poseBlockSize = _SkeletonPoseBlockSize(boneCount);
+    skel.poseBlock = PushType(&memPart, ui8, skel.poseBlockSize);
+    memset(skel.poseBlock, 0, skel.poseBlockSize);
+    _PointPoseArraysAt($(skel.pose), skel.poseBlock, boneCount);
     
-    if (skeletonJson)
+    for (i32 boneIndex {}; boneIndex < boneCount; ++boneIndex)
+    {
+        skel.setup->boneNames[boneIndex] = nullptr;
+        skel.setup->parentBoneIndices[boneIndex] = -1;
+        skel.setup->boneLengths[boneIndex] = 0.0f;
+        skel.setup->initialRotations_parentBoneSpace[boneIndex] = 0.0f;
+        skel.setup->initialPositions_parentBoneSpace[boneIndex] = { 0.0f, 0.0f };
+        skel.setup->originalCollisionBoxVerts[boneIndex] = bgz::Dynam_Array<v2> {};
+        bgz::Init(&skel.setup->originalCollisionBoxVerts[boneIndex], 10);
+        
+        skel.pose.scales_parentBoneSpace[boneIndex] = { 1.0f, 1.0f };
+        skel.pose.worldSpaceScales[boneIndex] = { 1.0f, 1.0f };
+    };
+};
+
+//Bones are gathered here while streaming since the bone count isn't known until the end of the "bones" array
+struct _Json_Bone
+{
+    const char* name { nullptr };
+    const char* parentName { nullptr };
+    f32 length {}, rotation {}, x {}, y {};
+    f32 scaleX { 1.0f }, scaleY { 1.0f };
+};
+
+local_func void _ReadBones(Skeleton&& skel, bgz::Memory_Partition&& memPart, Json_Reader* reader)
+{
+    bgz::Dynam_Array<_Json_Bone> bones;
+    bgz::Init(&bones, 32);
+    
+    Json_beginArray(reader);
+    while (Json_nextElement(reader))
+    {
+        _Json_Bone bone {};
+        
+        const char* key;
+        Json_beginObject(reader);
+        while (Json_nextKey(reader, &key))
+        {
+            if (StringCmp(key, "name"))
+                bone.name = Json_readString(reader, nullptr);
+            else if (StringCmp(key, "parent"))
+                bone.parentName = Json_readString(reader, nullptr);
+            else if (StringCmp(key, "length"))
+                bone.length = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "rotation"))
+                bone.rotation = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "x"))
+                bone.x = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "y"))
+                bone.y = Json_readFloat(reader, 0.0f);
+            else if (StringCmp(key, "scaleX"))
+                bone.scaleX = Json_readFloat(reader, 1.0f);
+            else if (StringCmp(key, "scaleY"))
+                bone.scaleY = Json_readFloat(reader, 1.0f);
+            else
+                Json_skipValue(reader);
+        };
+        
+        bgz::Push(bones, bone);
+    };
+    
+    i32 boneCount = (i32)bgz::Size(&bones);
+    BGZ_ASSERT(boneCount <= INT16_MAX);//, "Too many bones for i16 parent indices!");
+    _InitSkeletonData($(skel), $(memPart), boneCount);
+    Skeleton_Setup* setup = skel.setup;
+    
+    for (i32 boneIndex {}; boneIndex < boneCount; ++boneIndex)
     {
-        Json* root {};
-        root = Json_create(skeletonJson);
+        _Json_Bone* bone = &bones[boneIndex];
+        BGZ_ASSERT(bone->name);//, "Bone is missing its name!");
+        
+        setup->boneNames[boneIndex] = PushString(&memPart, bone->name);
+        
+        skel.pose.scales_parentBoneSpace[boneIndex] = { bone->scaleX, bone->scaleY };
+        
+        setup->initialRotations_parentBoneSpace[boneIndex] = bone->rotation;
+        skel.pose.rotations_parentBoneSpace[boneIndex] = bone->rotation;
         
-        Json* jsonSkeleton = Json_getItem(root, "skeleton"); /* clang-format off */BGZ_ASSERT(jsonSkeleton);//, "Unable to return valid json object for skeleton!"); /* clang-format on */
-        Json* jsonBones = Json_getItem(root, "bones"); /* clang-format off */BGZ_ASSERT(jsonBones);//, "Unable to return valid json object for bones!"); /* clang-format on */
-        Json* jsonSlots = Json_getItem(root, "slots"); /* clang-format off */BGZ_ASSERT(jsonSlots);//, "Unable to return valid json object for slots!"); /* clang-format on */
-        Json* skins_json = Json_getItem(root, "skins");
+        setup->initialPositions_parentBoneSpace[boneIndex] = { bone->x, bone->y };
+        skel.pose.translations_parentBoneSpace[boneIndex] = setup->initialPositions_parentBoneSpace[boneIndex];
         
-        skel.width = Json_getFloat(jsonSkeleton, "width", 0.0f);
-        skel.height = Json_getFloat(jsonSkeleton, "height", 0.0f);
+        setup->boneLengths[boneIndex] = bone->length;
+        
+        if (bone->parentName) //If no parent then skip
+        {
+            i32 parentBoneIndex = GetBoneIndex(setup, bone->parentName);
+            BGZ_ASSERT(parentBoneIndex < boneIndex);//, "Bones need to be listed parent before child!");
+            setup->parentBoneIndices[boneIndex] = (i16)parentBoneIndex;
+        };
+    };
+    
+    kv_destroy(bones.elems);
+};
+
+local_func void _ReadSlots(Skeleton&& skel, bgz::Memory_Partition&& memPart, Json_Reader* reader, bgz::Dynam_Array<const char*>&& slotAttachmentNames)
+{
+    BGZ_ASSERT(skel.setup);//, "Bones need to be listed before slots!");
+    
+    bgz::Init(&skel.slots, skel.boneCount);
+    
+    Json_beginArray(reader);
+    while (Json_nextElement(reader))
+    {
+        const char* slotName { nullptr };
+        const char* boneName { nullptr };
+        const char* attachmentName { nullptr };
+        
+        const char* key;
+        Json_beginObject(reader);
+        while (Json_nextKey(reader, &key))
+        {
+            if (StringCmp(key, "name"))
+                slotName = Json_readString(reader, nullptr);
+            else if (StringCmp(key, "bone"))
+                boneName = Json_readString(reader, nullptr);
+            else if (StringCmp(key, "attachment"))
+                attachmentName = Json_readString(reader, nullptr);
+            else
+                Json_skipValue(reader);
+        };
+        
+        //Ignore creating slots here for collision boxes. Don't think I need it
+        BGZ_ASSERT(slotName && boneName);//, "Slot is missing its name or bone!");
+        if (strncmp(slotName, "box", 3) != 0)
+        {
+            Slot slot {};
+            slot.name = PushString(&memPart, slotName);
+            slot.boneIndex = GetBoneIndex(skel.setup, boneName);
+            bgz::Push(skel.slots, slot);
+            
+            //Region attachments are filled in once the skin listing them is read
+            bgz::Push(slotAttachmentNames, attachmentName);
+        };
+    };
+};
+
+local_func void _ReadSkinAttachment(Skeleton&& skel, Json_Reader* reader, Atlas* atlas, const char* skinSlotName, const char* attachmentName, bgz::Dynam_Array<const char*> slotAttachmentNames)
+{
+    //Collision boxes are named "box-<bone name>" (case doesn't have to match). The root bone doesn't get one
+    i32 collisionBoxBoneIndex { -1 };
+    if (strncmp(skinSlotName, "box-", 4) == 0)
+    {
+        for (i32 boneIndex {}; boneIndex < skel.boneCount; ++boneIndex)
+        {
+            if (NOT StringCmp(skel.setup->boneNames[boneIndex], "root") && Json_strcasecmp(skel.setup->boneNames[boneIndex], skinSlotName + 4) == 0)
+            {
+                collisionBoxBoneIndex = boneIndex;
+                break;
+            };
+        };
+    };
+    
+    Region_Attachment regionAttachment {};
+    regionAttachment.scale = { 1.0f, 1.0f };
+    regionAttachment.parentBoneSpace.scale = { 1.0f, 1.0f };
+    
+    const char* key;
+    Json_beginObject(reader);
+    while (Json_nextKey(reader, &key))
+    {
+        if (StringCmp(key, "vertices") && collisionBoxBoneIndex != -1)
+        {
+            bgz::Dynam_Array<v2>* collisionBoxVerts = &skel.setup->originalCollisionBoxVerts[collisionBoxBoneIndex];
+            
+            Json_beginArray(reader);
+            while (Json_nextElement(reader))
+            {
+                v2 vert {};
+                vert.x = Json_readFloat(reader, 0.0f);
+                Json_nextElement(reader);
+                vert.y = Json_readFloat(reader, 0.0f);
+                bgz::Push(*collisionBoxVerts, vert);
+            };
+        }
+        else if (StringCmp(key, "width"))
+            regionAttachment.width = (f32)Json_readInt(reader, 0);
+        else if (StringCmp(key, "height"))
+            regionAttachment.height = (f32)Json_readInt(reader, 0);
+        else if (StringCmp(key, "scaleX"))
+            regionAttachment.scale.x = regionAttachment.parentBoneSpace.scale.x = Json_readFloat(reader, 1.0f);
+        else if (StringCmp(key, "scaleY"))
+            regionAttachment.scale.y = regionAttachment.parentBoneSpace.scale.y = Json_readFloat(reader, 1.0f);
+        else if (StringCmp(key, "x"))
+            regionAttachment.parentBoneSpace.translation.x = Json_readFloat(reader, 0.0f);
+        else if (StringCmp(key, "y"))
+            regionAttachment.parentBoneSpace.translation.y = Json_readFloat(reader, 0.0f);
+        else if (StringCmp(key, "rotation"))
+            regionAttachment.parentBoneSpace.rotation = Json_readFloat(reader, 0.0f);
+        else
+            Json_skipValue(reader);
+    };
+    
+    if (collisionBoxBoneIndex != -1)
+        return;
+    
+    b regionFound { false };
+    for (i32 slotIndex {}; slotIndex < bgz::Size(&skel.slots); ++slotIndex)
+    {
+        if (slotAttachmentNames[slotIndex] && StringCmp(slotAttachmentNames[slotIndex], attachmentName))
+        {
+            if (NOT regionFound)
+            {
+                AtlasRegion* region = Atlas_findRegion(atlas, attachmentName);
+                if (region)
+                    regionAttachment.region_image = *region;
+                regionFound = true;
+            };
+            
+            skel.slots[slotIndex].regionAttachment = regionAttachment;
+            slotAttachmentNames[slotIndex] = nullptr; //First skin entry with the slot's attachment wins
+        };
+    };
+};
+
+local_func void _ReadSkins(Skeleton&& skel, Json_Reader* reader, Atlas* atlas, bgz::Dynam_Array<const char*> slotAttachmentNames, b slotsRead)
+{
+    BGZ_ASSERT(skel.setup);//, "Bones need to be listed before skins!");
+    BGZ_ASSERT(slotsRead);//, "Slots need to be listed before skins, skin attachments are matched to the slots using them!");
+    
+    //Only the first (default) skin is used
+    b isFirstSkin { true };
+    Json_beginArray(reader);
+    while (Json_nextElement(reader))
+    {
+        if (NOT isFirstSkin)
+        {
+            Json_skipValue(reader);
+            continue;
+        };
+        isFirstSkin = false;
         
-        { //Read in Bone data
-            i32 boneIndex {};
-            bgz::Init(&skel.bones, jsonBones->size);
-            for (Json* currentBone_json = jsonBones->child; boneIndex < jsonBones->size; currentBone_json = currentBone_json->next, ++boneIndex)
+        const char* key;
+        Json_beginObject(reader);
+        while (Json_nextKey(reader, &key))
+        {
+            if (NOT StringCmp(key, "attachments"))
             {
-                bgz::Push(skel.bones, InitBone($(memPart)));
-                Bone* bone = &skel.bones[boneIndex];
-                
-                bone->name = Json_getString(currentBone_json, "name", 0);
-                if (StringCmp(bone->name, "root"))
-                    bone->isRoot = true;
-                bone->parentBoneSpace.scale.x = Json_getFloat(currentBone_json, "scaleX", 1.0f);
-                bone->parentBoneSpace.scale.y = Json_getFloat(currentBone_json, "scaleY", 1.0f);
-                bone->worldSpace.scale = { 1.0f, 1.0f };
-                
-                bone->parentBoneSpace.rotation = Json_getFloat(currentBone_json, "rotation", 0.0f);
-                bone->initialRotation_parentBoneSpace = bone->parentBoneSpace.rotation;
-                
-                bone->parentBoneSpace.translation.x = Json_getFloat(currentBone_json, "x", 0.0f);
-                bone->parentBoneSpace.translation.y = Json_getFloat(currentBone_json, "y", 0.0f);
-                bone->initialPos_parentBoneSpace = bone->parentBoneSpace.translation;
-                
-                bone->length = Json_getFloat(currentBone_json, "length", 0.0f);
-                
-                { //Read in collision box data
-                    Json* defaultSkinAttachments_json = Json_getItem(skins_json->child, "attachments");
-                    
-                    char nameOfCollisionBoxAttachment[100] = { "box-" };
-                    strcat(nameOfCollisionBoxAttachment, bone->name);
-                    if (NOT StringCmp(bone->name, "root"))
-                    {
-                        Json* collisionBox_json = Json_getItem(defaultSkinAttachments_json, nameOfCollisionBoxAttachment)->child;
-                        Json* verts_json = Json_getItem(collisionBox_json, "vertices")->child;
-                        
-                        i32 numVerts = Json_getInt(collisionBox_json, "vertexCount", 0);
-                        for (i32 i {}; i < numVerts; ++i)
-                        {
-                            bgz::Push(bone->originalCollisionBoxVerts, v2 { verts_json->valueFloat, verts_json->next->valueFloat });
-                            verts_json = verts_json->next->next;
-                        };
-                    }
-                }
-                
-                if (Json_getString(currentBone_json, "parent", 0)) //If no parent then skip
+                Json_skipValue(reader);
+                continue;
+            };
+            
+            const char* skinSlotName;
+            Json_beginObject(reader);
+            while (Json_nextKey(reader, &skinSlotName))
+            {
+                //Only a skin slot's first attachment is used
+                const char* attachmentName;
+                Json_beginObject(reader);
+                if (Json_nextKey(reader, &attachmentName))
                 {
-                    bone->parentBone = GetBoneFromSkeleton(&skel, (char*)Json_getString(currentBone_json, "parent", 0));
-                    bgz::Push(bone->parentBone->childBones, bone);
+                    _ReadSkinAttachment($(skel), reader, atlas, skinSlotName, attachmentName, slotAttachmentNames);
+                    while (Json_nextKey(reader, &attachmentName))
+                        Json_skipValue(reader);
                 };
             };
         };
+    };
+};
+
+//Streams through the mapped json once, building bones, slots and collision boxes as they're read. No json tree is built
+//and nothing points into the text afterwards, so it's unmapped before returning. Bones and slot attachment names are
+//gathered on the heap while reading since their counts aren't known until the end of their arrays
+void InitSkel(Skeleton&& skel, bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath)
+{
+    i32 length;
+    
+    //Copy on write, strings get terminated in place
+    char* skeletonJson = (char*)globalPlatformServices->MapEntireFile($(length), jsonFilePath);
+    
+    Atlas* atlas = CreateAtlasFromFile(atlasFilePath, 0);
+    
+    if (skeletonJson)
+    {
+        bgz::Dynam_Array<const char*> slotAttachmentNames;
+        bgz::Init(&slotAttachmentNames, 32);
+        b slotsRead { false };
+        
+        Json_Reader reader = Json_reader(skeletonJson);
         
-        { //Read in Slot data
-            i32 slotIndex {};
-            bgz::Init(&skel.slots, jsonBones->size);
-            for (Json* currentSlot_json = jsonSlots->child; slotIndex < jsonSlots->size; currentSlot_json = currentSlot_json->next, ++slotIndex)
+        const char* key;
+        Json_beginObject(&reader);
+        while (Json_nextKey(&reader, &key))
+        {
+            if (StringCmp(key, "skeleton"))
             {
-                //Ignore creating slots here for collision boxes. Don't think I need it
-                char* slotName = (char*)Json_getString(currentSlot_json, "name", 0);
-                char slotName_firstThreeLetters[4] = { slotName[0], slotName[1], slotName[2], NULL };
-                if (NOT StringCmp(slotName_firstThreeLetters, "box"))
+                const char* skeletonKey;
+                Json_beginObject(&reader);
+                while (Json_nextKey(&reader, &skeletonKey))
                 {
-                    //Insert slot info in reverse order to get correct draw order (since json file has the draw order flipped from spine application)
-                    bgz::Push(skel.slots);
-                    Slot* slot = &skel.slots[slotIndex];
-                    
-                    slot->name = (char*)Json_getString(currentSlot_json, "name", 0);
-                    if (StringCmp(slot->name, "left-hand"))
-                        int x {};
-                    slot->bone = GetBoneFromSkeleton(&skel, (char*)Json_getString(currentSlot_json, "bone", 0));
-                    slot->regionAttachment = [currentSlot_json, skins_json, atlas]() -> Region_Attachment {
-                        Region_Attachment resultRegionAttch {};
-                        
-                        const char* attachmentName = Json_getString(currentSlot_json, "attachment", 0);
-                        Json* jsonDefaultSkin = Json_getItem(skins_json->child, "attachments");
-                        
-                        i32 attachmentCounter {};
-                        for (Json* currentBodyPartOfSkin_json = jsonDefaultSkin->child; attachmentCounter < jsonDefaultSkin->size; currentBodyPartOfSkin_json = currentBodyPartOfSkin_json->next, ++attachmentCounter)
-                        {
-                            Json* jsonAttachment = currentBodyPartOfSkin_json->child;
-                            
-                            if (StringCmp(jsonAttachment->name, attachmentName))
-                            {
-                                resultRegionAttch.width = (f32)Json_getInt(jsonAttachment, "width", 0);
-                                resultRegionAttch.height = (f32)Json_getInt(jsonAttachment, "height", 0);
-                                resultRegionAttch.scale.x = (f32)Json_getFloat(jsonAttachment, "scaleX", 1.0f);
-                                resultRegionAttch.scale.y = (f32)Json_getFloat(jsonAttachment, "scaleY", 1.0f);
-                                resultRegionAttch.parentBoneSpace.translation.x = Json_getFloat(jsonAttachment, "x", 0.0f);
-                                resultRegionAttch.parentBoneSpace.translation.y = Json_getFloat(jsonAttachment, "y", 0.0f);
-                                resultRegionAttch.parentBoneSpace.rotation = Json_getFloat(jsonAttachment, "rotation", 0.0f);
-                                resultRegionAttch.parentBoneSpace.scale.x = Json_getFloat(jsonAttachment, "scaleX", 1.0f);
-                                resultRegionAttch.parentBoneSpace.scale.y = Json_getFloat(jsonAttachment, "scaleY", 1.0f);
-                                resultRegionAttch.region_image = [atlas, attachmentName]() -> AtlasRegion {
-                                    AtlasRegion resultAtlasRegion {};
-                                    AtlasRegion* region = atlas->regions;
-                                    
-                                    while (region)
-                                    {
-                                        if (StringCmp(region->name, attachmentName))
-                                        {
-                                            resultAtlasRegion = *region;
-                                            break;
-                                        };
-                                        
-                                        region = region->next;
-                                    };
-                                    
-                                    return resultAtlasRegion;
-                                }();
-                                
-                                break;
-                            };
-                        };
-                        
-                        return resultRegionAttch;
-                    }();
+                    if (StringCmp(skeletonKey, "width"))
+                        skel.width = Json_readFloat(&reader, 0.0f);
+                    else if (StringCmp(skeletonKey, "height"))
+                        skel.height = Json_readFloat(&reader, 0.0f);
+                    else
+                        Json_skipValue(&reader);
                 };
+            }
+            else if (StringCmp(key, "bones"))
+            {
+                _ReadBones($(skel), $(memPart), &reader);
+            }
+            else if (StringCmp(key, "slots"))
+            {
+                _ReadSlots($(skel), $(memPart), &reader, $(slotAttachmentNames));
+                slotsRead = true;
+            }
+            else if (StringCmp(key, "skins"))
+            {
+                _ReadSkins($(skel), &reader, atlas, slotAttachmentNames, slotsRead);
+            }
+            else
+            {
+                Json_skipValue(&reader);
             };
         };
+        
+        BGZ_ASSERT(NOT Json_readerFailed(&reader));//, "Malformed skeleton json!");
+        BGZ_ASSERT(skel.setup);//, "Skeleton json has no bones!");
+        
+        kv_destroy(slotAttachmentNames.elems);
     }
     else
     {
         InvalidCodePath;
     };
     
-    globalPlatformServices->Free((void*)skeletonJson);
+    globalPlatformServices->UnmapFile((void*)skeletonJson);
 };
 
-//TODO: Not sure if this is working properly yet
-Skeleton CopySkeleton(Skeleton src)
+//Setup data is shared with src (so anything that adjusts setup data, like InitFighter's height adjustment, affects both).
+//Pose data is flat, so it's a single memcpy
+Skeleton CopySkeleton(Skeleton src, bgz::Memory_Partition&& memPart)
 {
     Skeleton dest = src;
-#if 0
     
-    CopyArray(src.bones, $(dest.bones));
-    CopyArray(src.slots, $(dest.slots));
+    dest.poseBlock = PushType(&memPart, ui8, src.poseBlockSize);
+    memcpy(dest.poseBlock, src.poseBlock, src.poseBlockSize);
+    _PointPoseArraysAt($(dest.pose), dest.poseBlock, dest.boneCount);
+    
+    bgz::Init(&dest.slots, (i32)bgz::Size(&src.slots) + 1);
+    for (i32 slotIndex {}; slotIndex < bgz::Size(&src.slots); ++slotIndex)
+        bgz::Push(dest.slots, src.slots[slotIndex]);
     
-    for (i32 boneIndex {}; boneIndex < src.bones.length; ++boneIndex)
-    {
-        for (i32 childBoneIndex {}; childBoneIndex < bgz::Size(&src.bones[boneIndex].childBones); ++childBoneIndex)
-        {
-            const char* childBoneName = src.bones[boneIndex].childBones.At(childBoneIndex)->name;
-            Bone* bone = GetBoneFromSkeleton(&dest, (char*)childBoneName);
-            dest.bones[boneIndex].childBones.At(childBoneIndex) = bone;
-        }
-    };
-#endif
     return dest;
 };
 
 void ResetBonesToSetupPose(Skeleton&& skel)
 {
-    for (i32 boneIndex {}; boneIndex < bgz::Size(&skel.bones); ++boneIndex)
-    {
-        skel.bones[boneIndex].parentBoneSpace.rotation = skel.bones[boneIndex].initialRotation_parentBoneSpace;
-        skel.bones[boneIndex].parentBoneSpace.translation = skel.bones[boneIndex].initialPos_parentBoneSpace;
-    };
+    memcpy(skel.pose.rotations_parentBoneSpace, skel.setup->initialRotations_parentBoneSpace, sizeof(f32) * skel.boneCount);
+    memcpy(skel.pose.translations_parentBoneSpace, skel.setup->initialPositions_parentBoneSpace, sizeof(v2) * skel.boneCount);
 };
 
-Bone* GetBoneFromSkeleton(Skeleton* skeleton, char* boneName)
+i32 GetBoneIndex(const Skeleton_Setup* setup, const char* boneName)
 {
-    Bone* bone {};
+    i32 result { -1 };
     
-    for (i32 i = 0; i < bgz::Size(&skeleton->bones); ++i)
+    for (i32 i = 0; i < setup->boneCount; ++i)
     {
-        if (StringCmp(skeleton->bones[i].name, boneName))
+        if (setup->boneNames[i] && StringCmp(setup->boneNames[i], boneName))
         {
-            bone = &skeleton->bones[i];
+            result = i;
             break;
         };
     };
     
-    BGZ_ASSERT(bone->name != nullptr);//, "Bone was not found!");
+    BGZ_ASSERT(result != -1);//, "Bone was not found!");
     
-    return bone;
+    return result;
 };
 
-v2 ParentTransform_1Vector(v2 localCoords, Transform parentTransform)
+inline mat2x3 AffineMatrix(v2 translation, f32 rotation, v2 scale)
 {
-    ConvertToCorrectPositiveRadian($(parentTransform.rotation));
-    
-    Coordinate_Space parentSpace {};
-    parentSpace.origin = parentTransform.translation;
-    parentSpace.xBasis = v2 { CosR(parentTransform.rotation), SinR(parentTransform.rotation) };
-    parentSpace.yBasis = parentTransform.scale.y * PerpendicularOp(parentSpace.xBasis);
-    parentSpace.xBasis *= parentTransform.scale.x;
+    v2 xBasis = v2 { CosR(rotation), SinR(rotation) };
+    v2 yBasis = scale.y * PerpendicularOp(xBasis);
+    xBasis *= scale.x;
     
-    v2 transformedCoords {};
+    mat2x3 result {};
+    result.elem[0][0] = xBasis.x; result.elem[0][1] = yBasis.x; result.elem[0][2] = translation.x;
+    result.elem[1][0] = xBasis.y; result.elem[1][1] = yBasis.y; result.elem[1][2] = translation.y;
     
-    //This equation rotates first then moves to correct world position
-    transformedCoords = parentSpace.origin + (localCoords.x * parentSpace.xBasis) + (localCoords.y * parentSpace.yBasis);
-    
-    return transformedCoords;
+    return result;
 };
 
-f32 RecursivelyAddBoneRotations(f32 rotation, Bone bone)
+//Returns a matrix that applies b first, then a
+inline mat2x3 ComposeAffine(mat2x3 a, mat2x3 b)
 {
-    rotation += bone.parentBoneSpace.rotation;
+    mat2x3 result {};
+    for (i32 row {}; row < 2; ++row)
+    {
+        result.elem[row][0] = a.elem[row][0] * b.elem[0][0] + a.elem[row][1] * b.elem[1][0];
+        result.elem[row][1] = a.elem[row][0] * b.elem[0][1] + a.elem[row][1] * b.elem[1][1];
+        result.elem[row][2] = a.elem[row][0] * b.elem[0][2] + a.elem[row][1] * b.elem[1][2] + a.elem[row][2];
+    };
     
-    if (bone.isRoot)
-        return rotation;
-    else
-        return RecursivelyAddBoneRotations(rotation, *bone.parentBone);
-};
-
-f32 WorldRotation_Bone(Bone bone)
-{
-    if (bone.isRoot)
-        return 0;
-    else
-        return RecursivelyAddBoneRotations(bone.parentBoneSpace.rotation, *bone.parentBone);
+    return result;
 };
 
-v2 WorldTransform_Bone(v2 vertToTransform, Bone boneToGrabTransformFrom)
+//Single forward pass over the bones. Since parents are always stored before their children, a parent's world matrix is
+//already up to date by the time its children get to it. Only touches the pose arrays + parent indices
+void UpdateSkeletonBoneWorldTransforms(Skeleton&& fighterSkel, v2 fighterWorldPos)
 {
-    v2 parentLocalPos = ParentTransform_1Vector(vertToTransform, boneToGrabTransformFrom.parentBoneSpace);
+    Skeleton_Pose pose = fighterSkel.pose;
+    const i16* parentBoneIndices = fighterSkel.setup->parentBoneIndices;
+    b isFlipped = pose.scales_parentBoneSpace[0].x == -1.0f;
     
-    if (boneToGrabTransformFrom.isRoot) //If root bone has been hit then exit recursion by returning world pos of main bone
-    {
-        return parentLocalPos;
-    }
-    else
+    mat2x3 fighterWorldMatrix {};
+    fighterWorldMatrix.elem[0][0] = 1.0f; fighterWorldMatrix.elem[0][2] = fighterWorldPos.x;
+    fighterWorldMatrix.elem[1][1] = 1.0f; fighterWorldMatrix.elem[1][2] = fighterWorldPos.y;
+    
+    for (i32 boneIndex {}; boneIndex < fighterSkel.boneCount; ++boneIndex)
     {
-        return WorldTransform_Bone(parentLocalPos, *boneToGrabTransformFrom.parentBone);
+        mat2x3 parentBoneSpaceMatrix = AffineMatrix(pose.translations_parentBoneSpace[boneIndex], pose.rotations_parentBoneSpace[boneIndex], pose.scales_parentBoneSpace[boneIndex]);
+        i32 parentBoneIndex = parentBoneIndices[boneIndex];
+        
+        if (parentBoneIndex < 0) //Root
+        {
+            pose.worldSpaceMatrices[boneIndex] = ComposeAffine(fighterWorldMatrix, parentBoneSpaceMatrix);
+            pose.summedRotations[boneIndex] = pose.rotations_parentBoneSpace[boneIndex];
+            pose.worldSpaceRotations[boneIndex] = 0.0f;
+            pose.worldSpaceTranslations[boneIndex] = fighterWorldPos;
+        }
+        else
+        {
+            pose.worldSpaceMatrices[boneIndex] = ComposeAffine(pose.worldSpaceMatrices[parentBoneIndex], parentBoneSpaceMatrix);
+            pose.summedRotations[boneIndex] = pose.summedRotations[parentBoneIndex] + pose.rotations_parentBoneSpace[boneIndex];
+            pose.worldSpaceRotations[boneIndex] = pose.summedRotations[boneIndex];
+            pose.worldSpaceTranslations[boneIndex] = v2 { pose.worldSpaceMatrices[boneIndex].elem[0][2], pose.worldSpaceMatrices[boneIndex].elem[1][2] };
+        };
+        
+        if (isFlipped)
+            pose.worldSpaceRotations[boneIndex] = PI - pose.worldSpaceRotations[boneIndex];
     };
+    
+    pose.translations_parentBoneSpace[0] = fighterWorldPos;
 };
 
-inline void UpdateBoneChainsWorldPositions_StartingFrom(Bone&& mainBone)
+#if DEVELOPMENT_BUILD
+local_func void _BenchmarkSkeletonWorldTransforms(Skeleton&& skel, const char* skelName, i32 updates)
 {
-    if (bgz::Size(&mainBone.childBones) > 0)
+    v2 fighterWorldPos = { 3.0f, 1.0f };
+    i64 (*ReadCacheMissCount)(void) = globalPlatformServices->ReadCacheMissCount;
+    
+    i64 startMissCount = ReadCacheMissCount ? ReadCacheMissCount() : -1;
+    f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+    for (i32 update {}; update < updates; ++update)
     {
-        for (i32 childBoneIndex {}; childBoneIndex < bgz::Size(&mainBone.childBones); ++childBoneIndex)
-        {
-            Bone* childBone = mainBone.childBones[childBoneIndex];
-            childBone->worldSpace.translation = WorldTransform_Bone(childBone->parentBoneSpace.translation, *childBone->parentBone);
-            
-            UpdateBoneChainsWorldPositions_StartingFrom($(*childBone));
-        };
+        ResetBonesToSetupPose($(skel));
+        UpdateSkeletonBoneWorldTransforms($(skel), fighterWorldPos);
     };
-}
+    f64 secs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+    i64 endMissCount = ReadCacheMissCount ? ReadCacheMissCount() : -1;
+    
+    //Everything the reset + update reads/writes: setup rot/pos, parent indices and all pose arrays except world scales
+    sizet hotBytesPerBone = (sizeof(f32) + sizeof(v2)) + sizeof(i16) + (skel.poseBlockSize / skel.boneCount) - sizeof(v2);
+    
+    char cacheMissText[48] = "no cache miss counter";
+    if (startMissCount >= 0 && endMissCount >= 0)
+        snprintf(cacheMissText, sizeof(cacheMissText), "%.3f cache misses/update", (f64)(endMissCount - startMissCount) / (f64)updates);
+    
+    BGZ_CONSOLE("Skeleton world transform bench (%s, %d bones): %.0f updates/sec, %.2f ns/bone, %s, %zu hot bytes/update\n",
+                skelName, skel.boneCount, (f64)updates / secs, (secs * 1000000000.0) / ((f64)updates * (f64)skel.boneCount), cacheMissText,
+                hotBytesPerBone * skel.boneCount);
+};
 
-void UpdateSkeletonBoneWorldTransforms(Skeleton&& fighterSkel, v2 fighterWorldPos)
+void BenchmarkSkeletonWorldTransforms(Skeleton* shippedSkel, const char* shippedSkelName, bgz::Memory_Partition&& memPart, i32 updatesPerSkeleton)
 {
-    Bone* root = &fighterSkel.bones[0];
-    
-    UpdateBoneChainsWorldPositions_StartingFrom($(*root));
+    _BenchmarkSkeletonWorldTransforms($(*shippedSkel), shippedSkelName, updatesPerSkeleton);
     
-    for (i32 i {}; i < bgz::Size(&fighterSkel.bones); ++i)
+    Array<i32, 2> chainLengths = { 64, 256 };
+    for (i32 chainIndex {}; chainIndex < chainLengths.Size(); ++chainIndex)
     {
-        fighterSkel.bones[i].worldSpace.translation += fighterWorldPos;
-        fighterSkel.bones[i].worldSpace.rotation = WorldRotation_Bone(fighterSkel.bones[i]);
+        bgz::ScopedMemory scopeMemory(&memPart);
         
-        if (root->parentBoneSpace.scale.x == -1.0f)
-            fighterSkel.bones[i].worldSpace.rotation = PI - fighterSkel.bones[i].worldSpace.rotation;
+        //Single deep chain, every bone parented to the one before it
+        i32 boneCount = chainLengths[chainIndex];
+        Skeleton chain {};
+        _InitSkeletonData($(chain), $(memPart), boneCount);
+        for (i32 boneIndex {}; boneIndex < boneCount; ++boneIndex)
+        {
+            chain.setup->parentBoneIndices[boneIndex] = (i16)(boneIndex - 1);
+            chain.setup->boneLengths[boneIndex] = .1f;
+            chain.setup->initialRotations_parentBoneSpace[boneIndex] = .05f;
+            chain.setup->initialPositions_parentBoneSpace[boneIndex] = { .1f, .02f };
+        };
+        
+        _BenchmarkSkeletonWorldTransforms($(chain), "synthetic chain", (updatesPerSkeleton / boneCount) + 1);
+        
+        for (i32 boneIndex {}; boneIndex < boneCount; ++boneIndex)
+            kv_destroy(chain.setup->originalCollisionBoxVerts[boneIndex].elems);
     };
-    
-    root->worldSpace.translation = fighterWorldPos;
-    root->parentBoneSpace.translation = fighterWorldPos;
 };
+#endif
 
 #endif //SKELETON_IMPL
\ No newline at end of file
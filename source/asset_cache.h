@@ -0,0 +1,664 @@
+#ifndef ASSET_CACHE_INCLUDE
+#define ASSET_CACHE_INCLUDE
+
+#include "2d_skeleton.h"
+#include "2d_animation.h"
+#include "cooked_rig.h"
+
+//Assets requested async are loaded on the platform's worker threads. Anything written by the load is only safe to
+//touch from the game thread once the asset reads LOADED (poll with IsLoaded or block with AwaitLoad)
+enum class Asset_State : i32
+{
+    UNLOADED,
+    LOADING,
+    LOADED
+};
+
+//A skeleton + its animations loaded (and converted to game units) once, shared by every fighter using the same files
+struct Rig_Asset
+{
+    char atlasFilePath[256] {};
+    char jsonFilePath[256] {};
+    i32 refCount {};
+    Skeleton skel {}; //Prototype. Fighters get their own pose through InstantiateSkeleton but share its setup data
+    AnimationData animData {}; //Clips are read only at runtime so these are shared as is
+    void* cookedFile { nullptr }; //Mapped .rig file when loaded from one. Skeleton setup data and baked clips point into it
+    f32 pixelsPerMeter {};
+    bgz::Memory_Partition loadPart {}; //Async loads get their own partition so worker threads never push onto the caller's
+    Asset_State volatile state { Asset_State::UNLOADED };
+};
+
+struct Bitmap_Asset
+{
+    char filePath[256] {};
+    i32 refCount {};
+    Bitmap bitmap {};
+    Asset_State volatile state { Asset_State::UNLOADED };
+};
+
+//The font itself lives in the rendering info it was loaded into, this just tracks the load
+struct Font_Asset
+{
+    char filePath[256] {};
+    i32 pixelHeight {};
+    Rendering_Info* renderingInfo { nullptr };
+    Asset_State volatile state { Asset_State::UNLOADED };
+};
+
+struct Asset_Cache
+{
+    Array<Rig_Asset, 8> rigs;
+    Array<Bitmap_Asset, 8> bitmaps;
+    Array<Font_Asset, 2> fonts;
+};
+
+Rig_Asset* AcquireRig(Asset_Cache&& cache, bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter);
+Rig_Asset* AcquireRigAsync(Asset_Cache&& cache, bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter);
+void ReleaseRig(Asset_Cache&& cache, Rig_Asset* rig);
+Skeleton InstantiateSkeleton(Rig_Asset* rig, bgz::Memory_Partition&& memPart);
+
+Bitmap_Asset* AcquireBitmapAsync(Asset_Cache&& cache, const char* filePath);
+void ReleaseBitmap(Asset_Cache&& cache, Bitmap_Asset* bitmap);
+
+//Writes the font into renderingInfo from a worker thread so don't draw text with it (or load another font into it) until it's loaded
+Font_Asset* LoadFontAsync(Asset_Cache&& cache, Rendering_Info* renderingInfo, const char* ttfFilePath, i32 pixelHeight);
+void ReleaseFont(Asset_Cache&& cache, Font_Asset* font);
+
+b IsLoaded(const Rig_Asset* rig);
+b IsLoaded(const Bitmap_Asset* bitmap);
+b IsLoaded(const Font_Asset* font);
+void AwaitLoad(Rig_Asset* rig);
+void AwaitLoad(Bitmap_Asset* bitmap);
+void AwaitLoad(Font_Asset* font);
+
+#if DEVELOPMENT_BUILD
+void BenchmarkRigLoading(bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter);
+void BenchmarkCookedRigLoading(bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter);
+void BenchmarkLevelLoading(bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter);
+#endif
+
+#endif
+
+#ifdef ASSET_CACHE_IMPL
+
+//Translate pixels to meters and degrees to radians (since spine exports everything in pixel/degree units)
+local_func void _ConvertRigToGameUnits(Skeleton&& skel, AnimationData&& animData, f32 pixelsPerMeter)
+{
+    skel.width /= pixelsPerMeter;
+    skel.height /= pixelsPerMeter;
+
+    for (i32 boneIndex {}; boneIndex < skel.boneCount; ++boneIndex)
+    {
+        skel.pose.translations_parentBoneSpace[boneIndex].x /= pixelsPerMeter;
+        skel.pose.translations_parentBoneSpace[boneIndex].y /= pixelsPerMeter;
+        skel.setup->initialPositions_parentBoneSpace[boneIndex].x /= pixelsPerMeter;
+        skel.setup->initialPositions_parentBoneSpace[boneIndex].y /= pixelsPerMeter;
+
+        skel.pose.rotations_parentBoneSpace[boneIndex] = Radians(skel.pose.rotations_parentBoneSpace[boneIndex]);
+        skel.setup->initialRotations_parentBoneSpace[boneIndex] = Radians(skel.setup->initialRotations_parentBoneSpace[boneIndex]);
+
+        skel.setup->boneLengths[boneIndex] /= pixelsPerMeter;
+    };
+
+    for (i32 slotI {}; slotI < bgz::Size(&skel.slots); ++slotI)
+    {
+        skel.slots[slotI].regionAttachment.height /= pixelsPerMeter;
+        skel.slots[slotI].regionAttachment.width /= pixelsPerMeter;
+        skel.slots[slotI].regionAttachment.parentBoneSpace.rotation = Radians(skel.slots[slotI].regionAttachment.parentBoneSpace.rotation);
+        skel.slots[slotI].regionAttachment.parentBoneSpace.translation.x /= pixelsPerMeter;
+        skel.slots[slotI].regionAttachment.parentBoneSpace.translation.y /= pixelsPerMeter;
+    };
+
+    for (i32 animIndex {}; animIndex < bgz::Size(&animData.animMap.animations); ++animIndex)
+    {
+        Animation* anim = &animData.animMap.animations[animIndex];
+
+        if (anim->name)
+        {
+            for (i32 boneIndex {}; boneIndex < anim->boneCount; ++boneIndex)
+            {
+                TranslationTimeline* boneTranslationTimeline = &anim->boneTranslationTimelines[boneIndex];
+                for (i32 keyFrameIndex {}; keyFrameIndex < boneTranslationTimeline->translations.Size(); ++keyFrameIndex)
+                {
+                    boneTranslationTimeline->translations[keyFrameIndex].x /= pixelsPerMeter;
+                    boneTranslationTimeline->translations[keyFrameIndex].y /= pixelsPerMeter;
+                }
+
+                RotationTimeline* boneRotationTimeline = &anim->boneRotationTimelines[boneIndex];
+                for (i32 keyFrameIndex {}; keyFrameIndex < boneRotationTimeline->angles.Size(); ++keyFrameIndex)
+                {
+                    boneRotationTimeline->angles[keyFrameIndex] = Radians(boneRotationTimeline->angles[keyFrameIndex]);
+                }
+            };
+
+            for (i32 hitBoxIndex {}; hitBoxIndex < anim->hitBoxes.length; ++hitBoxIndex)
+            {
+                anim->hitBoxes[hitBoxIndex].size.width /= pixelsPerMeter;
+                anim->hitBoxes[hitBoxIndex].size.height /= pixelsPerMeter;
+                anim->hitBoxes[hitBoxIndex].worldPosOffset.x /= pixelsPerMeter;
+                anim->hitBoxes[hitBoxIndex].worldPosOffset.y /= pixelsPerMeter;
+            };
+        };
+    }
+};
+
+//False if the animations didn't fit (see InitAnimData). What did fit is still loaded
+local_func b _LoadRig(Skeleton&& skel, AnimationData&& animData, bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter)
+{
+    InitSkel($(skel), $(memPart), atlasFilePath, jsonFilePath);
+    b animsLoaded = InitAnimData($(animData), $(memPart), jsonFilePath, skel);
+    _ConvertRigToGameUnits($(skel), $(animData), pixelsPerMeter);
+    
+    return animsLoaded;
+};
+
+//The cooked file lives next to the json, e.g. data/yellow_god.json -> data/yellow_god.rig
+local_func void _CookedRigFilePath(char* cookedFilePath, i32 cookedFilePathSize, const char* jsonFilePath)
+{
+    i32 pathLength = (i32)strlen(jsonFilePath);
+    const char* extension = strrchr(jsonFilePath, '.');
+    if (extension)
+        pathLength = (i32)(extension - jsonFilePath);
+
+    BGZ_ASSERT(pathLength + (i32)sizeof(".rig") <= cookedFilePathSize);//, "Cooked rig file path is too long!");
+    memcpy(cookedFilePath, jsonFilePath, pathLength);
+    strcpy(cookedFilePath + pathLength, ".rig");
+};
+
+//Returns the mapped file on success. Null if there's no cooked file or it's out of date (caller falls back to json)
+local_func void* _LoadCookedRig(Skeleton&& skel, AnimationData&& animData, bgz::Memory_Partition&& memPart, const char* jsonFilePath, f32 pixelsPerMeter)
+{
+    char cookedFilePath[256] {};
+    _CookedRigFilePath(cookedFilePath, sizeof(cookedFilePath), jsonFilePath);
+
+    i32 cookedFileSize {};
+    void* cookedFile = globalPlatformServices->MapEntireFile($(cookedFileSize), cookedFilePath);
+    if (NOT cookedFile)
+        return nullptr;
+
+    if (NOT LoadCookedRig($(skel), $(animData), $(memPart), cookedFile, cookedFileSize, pixelsPerMeter))
+    {
+        BGZ_CONSOLE("%s is out of date (re-run rig_cooker). Loading %s instead\n", cookedFilePath, jsonFilePath);
+        globalPlatformServices->UnmapFile(cookedFile);
+        return nullptr;
+    };
+
+    return cookedFile;
+};
+
+//Frees what loading put on the heap. Everything else lives in the memory partition it was loaded into (or in the
+//cooked file, which strings/setup data point into)
+local_func void _FreeRigHeapData(Skeleton&& skel, AnimationData&& animData, void* cookedFile)
+{
+    if (NOT cookedFile)
+    {
+        for (i32 boneIndex {}; boneIndex < skel.boneCount; ++boneIndex)
+            kv_destroy(skel.setup->originalCollisionBoxVerts[boneIndex].elems);
+    };
+
+    kv_destroy(animData.animMap.animations.elems);
+    kv_destroy(skel.slots.elems);
+
+    if (cookedFile)
+        globalPlatformServices->UnmapFile(cookedFile);
+};
+
+//Rig setup data + names are small, this is plenty for the rigs we have (PushSize will assert if one outgrows it)
+#define RIG_LOAD_PARTITION_SIZE Megabytes(2)
+
+local_func void _MarkLoaded(Asset_State volatile* state)
+{
+    _mm_sfence(); //Everything the load wrote has to be visible before the game thread sees LOADED
+    *state = Asset_State::LOADED;
+};
+
+local_func void _AwaitAssetState(Asset_State volatile* state)
+{
+    BGZ_ASSERT(*state != Asset_State::UNLOADED);//, "Waiting on an asset that was never requested!");
+    
+    //Help with queued work instead of just spinning, the load we want might still be waiting on a free worker
+    while (*state != Asset_State::LOADED)
+    {
+        if (NOT globalPlatformServices->DoNextWorkQueueEntry())
+            globalPlatformServices->Sleep(0);
+    };
+};
+
+//Returns the cached rig if one with the same files is already loaded/loading, otherwise claims a free slot
+local_func Rig_Asset* _FindOrClaimRig(Asset_Cache&& cache, b&& alreadyCached, const char* atlasFilePath, const char* jsonFilePath)
+{
+    BGZ_ASSERT(strlen(atlasFilePath) < sizeof(Rig_Asset::atlasFilePath) && strlen(jsonFilePath) < sizeof(Rig_Asset::jsonFilePath));//, "Rig file path is too long!");
+
+    Rig_Asset* freeRig { nullptr };
+    for (i32 rigIndex {}; rigIndex < cache.rigs.Size(); ++rigIndex)
+    {
+        Rig_Asset* rig = &cache.rigs[rigIndex];
+
+        if (rig->refCount > 0)
+        {
+            if (StringCmp(rig->jsonFilePath, jsonFilePath) && StringCmp(rig->atlasFilePath, atlasFilePath))
+            {
+                ++rig->refCount;
+                alreadyCached = true;
+                return rig;
+            };
+        }
+        else if (NOT freeRig)
+        {
+            freeRig = rig;
+        };
+    };
+
+    BGZ_ASSERT(freeRig);//, "Asset cache is full!");
+
+    *freeRig = Rig_Asset {};
+    strcpy(freeRig->atlasFilePath, atlasFilePath);
+    strcpy(freeRig->jsonFilePath, jsonFilePath);
+    freeRig->refCount = 1;
+    alreadyCached = false;
+
+    return freeRig;
+};
+
+local_func void _LoadRigAsset(Rig_Asset* rig, bgz::Memory_Partition&& memPart)
+{
+    rig->cookedFile = _LoadCookedRig($(rig->skel), $(rig->animData), $(memPart), rig->jsonFilePath, rig->pixelsPerMeter);
+    if (NOT rig->cookedFile)
+    {
+        rig->skel = Skeleton {};
+        rig->animData = AnimationData {};
+        if (NOT _LoadRig($(rig->skel), $(rig->animData), $(memPart), rig->atlasFilePath, rig->jsonFilePath, rig->pixelsPerMeter))
+            BGZ_CONSOLE("%s didn't fully load, some animations are missing key frames or hit boxes\n", rig->jsonFilePath);
+    };
+
+    _MarkLoaded(&rig->state);
+};
+
+local_func PLATFORM_WORK_QUEUE_CALLBACK(_LoadRigWork)
+{
+    Rig_Asset* rig = (Rig_Asset*)data;
+    _LoadRigAsset(rig, $(rig->loadPart));
+};
+
+Rig_Asset* AcquireRig(Asset_Cache&& cache, bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter)
+{
+    b alreadyCached {};
+    Rig_Asset* rig = _FindOrClaimRig($(cache), $(alreadyCached), atlasFilePath, jsonFilePath);
+
+    if (alreadyCached)
+    {
+        if (rig->state != Asset_State::LOADED)
+            AwaitLoad(rig);
+
+        return rig;
+    };
+
+    rig->pixelsPerMeter = pixelsPerMeter;
+    rig->state = Asset_State::LOADING;
+    _LoadRigAsset(rig, $(memPart));
+
+    return rig;
+};
+
+Rig_Asset* AcquireRigAsync(Asset_Cache&& cache, bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter)
+{
+    b alreadyCached {};
+    Rig_Asset* rig = _FindOrClaimRig($(cache), $(alreadyCached), atlasFilePath, jsonFilePath);
+
+    if (alreadyCached)
+        return rig;
+
+    //Carved out here on the game thread. The rig's setup data lives in it so it has to last as long as memPart does
+    rig->loadPart = bgz::Memory_Partition { PushSize(&memPart, RIG_LOAD_PARTITION_SIZE), 0, RIG_LOAD_PARTITION_SIZE };
+    rig->pixelsPerMeter = pixelsPerMeter;
+    rig->state = Asset_State::LOADING;
+    globalPlatformServices->AddWorkQueueEntry(&_LoadRigWork, rig);
+
+    return rig;
+};
+
+void ReleaseRig(Asset_Cache&& cache, Rig_Asset* rig)
+{
+    BGZ_ASSERT(rig->refCount > 0);//, "Releasing a rig that isn't loaded!");
+
+    --rig->refCount;
+    if (rig->refCount == 0)
+    {
+        if (rig->state != Asset_State::LOADED)
+            AwaitLoad(rig);
+
+        _FreeRigHeapData($(rig->skel), $(rig->animData), rig->cookedFile);
+        *rig = Rig_Asset {};
+    };
+};
+
+Skeleton InstantiateSkeleton(Rig_Asset* rig, bgz::Memory_Partition&& memPart)
+{
+    BGZ_ASSERT(rig->refCount > 0);//, "Instancing a rig that isn't loaded!");
+
+    return CopySkeleton(rig->skel, $(memPart));
+};
+
+local_func PLATFORM_WORK_QUEUE_CALLBACK(_LoadBitmapWork)
+{
+    Bitmap_Asset* bitmap = (Bitmap_Asset*)data;
+    bitmap->bitmap = LoadBitmap_BGRA(bitmap->filePath);
+    _MarkLoaded(&bitmap->state);
+};
+
+Bitmap_Asset* AcquireBitmapAsync(Asset_Cache&& cache, const char* filePath)
+{
+    BGZ_ASSERT(strlen(filePath) < sizeof(Bitmap_Asset::filePath));//, "Bitmap file path is too long!");
+
+    Bitmap_Asset* freeBitmap { nullptr };
+    for (i32 bitmapIndex {}; bitmapIndex < cache.bitmaps.Size(); ++bitmapIndex)
+    {
+        Bitmap_Asset* bitmap = &cache.bitmaps[bitmapIndex];
+
+        if (bitmap->refCount > 0)
+        {
+            if (StringCmp(bitmap->filePath, filePath))
+            {
+                ++bitmap->refCount;
+                return bitmap;
+            };
+        }
+        else if (NOT freeBitmap)
+        {
+            freeBitmap = bitmap;
+        };
+    };
+
+    BGZ_ASSERT(freeBitmap);//, "Asset cache is full!");
+
+    *freeBitmap = Bitmap_Asset {};
+    strcpy(freeBitmap->filePath, filePath);
+    freeBitmap->refCount = 1;
+    freeBitmap->state = Asset_State::LOADING;
+    globalPlatformServices->AddWorkQueueEntry(&_LoadBitmapWork, freeBitmap);
+
+    return freeBitmap;
+};
+
+void ReleaseBitmap(Asset_Cache&& cache, Bitmap_Asset* bitmap)
+{
+    BGZ_ASSERT(bitmap->refCount > 0);//, "Releasing a bitmap that isn't loaded!");
+
+    --bitmap->refCount;
+    if (bitmap->refCount == 0)
+    {
+        if (bitmap->state != Asset_State::LOADED)
+            AwaitLoad(bitmap);
+
+        DeAlloc(heap, bitmap->bitmap.data);
+        *bitmap = Bitmap_Asset {};
+    };
+};
+
+local_func PLATFORM_WORK_QUEUE_CALLBACK(_LoadFontWork)
+{
+    Font_Asset* font = (Font_Asset*)data;
+    CreateFontAtlasFromFile_TTF(font->renderingInfo, font->filePath, font->pixelHeight);
+    _MarkLoaded(&font->state);
+};
+
+Font_Asset* LoadFontAsync(Asset_Cache&& cache, Rendering_Info* renderingInfo, const char* ttfFilePath, i32 pixelHeight)
+{
+    BGZ_ASSERT(strlen(ttfFilePath) < sizeof(Font_Asset::filePath));//, "Font file path is too long!");
+
+    Font_Asset* freeFont { nullptr };
+    for (i32 fontIndex {}; fontIndex < cache.fonts.Size(); ++fontIndex)
+    {
+        BGZ_ASSERT(cache.fonts[fontIndex].renderingInfo != renderingInfo);//, "Already loading a font into this rendering info!");
+
+        if (NOT freeFont && cache.fonts[fontIndex].state == Asset_State::UNLOADED)
+            freeFont = &cache.fonts[fontIndex];
+    };
+
+    BGZ_ASSERT(freeFont);//, "Asset cache is full!");
+
+    *freeFont = Font_Asset {};
+    strcpy(freeFont->filePath, ttfFilePath);
+    freeFont->pixelHeight = pixelHeight;
+    freeFont->renderingInfo = renderingInfo;
+    freeFont->state = Asset_State::LOADING;
+    globalPlatformServices->AddWorkQueueEntry(&_LoadFontWork, freeFont);
+
+    return freeFont;
+};
+
+//Only frees up the slot, the font stays in the rendering info it was loaded into
+void ReleaseFont(Asset_Cache&& cache, Font_Asset* font)
+{
+    if (font->state != Asset_State::LOADED)
+        AwaitLoad(font);
+
+    *font = Font_Asset {};
+};
+
+b IsLoaded(const Rig_Asset* rig)
+{
+    return rig->state == Asset_State::LOADED;
+};
+
+b IsLoaded(const Bitmap_Asset* bitmap)
+{
+    return bitmap->state == Asset_State::LOADED;
+};
+
+b IsLoaded(const Font_Asset* font)
+{
+    return font->state == Asset_State::LOADED;
+};
+
+void AwaitLoad(Rig_Asset* rig)
+{
+    _AwaitAssetState(&rig->state);
+};
+
+void AwaitLoad(Bitmap_Asset* bitmap)
+{
+    _AwaitAssetState(&bitmap->state);
+};
+
+void AwaitLoad(Font_Asset* font)
+{
+    _AwaitAssetState(&font->state);
+};
+
+#if DEVELOPMENT_BUILD
+//Compares loading a rig from file for every fighter against loading it once through the cache and instancing it
+void BenchmarkRigLoading(bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter)
+{
+    Array<i32, 3> fighterCounts = { 2, 16, 128 };
+    for (i32 countIndex {}; countIndex < fighterCounts.Size(); ++countIndex)
+    {
+        i32 fighterCount = fighterCounts[countIndex];
+
+        f64 uncachedSecs {}, cachedSecs {};
+        i64 uncachedBytes {}, cachedBytes {};
+
+        { //Every fighter loads its own copy
+            bgz::ScopedMemory scopeMemory(&memPart);
+
+            Skeleton* skels = PushType(&memPart, Skeleton, fighterCount);
+            AnimationData* animDatas = PushType(&memPart, AnimationData, fighterCount);
+            i64 startBytes = memPart.usedAmount;
+
+            f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+            for (i32 fighterIndex {}; fighterIndex < fighterCount; ++fighterIndex)
+            {
+                skels[fighterIndex] = Skeleton {};
+                animDatas[fighterIndex] = AnimationData {};
+                _LoadRig($(skels[fighterIndex]), $(animDatas[fighterIndex]), $(memPart), atlasFilePath, jsonFilePath, pixelsPerMeter);
+            };
+            uncachedSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+            uncachedBytes = memPart.usedAmount - startBytes;
+
+            for (i32 fighterIndex {}; fighterIndex < fighterCount; ++fighterIndex)
+                _FreeRigHeapData($(skels[fighterIndex]), $(animDatas[fighterIndex]), nullptr);
+        };
+
+        { //Load once, instance per fighter
+            bgz::ScopedMemory scopeMemory(&memPart);
+
+            Asset_Cache* cache = PushType(&memPart, Asset_Cache, 1);
+            *cache = Asset_Cache {};
+            Skeleton* skels = PushType(&memPart, Skeleton, fighterCount);
+            Rig_Asset** rigs = PushType(&memPart, Rig_Asset*, fighterCount);
+            i64 startBytes = memPart.usedAmount;
+
+            f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+            for (i32 fighterIndex {}; fighterIndex < fighterCount; ++fighterIndex)
+            {
+                rigs[fighterIndex] = AcquireRig($(*cache), $(memPart), atlasFilePath, jsonFilePath, pixelsPerMeter);
+                skels[fighterIndex] = InstantiateSkeleton(rigs[fighterIndex], $(memPart));
+            };
+            cachedSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+            cachedBytes = memPart.usedAmount - startBytes;
+
+            for (i32 fighterIndex {}; fighterIndex < fighterCount; ++fighterIndex)
+            {
+                kv_destroy(skels[fighterIndex].slots.elems);
+                ReleaseRig($(*cache), rigs[fighterIndex]);
+            };
+        };
+
+        BGZ_CONSOLE("Rig load bench (%s, %d fighters): per fighter load %.3f ms (%lld bytes), cached %.3f ms (%lld bytes)\n",
+                    jsonFilePath, fighterCount, uncachedSecs * 1000.0, uncachedBytes, cachedSecs * 1000.0, cachedBytes);
+    };
+};
+
+//First load of each path in the process counts as cold (the os may still have the files cached from a previous run,
+//so this is a best case for cold), the average of the loads after it as warm
+void BenchmarkCookedRigLoading(bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter)
+{
+    const i32 loadCount = 16;
+
+    f64 jsonColdSecs {}, jsonWarmSecs {}, cookedColdSecs {}, cookedWarmSecs {};
+    for (i32 loadIndex {}; loadIndex < loadCount; ++loadIndex)
+    {
+        bgz::ScopedMemory scopeMemory(&memPart);
+
+        Skeleton skel {};
+        AnimationData animData {};
+
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        _LoadRig($(skel), $(animData), $(memPart), atlasFilePath, jsonFilePath, pixelsPerMeter);
+        BakeAnimationClips($(animData), $(memPart));
+        f64 loadSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        if (loadIndex == 0)
+            jsonColdSecs = loadSecs;
+        else
+            jsonWarmSecs += loadSecs / (loadCount - 1);
+
+        _FreeRigHeapData($(skel), $(animData), nullptr);
+    };
+
+    for (i32 loadIndex {}; loadIndex < loadCount; ++loadIndex)
+    {
+        bgz::ScopedMemory scopeMemory(&memPart);
+
+        Skeleton skel {};
+        AnimationData animData {};
+
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        void* cookedFile = _LoadCookedRig($(skel), $(animData), $(memPart), jsonFilePath, pixelsPerMeter);
+        f64 loadSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        if (NOT cookedFile)
+        {
+            BGZ_CONSOLE("Cooked rig load bench (%s): no up to date cooked file, skipping\n", jsonFilePath);
+            return;
+        };
+
+        if (loadIndex == 0)
+            cookedColdSecs = loadSecs;
+        else
+            cookedWarmSecs += loadSecs / (loadCount - 1);
+
+        _FreeRigHeapData($(skel), $(animData), cookedFile);
+    };
+
+    BGZ_CONSOLE("Cooked rig load bench (%s): json + bake cold %.3f ms warm %.3f ms, cooked cold %.3f ms warm %.3f ms\n",
+                jsonFilePath, jsonColdSecs * 1000.0, jsonWarmSecs * 1000.0, cookedColdSecs * 1000.0, cookedWarmSecs * 1000.0);
+};
+
+local_func void _FreeFontData(Rendering_Info* renderingInfo)
+{
+    DeAlloc(heap, renderingInfo->fontAtlas.data);
+    globalPlatformServices->Free(renderingInfo->fontInfo.data);
+};
+
+//Loads a level's worth of assets (stage images, a rig and a font) and times it with 1 to max worker threads. The game
+//thread helps out while it waits so N workers is really N + 1 threads. Serial is everything loaded on the game thread
+void BenchmarkLevelLoading(bgz::Memory_Partition&& memPart, const char* atlasFilePath, const char* jsonFilePath, f32 pixelsPerMeter)
+{
+    Array<const char*, 5> imageFilePaths = { "data/4k.jpg", "data/1080p.jpg", "data/mountain.jpg", "data/yellow_god.png", "data/left-bicep.png" };
+    const char* fontFilePath = "data/arial.ttf";
+
+    f64 serialSecs {};
+    { //Serial
+        bgz::ScopedMemory scopeMemory(&memPart);
+
+        Asset_Cache* cache = PushType(&memPart, Asset_Cache, 1);
+        *cache = Asset_Cache {};
+        Rendering_Info* fontRenderingInfo = PushType(&memPart, Rendering_Info, 1);
+        *fontRenderingInfo = Rendering_Info {};
+        Bitmap* bitmaps = PushType(&memPart, Bitmap, imageFilePaths.Size());
+
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            bitmaps[imageIndex] = LoadBitmap_BGRA(imageFilePaths[imageIndex]);
+        Rig_Asset* rig = AcquireRig($(*cache), $(memPart), atlasFilePath, jsonFilePath, pixelsPerMeter);
+        CreateFontAtlasFromFile_TTF(fontRenderingInfo, fontFilePath, 18);
+        serialSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            DeAlloc(heap, bitmaps[imageIndex].data);
+        ReleaseRig($(*cache), rig);
+        _FreeFontData(fontRenderingInfo);
+    };
+
+    BGZ_CONSOLE("Level load bench (%d images, 1 rig, 1 font): serial %.2f ms\n", imageFilePaths.Size(), serialSecs * 1000.0);
+
+    for (i32 threadCount { 1 }; threadCount <= globalPlatformServices->maxWorkerThreadCount; ++threadCount)
+    {
+        bgz::ScopedMemory scopeMemory(&memPart);
+
+        Asset_Cache* cache = PushType(&memPart, Asset_Cache, 1);
+        *cache = Asset_Cache {};
+        Rendering_Info* fontRenderingInfo = PushType(&memPart, Rendering_Info, 1);
+        *fontRenderingInfo = Rendering_Info {};
+        Bitmap_Asset** bitmaps = PushType(&memPart, Bitmap_Asset*, imageFilePaths.Size());
+
+        globalPlatformServices->SetWorkerThreadCount(threadCount);
+
+        //Biggest jobs first so the long 4k decode doesn't end up being the last thing started
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            bitmaps[imageIndex] = AcquireBitmapAsync($(*cache), imageFilePaths[imageIndex]);
+        Rig_Asset* rig = AcquireRigAsync($(*cache), $(memPart), atlasFilePath, jsonFilePath, pixelsPerMeter);
+        Font_Asset* font = LoadFontAsync($(*cache), fontRenderingInfo, fontFilePath, 18);
+
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            AwaitLoad(bitmaps[imageIndex]);
+        AwaitLoad(rig);
+        AwaitLoad(font);
+        f64 asyncSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            ReleaseBitmap($(*cache), bitmaps[imageIndex]);
+        ReleaseRig($(*cache), rig);
+        ReleaseFont($(*cache), font);
+        _FreeFontData(fontRenderingInfo);
+
+        BGZ_CONSOLE("Level load bench: %d worker threads %.2f ms (%.2fx serial)\n", threadCount, asyncSecs * 1000.0, serialSecs / asyncSecs);
+    };
+
+    globalPlatformServices->SetWorkerThreadCount(globalPlatformServices->maxWorkerThreadCount);
+};
+#endif
+
+#endif //ASSET_CACHE_IMPL
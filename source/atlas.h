@@ -94,17 +94,27 @@ struct AtlasRegion
     i32* pads{nullptr};
     
     AtlasPage* page{nullptr};
-    
-    AtlasRegion* next{nullptr};
 };
 
-AtlasRegion* AtlasRegion_create();
 void AtlasRegion_dispose(AtlasRegion* self);
 
+struct AtlasRegionSlot
+{
+    ui32 nameHash{0};//0 == empty slot
+    i32 regionIndex{0};
+};
+
 struct Atlas
 {
     AtlasPage* pages{nullptr};
+    
+    //Regions are stored contiguously in file order so batching code can just walk the array. Name lookups go through
+    //an open addressed hash table (linear probing, kept at most half full) that's built once the atlas is parsed.
     AtlasRegion* regions{nullptr};
+    i32 regionCount{0};
+    i32 regionCapacity{0};
+    AtlasRegionSlot* regionSlots{nullptr};
+    i32 regionSlotCount{0};//Always a power of 2
     
     void* rendererObject{nullptr};
 };
@@ -118,6 +128,10 @@ void Atlas_dispose(Atlas* atlas);
 /* Returns 0 if the region was not found. */
 AtlasRegion* Atlas_findRegion(const Atlas* self, const char* name);
 
+#if DEVELOPMENT_BUILD
+void BenchmarkAtlasRegionLookup(const char* pageImageDir, const char* pageImageName, i32 regionCount, i32 lookupsPerRegion);
+#endif
+
 #endif // ATLAS_INCLUDE_H
 
 #ifdef ATLAS_IMPL
@@ -288,17 +302,78 @@ static Atlas* abortAtlas(Atlas* self)
 
 /**/
 
-AtlasRegion* AtlasRegion_create()
-{
-    return CallocType(heap, AtlasRegion, 1);
-}
-
+/* Regions live in the atlas's region array so only the strings/arrays they own get freed. */
 void AtlasRegion_dispose(AtlasRegion* self)
 {
     DeAlloc(heap, self->name);
     DeAlloc(heap, self->splits);
     DeAlloc(heap, self->pads);
-    DeAlloc(heap, self);
+}
+
+static ui32 _Atlas_hashRegionName(const char* name)
+{
+    //32 bit FNV-1a
+    ui32 hash = 2166136261u;
+    for (i32 i = 0; name[i] != 0; ++i)
+    {
+        hash ^= (ui8)name[i];
+        hash *= 16777619u;
+    }
+    
+    if (hash == 0) //0 marks an empty slot
+        hash = 1;
+    
+    return hash;
+}
+
+/* Returned pointer is only valid until the next region is added. */
+static AtlasRegion* _Atlas_addRegion(Atlas* self)
+{
+    if (self->regionCount == self->regionCapacity)
+    {
+        i32 newCapacity = self->regionCapacity ? self->regionCapacity * 2 : 32;
+        self->regions = ReAllocType(heap, self->regions, AtlasRegion, newCapacity);
+        self->regionCapacity = newCapacity;
+    }
+    
+    AtlasRegion* region = &self->regions[self->regionCount++];
+    *region = AtlasRegion{};
+    return region;
+}
+
+static void _Atlas_buildRegionTable(Atlas* self)
+{
+    i32 slotCount = 16;
+    while (slotCount < self->regionCount * 2)
+        slotCount *= 2;
+    
+    self->regionSlots = CallocType(heap, AtlasRegionSlot, slotCount);
+    self->regionSlotCount = slotCount;
+    
+    for (i32 regionIndex = 0; regionIndex < self->regionCount; ++regionIndex)
+    {
+        const char* name = self->regions[regionIndex].name;
+        ui32 hash = _Atlas_hashRegionName(name);
+        
+        b32 alreadyInTable = false;
+        i32 slotIndex = (i32)(hash & (ui32)(slotCount - 1));
+        while (self->regionSlots[slotIndex].nameHash != 0)
+        {
+            AtlasRegionSlot slot = self->regionSlots[slotIndex];
+            if (slot.nameHash == hash && StringCmp(self->regions[slot.regionIndex].name, name))
+            {
+                alreadyInTable = true; //Duplicate region names resolve to the first one in the file, same as the old list walk
+                break;
+            }
+            slotIndex = (slotIndex + 1) & (slotCount - 1);
+        }
+        
+        if (!alreadyInTable)
+        {
+            self->regionSlots[slotIndex].nameHash = hash;
+            self->regionSlots[slotIndex].regionIndex = regionIndex;
+        }
+    }
 }
 
 static const char* formatNames[] = { "", "Alpha", "Intensity", "LuminanceAlpha", "RGB565", "RGBA4444", "RGB888", "RGBA8888" };
@@ -316,7 +391,6 @@ Atlas* CreateAtlas(const char* begin, i64 length, const char* dir, void* rendere
     
     AtlasPage* page = 0;
     AtlasPage* lastPage = 0;
-    AtlasRegion* lastRegion = 0;
     Str str;
     Str tuple[4];
     
@@ -389,12 +463,7 @@ Atlas* CreateAtlas(const char* begin, i64 length, const char* dir, void* rendere
         }
         else
         {
-            AtlasRegion* region = AtlasRegion_create();
-            if (lastRegion)
-                lastRegion->next = region;
-            else
-                self->regions = region;
-            lastRegion = region;
+            AtlasRegion* region = _Atlas_addRegion(self);
             
             region->page = page;
             region->name = mallocString(&str);
@@ -468,6 +537,8 @@ Atlas* CreateAtlas(const char* begin, i64 length, const char* dir, void* rendere
         }
     }
     
+    _Atlas_buildRegionTable(self);
+    
     return self;
 };
 
@@ -505,7 +576,6 @@ Atlas* CreateAtlasFromFile(const char* path, void* rendererObject)
 
 void Atlas_dispose(Atlas* self)
 {
-    AtlasRegion *region, *nextRegion;
     AtlasPage* page = self->pages;
     while (page)
     {
@@ -514,27 +584,94 @@ void Atlas_dispose(Atlas* self)
         page = nextPage;
     }
     
-    region = self->regions;
-    while (region)
-    {
-        nextRegion = region->next;
-        AtlasRegion_dispose(region);
-        region = nextRegion;
-    }
+    for (i32 i = 0; i < self->regionCount; ++i)
+        AtlasRegion_dispose(&self->regions[i]);
     
+    DeAlloc(heap, self->regions);
+    DeAlloc(heap, self->regionSlots);
     DeAlloc(heap, self);
 }
 
 AtlasRegion* Atlas_findRegion(const Atlas* self, const char* name)
 {
-    AtlasRegion* region = self->regions;
-    while (region)
+    if (!self->regionSlots)
+        return 0;
+    
+    ui32 hash = _Atlas_hashRegionName(name);
+    i32 slotIndex = (i32)(hash & (ui32)(self->regionSlotCount - 1));
+    while (self->regionSlots[slotIndex].nameHash != 0)
     {
-        if (StringCmp(region->name, name))
-            return region;
-        region = region->next;
+        AtlasRegionSlot slot = self->regionSlots[slotIndex];
+        if (slot.nameHash == hash && StringCmp(self->regions[slot.regionIndex].name, name))
+            return &self->regions[slot.regionIndex];
+        slotIndex = (slotIndex + 1) & (self->regionSlotCount - 1);
     }
     return 0;
 }
 
+#if DEVELOPMENT_BUILD
+void BenchmarkAtlasRegionLookup(const char* pageImageDir, const char* pageImageName, i32 regionCount, i32 lookupsPerRegion)
+{
+    //Synthetic single page atlas. The page image only has to exist since every region is a tiny rect in the corner
+    const char* regionText = "%s%05d\n  rotate: false\n  xy: 0, 0\n  size: 4, 4\n  orig: 4, 4\n  offset: 0, 0\n  index: -1\n";
+    i64 atlasTextCapacity = 256 + (i64)regionCount * 128;
+    char* atlasText = MallocType(heap, char, atlasTextCapacity);
+    i64 atlasTextLength = sprintf(atlasText, "%s\nsize: 1024,512\nformat: RGBA8888\nfilter: Linear,Linear\nrepeat: none\n", pageImageName);
+    for (i32 i = 0; i < regionCount; ++i)
+        atlasTextLength += sprintf(atlasText + atlasTextLength, regionText, "synthetic-region-", i);
+    
+    //Separate copies of the names so lookups can't win by comparing the region's own string against itself
+    char* lookupNames = MallocType(heap, char, (i64)regionCount * 32);
+    for (i32 i = 0; i < regionCount; ++i)
+        sprintf(lookupNames + (i64)i * 32, "synthetic-region-%05d", (i * 7919) % regionCount);
+    
+    f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+    Atlas* atlas = CreateAtlas(atlasText, atlasTextLength, pageImageDir, 0);
+    f64 createSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+    BGZ_ASSERT(atlas && atlas->regionCount == regionCount);//, "Synthetic atlas failed to parse!");
+    
+    //What Atlas_findRegion used to do (minus the pointer chasing of the old linked list), only done once since it's O(n^2)
+    i64 checkSum = 0;
+    startTime = globalPlatformServices->CurrentTimeInSecs();
+    for (i32 i = 0; i < regionCount; ++i)
+    {
+        const char* name = lookupNames + (i64)i * 32;
+        for (i32 regionIndex = 0; regionIndex < atlas->regionCount; ++regionIndex)
+        {
+            if (StringCmp(atlas->regions[regionIndex].name, name))
+            {
+                checkSum += regionIndex;
+                break;
+            }
+        }
+    }
+    f64 linearSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+    
+    startTime = globalPlatformServices->CurrentTimeInSecs();
+    for (i32 lookup = 0; lookup < lookupsPerRegion; ++lookup)
+    {
+        for (i32 i = 0; i < regionCount; ++i)
+            checkSum += Atlas_findRegion(atlas, lookupNames + (i64)i * 32) - atlas->regions;
+    }
+    f64 hashedSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+    
+    b32 missReturnedNull = Atlas_findRegion(atlas, "not-a-synthetic-region") == 0;
+    BGZ_ASSERT(missReturnedNull);//, "Lookup of a missing region name returned a region!");
+    
+    startTime = globalPlatformServices->CurrentTimeInSecs();
+    for (i32 i = 0; i < atlas->regionCount; ++i)
+        checkSum += atlas->regions[i].width + atlas->regions[i].x;
+    f64 iterateSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+    
+    f64 hashedLookups = (f64)regionCount * (f64)lookupsPerRegion;
+    BGZ_CONSOLE("Atlas region bench (%d regions, %d table slots): create %.2fms, linear scan %.1fns/lookup, hashed %.1fns/lookup (%.0fx), iterate %.2fns/region, miss %s (checksum %lld)\n",
+                regionCount, atlas->regionSlotCount, createSecs * 1000.0, linearSecs * 1e9 / (f64)regionCount, hashedSecs * 1e9 / hashedLookups,
+                (linearSecs / (f64)regionCount) / (hashedSecs / hashedLookups), iterateSecs * 1e9 / (f64)regionCount, missReturnedNull ? "ok" : "FAILED", checkSum);
+    
+    Atlas_dispose(atlas);
+    DeAlloc(heap, lookupNames);
+    DeAlloc(heap, atlasText);
+}
+#endif
+
 #endif //ATLAS_IMPL
\ No newline at end of file
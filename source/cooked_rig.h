@@ -0,0 +1,457 @@
+#ifndef COOKED_RIG_INCLUDE
+#define COOKED_RIG_INCLUDE
+
+#include "2d_skeleton.h"
+#include "2d_animation.h"
+
+/*
+    Cooked rig (.rig) file format. Written offline by rig_cooker from a spine .json + .atlas pair after it's been
+    converted to game units (meters/radians) and had its clips baked. The file is pointer free: everything is
+    addressed through byte offsets from the start of the file so the game can map it and point straight into it.
+
+    Texture pages aren't part of the file. Slot regions only keep their atlas rect/uv info.
+*/
+
+#define COOKED_RIG_MAGIC 0x47495243 //"CRIG"
+#define COOKED_RIG_VERSION 1
+#define COOKED_RIG_MAX_KEYFRAMES 10
+
+//Offsets below are all relative to the start of the file. Strings are null terminated
+struct Cooked_Rig_Header
+{
+    ui32 magic;
+    ui32 version;
+    ui32 fileSize;
+    f32 pixelsPerMeter; //Cooked data is only valid for a game running at this pixels per meter
+    f32 skelWidth, skelHeight;
+
+    i32 boneCount;
+    ui32 boneNameOffsets; //ui32[boneCount], offsets of each bone's name
+    ui32 parentBoneIndices; //i16[boneCount]
+    ui32 boneLengths; //f32[boneCount]
+    ui32 initialRotations_parentBoneSpace; //f32[boneCount]
+    ui32 initialPositions_parentBoneSpace; //v2[boneCount]
+    ui32 scales_parentBoneSpace; //v2[boneCount]
+
+    i32 slotCount;
+    ui32 slots; //Cooked_Slot[slotCount]
+
+    i32 animCount;
+    ui32 anims; //Cooked_Animation[animCount]
+};
+
+struct Cooked_Slot
+{
+    ui32 nameOffset;
+    i32 boneIndex;
+    f32 width, height;
+    v2 scale;
+    v2 translation_parentBoneSpace;
+    f32 rotation_parentBoneSpace;
+    v2 scale_parentBoneSpace;
+
+    ui32 regionNameOffset;
+    i32 x, y, width_pxls, height_pxls;
+    f32 u, v, u2, v2;
+    i32 offsetX, offsetY;
+    i32 originalWidth, originalHeight;
+    i32 index;
+    i32 rotate, flip;
+};
+
+struct Cooked_HitBox
+{
+    ui32 boneNameOffset;
+    v2 worldPosOffset;
+    v2 size;
+    f32 endTime;
+    f32 duration;
+    f32 timeUntilHitBoxIsActivated;
+};
+
+struct Cooked_Timeline
+{
+    i32 exists;
+    i32 timesCount, curvesCount, valuesCount;
+    f32 times[COOKED_RIG_MAX_KEYFRAMES];
+    i32 curves[COOKED_RIG_MAX_KEYFRAMES];
+    v2 values[COOKED_RIG_MAX_KEYFRAMES]; //Rotation timelines only use x
+};
+
+struct Cooked_Animation
+{
+    ui32 nameOffset;
+    f32 totalTime;
+    i32 boneCount;
+
+    i32 hitBoxCount;
+    ui32 hitBoxes; //Cooked_HitBox[hitBoxCount]
+
+    ui32 rotationTimelines; //Cooked_Timeline[boneCount]
+    ui32 translationTimelines; //Cooked_Timeline[boneCount]
+
+    f32 bakedSampleRate;
+    i32 bakedSampleCount;
+    ui32 bakedRotations; //f32[bakedSampleCount * boneCount], same layout as Baked_Clip
+    ui32 bakedTranslations; //v2[bakedSampleCount * boneCount]
+};
+
+ui32 CookRig(void* fileMemory, ui32 fileMemorySize, Skeleton skel, AnimationData animData, f32 pixelsPerMeter);
+b LoadCookedRig(Skeleton&& skel, AnimationData&& animData, bgz::Memory_Partition&& memPart, void* cookedFile, i32 cookedFileSize, f32 pixelsPerMeter);
+
+#endif
+
+#ifdef COOKED_RIG_IMPL
+
+template <typename Type>
+inline Type* _CookedRigAt(void* cookedFile, ui32 offset)
+{
+    return (Type*)((ui8*)cookedFile + offset);
+};
+
+struct _Cooked_Rig_Writer
+{
+    ui8* fileMemory;
+    ui32 size;
+    ui32 usedAmount;
+};
+
+//Returns the offset the data got written at. Everything is kept 8 byte aligned
+local_func ui32 _CookedRigWrite(_Cooked_Rig_Writer&& writer, const void* data, ui32 dataSize)
+{
+    ui32 offset = (writer.usedAmount + 7) & ~7u;
+    BGZ_ASSERT(offset + dataSize <= writer.size);//, "Not enough memory to cook rig!");
+
+    memset(writer.fileMemory + writer.usedAmount, 0, offset - writer.usedAmount);
+    if (data)
+        memcpy(writer.fileMemory + offset, data, dataSize);
+    else
+        memset(writer.fileMemory + offset, 0, dataSize);
+
+    writer.usedAmount = offset + dataSize;
+    return offset;
+};
+
+local_func ui32 _CookedRigWriteString(_Cooked_Rig_Writer&& writer, const char* string)
+{
+    if (NOT string)
+        string = "";
+
+    return _CookedRigWrite($(writer), string, (ui32)strlen(string) + 1);
+};
+
+template <typename TimelineType>
+local_func Cooked_Timeline _CookTimeline(TimelineType* timeline, i32 valuesCount)
+{
+    Cooked_Timeline result {};
+    result.exists = timeline->exists;
+    result.timesCount = timeline->timesCount;
+    result.curvesCount = timeline->curvesCount;
+    result.valuesCount = valuesCount;
+
+    for (i32 keyFrameIndex {}; keyFrameIndex < COOKED_RIG_MAX_KEYFRAMES; ++keyFrameIndex)
+    {
+        result.times[keyFrameIndex] = timeline->times[keyFrameIndex];
+        result.curves[keyFrameIndex] = (i32)timeline->curves[keyFrameIndex];
+    };
+
+    return result;
+};
+
+//Skeleton + anim data need to already be converted to game units and have their clips baked. Returns the size of the
+//cooked file written to fileMemory
+ui32 CookRig(void* fileMemory, ui32 fileMemorySize, Skeleton skel, AnimationData animData, f32 pixelsPerMeter)
+{
+    BGZ_ASSERT(sizeof(((RotationTimeline*)0)->times.elements) == sizeof(f32) * COOKED_RIG_MAX_KEYFRAMES);//, "Cooked timelines need updating!");
+
+    _Cooked_Rig_Writer writer { (ui8*)fileMemory, fileMemorySize, 0 };
+
+    ui32 headerOffset = _CookedRigWrite($(writer), nullptr, sizeof(Cooked_Rig_Header));
+
+    Cooked_Rig_Header header {};
+    header.magic = COOKED_RIG_MAGIC;
+    header.version = COOKED_RIG_VERSION;
+    header.pixelsPerMeter = pixelsPerMeter;
+    header.skelWidth = skel.width;
+    header.skelHeight = skel.height;
+
+    { //Bones
+        header.boneCount = skel.boneCount;
+
+        header.boneNameOffsets = _CookedRigWrite($(writer), nullptr, sizeof(ui32) * skel.boneCount);
+        for (i32 boneIndex {}; boneIndex < skel.boneCount; ++boneIndex)
+        {
+            ui32 nameOffset = _CookedRigWriteString($(writer), skel.setup->boneNames[boneIndex]);
+            _CookedRigAt<ui32>(writer.fileMemory, header.boneNameOffsets)[boneIndex] = nameOffset;
+        };
+
+        header.parentBoneIndices = _CookedRigWrite($(writer), skel.setup->parentBoneIndices, sizeof(i16) * skel.boneCount);
+        header.boneLengths = _CookedRigWrite($(writer), skel.setup->boneLengths, sizeof(f32) * skel.boneCount);
+        header.initialRotations_parentBoneSpace = _CookedRigWrite($(writer), skel.setup->initialRotations_parentBoneSpace, sizeof(f32) * skel.boneCount);
+        header.initialPositions_parentBoneSpace = _CookedRigWrite($(writer), skel.setup->initialPositions_parentBoneSpace, sizeof(v2) * skel.boneCount);
+        header.scales_parentBoneSpace = _CookedRigWrite($(writer), skel.pose.scales_parentBoneSpace, sizeof(v2) * skel.boneCount);
+    };
+
+    { //Slots
+        header.slotCount = (i32)bgz::Size(&skel.slots);
+        header.slots = _CookedRigWrite($(writer), nullptr, sizeof(Cooked_Slot) * header.slotCount);
+
+        for (i32 slotIndex {}; slotIndex < header.slotCount; ++slotIndex)
+        {
+            Slot* slot = &skel.slots[slotIndex];
+            Region_Attachment* attachment = &slot->regionAttachment;
+            AtlasRegion* region = &attachment->region_image;
+
+            Cooked_Slot cookedSlot {};
+            cookedSlot.nameOffset = _CookedRigWriteString($(writer), slot->name);
+            cookedSlot.boneIndex = slot->boneIndex;
+            cookedSlot.width = attachment->width;
+            cookedSlot.height = attachment->height;
+            cookedSlot.scale = attachment->scale;
+            cookedSlot.translation_parentBoneSpace = attachment->parentBoneSpace.translation;
+            cookedSlot.rotation_parentBoneSpace = attachment->parentBoneSpace.rotation;
+            cookedSlot.scale_parentBoneSpace = attachment->parentBoneSpace.scale;
+            cookedSlot.regionNameOffset = _CookedRigWriteString($(writer), region->name);
+            cookedSlot.x = region->x;
+            cookedSlot.y = region->y;
+            cookedSlot.width_pxls = region->width;
+            cookedSlot.height_pxls = region->height;
+            cookedSlot.u = region->u;
+            cookedSlot.v = region->v;
+            cookedSlot.u2 = region->u2;
+            cookedSlot.v2 = region->v2;
+            cookedSlot.offsetX = region->offsetX;
+            cookedSlot.offsetY = region->offsetY;
+            cookedSlot.originalWidth = region->originalWidth;
+            cookedSlot.originalHeight = region->originalHeight;
+            cookedSlot.index = region->index;
+            cookedSlot.rotate = region->rotate;
+            cookedSlot.flip = region->flip;
+
+            *_CookedRigAt<Cooked_Slot>(writer.fileMemory, header.slots + (sizeof(Cooked_Slot) * slotIndex)) = cookedSlot;
+        };
+    };
+
+    { //Animations
+        header.animCount = (i32)bgz::Size(&animData.animMap.animations);
+        header.anims = _CookedRigWrite($(writer), nullptr, sizeof(Cooked_Animation) * header.animCount);
+
+        for (i32 animIndex {}; animIndex < header.animCount; ++animIndex)
+        {
+            Animation* anim = &animData.animMap.animations[animIndex];
+            BGZ_ASSERT(anim->bakedClip.sampleCount > 1);//, "Clips need to be baked before cooking!");
+
+            Cooked_Animation cookedAnim {};
+            cookedAnim.nameOffset = _CookedRigWriteString($(writer), anim->name);
+            cookedAnim.totalTime = anim->totalTime;
+            cookedAnim.boneCount = anim->boneCount;
+
+            cookedAnim.hitBoxCount = anim->hitBoxes.length;
+            cookedAnim.hitBoxes = _CookedRigWrite($(writer), nullptr, sizeof(Cooked_HitBox) * cookedAnim.hitBoxCount);
+            for (i32 hitBoxIndex {}; hitBoxIndex < anim->hitBoxes.length; ++hitBoxIndex)
+            {
+                HitBox* hitBox = &anim->hitBoxes[hitBoxIndex];
+
+                Cooked_HitBox cookedHitBox {};
+                cookedHitBox.boneNameOffset = _CookedRigWriteString($(writer), hitBox->boneName);
+                cookedHitBox.worldPosOffset = hitBox->worldPosOffset;
+                cookedHitBox.size = hitBox->size;
+                cookedHitBox.endTime = hitBox->endTime;
+                cookedHitBox.duration = hitBox->duration;
+                cookedHitBox.timeUntilHitBoxIsActivated = hitBox->timeUntilHitBoxIsActivated;
+
+                *_CookedRigAt<Cooked_HitBox>(writer.fileMemory, cookedAnim.hitBoxes + (sizeof(Cooked_HitBox) * hitBoxIndex)) = cookedHitBox;
+            };
+
+            cookedAnim.rotationTimelines = _CookedRigWrite($(writer), nullptr, sizeof(Cooked_Timeline) * anim->boneCount);
+            cookedAnim.translationTimelines = _CookedRigWrite($(writer), nullptr, sizeof(Cooked_Timeline) * anim->boneCount);
+            for (i32 boneIndex {}; boneIndex < anim->boneCount; ++boneIndex)
+            {
+                RotationTimeline* rotationTimeline = &anim->boneRotationTimelines[boneIndex];
+                Cooked_Timeline cookedRotations = _CookTimeline(rotationTimeline, rotationTimeline->anglesCount);
+                for (i32 keyFrameIndex {}; keyFrameIndex < COOKED_RIG_MAX_KEYFRAMES; ++keyFrameIndex)
+                    cookedRotations.values[keyFrameIndex] = { rotationTimeline->angles[keyFrameIndex], 0.0f };
+
+                TranslationTimeline* translationTimeline = &anim->boneTranslationTimelines[boneIndex];
+                Cooked_Timeline cookedTranslations = _CookTimeline(translationTimeline, translationTimeline->translationCount);
+                for (i32 keyFrameIndex {}; keyFrameIndex < COOKED_RIG_MAX_KEYFRAMES; ++keyFrameIndex)
+                    cookedTranslations.values[keyFrameIndex] = translationTimeline->translations[keyFrameIndex];
+
+                _CookedRigAt<Cooked_Timeline>(writer.fileMemory, cookedAnim.rotationTimelines)[boneIndex] = cookedRotations;
+                _CookedRigAt<Cooked_Timeline>(writer.fileMemory, cookedAnim.translationTimelines)[boneIndex] = cookedTranslations;
+            };
+
+            Baked_Clip* clip = &anim->bakedClip;
+            cookedAnim.bakedSampleRate = clip->sampleRate;
+            cookedAnim.bakedSampleCount = clip->sampleCount;
+            cookedAnim.bakedRotations = _CookedRigWrite($(writer), clip->boneRotations, sizeof(f32) * clip->sampleCount * clip->boneCount);
+            cookedAnim.bakedTranslations = _CookedRigWrite($(writer), clip->boneTranslations, sizeof(v2) * clip->sampleCount * clip->boneCount);
+
+            *_CookedRigAt<Cooked_Animation>(writer.fileMemory, header.anims + (sizeof(Cooked_Animation) * animIndex)) = cookedAnim;
+        };
+    };
+
+    header.fileSize = writer.usedAmount;
+    *_CookedRigAt<Cooked_Rig_Header>(writer.fileMemory, headerOffset) = header;
+
+    return writer.usedAmount;
+};
+
+//Builds a skeleton + anim data that point into the (mapped) cooked file. Setup arrays, baked clips and all strings are
+//used in place, so the file needs to stay mapped for as long as the rig is in use. Keyframe timelines are the exception
+//and get copied into each Animation, see below. Returns false if the file is out of date and needs re-cooking
+b LoadCookedRig(Skeleton&& skel, AnimationData&& animData, bgz::Memory_Partition&& memPart, void* cookedFile, i32 cookedFileSize, f32 pixelsPerMeter)
+{
+    if (cookedFileSize < (i32)sizeof(Cooked_Rig_Header))
+        return false;
+
+    Cooked_Rig_Header* header = _CookedRigAt<Cooked_Rig_Header>(cookedFile, 0);
+    if (header->magic != COOKED_RIG_MAGIC || header->version != COOKED_RIG_VERSION || header->fileSize != (ui32)cookedFileSize || header->pixelsPerMeter != pixelsPerMeter)
+        return false;
+
+    const char* fileStrings = (const char*)cookedFile;
+
+    { //Skeleton
+        skel.width = header->skelWidth;
+        skel.height = header->skelHeight;
+        skel.boneCount = header->boneCount;
+
+        skel.setup = PushType(&memPart, Skeleton_Setup, 1);
+        *skel.setup = Skeleton_Setup {};
+        skel.setup->boneCount = header->boneCount;
+        skel.setup->parentBoneIndices = _CookedRigAt<i16>(cookedFile, header->parentBoneIndices);
+        skel.setup->boneLengths = _CookedRigAt<f32>(cookedFile, header->boneLengths);
+        skel.setup->initialRotations_parentBoneSpace = _CookedRigAt<f32>(cookedFile, header->initialRotations_parentBoneSpace);
+        skel.setup->initialPositions_parentBoneSpace = _CookedRigAt<v2>(cookedFile, header->initialPositions_parentBoneSpace);
+        skel.setup->originalCollisionBoxVerts = nullptr; //Only needed to size hit boxes, which are already cooked
+
+        skel.setup->boneNames = PushType(&memPart, const char*, header->boneCount);
+        ui32* boneNameOffsets = _CookedRigAt<ui32>(cookedFile, header->boneNameOffsets);
+        for (i32 boneIndex {}; boneIndex < header->boneCount; ++boneIndex)
+            skel.setup->boneNames[boneIndex] = fileStrings + boneNameOffsets[boneIndex];
+
+        skel.poseBlockSize = _SkeletonPoseBlockSize(header->boneCount);
+        skel.poseBlock = PushType(&memPart, ui8, skel.poseBlockSize);
+        memset(skel.poseBlock, 0, skel.poseBlockSize);
+        _PointPoseArraysAt($(skel.pose), skel.poseBlock, header->boneCount);
+
+        memcpy(skel.pose.scales_parentBoneSpace, _CookedRigAt<v2>(cookedFile, header->scales_parentBoneSpace), sizeof(v2) * header->boneCount);
+        ResetBonesToSetupPose($(skel));
+        for (i32 boneIndex {}; boneIndex < header->boneCount; ++boneIndex)
+            skel.pose.worldSpaceScales[boneIndex] = { 1.0f, 1.0f };
+
+        bgz::Init(&skel.slots, header->slotCount + 1);
+        Cooked_Slot* cookedSlots = _CookedRigAt<Cooked_Slot>(cookedFile, header->slots);
+        for (i32 slotIndex {}; slotIndex < header->slotCount; ++slotIndex)
+        {
+            Cooked_Slot* cookedSlot = &cookedSlots[slotIndex];
+
+            Slot slot {};
+            slot.name = (char*)fileStrings + cookedSlot->nameOffset;
+            slot.boneIndex = cookedSlot->boneIndex;
+            slot.regionAttachment.width = cookedSlot->width;
+            slot.regionAttachment.height = cookedSlot->height;
+            slot.regionAttachment.scale = cookedSlot->scale;
+            slot.regionAttachment.parentBoneSpace = Transform { cookedSlot->translation_parentBoneSpace, cookedSlot->rotation_parentBoneSpace, cookedSlot->scale_parentBoneSpace };
+
+            AtlasRegion* region = &slot.regionAttachment.region_image;
+            region->name = fileStrings + cookedSlot->regionNameOffset;
+            region->x = cookedSlot->x;
+            region->y = cookedSlot->y;
+            region->width = cookedSlot->width_pxls;
+            region->height = cookedSlot->height_pxls;
+            region->u = cookedSlot->u;
+            region->v = cookedSlot->v;
+            region->u2 = cookedSlot->u2;
+            region->v2 = cookedSlot->v2;
+            region->offsetX = cookedSlot->offsetX;
+            region->offsetY = cookedSlot->offsetY;
+            region->originalWidth = cookedSlot->originalWidth;
+            region->originalHeight = cookedSlot->originalHeight;
+            region->index = cookedSlot->index;
+            region->rotate = cookedSlot->rotate;
+            region->flip = cookedSlot->flip;
+
+            bgz::Push(skel.slots, slot);
+        };
+    };
+
+    { //Animations
+        InitAnimMap($(animData.animMap), $(memPart), header->animCount > 0 ? header->animCount : 1);
+
+        Cooked_Animation* cookedAnims = _CookedRigAt<Cooked_Animation>(cookedFile, header->anims);
+        for (i32 animIndex {}; animIndex < header->animCount; ++animIndex)
+        {
+            Cooked_Animation* cookedAnim = &cookedAnims[animIndex];
+            BGZ_ASSERT(cookedAnim->boneCount <= skel.boneCount);//, "Cooked animation has more bones than its skeleton!");
+
+            const char* animName = fileStrings + cookedAnim->nameOffset;
+            InsertAnimation($(animData.animMap), animName, Animation {});
+            Animation* anim = &bgz::LastElem(&animData.animMap.animations);
+
+            anim->name = animName;
+            anim->totalTime = cookedAnim->totalTime;
+            anim->skelSetup = skel.setup;
+            anim->boneCount = cookedAnim->boneCount;
+
+            Cooked_HitBox* cookedHitBoxes = _CookedRigAt<Cooked_HitBox>(cookedFile, cookedAnim->hitBoxes);
+            for (i32 hitBoxIndex {}; hitBoxIndex < cookedAnim->hitBoxCount; ++hitBoxIndex)
+            {
+                HitBox* hitBox = &anim->hitBoxes.Push();
+                hitBox->boneName = (char*)fileStrings + cookedHitBoxes[hitBoxIndex].boneNameOffset;
+                hitBox->worldPosOffset = cookedHitBoxes[hitBoxIndex].worldPosOffset;
+                hitBox->size = cookedHitBoxes[hitBoxIndex].size;
+                hitBox->endTime = cookedHitBoxes[hitBoxIndex].endTime;
+                hitBox->duration = cookedHitBoxes[hitBoxIndex].duration;
+                hitBox->timeUntilHitBoxIsActivated = cookedHitBoxes[hitBoxIndex].timeUntilHitBoxIsActivated;
+            };
+
+            //Keyframe timelines are still needed for mixing, which samples them directly. They're copied rather than pointed
+            //at: an Animation holds its timelines inline (the same Rotation/TranslationTimeline arrays the json loader fills
+            //and the mixer reads, with their sampling function pointers), so pointing into the file would mean turning
+            //those into pointers for every rig. It's ~7 KB per animation and a fraction of the load (yellow_god: ~.007 ms
+            //of the ~.03 ms warm load, see BenchmarkCookedRigLoading)
+            Cooked_Timeline* cookedRotationTimelines = _CookedRigAt<Cooked_Timeline>(cookedFile, cookedAnim->rotationTimelines);
+            Cooked_Timeline* cookedTranslationTimelines = _CookedRigAt<Cooked_Timeline>(cookedFile, cookedAnim->translationTimelines);
+            for (i32 boneIndex {}; boneIndex < cookedAnim->boneCount; ++boneIndex)
+            {
+                RotationTimeline* rotationTimeline = &anim->boneRotationTimelines[boneIndex];
+                Cooked_Timeline* cookedRotations = &cookedRotationTimelines[boneIndex];
+                rotationTimeline->GetTransformationVal = &GetTransformationVal_RotationTimeline;
+                rotationTimeline->exists = cookedRotations->exists;
+                rotationTimeline->timesCount = cookedRotations->timesCount;
+                rotationTimeline->curvesCount = cookedRotations->curvesCount;
+                rotationTimeline->anglesCount = cookedRotations->valuesCount;
+
+                TranslationTimeline* translationTimeline = &anim->boneTranslationTimelines[boneIndex];
+                Cooked_Timeline* cookedTranslations = &cookedTranslationTimelines[boneIndex];
+                translationTimeline->GetTransformationVal = &GetTransformationVal_TranslationTimeline;
+                translationTimeline->exists = cookedTranslations->exists;
+                translationTimeline->timesCount = cookedTranslations->timesCount;
+                translationTimeline->curvesCount = cookedTranslations->curvesCount;
+                translationTimeline->translationCount = cookedTranslations->valuesCount;
+
+                for (i32 keyFrameIndex {}; keyFrameIndex < COOKED_RIG_MAX_KEYFRAMES; ++keyFrameIndex)
+                {
+                    rotationTimeline->times[keyFrameIndex] = cookedRotations->times[keyFrameIndex];
+                    rotationTimeline->curves[keyFrameIndex] = (CurveType)cookedRotations->curves[keyFrameIndex];
+                    rotationTimeline->angles[keyFrameIndex] = cookedRotations->values[keyFrameIndex].x;
+
+                    translationTimeline->times[keyFrameIndex] = cookedTranslations->times[keyFrameIndex];
+                    translationTimeline->curves[keyFrameIndex] = (CurveType)cookedTranslations->curves[keyFrameIndex];
+                    translationTimeline->translations[keyFrameIndex] = cookedTranslations->values[keyFrameIndex];
+                };
+            };
+
+            anim->bakedClip.sampleRate = cookedAnim->bakedSampleRate;
+            anim->bakedClip.sampleCount = cookedAnim->bakedSampleCount;
+            anim->bakedClip.boneCount = cookedAnim->boneCount;
+            anim->bakedClip.boneRotations = _CookedRigAt<f32>(cookedFile, cookedAnim->bakedRotations);
+            anim->bakedClip.boneTranslations = _CookedRigAt<v2>(cookedFile, cookedAnim->bakedTranslations);
+        };
+    };
+
+    return true;
+};
+
+#endif //COOKED_RIG_IMPL
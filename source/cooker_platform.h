@@ -0,0 +1,161 @@
+#pragma once
+
+/*
+    Crt backed stand ins for the platform services the game code needs when it's run from an offline cooking tool
+    instead of the win64 platform layer. Include after gamecode.cpp.
+*/
+
+#include <time.h>
+#ifdef __linux__
+#include <sys/resource.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+local_func unsigned char* Cooker_ReadEntireFile(i32&& length, const char* filePath)
+{
+    FILE* file = fopen(filePath, "rb");
+    BGZ_ASSERT(file);//File path used is incorrect or doesn't exist!"
+
+    fseek(file, 0, SEEK_END);
+    length = (i32)ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char* data = (unsigned char*)malloc(length + 1);
+    fread(data, 1, length, file);
+    data[length] = 0;
+
+    fclose(file);
+
+    return data;
+};
+
+local_func bool Cooker_WriteEntireFile(const char* filePath, void* memory, ui32 memorySize)
+{
+    FILE* file = fopen(filePath, "wb");
+    if (NOT file)
+        return false;
+
+    bool result = fwrite(memory, 1, memorySize, file) == memorySize;
+    fclose(file);
+
+    return result;
+};
+
+local_func void Cooker_FreeFileMemory(void* fileMemory)
+{
+    free(fileMemory);
+};
+
+//No mapping here, the file is just read into a zero terminated copy (which is all callers can tell apart anyway)
+local_func void* Cooker_MapEntireFile(i32&& length, const char* filePath)
+{
+    length = 0;
+
+    FILE* file = fopen(filePath, "rb");
+    if (NOT file)
+        return nullptr;
+
+    fseek(file, 0, SEEK_END);
+    i32 fileSize = (i32)ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char* data = (unsigned char*)malloc(fileSize + 1);
+    if (data && fread(data, 1, fileSize, file) == (sizet)fileSize)
+    {
+        data[fileSize] = 0;
+        length = fileSize;
+    }
+    else
+    {
+        free(data);
+        data = nullptr;
+    };
+
+    fclose(file);
+
+    return data;
+};
+
+local_func void Cooker_UnmapFile(void* mappedFile)
+{
+    free(mappedFile);
+};
+
+local_func void* Cooker_Malloc(sizet size)
+{
+    return malloc(size);
+};
+
+local_func void* Cooker_Calloc(sizet count, sizet size)
+{
+    return calloc(count, size);
+};
+
+local_func void* Cooker_Realloc(void* ptr, sizet size)
+{
+    return realloc(ptr, size);
+};
+
+local_func void Cooker_Free(void* ptr)
+{
+    free(ptr);
+};
+
+local_func f64 Cooker_CurrentTimeInSecs()
+{
+    return (f64)clock() / (f64)CLOCKS_PER_SEC;
+};
+
+#ifdef __linux__
+local_func i64 Cooker_PeakMemoryUsage()
+{
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return (i64)usage.ru_maxrss * 1024; //Kilobytes on linux
+};
+
+//Same counter `perf stat -e cache-misses` reads, user space only. Vms often don't pass the cpu's counters through, in which
+//case opening it fails and this returns -1
+local_func i64 Cooker_ReadCacheMissCount()
+{
+    local_persist int counterFile { -2 };
+    if (counterFile == -2)
+    {
+        perf_event_attr counter {};
+        counter.size = sizeof(counter);
+        counter.type = PERF_TYPE_HARDWARE;
+        counter.config = PERF_COUNT_HW_CACHE_MISSES;
+        counter.exclude_kernel = 1;
+        counter.exclude_hv = 1;
+        counterFile = (int)syscall(SYS_perf_event_open, &counter, 0, -1, -1, 0);
+    };
+
+    i64 missCount {};
+    if (counterFile < 0 || read(counterFile, &missCount, sizeof(missCount)) != sizeof(missCount))
+        return -1;
+
+    return missCount;
+};
+#endif
+
+local_func void Cooker_InitPlatformServices(Platform_Services&& platformServices)
+{
+    platformServices = Platform_Services {};
+    platformServices.ReadEntireFile = &Cooker_ReadEntireFile;
+    platformServices.WriteEntireFile = &Cooker_WriteEntireFile;
+    platformServices.FreeFileMemory = &Cooker_FreeFileMemory;
+    platformServices.Malloc = &Cooker_Malloc;
+    platformServices.Calloc = &Cooker_Calloc;
+    platformServices.Realloc = &Cooker_Realloc;
+    platformServices.Free = &Cooker_Free;
+    platformServices.CurrentTimeInSecs = &Cooker_CurrentTimeInSecs;
+#ifdef __linux__
+    platformServices.PeakMemoryUsage = &Cooker_PeakMemoryUsage;
+    platformServices.ReadCacheMissCount = &Cooker_ReadCacheMissCount;
+#endif
+    platformServices.MapEntireFile = &Cooker_MapEntireFile;
+    platformServices.UnmapFile = &Cooker_UnmapFile;
+    globalPlatformServices = &platformServices;
+};
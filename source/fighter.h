@@ -20,6 +20,12 @@ struct Fighter
 };
 
 void InitFighter(Fighter&& fighter, AnimationData animData, Skeleton skel, f32 fighterHeight, HurtBox defaultHurtBox,v2 worldPos, b flipX);
+//Joint markers for every bone plus the hurt box outline. Only writes to cmdBuffer so different fighters can be recorded
+//on different threads (see BeginRenderCmdSubBuffer)
+void RecordFighterDebugDraw(RenderCmdBuffer* cmdBuffer, const Fighter& fighter, f32 depth);
+#if DEVELOPMENT_BUILD
+void BenchmarkParallelCmdRecording(bgz::Memory_Partition&& memPart, const Fighter& fighter, i32 fighterCount);
+#endif
 
 #endif
 
@@ -33,6 +39,12 @@ void InitFighter(Fighter&& fighter, AnimationData animData, Skeleton skel, f32 f
     fighter.height = fighterHeight;
     fighter.hurtBox = defaultHurtBox;
     
+    //Skeleton setup data and animations can be shared by several fighters (see asset_cache.h) so only the first fighter on a rig adjusts them
+    b adjustSharedRigData = skel.setup->adjustedToFighterHeight == 0.0f;
+    BGZ_ASSERT(adjustSharedRigData || (skel.setup->adjustedToFighterHeight == fighterHeight && skel.setup->adjustedToFlipX == flipX));//, "Fighters sharing a rig need the same height and flip!");
+    skel.setup->adjustedToFighterHeight = fighterHeight;
+    skel.setup->adjustedToFlipX = flipX;
+    
     f32 scaleFactorForHeightAdjustment {};
     { //Change fighter height
         f32 aspectRatio = fighter.skel.height / fighter.skel.width;
@@ -42,14 +54,18 @@ void InitFighter(Fighter&& fighter, AnimationData animData, Skeleton skel, f32 f
         fighter.skel.height = fighter.height;
         fighter.skel.width = aspectRatio * fighter.height;
         
-        for (i32 boneIndex {}; boneIndex < bgz::Size(&fighter.skel.bones); ++boneIndex)
+        for (i32 boneIndex {}; boneIndex < fighter.skel.boneCount; ++boneIndex)
         {
-            fighter.skel.bones[boneIndex].worldSpace.scale = fighter.world.scale;
-            fighter.skel.bones[boneIndex].parentBoneSpace.translation.x *= (scaleFactorForHeightAdjustment * fighter.world.scale.x);
-            fighter.skel.bones[boneIndex].parentBoneSpace.translation.y *= (scaleFactorForHeightAdjustment * fighter.world.scale.y);
-            fighter.skel.bones[boneIndex].initialPos_parentBoneSpace.x *= (scaleFactorForHeightAdjustment * fighter.world.scale.x);
-            fighter.skel.bones[boneIndex].initialPos_parentBoneSpace.y *= (scaleFactorForHeightAdjustment * fighter.world.scale.y);
-            fighter.skel.bones[boneIndex].length *= (scaleFactorForHeightAdjustment * fighter.world.scale.x);
+            fighter.skel.pose.worldSpaceScales[boneIndex] = fighter.world.scale;
+            fighter.skel.pose.translations_parentBoneSpace[boneIndex].x *= (scaleFactorForHeightAdjustment * fighter.world.scale.x);
+            fighter.skel.pose.translations_parentBoneSpace[boneIndex].y *= (scaleFactorForHeightAdjustment * fighter.world.scale.y);
+            
+            if (adjustSharedRigData)
+            {
+                fighter.skel.setup->initialPositions_parentBoneSpace[boneIndex].x *= (scaleFactorForHeightAdjustment * fighter.world.scale.x);
+                fighter.skel.setup->initialPositions_parentBoneSpace[boneIndex].y *= (scaleFactorForHeightAdjustment * fighter.world.scale.y);
+                fighter.skel.setup->boneLengths[boneIndex] *= (scaleFactorForHeightAdjustment * fighter.world.scale.x);
+            };
         };
         
         for (i32 slotI {}; slotI < bgz::Size(&fighter.skel.slots); ++slotI)
@@ -60,7 +76,7 @@ void InitFighter(Fighter&& fighter, AnimationData animData, Skeleton skel, f32 f
             fighter.skel.slots[slotI].regionAttachment.parentBoneSpace.translation.y *= (scaleFactorForHeightAdjustment * fighter.world.scale.y);
         };
         
-        for (i32 animIndex {}; animIndex < bgz::Size(&fighter.animData.animMap.animations); ++animIndex)
+        for (i32 animIndex {}; adjustSharedRigData && animIndex < bgz::Size(&fighter.animData.animMap.animations); ++animIndex)
         {
             Animation* anim = (Animation*)&fighter.animData.animMap.animations[animIndex];
             
@@ -80,13 +96,13 @@ void InitFighter(Fighter&& fighter, AnimationData animData, Skeleton skel, f32 f
     
     { //Adjust animations to new height standards
         //TODO: Very stupid, move out or change as I'm currently iterating over ALL keyInfos for which there are a lot in my current hashMap_Str class
-        for (i32 animIndex {}; animIndex < bgz::Size(&fighter.animData.animMap.animations); ++animIndex)
+        for (i32 animIndex {}; adjustSharedRigData && animIndex < bgz::Size(&fighter.animData.animMap.animations); ++animIndex)
         {
             Animation anim = fighter.animData.animMap.animations[animIndex];
             
             if (anim.name)
             {
-                for (i32 boneIndex {}; boneIndex < bgz::Size(&fighter.skel.bones); ++boneIndex)
+                for (i32 boneIndex {}; boneIndex < fighter.skel.boneCount; ++boneIndex)
                 {
                     TranslationTimeline* translationTimeline = &anim.boneTranslationTimelines[boneIndex];
                     
@@ -99,6 +115,15 @@ void InitFighter(Fighter&& fighter, AnimationData animData, Skeleton skel, f32 f
                         };
                     };
                 };
+                
+                //Clips from a cooked rig come already baked (from the unadjusted keyframes), so their poses get the same scale.
+                //Json loaded clips aren't baked until after this (see GameUpdate) and skip this
+                Baked_Clip bakedClip = anim.bakedClip;
+                for (i32 sampleIndex {}; sampleIndex < bakedClip.sampleCount * bakedClip.boneCount; ++sampleIndex)
+                {
+                    bakedClip.boneTranslations[sampleIndex].x *= (scaleFactorForHeightAdjustment * fighter.world.scale.x);
+                    bakedClip.boneTranslations[sampleIndex].y *= (scaleFactorForHeightAdjustment * fighter.world.scale.y);
+                };
             };
         };
     };
@@ -106,17 +131,17 @@ void InitFighter(Fighter&& fighter, AnimationData animData, Skeleton skel, f32 f
     //Flip skeleton bones world positions/rotations
     if (flipX)
     {
-        for (i32 i {}; i < bgz::Size(&fighter.skel.bones); ++i)
+        for (i32 i {}; i < fighter.skel.boneCount; ++i)
         {
-            if (fighter.skel.bones[i].isRoot)
-                fighter.skel.bones[i].parentBoneSpace.scale.x = -1.0f;
+            if (fighter.skel.setup->parentBoneIndices[i] < 0) //Root
+                fighter.skel.pose.scales_parentBoneSpace[i].x = -1.0f;
             else
-                fighter.skel.bones[i].worldSpace.scale.y = -1.0f;
+                fighter.skel.pose.worldSpaceScales[i].y = -1.0f;
         };
         
         UpdateSkeletonBoneWorldTransforms($(fighter.skel), fighter.world.translation);
         
-        for (i32 animIndex {}; animIndex < bgz::Size(&fighter.animData.animMap.animations); ++animIndex)
+        for (i32 animIndex {}; adjustSharedRigData && animIndex < bgz::Size(&fighter.animData.animMap.animations); ++animIndex)
         {
             Animation* anim = &fighter.animData.animMap.animations[animIndex];
             
@@ -132,4 +157,148 @@ void InitFighter(Fighter&& fighter, AnimationData animData, Skeleton skel, f32 f
     }
 };
 
+local_func void _RecordDebugRect(RenderCmdBuffer* cmdBuffer, v2 min, v2 size, f32 depth, Color color)
+{
+    Rect rect = CreateRect(size.x, size.y, min, Origin::BOTTOM_LEFT, color);
+    rect._worldTransform.translation.x = min.x;
+    rect._worldTransform.translation.y = min.y;
+    GPUCmd_DrawRect(cmdBuffer, rect, depth, 0);
+};
+
+void RecordFighterDebugDraw(RenderCmdBuffer* cmdBuffer, const Fighter& fighter, f32 depth)
+{
+    const Skeleton& skel = fighter.skel;
+    
+    v2 jointSize = { .1f, .1f };
+    for (i32 boneIndex {}; boneIndex < skel.boneCount; ++boneIndex)
+        _RecordDebugRect(cmdBuffer, skel.pose.worldSpaceTranslations[boneIndex] - jointSize / 2.0f, jointSize, depth, Color { 255, 255, 0, 255 });
+    
+    AABB bounds = fighter.hurtBox.bounds;
+    v2 boundsSize = bounds.maxCorner - bounds.minCorner;
+    f32 thickness = .05f;
+    Color hurtBoxColor { 0, 0, 255, 255 };
+    _RecordDebugRect(cmdBuffer, bounds.minCorner, v2 { thickness, boundsSize.y }, depth, hurtBoxColor);
+    _RecordDebugRect(cmdBuffer, v2 { bounds.maxCorner.x - thickness, bounds.minCorner.y }, v2 { thickness, boundsSize.y }, depth, hurtBoxColor);
+    _RecordDebugRect(cmdBuffer, bounds.minCorner, v2 { boundsSize.x, thickness }, depth, hurtBoxColor);
+    _RecordDebugRect(cmdBuffer, v2 { bounds.minCorner.x, bounds.maxCorner.y - thickness }, v2 { boundsSize.x, thickness }, depth, hurtBoxColor);
+};
+
+#if DEVELOPMENT_BUILD
+struct _Fighter_Recording_Job
+{
+    RenderCmdBuffer subBuffer;
+    const Fighter* fighter;
+    i32 firstFighter;
+    i32 fighterCount;
+};
+
+local_func PLATFORM_WORK_QUEUE_CALLBACK(_RecordFighterBatchWork)
+{
+    _Fighter_Recording_Job* job = (_Fighter_Recording_Job*)data;
+    for (i32 fighterIndex { job->firstFighter }; fighterIndex < job->firstFighter + job->fighterCount; ++fighterIndex)
+        RecordFighterDebugDraw(&job->subBuffer, *job->fighter, (f32)fighterIndex * .01f);
+};
+
+//Only rects get recorded here so every entry is a RenderEntry_DrawRect
+local_func b _SameRectCommands(const RenderCmdBuffer& a, const RenderCmdBuffer& b)
+{
+    if (a.entryCount != b.entryCount)
+        return false;
+    
+    Render_Sort_Entry* aSortEntries = (Render_Sort_Entry*)(a.baseAddress + a.size);
+    Render_Sort_Entry* bSortEntries = (Render_Sort_Entry*)(b.baseAddress + b.size);
+    for (i32 entryIndex { 1 }; entryIndex <= a.entryCount; ++entryIndex)
+    {
+        Render_Sort_Entry aSortEntry = aSortEntries[-entryIndex], bSortEntry = bSortEntries[-entryIndex];
+        if (aSortEntry.key != bSortEntry.key || aSortEntry.drawOrder != bSortEntry.drawOrder || memcmp(a.baseAddress + aSortEntry.entryOffset, b.baseAddress + bSortEntry.entryOffset, sizeof(RenderEntry_DrawRect)) != 0)
+            return false;
+    };
+    
+    return true;
+};
+
+//Records debug draw for fighterCount copies of a fighter on the game thread, then again split into batches that are
+//recorded into sub-buffers on the work queue with 1 to max worker threads (plus the game thread helping) and merged.
+//The merged frame has to match the serial one exactly
+void BenchmarkParallelCmdRecording(bgz::Memory_Partition&& memPart, const Fighter& fighter, i32 fighterCount)
+{
+    bgz::ScopedMemory scopeMemory(&memPart);
+    
+    const i32 batchCount = 64; //Same batches for every thread count so they all record the exact same sub-buffers
+    const i32 runs = 20;
+    
+    RenderCmdBuffer serialBuffer {}, parallelBuffer {};
+    serialBuffer.size = parallelBuffer.size = (s32)Megabytes(16);
+    serialBuffer.baseAddress = (u8*)PushSize(&memPart, serialBuffer.size);
+    parallelBuffer.baseAddress = (u8*)PushSize(&memPart, parallelBuffer.size);
+    
+    //Entries have padding. Zeroing both up front lets the two frames be compared byte for byte
+    memset(serialBuffer.baseAddress, 0, serialBuffer.size);
+    memset(parallelBuffer.baseAddress, 0, parallelBuffer.size);
+    
+    f64 serialSecs { 1e9 };
+    for (i32 run {}; run < runs; ++run)
+    {
+        serialBuffer.usedAmount = 0;
+        serialBuffer.entryCount = 0;
+        
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 fighterIndex {}; fighterIndex < fighterCount; ++fighterIndex)
+            RecordFighterDebugDraw(&serialBuffer, fighter, (f32)fighterIndex * .01f);
+        f64 secs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        serialSecs = secs < serialSecs ? secs : serialSecs;
+    };
+    
+    BGZ_CONSOLE("Cmd recording bench (%d fighters, %d entries, %d batches): serial %.3f ms\n", fighterCount, serialBuffer.entryCount, batchCount,
+                serialSecs * 1000.0);
+    
+    s32 bytesPerFighter = (serialBuffer.usedAmount + serialBuffer.entryCount * (s32)sizeof(Render_Sort_Entry)) / fighterCount;
+    i32 fightersPerBatch = (fighterCount + batchCount - 1) / batchCount;
+    _Fighter_Recording_Job* jobs = PushType(&memPart, _Fighter_Recording_Job, batchCount);
+    
+    for (i32 threadCount { 1 }; threadCount <= globalPlatformServices->maxWorkerThreadCount; ++threadCount)
+    {
+        globalPlatformServices->SetWorkerThreadCount(threadCount);
+        
+        f64 parallelSecs { 1e9 }, mergeSecs {};
+        for (i32 run {}; run < runs; ++run)
+        {
+            parallelBuffer.usedAmount = 0;
+            parallelBuffer.entryCount = 0;
+            
+            f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+            for (i32 batchIndex {}; batchIndex < batchCount; ++batchIndex)
+            {
+                _Fighter_Recording_Job* job = &jobs[batchIndex];
+                job->fighter = &fighter;
+                job->firstFighter = batchIndex * fightersPerBatch;
+                job->fighterCount = fighterCount - job->firstFighter < fightersPerBatch ? fighterCount - job->firstFighter : fightersPerBatch;
+                job->fighterCount = job->fighterCount < 0 ? 0 : job->fighterCount;
+                job->subBuffer = BeginRenderCmdSubBuffer(&parallelBuffer, bytesPerFighter * fightersPerBatch + 64);
+                globalPlatformServices->AddWorkQueueEntry(&_RecordFighterBatchWork, job);
+            };
+            globalPlatformServices->FinishAllWork();
+            
+            f64 mergeStartTime = globalPlatformServices->CurrentTimeInSecs();
+            for (i32 batchIndex {}; batchIndex < batchCount; ++batchIndex)
+                MergeRenderCmdSubBuffer(&parallelBuffer, &jobs[batchIndex].subBuffer);
+            f64 endTime = globalPlatformServices->CurrentTimeInSecs();
+            
+            if (endTime - startTime < parallelSecs)
+            {
+                parallelSecs = endTime - startTime;
+                mergeSecs = endTime - mergeStartTime;
+            };
+        };
+        
+        BGZ_ASSERT(_SameRectCommands(serialBuffer, parallelBuffer));//, "Merged sub-buffers don't match recording serially!");
+        BGZ_CONSOLE("Cmd recording bench: %d worker threads %.3f ms (%.2fx serial, %.3f ms of that merging)\n", threadCount, parallelSecs * 1000.0,
+                    serialSecs / parallelSecs, mergeSecs * 1000.0);
+    };
+    
+    globalPlatformServices->SetWorkerThreadCount(globalPlatformServices->maxWorkerThreadCount);
+};
+#endif
+
 #endif //FIGHTER_IMPL
\ No newline at end of file
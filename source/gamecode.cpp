@@ -7,11 +7,17 @@
 #if (DEVELOPMENT_BUILD)
 #define BGZ_LOGGING_ON true
 #define BGZ_ERRHANDLING_ON true
+#define RUN_BENCHMARKS_ON_STARTUP false //Logs results to console once game memory is initialized
+#define SHOW_GPU_STATS false //Draws the renderer's last frame stats on screen and logs them when they change
 #else
 #define BGZ_LOGGING_ON false
 #define BGZ_ERRHANDLING_ON false
+#define RUN_BENCHMARKS_ON_STARTUP false
+#define SHOW_GPU_STATS false
 #endif
 
+#define STRESS_RECT_COUNT 100 //Rects pushed every frame to load up the renderer
+
 #define _CRT_SECURE_NO_WARNINGS // to surpress things like 'use printf_s func instead!'
 
 #define BGZ_MAX_CONTEXTS 10000
@@ -76,6 +82,14 @@ global_variable i32 renderBuffer;
 #include "2d_animation.h"
 #define FIGHTER_IMPL
 #include "fighter.h"
+#define COOKED_RIG_IMPL
+#include "cooked_rig.h"
+#define ASSET_CACHE_IMPL
+#include "asset_cache.h"
+#define TEXTURE_CACHE_IMPL
+#include "texture_cache.h"
+#define TILED_IMAGE_IMPL
+#include "tiled_image.h"
 #define GAME_RENDERER_STUFF_IMPL
 #include "renderer_stuff.h"
 #define MY_MATH_IMPL
@@ -246,67 +260,6 @@ Quad ParentTransform(Quad localCoords, Transform transformInfo_world)
 
 extern "C" void GameUpdate(bgz::MemoryBlock* gameMemory, Platform_Services* platformServices, Rendering_Info* renderingInfo, Game_Sound_Output_Buffer* soundOutput, Game_Input* gameInput)
 {
-    auto TranslateCurrentMeasurementsToGameUnits = [](Skeleton&& skel, AnimationData&& animData) {
-        f32 pixelsPerMeter { global_renderingInfo->_pixelsPerMeter };
-        
-        skel.width /= pixelsPerMeter;
-        skel.height /= pixelsPerMeter;
-        
-        for (i32 boneIndex {}; boneIndex < bgz::Size(&skel.bones); ++boneIndex)
-        {
-            skel.bones[boneIndex].parentBoneSpace.translation.x /= pixelsPerMeter;
-            skel.bones[boneIndex].parentBoneSpace.translation.y /= pixelsPerMeter;
-            skel.bones[boneIndex].initialPos_parentBoneSpace.x /= pixelsPerMeter;
-            skel.bones[boneIndex].initialPos_parentBoneSpace.y /= pixelsPerMeter;
-            
-            skel.bones[boneIndex].parentBoneSpace.rotation = Radians(skel.bones[boneIndex].parentBoneSpace.rotation);
-            skel.bones[boneIndex].initialRotation_parentBoneSpace = Radians(skel.bones[boneIndex].initialRotation_parentBoneSpace);
-            
-            skel.bones[boneIndex].length /= pixelsPerMeter;
-        };
-        
-        for (i32 slotI {}; slotI < bgz::Size(&skel.slots); ++slotI)
-        {
-            skel.slots[slotI].regionAttachment.height /= pixelsPerMeter;
-            skel.slots[slotI].regionAttachment.width /= pixelsPerMeter;
-            skel.slots[slotI].regionAttachment.parentBoneSpace.rotation = Radians(skel.slots[slotI].regionAttachment.parentBoneSpace.rotation);
-            skel.slots[slotI].regionAttachment.parentBoneSpace.translation.x /= pixelsPerMeter;
-            skel.slots[slotI].regionAttachment.parentBoneSpace.translation.y /= pixelsPerMeter;
-        };
-        
-        for (i32 animIndex {}; animIndex < bgz::Size(&animData.animMap.animations); ++animIndex)
-        {
-            Animation* anim = &animData.animMap.animations[animIndex];
-            
-            if (anim->name)
-            {
-                for (i32 boneIndex {}; boneIndex < anim->bones.Size(); ++boneIndex)
-                {
-                    TranslationTimeline* boneTranslationTimeline = &anim->boneTranslationTimelines[boneIndex];
-                    for (i32 keyFrameIndex {}; keyFrameIndex < boneTranslationTimeline->translations.Size(); ++keyFrameIndex)
-                    {
-                        boneTranslationTimeline->translations[keyFrameIndex].x /= pixelsPerMeter;
-                        boneTranslationTimeline->translations[keyFrameIndex].y /= pixelsPerMeter;
-                    }
-                    
-                    RotationTimeline* boneRotationTimeline = &anim->boneRotationTimelines[boneIndex];
-                    for (i32 keyFrameIndex {}; keyFrameIndex < boneRotationTimeline->angles.Size(); ++keyFrameIndex)
-                    {
-                        boneRotationTimeline->angles[keyFrameIndex] = Radians(boneRotationTimeline->angles[keyFrameIndex]);
-                    }
-                };
-                
-                for (i32 hitBoxIndex {}; hitBoxIndex < anim->hitBoxes.length; ++hitBoxIndex)
-                {
-                    anim->hitBoxes[hitBoxIndex].size.width /= pixelsPerMeter;
-                    anim->hitBoxes[hitBoxIndex].size.height /= pixelsPerMeter;
-                    anim->hitBoxes[hitBoxIndex].worldPosOffset.x /= pixelsPerMeter;
-                    anim->hitBoxes[hitBoxIndex].worldPosOffset.y /= pixelsPerMeter;
-                };
-            };
-        }
-    };
-    
     const Game_Controller* keyboard = &gameInput->Controllers[0];
     const Game_Controller* gamePad = &gameInput->Controllers[1];
     
@@ -333,11 +286,13 @@ extern "C" void GameUpdate(bgz::MemoryBlock* gameMemory, Platform_Services* plat
         
         *gState = {}; //Make sure everything gets properly defaulted/Initialized (constructors are called that need to be)
         
-        //Stage Init
-        stage->backgroundImg = LoadBitmap_BGRA("data/4k.jpg");
-        stage->size.height = 40.0f;
-        stage->size.width = WidthInMeters(stage->backgroundImg, stage->size.height);
-        stage->centerPoint = { (f32)WidthInMeters(stage->backgroundImg, stage->size.height) / 2, (f32)stage->size.height / 2 };
+        //Kick off level asset loads first so decoding/parsing happens on the worker threads while the rest of init runs.
+        //Both fighters share one rig so the files are only read, parsed and converted to game units once
+        Rig_Asset* playerRig = AcquireRigAsync($(gState->assetCache), $(*levelPart), "data/yellow_god.atlas", "data/yellow_god.json", global_renderingInfo->_pixelsPerMeter);
+        Rig_Asset* enemyRig = AcquireRigAsync($(gState->assetCache), $(*levelPart), "data/yellow_god.atlas", "data/yellow_god.json", global_renderingInfo->_pixelsPerMeter);
+        Font_Asset* fontAsset = LoadFontAsync($(gState->assetCache), global_renderingInfo, "data/arial.ttf", 18);
+        
+        gState->textureCache.diskCacheDir = "data/texture_cache";
         
         //Init renderer
         GPU_InitRenderer(global_renderingInfo, 60.0f/*fov*/, 16.0f/9.0f/*aspect*/, .1f/*nearPlane*/, 100.0f/*farPlane*/);
@@ -348,17 +303,33 @@ extern "C" void GameUpdate(bgz::MemoryBlock* gameMemory, Platform_Services* plat
         camera3d->rotation = {0.0f, 0.0f, 0.0f};
         GPU_SetCamera3D(global_renderingInfo, camera3d->worldPos, camera3d->rotation);
         
-        //Read in data
-        Skeleton playerSkel {}, enemySkel {};
-        AnimationData playerAnimData {}, enemyAnimData {};
-        InitSkel($(playerSkel), $(*levelPart), "data/yellow_god.atlas", "data/yellow_god.json"); //TODO: In order to reduce the amount of time reading from json file think about how to implement one common skeleton/animdata file(s)
-        InitSkel($(enemySkel), $(*levelPart), "data/yellow_god.atlas", "data/yellow_god.json");
-        InitAnimData($(playerAnimData), $(*levelPart), "data/yellow_god.json", playerSkel);
-        InitAnimData($(enemyAnimData), $(*levelPart), "data/yellow_god.json", enemySkel);
+        GPUCmd_SendCubeVertexData(global_renderingInfo, &global_renderingInfo->gameCmdBuffer, levelPart, Color{255, 0, 0, 255}/*initial color*/);
+        gState->myCube = CreateCube(v3{1.0f, 1.0f, 1.0f}/*radius*/, v3{0.0f, 0.0f, 0.0f}/*translation*/, Color{255, 0, 0, 255}/*color*/);
+        
+        GPUCmd_SendRectVertexData(renderingInfo, &renderingInfo->gameCmdBuffer, levelPart, Color{255, 0, 0});
+        gState->myRect = CreateRect(1.0f, 1.0f, v2{0.0f, 0.0f}, Origin::BOTTOM_LEFT, Color{255, 0, 0});
+        
+        //Stage Init. Background is streamed in tile by tile from the cooked .tiles file (see tile_cooker) based on what the camera can see
+        stage->size.height = 40.0f;
+        if (LoadTiledBackground($(stage->background), "data/4k.tiles", stage->size.height))
+        {
+            stage->size.width = stage->background.size_meters.x;
+        }
+        else
+        {
+            stage->backgroundTexture = AcquireTexture($(gState->textureCache), &global_renderingInfo->gameCmdBuffer, "data/4k.jpg");
+            f32 backgroundAspectRatio = stage->backgroundTexture ? stage->backgroundTexture->mips[0].aspectRatio : 16.0f / 9.0f;
+            stage->size.width = stage->size.height * backgroundAspectRatio;
+        };
+        stage->centerPoint = { stage->size.width / 2, stage->size.height / 2 };
+        stage->camera.lookAt = stage->centerPoint;
+        stage->camera.zoomFactor = 1.0f;
         
-        //Translate pixels to meters and degrees to radians (since spine exports everything in pixel/degree units)
-        TranslateCurrentMeasurementsToGameUnits($(playerSkel), $(playerAnimData));
-        TranslateCurrentMeasurementsToGameUnits($(enemySkel), $(enemyAnimData));
+        AwaitLoad(playerRig);
+        AwaitLoad(enemyRig);
+        Skeleton playerSkel = InstantiateSkeleton(playerRig, $(*levelPart));
+        Skeleton enemySkel = InstantiateSkeleton(enemyRig, $(*levelPart));
+        AnimationData playerAnimData = playerRig->animData, enemyAnimData = enemyRig->animData;
         
         //Init fighters
         v2 playerWorldPos = { (stage->size.width / 2.0f) - 6.0f, 3.0f }, enemyWorldPos = { (stage->size.width / 2.0f) + 6.0f, 3.0f };
@@ -367,23 +338,64 @@ extern "C" void GameUpdate(bgz::MemoryBlock* gameMemory, Platform_Services* plat
         InitFighter($(*player), playerAnimData, playerSkel, /*player height*/ playerSkel.height, playerDefaultHurtBox, playerWorldPos, /*flipX*/ false );
         InitFighter($(*enemy), enemyAnimData, enemySkel, /*player height*/ enemySkel.height, enemyDefaultHurtBox, enemyWorldPos, /*flipX*/ false );
         
+        //Bake after all keyframe adjustments above so baked poses match what the keyframes would produce. Cooked rigs come
+        //with their clips baked, which InitFighter scales along with the keyframes (BakeAnimationClips skips them)
+        BakeAnimationClips($(player->animData), $(*levelPart));
+        BakeAnimationClips($(enemy->animData), $(*levelPart));
+        
+#if RUN_BENCHMARKS_ON_STARTUP
+        BenchmarkAnimationSamplers(player->animData, "data/yellow_god.json", 100000);
+        BenchmarkBatchPoseSampling(GetAnimation(player->animData.animMap, "run"), $(*framePart));
+        BenchmarkAnimationLookup(player->animData, $(*framePart), 100000);
+        BenchmarkSkeletonWorldTransforms(&player->skel, "data/yellow_god.json", $(*framePart), 100000);
+        BenchmarkRigLoading($(*framePart), "data/yellow_god.atlas", "data/yellow_god.json", global_renderingInfo->_pixelsPerMeter);
+        BenchmarkJsonParsing($(*framePart), 100);
+        BenchmarkCookedRigLoading($(*framePart), "data/yellow_god.atlas", "data/yellow_god.json", global_renderingInfo->_pixelsPerMeter);
+        BenchmarkAtlasRegionLookup("data", "yellow_god.png", 10000, 100);
+        BenchmarkBitmapPremultiply("data/1080p.jpg", 10);
+        BenchmarkBitmapPremultiply("data/4k.jpg", 10);
+        BenchmarkLevelLoading($(*framePart), "data/yellow_god.atlas", "data/yellow_god.json", global_renderingInfo->_pixelsPerMeter);
+        BenchmarkTextureCache($(*framePart), "data/texture_cache");
+        BenchmarkTiledBackgroundZoom($(*framePart), "data/4k.tiles", stage->size.height, global_renderingInfo->heightOfScreen_pixels, global_renderingInfo->_pixelsPerMeter);
+        BenchmarkParallelCmdRecording($(*framePart), *player, 512);
+#endif
+        
         MixAnimations($(player->animData), "idle", "walk", .2f);
         MixAnimations($(player->animData), "walk", "run", .2f);
         MixAnimations($(player->animData), "right-jab", "idle", .1f);
         
-        SetIdleAnimation($(player->animQueue), player->animData, "idle");
-        SetIdleAnimation($(enemy->animQueue), enemy->animData, "idle");
-        
-        GPUCmd_SendCubeVertexData(global_renderingInfo, &global_renderingInfo->gameCmdBuffer, levelPart, Color{255, 0, 0, 255}/*initial color*/);
-        gState->myCube = CreateCube(v3{1.0f, 1.0f, 1.0f}/*radius*/, v3{0.0f, 0.0f, 0.0f}/*translation*/, Color{255, 0, 0, 255}/*color*/);
+        gState->animIDs.idle = AnimIDFromName("idle");
+        gState->animIDs.walk = AnimIDFromName("walk");
+        gState->animIDs.run = AnimIDFromName("run");
+        gState->animIDs.leftJab = AnimIDFromName("left-jab");
+        gState->animIDs.rightCross = AnimIDFromName("right-cross");
         
-        GPUCmd_SendRectVertexData(renderingInfo, &renderingInfo->gameCmdBuffer, framePart, Color{255, 0, 0});
-        gState->myRect = CreateRect(1.0f, 1.0f, v2{0.0f, 0.0f}, Origin::BOTTOM_LEFT, Color{255, 0, 0});
+        SetIdleAnimation($(player->animQueue), player->animData, gState->animIDs.idle);
+        SetIdleAnimation($(enemy->animQueue), enemy->animData, gState->animIDs.idle);
         
-        CreateFontAtlasFromFile_TTF(global_renderingInfo, "data/arial.ttf", 18);
+        //Font atlas only gets sent to the gpu once it's been built
+        AwaitLoad(fontAsset);
         GPUCmd_SendFontAtlas(global_renderingInfo, &global_renderingInfo->gameCmdBuffer, levelPart);
+        ReleaseFont($(gState->assetCache), fontAsset);
+        
+#if DEVELOPMENT_BUILD
+        Texture_Cache_Stats textureStats = gState->textureCache.stats;
+        BGZ_CONSOLE("Texture cache: %d memory hits, %d disk hits, %d misses, %.2f ms loading (%.2f ms saved by the disk cache)\n", textureStats.memoryHits,
+                    textureStats.diskHits, textureStats.misses, textureStats.loadSecs * 1000.0, textureStats.secsSaved * 1000.0);
+#endif
     };
     
+#if RUN_BENCHMARKS_ON_STARTUP
+    { //Stands in for the game's frames until the hardware renderer's numbers for every scene have come back
+        local_persist GPU_Benchmark gpuBenchmark {};
+        if (RecordGPUBenchmarkFrame($(gpuBenchmark), global_renderingInfo, &global_renderingInfo->gameCmdBuffer))
+        {
+            Release($(*framePart));
+            return;
+        };
+    };
+#endif
+    
     if (globalPlatformServices->DLLJustReloaded)
     {
         BGZ_CONSOLE("Dll reloaded!");
@@ -393,7 +405,7 @@ extern "C" void GameUpdate(bgz::MemoryBlock* gameMemory, Platform_Services* plat
     if (KeyHeld(keyboard->MoveRight))
     {
         player->world.translation.x += .1f;
-        QueueAnimation($(player->animQueue), player->animData, "walk", PlayBackStatus::NEXT);
+        QueueAnimation($(player->animQueue), player->animData, gState->animIDs.walk, PlayBackStatus::NEXT);
     };
     
     if (KeyHeld(keyboard->MoveLeft))
@@ -409,28 +421,30 @@ extern "C" void GameUpdate(bgz::MemoryBlock* gameMemory, Platform_Services* plat
     if (KeyHeld(keyboard->MoveDown))
     {
         stage->camera.zoomFactor -= .02f;
+        if (stage->camera.zoomFactor < .1f)
+            stage->camera.zoomFactor = .1f;
     };
     
     if (KeyPressed(keyboard->ActionLeft))
     {
-        QueueAnimation($(player->animQueue), player->animData, "left-jab", PlayBackStatus::IMMEDIATE);
+        QueueAnimation($(player->animQueue), player->animData, gState->animIDs.leftJab, PlayBackStatus::IMMEDIATE);
     };
     
     if (KeyComboHeld(keyboard->ActionLeft, keyboard->MoveRight))
     {
-        QueueAnimation($(player->animQueue), player->animData, "run", PlayBackStatus::DEFAULT);
+        QueueAnimation($(player->animQueue), player->animData, gState->animIDs.run, PlayBackStatus::DEFAULT);
     }
     
     if (KeyPressed(keyboard->ActionRight))
     {
-        QueueAnimation($(player->animQueue), player->animData, "right-cross", PlayBackStatus::IMMEDIATE);
+        QueueAnimation($(player->animQueue), player->animData, gState->animIDs.rightCross, PlayBackStatus::IMMEDIATE);
     };
     
-    Animation playerCurrentAnim = UpdateAnimationState($(player->animQueue), deltaT);
-    Animation enemyCurrentAnim = UpdateAnimationState($(enemy->animQueue), deltaT);
+    AnimationPlayback playerCurrentAnim = UpdateAnimationState($(player->animQueue), deltaT);
+    AnimationPlayback enemyCurrentAnim = UpdateAnimationState($(enemy->animQueue), deltaT);
     
-    ApplyAnimationToSkeleton($(player->skel), playerCurrentAnim);
-    ApplyAnimationToSkeleton($(enemy->skel), enemyCurrentAnim);
+    ApplyAnimationToSkeleton($(player->skel), &player->animQueue.pose);
+    ApplyAnimationToSkeleton($(enemy->skel), &enemy->animQueue.pose);
     
     UpdateSkeletonBoneWorldTransforms($(player->skel), player->world.translation);
     UpdateSkeletonBoneWorldTransforms($(enemy->skel), enemy->world.translation);
@@ -438,27 +452,86 @@ extern "C" void GameUpdate(bgz::MemoryBlock* gameMemory, Platform_Services* plat
     UpdateCollisionBoxWorldPos_BasedOnCenterPoint($(player->hurtBox), player->world.translation);
     UpdateCollisionBoxWorldPos_BasedOnCenterPoint($(enemy->hurtBox), enemy->world.translation);
     
-    for (i32 hitBoxIndex {}; hitBoxIndex < playerCurrentAnim.hitBoxes.length; ++hitBoxIndex)
+    for (i32 hitBoxIndex {}; hitBoxIndex < playerCurrentAnim.anim->hitBoxes.length; ++hitBoxIndex)
     {
-        UpdateHitBoxStatus($(playerCurrentAnim.hitBoxes[hitBoxIndex]), playerCurrentAnim.currentTime);
+        HitBox hitBox = playerCurrentAnim.anim->hitBoxes[hitBoxIndex];
+        UpdateHitBoxStatus($(hitBox), playerCurrentAnim.currentTime);
         
-        if (playerCurrentAnim.hitBoxes[hitBoxIndex].isActive)
+        if (hitBox.isActive)
         {
-            playerCurrentAnim.hitBoxes[hitBoxIndex].pos_worldSpace = { 0.0f, 0.0f };
+            hitBox.pos_worldSpace = { 0.0f, 0.0f };
             
-            Bone* bone = GetBoneFromSkeleton(&player->skel, playerCurrentAnim.hitBoxes[hitBoxIndex].boneName);
-            UpdateCollisionBoxWorldPos_BasedOnCenterPoint($(playerCurrentAnim.hitBoxes[hitBoxIndex]), bone->worldSpace.translation);
-            b collisionOccurred = CheckForFighterCollisions_AxisAligned(playerCurrentAnim.hitBoxes[hitBoxIndex], enemy->hurtBox);
+            i32 boneIndex = GetBoneIndex(player->skel.setup, hitBox.boneName);
+            UpdateCollisionBoxWorldPos_BasedOnCenterPoint($(hitBox), player->skel.pose.worldSpaceTranslations[boneIndex]);
+            b collisionOccurred = CheckForFighterCollisions_AxisAligned(hitBox, enemy->hurtBox);
             
             if (collisionOccurred)
                 BGZ_CONSOLE("ahhahha");
         };
     };
     
+#if DEVELOPMENT_BUILD
+    { //Only log anim copy stats when they change so the console doesn't get flooded every frame
+        local_persist i64 prevAnimBytesCopied { -1 };
+        if (animBytesCopied_thisFrame != prevAnimBytesCopied)
+            BGZ_CONSOLE("Anim bytes copied this frame: %lld\n", animBytesCopied_thisFrame);
+        
+        prevAnimBytesCopied = animBytesCopied_thisFrame;
+        animBytesCopied_thisFrame = 0;
+    };
+#endif
+    
     { //Render
-        for(int i{}; i < 100; ++i)
+        if (stage->backgroundTexture)
+        {
+            Rect backgroundRect = CreateRect(stage->size.width, stage->size.height, v2 { 0.0f, 0.0f }, Origin::BOTTOM_LEFT, Color { 255, 255, 255, 255 });
+            GPUCmd_DrawRect(&global_renderingInfo->gameCmdBuffer, backgroundRect, 10.0f, stage->backgroundTexture->textureID);
+        }
+        else if (stage->background.file)
+        {
+            Game_Camera* stageCamera = &stage->camera;
+            f32 viewHeight_meters = ((f32)global_renderingInfo->heightOfScreen_pixels / global_renderingInfo->_pixelsPerMeter) / stageCamera->zoomFactor;
+            v2 viewSize_meters = { viewHeight_meters * ((f32)global_renderingInfo->widthOfScreen_pixels / (f32)global_renderingInfo->heightOfScreen_pixels), viewHeight_meters };
+            
+            UpdateTiledBackground($(stage->background), &global_renderingInfo->gameCmdBuffer, stageCamera->lookAt - viewSize_meters / 2.0f,
+                                  stageCamera->lookAt + viewSize_meters / 2.0f, global_renderingInfo->heightOfScreen_pixels, 10.0f, global_renderingInfo->framesInFlight);
+            
+#if DEVELOPMENT_BUILD
+            { //Only log streaming stats when the zoom changes or tiles are still coming in
+                local_persist f32 prevZoomFactor {};
+                Tiled_Background_Stats stats = stage->background.stats;
+                if (stageCamera->zoomFactor != prevZoomFactor || stats.bytesUploadedThisFrame)
+                    BGZ_CONSOLE("Background zoom %.2f: mip %d, %d/%d tiles missing, uploaded %lld KB this frame (%lld KB total), cpu %lld KB, gpu %lld KB\n",
+                                stageCamera->zoomFactor, stats.mipLevel, stats.missingTileCount, stats.visibleTileCount, stats.bytesUploadedThisFrame / 1024,
+                                stats.totalBytesUploaded / 1024, stats.cpuBytesResident / 1024, stats.gpuBytesResident / 1024);
+                
+                prevZoomFactor = stageCamera->zoomFactor;
+            };
+#endif
+        };
+        
+        for(int i{}; i < STRESS_RECT_COUNT; ++i)
             GPUCmd_DrawRect(&global_renderingInfo->gameCmdBuffer, gState->myRect, -1.0f);
         
+#if SHOW_GPU_STATS
+        { //Log gpu stats when they change and keep them on screen
+            local_persist GPU_Frame_Stats prevFrameStats {};
+            GPU_Frame_Stats frameStats = global_renderingInfo->frameStats;
+            if (frameStats.drawCalls != prevFrameStats.drawCalls || frameStats.rectsDrawn != prevFrameStats.rectsDrawn)
+                BGZ_CONSOLE("GPU: %d draw calls, %d rects, %d glyphs, %d uniform updates, %d binds (%d avoided), %lld KB streamed\n", frameStats.drawCalls,
+                            frameStats.rectsDrawn, frameStats.glyphsDrawn, frameStats.uniformUpdates, frameStats.bindsIssued, frameStats.bindsAvoided,
+                            frameStats.bytesStreamed / 1024);
+            
+            prevFrameStats = frameStats;
+            
+            char gpuStatsText[128];
+            snprintf(gpuStatsText, sizeof(gpuStatsText), "GPU: %d draw calls, %d rects, %d glyphs, %d binds avoided", frameStats.drawCalls, frameStats.rectsDrawn,
+                     frameStats.glyphsDrawn, frameStats.bindsAvoided);
+            GPUCmd_Overlay_DrawText(global_renderingInfo, &global_renderingInfo->gameCmdBuffer, gpuStatsText, v2 { 10.0f, 10.0f }, 0.0f,
+                                    (f32)global_renderingInfo->widthOfScreen_pixels);
+        };
+#endif
+        
         //GPUCmd_DrawCube(&global_renderingInfo->gameCmdBuffer, gState->myCube);
         //GPUCmd_DrawRect(&global_renderingInfo->gameCmdBuffer, gState->myRect, 0);
         
@@ -5,6 +5,9 @@
 #include "2d_skeleton.h"
 #include "2d_animation.h"
 #include "fighter.h"
+#include "asset_cache.h"
+#include "texture_cache.h"
+#include "tiled_image.h"
 
 struct Game_Camera
 {
@@ -16,7 +19,8 @@ struct Game_Camera
 
 struct Stage_Data
 {
-    Bitmap backgroundImg;
+    Tiled_Background background;
+    Texture_Cache_Entry* backgroundTexture { nullptr }; //Whole image fallback for when there's no tiled background
     v2 size{};
     v2 centerPoint{};
     Fighter player;
@@ -25,6 +29,16 @@ struct Stage_Data
     Game_Camera camera;
 };
 
+//Interned once at startup so per frame input handling never touches animation name strings
+struct Fighter_AnimIDs
+{
+    AnimID idle {};
+    AnimID walk {};
+    AnimID run {};
+    AnimID leftJab {};
+    AnimID rightCross {};
+};
+
 struct Game_State
 {
     Rect myRect{};
@@ -36,5 +50,8 @@ struct Game_State
     f32 lightAngle{};
     f32 lightThreshold{};
     Stage_Data stage;
+    Fighter_AnimIDs animIDs;
+    Asset_Cache assetCache;
+    Texture_Cache textureCache;
     b isLevelOver{false};
 };
@@ -18,6 +18,8 @@
  */
 
 /* Esoteric Software: Removed everything except parsing, shorter method names, more get methods, double to float, formatted. */
+/* Nodes are bump allocated from a memory partition and strings are unescaped in place in the source text, so parsing never
+   touches the heap. There's nothing to dispose: the tree lives until the partition (or scope) it was parsed into is released. */
 
 #ifndef JSON_INCLUDE
 #define JSON_INCLUDE
@@ -27,8 +29,6 @@
 #include <stdlib.h> /* strtod (C89), strtof (C99) */
 #include <string.h> /* strcasecmp (4.4BSD - compatibility), _stricmp (_WIN32) */
 
-#define POW(A,B) pow(A, B)
-
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -65,11 +65,12 @@ typedef struct Json {
 	const char* name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
 } Json;
 
-/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
-Json* Json_create (const char* value);
+/* Supply a block of JSON, and this returns a Json object you can interrogate. The text is modified in place (strings get
+   unescaped/null terminated where they sit) and all names/strings point into it, so it has to outlive the returned tree. */
+Json* Json_create (char* value, bgz::Memory_Partition&& memPart);
 
-/* Delete a Json entity and all subentities. */
-void Json_dispose (Json* json);
+/* Reads a file into memPart (null terminated) so it can be handed to Json_create and share the tree's lifetime. */
+char* Json_readFile (bgz::Memory_Partition&& memPart, const char* filePath);
 
 /* Get item "string" from object. Case insensitive. */
 Json* Json_getItem (Json* json, const char* string);
@@ -77,6 +78,35 @@ const char* Json_getString (Json* json, const char* name, const char* defaultVal
 float Json_getFloat (Json* json, const char* name, float defaultValue);
 int Json_getInt (Json* json, const char* name, int defaultValue);
 
+/* Pull parser. Walks the text front to back once without building a tree: the caller asks for the value it expects next
+   and reads or skips it. Like Json_create, strings are unescaped/terminated in place so the text gets modified and returned
+   strings point into it. On malformed input the reader stops (every call after returns 0/defaults) and Json_readerFailed
+   reports it.
+
+	Json_Reader reader = Json_reader(text);
+	const char* key;
+	Json_beginObject(&reader);
+	while (Json_nextKey(&reader, &key)) {
+		if (!strcmp(key, "width")) width = Json_readFloat(&reader, 0.0f);
+		else Json_skipValue(&reader);
+	}
+*/
+typedef struct Json_Reader {
+	char* at;
+} Json_Reader;
+
+Json_Reader Json_reader (char* text);
+int Json_readerFailed (Json_Reader* reader);
+int Json_peekType (Json_Reader* reader); /* Json type of the next value, -1 if there isn't one */
+int Json_beginObject (Json_Reader* reader);
+int Json_nextKey (Json_Reader* reader, const char** key); /* 0 once the object's closing brace has been consumed */
+int Json_beginArray (Json_Reader* reader);
+int Json_nextElement (Json_Reader* reader); /* 0 once the array's closing bracket has been consumed */
+const char* Json_readString (Json_Reader* reader, const char* defaultValue); /* Skips and returns defaultValue if the value isn't a string */
+float Json_readFloat (Json_Reader* reader, float defaultValue);
+int Json_readInt (Json_Reader* reader, int defaultValue);
+void Json_skipValue (Json_Reader* reader);
+
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when Json_create() returns 0. 0 when Json_create() succeeds. */
 const char* Json_getError (void);
 
@@ -84,6 +114,10 @@ const char* Json_getError (void);
 }
 #endif
 
+#if DEVELOPMENT_BUILD
+void BenchmarkJsonParsing(bgz::Memory_Partition&& memPart, i32 parsesPerFile);
+#endif
+
 #endif /* SPINE_JSON_H_ */
 
 #ifdef JSON_IMPL
@@ -129,78 +163,102 @@ static int Json_strcasecmp (const char* s1, const char* s2) {
 }
 
 /* Internal constructor. */
-static Json *Json_new (void) {
-	return (Json*)CallocType(heap, Json, 1);
-}
-
-/* Delete a Json structure. */
-void Json_dispose (Json *c) {
-	Json *next;
-	while (c) {
-		next = c->next;
-		if (c->child) Json_dispose(c->child);
-		if (c->valueString) DeAlloc(heap, c->valueString);
-		if (c->name) DeAlloc(heap, c->name);
-		DeAlloc(heap, c);
-		c = next;
-	}
+static Json *Json_new (bgz::Memory_Partition* memPart) {
+	Json* json = PushType(memPart, Json, 1);
+	memset(json, 0, sizeof(Json));
+	return json;
 }
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static const char* parse_number (Json *item, const char* num) {
-	double result = 0.0;
+/* Powers of ten a double holds exactly. 10^22 is the largest (5^22 still fits in 53 bits). */
+static const double exactPowersOf10[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Parse the number at num into a correctly rounded double. Returns the end of the number, or num if there wasn't one.
+   Uses Clinger's fast path (the exact case Eisel-Lemire implementations try first): a significand of at most 2^53
+   scaled by an exactly representable power of ten is a single correctly rounded multiply/divide. Anything else
+   (more than 19 significant digits, large significands or exponents) falls back to strtod. */
+static const char* parse_double (const char* num, double* out) {
+	const char* ptr = num;
+	unsigned long long significand = 0;
+	int significantDigits = 0;
+	int exponent10 = 0;
 	int negative = 0;
-	char* ptr = (char*)num;
 
 	if (*ptr == '-') {
-		negative = -1;
+		negative = 1;
 		++ptr;
 	}
 
 	while (*ptr >= '0' && *ptr <= '9') {
-		result = result * 10.0 + (*ptr - '0');
+		if (significantDigits < 19) {
+			significand = significand * 10 + (*ptr - '0');
+			if (significand) ++significantDigits;
+		} else {
+			++significantDigits; /* Digits past 19 don't fit, strtod has to handle this one. */
+		}
 		++ptr;
 	}
 
 	if (*ptr == '.') {
-		double fraction = 0.0;
-		int n = 0;
 		++ptr;
 
 		while (*ptr >= '0' && *ptr <= '9') {
-			fraction = (fraction * 10.0) + (*ptr - '0');
+			if (significantDigits < 19) {
+				significand = significand * 10 + (*ptr - '0');
+				if (significand) ++significantDigits;
+				--exponent10;
+			} else {
+				++significantDigits;
+			}
 			++ptr;
-			++n;
 		}
-		result += fraction / POW(10.0, n);
 	}
-	if (negative) result = -result;
 
 	if (*ptr == 'e' || *ptr == 'E') {
-		double exponent = 0;
+		int exponent = 0;
 		int expNegative = 0;
-		int n = 0;
 		++ptr;
 
 		if (*ptr == '-') {
-			expNegative = -1;
+			expNegative = 1;
 			++ptr;
 		} else if (*ptr == '+') {
 			++ptr;
 		}
 
 		while (*ptr >= '0' && *ptr <= '9') {
-			exponent = (exponent * 10.0) + (*ptr - '0');
+			if (exponent < 100000) exponent = (exponent * 10) + (*ptr - '0'); /* Way out of range either way, just don't overflow. */
 			++ptr;
-			++n;
 		}
 
-		if (expNegative)
-			result = result / POW(10, exponent);
+		exponent10 += expNegative ? -exponent : exponent;
+	}
+
+	if (ptr == num) return num;
+
+	if (significand == 0 && significantDigits == 0) {
+		*out = negative ? -0.0 : 0.0;
+	} else if (significantDigits <= 19 && significand <= (1ull << 53) && exponent10 >= -22 && exponent10 <= 22) {
+		double result = (double)significand;
+		if (exponent10 < 0)
+			result /= exactPowersOf10[-exponent10];
 		else
-			result = result * POW(10, exponent);
+			result *= exactPowersOf10[exponent10];
+		*out = negative ? -result : result;
+	} else {
+		*out = strtod(num, 0);
 	}
 
+	return ptr;
+}
+
+/* Parse the input text to generate a number, and populate the result into item. */
+static const char* parse_number (Json *item, const char* num) {
+	double result = 0.0;
+	const char* ptr = parse_double(num, &result);
+
 	if (ptr != num) {
 		/* Parse success, number found. */
 		item->valueFloat = (float)result;
@@ -214,27 +272,32 @@ static const char* parse_number (Json *item, const char* num) {
 	}
 }
 
-/* Parse the input text into an unescaped cstring, and populate item. */
+/* Parse the input text into an unescaped cstring, and populate item. The string is unescaped in place (escapes never
+   unescape to more bytes than they take up) with the closing quote or a byte before it becoming the null terminator. */
 static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
 static const char* parse_string (Json *item, const char* str) {
-	const char* ptr = str + 1;
+	char* out = (char*)str + 1;
+	char* ptr = out;
 	char* ptr2;
-	char* out;
 	int len = 0;
+	int closed;
 	unsigned uc, uc2;
 	if (*str != '\"') { /* TODO: don't need this check when called from parse_value, but do need from parse_object */
 		ep = str;
 		return 0;
 	} /* not a string! */
 
-	while (*ptr != '\"' && *ptr && ++len)
-		if (*ptr++ == '\\') ptr++; /* Skip escaped quotes. */
+	while (*ptr != '\"' && *ptr != '\\' && *ptr)
+		ptr++;
 
-	out = MallocType(heap, char, len + 1); /* The length needed for the string, roughly. */
-	if (!out) return 0;
+	if (*ptr == '\"') { /* No escapes, the most common case. Just terminate it where it is. */
+		*ptr = 0;
+		item->valueString = out;
+		item->type = Json_String;
+		return ptr + 1;
+	}
 
-	ptr = str + 1;
-	ptr2 = out;
+	ptr2 = ptr;
 	while (*ptr != '\"' && *ptr) {
 		if (*ptr != '\\')
 			*ptr2++ = *ptr++;
@@ -305,17 +368,18 @@ static const char* parse_string (Json *item, const char* str) {
 			ptr++;
 		}
 	}
+	closed = (*ptr == '\"');
 	*ptr2 = 0;
-	if (*ptr == '\"') ptr++; /* TODO error handling if not \" or \0 ? */
+	if (closed) ptr++; /* TODO error handling if not \" or \0 ? */
 	item->valueString = out;
 	item->type = Json_String;
 	return ptr;
 }
 
 /* Predeclare these prototypes. */
-static const char* parse_value (Json *item, const char* value);
-static const char* parse_array (Json *item, const char* value);
-static const char* parse_object (Json *item, const char* value);
+static const char* parse_value (Json *item, const char* value, bgz::Memory_Partition* memPart);
+static const char* parse_array (Json *item, const char* value, bgz::Memory_Partition* memPart);
+static const char* parse_object (Json *item, const char* value, bgz::Memory_Partition* memPart);
 
 /* Utility to jump whitespace and cr/lf */
 static const char* skip (const char* in) {
@@ -326,24 +390,35 @@ static const char* skip (const char* in) {
 }
 
 /* Parse an object - create a new root, and populate. */
-Json *Json_create (const char* value) {
+Json *Json_create (char* value, bgz::Memory_Partition&& memPart) {
 	Json *c;
 	ep = 0;
 	if (!value) return 0; /* only place we check for NULL other than skip() */
-	c = Json_new();
+	c = Json_new(&memPart);
 	if (!c) return 0; /* memory fail */
 
-	value = parse_value(c, skip(value));
-	if (!value) {
-		Json_dispose(c);
-		return 0;
-	} /* parse failure. ep is set. */
+	if (!parse_value(c, skip(value), &memPart))
+		return 0; /* parse failure. ep is set. Whatever got parsed is left in memPart for the caller's scope to release */
 
 	return c;
 }
 
+char* Json_readFile (bgz::Memory_Partition&& memPart, const char* filePath) {
+	int length = 0;
+	unsigned char* fileData = globalPlatformServices->ReadEntireFile($(length), filePath);
+	char* text;
+	if (!fileData) return 0;
+
+	text = PushType(&memPart, char, length + 1);
+	memcpy(text, fileData, length);
+	text[length] = 0;
+	globalPlatformServices->Free(fileData);
+
+	return text;
+}
+
 /* Parser core - when encountering text, process appropriately. */
-static const char* parse_value (Json *item, const char* value) {
+static const char* parse_value (Json *item, const char* value, bgz::Memory_Partition* memPart) {
 	/* Referenced by Json_create(), parse_array(), and parse_object(). */
 	/* Always called with the result of skip(). */
 #if SPINE_JSON_DEBUG /* Checked at entry to graph, Json_create, and after every parse_ call. */
@@ -377,9 +452,9 @@ static const char* parse_value (Json *item, const char* value) {
 	case '\"':
 		return parse_string(item, value);
 	case '[':
-		return parse_array(item, value);
+		return parse_array(item, value, memPart);
 	case '{':
-		return parse_object(item, value);
+		return parse_object(item, value, memPart);
 	case '-': /* fallthrough */
 	case '0': /* fallthrough */
 	case '1': /* fallthrough */
@@ -401,7 +476,7 @@ static const char* parse_value (Json *item, const char* value) {
 }
 
 /* Build an array from input text. */
-static const char* parse_array (Json *item, const char* value) {
+static const char* parse_array (Json *item, const char* value, bgz::Memory_Partition* memPart) {
 	Json *child;
 
 #if SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -415,21 +490,21 @@ static const char* parse_array (Json *item, const char* value) {
 	value = skip(value + 1);
 	if (*value == ']') return value + 1; /* empty array. */
 
-	item->child = child = Json_new();
+	item->child = child = Json_new(memPart);
 	if (!item->child) return 0; /* memory fail */
-	value = skip(parse_value(child, skip(value))); /* skip any spacing, get the value. */
+	value = skip(parse_value(child, skip(value), memPart)); /* skip any spacing, get the value. */
 	if (!value) return 0;
 	item->size = 1;
 
 	while (*value == ',') {
-		Json *new_item = Json_new();
+		Json *new_item = Json_new(memPart);
 		if (!new_item) return 0; /* memory fail */
 		child->next = new_item;
 #if SPINE_JSON_HAVE_PREV
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parse_value(child, skip(value + 1)));
+		value = skip(parse_value(child, skip(value + 1), memPart));
 		if (!value) return 0; /* parse fail */
 		item->size++;
 	}
@@ -440,7 +515,7 @@ static const char* parse_array (Json *item, const char* value) {
 }
 
 /* Build an object from the text. */
-static const char* parse_object (Json *item, const char* value) {
+static const char* parse_object (Json *item, const char* value, bgz::Memory_Partition* memPart) {
 	Json *child;
 
 #if SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -454,7 +529,7 @@ static const char* parse_object (Json *item, const char* value) {
 	value = skip(value + 1);
 	if (*value == '}') return value + 1; /* empty array. */
 
-	item->child = child = Json_new();
+	item->child = child = Json_new(memPart);
 	if (!item->child) return 0;
 	value = skip(parse_string(child, skip(value)));
 	if (!value) return 0;
@@ -464,12 +539,12 @@ static const char* parse_object (Json *item, const char* value) {
 		ep = value;
 		return 0;
 	} /* fail! */
-	value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+	value = skip(parse_value(child, skip(value + 1), memPart)); /* skip any spacing, get the value. */
 	if (!value) return 0;
 	item->size = 1;
 
 	while (*value == ',') {
-		Json *new_item = Json_new();
+		Json *new_item = Json_new(memPart);
 		if (!new_item) return 0; /* memory fail */
 		child->next = new_item;
 #if SPINE_JSON_HAVE_PREV
@@ -484,7 +559,7 @@ static const char* parse_object (Json *item, const char* value) {
 			ep = value;
 			return 0;
 		} /* fail! */
-		value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+		value = skip(parse_value(child, skip(value + 1), memPart)); /* skip any spacing, get the value. */
 		if (!value) return 0;
 		item->size++;
 	}
@@ -494,6 +569,202 @@ static const char* parse_object (Json *item, const char* value) {
 	return 0; /* malformed. */
 }
 
+Json_Reader Json_reader (char* text) {
+	Json_Reader reader;
+	ep = 0;
+	reader.at = (char*)skip(text);
+	return reader;
+}
+
+int Json_readerFailed (Json_Reader* reader) {
+	return reader->at == 0;
+}
+
+static void reader_fail (Json_Reader* reader, const char* at) {
+	ep = at;
+	reader->at = 0;
+}
+
+int Json_peekType (Json_Reader* reader) {
+	if (!reader->at) return -1;
+
+	switch (*reader->at) {
+	case '{': return Json_Object;
+	case '[': return Json_Array;
+	case '\"': return Json_String;
+	case 't': return Json_True;
+	case 'f': return Json_False;
+	case 'n': return Json_NULL;
+	case '-': /* fallthrough */
+	case '0': case '1': case '2': case '3': case '4': /* fallthrough */
+	case '5': case '6': case '7': case '8': case '9':
+		return Json_Number;
+	default:
+		return -1;
+	}
+}
+
+int Json_beginObject (Json_Reader* reader) {
+	if (!reader->at) return 0;
+	if (*reader->at != '{') {
+		reader_fail(reader, reader->at);
+		return 0;
+	}
+	reader->at = (char*)skip(reader->at + 1);
+	return 1;
+}
+
+int Json_nextKey (Json_Reader* reader, const char** key) {
+	Json item;
+	const char* at = reader->at;
+	if (!at) return 0;
+
+	if (*at == ',') at = skip(at + 1);
+	if (*at == '}') {
+		reader->at = (char*)skip(at + 1);
+		return 0;
+	}
+
+	at = skip(parse_string(&item, at));
+	if (!at || *at != ':') {
+		reader_fail(reader, at ? at : ep);
+		return 0;
+	}
+
+	*key = item.valueString;
+	reader->at = (char*)skip(at + 1);
+	return 1;
+}
+
+int Json_beginArray (Json_Reader* reader) {
+	if (!reader->at) return 0;
+	if (*reader->at != '[') {
+		reader_fail(reader, reader->at);
+		return 0;
+	}
+	reader->at = (char*)skip(reader->at + 1);
+	return 1;
+}
+
+int Json_nextElement (Json_Reader* reader) {
+	const char* at = reader->at;
+	if (!at) return 0;
+
+	if (*at == ',') at = skip(at + 1);
+	if (*at == ']') {
+		reader->at = (char*)skip(at + 1);
+		return 0;
+	}
+	if (!*at) {
+		reader_fail(reader, at);
+		return 0;
+	}
+
+	reader->at = (char*)at;
+	return 1;
+}
+
+const char* Json_readString (Json_Reader* reader, const char* defaultValue) {
+	Json item;
+	const char* at;
+	if (!reader->at) return defaultValue;
+	if (*reader->at != '\"') {
+		Json_skipValue(reader);
+		return defaultValue;
+	}
+
+	at = parse_string(&item, reader->at);
+	if (!at) {
+		reader_fail(reader, ep);
+		return defaultValue;
+	}
+
+	reader->at = (char*)skip(at);
+	return item.valueString;
+}
+
+float Json_readFloat (Json_Reader* reader, float defaultValue) {
+	double result = 0.0;
+	const char* at;
+	if (Json_peekType(reader) != Json_Number) {
+		Json_skipValue(reader);
+		return defaultValue;
+	}
+
+	at = parse_double(reader->at, &result);
+	reader->at = (char*)skip(at);
+	return (float)result;
+}
+
+int Json_readInt (Json_Reader* reader, int defaultValue) {
+	double result = 0.0;
+	const char* at;
+	if (Json_peekType(reader) != Json_Number) {
+		Json_skipValue(reader);
+		return defaultValue;
+	}
+
+	at = parse_double(reader->at, &result);
+	reader->at = (char*)skip(at);
+	return (int)result;
+}
+
+/* Skips a whole value, containers included, without looking at anything but brackets and string boundaries. */
+void Json_skipValue (Json_Reader* reader) {
+	const char* at = reader->at;
+	int depth = 0;
+	if (!at) return;
+
+	do {
+		switch (*at) {
+		case '\0':
+			reader_fail(reader, at);
+			return;
+		case '{': /* fallthrough */
+		case '[':
+			++depth;
+			++at;
+			break;
+		case '}': /* fallthrough */
+		case ']':
+			--depth;
+			++at;
+			break;
+		case '\"':
+			++at;
+			while (*at != '\"' && *at) {
+				if (*at == '\\' && at[1]) ++at;
+				++at;
+			}
+			if (*at) ++at;
+			break;
+		case ',': /* fallthrough */
+		case ':':
+			if (depth == 0) {
+				reader_fail(reader, at);
+				return;
+			}
+			++at;
+			break;
+		default:
+			if (depth == 0) { /* Scalar outside of any container: skip to whatever ends it */
+				while (*at && *at != ',' && *at != '}' && *at != ']' && (unsigned char)*at > 32)
+					++at;
+			} else {
+				++at;
+			}
+			break;
+		}
+	} while (depth > 0);
+
+	if (depth < 0) {
+		reader_fail(reader, at);
+		return;
+	}
+
+	reader->at = (char*)skip(at);
+}
+
 Json *Json_getItem (Json *object, const char* string) {
 	Json *c = object->child;
 	while (c && Json_strcasecmp(c->name, string))
@@ -517,4 +788,201 @@ int Json_getInt (Json* value, const char* name, int defaultValue) {
 	return value ? value->valueInt : defaultValue;
 }
 
+#if DEVELOPMENT_BUILD
+//Visits every value with the pull parser (what a loader reading all of a file would do) without building anything
+local_func f64 _BenchmarkReadEverything(Json_Reader* reader)
+{
+    f64 checksum {};
+
+    switch (Json_peekType(reader))
+    {
+        case Json_Object: {
+            const char* key;
+            Json_beginObject(reader);
+            while (Json_nextKey(reader, &key))
+                checksum += _BenchmarkReadEverything(reader);
+        }
+        break;
+
+        case Json_Array: {
+            Json_beginArray(reader);
+            while (Json_nextElement(reader))
+                checksum += _BenchmarkReadEverything(reader);
+        }
+        break;
+
+        case Json_String: {
+            checksum += (f64)strlen(Json_readString(reader, ""));
+        }
+        break;
+
+        case Json_Number: {
+            checksum += (f64)Json_readFloat(reader, 0.0f);
+        }
+        break;
+
+        default: {
+            Json_skipValue(reader);
+        }
+        break;
+    };
+
+    return checksum;
+};
+
+//Parsing modifies the text in place so every parse works on a fresh copy of it (the copy isn't timed)
+local_func void _BenchmarkJsonParse(bgz::Memory_Partition&& memPart, const char* text, i64 textSize, const char* name, i32 parses)
+{
+    f64 parseSecs {};
+    i64 treeBytes {};
+    b parsed { true };
+    for (i32 parseIndex {}; parseIndex < parses; ++parseIndex)
+    {
+        bgz::ScopedMemory scopeMemory(&memPart);
+
+        char* textCopy = PushType(&memPart, char, textSize + 1);
+        memcpy(textCopy, text, textSize + 1);
+        i64 startBytes = memPart.usedAmount;
+
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        Json* root = Json_create(textCopy, $(memPart));
+        parseSecs += globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        treeBytes = memPart.usedAmount - startBytes;
+        parsed = parsed && root;
+    };
+
+    f64 readSecs {};
+    f64 checksum {};
+    for (i32 parseIndex {}; parseIndex < parses; ++parseIndex)
+    {
+        bgz::ScopedMemory scopeMemory(&memPart);
+
+        char* textCopy = PushType(&memPart, char, textSize + 1);
+        memcpy(textCopy, text, textSize + 1);
+
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        Json_Reader reader = Json_reader(textCopy);
+        checksum += _BenchmarkReadEverything(&reader);
+        readSecs += globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        parsed = parsed && NOT Json_readerFailed(&reader);
+    };
+
+    f64 msPerParse = (parseSecs * 1000.0) / parses;
+    f64 msPerRead = (readSecs * 1000.0) / parses;
+    f64 megabytes = (f64)textSize / (1024.0 * 1024.0);
+    BGZ_CONSOLE("Json parse bench (%s, %lld bytes): tree %.3f ms per parse (%.1f MB/s, %lld bytes, %lld nodes), reader %.3f ms per pass (%.1f MB/s, 0 bytes), parsed %s (checksum %f)\n",
+                name, textSize, msPerParse, megabytes / (parseSecs / parses), treeBytes, treeBytes / (i64)sizeof(Json), msPerRead, megabytes / (readSecs / parses), parsed ? "yes" : "NO", checksum);
+    
+    //High water mark of the whole process, so it only moves once a parse needs more than anything before it did
+    if (globalPlatformServices->PeakMemoryUsage)
+        BGZ_CONSOLE("Json parse bench (%s): process peak RSS %.1f MB\n", name, (f64)globalPlatformServices->PeakMemoryUsage() / (1024.0 * 1024.0));
+};
+
+local_func b _IsJsonNumberStart(const char* text, const char* at)
+{
+    //Good enough tokenizing for spine json, numbers only follow these characters
+    return (*at == '-' || (*at >= '0' && *at <= '9')) && at != text && (at[-1] == ':' || at[-1] == '[' || at[-1] == ',' || (unsigned char)at[-1] <= 32);
+};
+
+//Times parse_double against strtod over every number in the text and checks they produce bit identical doubles
+local_func void _BenchmarkJsonNumbers(bgz::Memory_Partition&& memPart, const char* text, const char* name, i32 passes)
+{
+    bgz::ScopedMemory scopeMemory(&memPart);
+
+    i32 numberCount {};
+    for (const char* at = text; *at; ++at)
+        if (_IsJsonNumberStart(text, at))
+            ++numberCount;
+
+    const char** numbers = PushType(&memPart, const char*, numberCount);
+    double* fastResults = PushType(&memPart, double, numberCount);
+    double* strtodResults = PushType(&memPart, double, numberCount);
+
+    i64 numberBytes {};
+    i32 numberIndex {};
+    for (const char* at = text; *at; ++at)
+    {
+        if (_IsJsonNumberStart(text, at))
+        {
+            double unused {};
+            const char* end = parse_double(at, &unused);
+            numbers[numberIndex++] = at;
+            numberBytes += end - at;
+            at = end - 1;
+        };
+    };
+    numberCount = numberIndex;
+
+    f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+    for (i32 passIndex {}; passIndex < passes; ++passIndex)
+        for (i32 i {}; i < numberCount; ++i)
+            parse_double(numbers[i], &fastResults[i]);
+    f64 parseDoubleSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+    startTime = globalPlatformServices->CurrentTimeInSecs();
+    for (i32 passIndex {}; passIndex < passes; ++passIndex)
+        for (i32 i {}; i < numberCount; ++i)
+            strtodResults[i] = strtod(numbers[i], nullptr);
+    f64 strtodSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+    i32 mismatchCount {};
+    for (i32 i {}; i < numberCount; ++i)
+        if (memcmp(&fastResults[i], &strtodResults[i], sizeof(double)) != 0)
+            ++mismatchCount;
+
+    f64 megabytes = ((f64)numberBytes * passes) / (1024.0 * 1024.0);
+    BGZ_CONSOLE("Json number bench (%s, %d numbers): parse_double %.1f MB/s, strtod %.1f MB/s, %d mismatches vs strtod\n",
+                name, numberCount, megabytes / parseDoubleSecs, megabytes / strtodSecs, mismatchCount);
+};
+
+//The parser doesn't touch the heap anymore so the tree bytes reported (plus the text itself) are all the memory a parse needs.
+//Process peak RSS is logged after each file where the platform can report it
+void BenchmarkJsonParsing(bgz::Memory_Partition&& memPart, i32 parsesPerFile)
+{
+    const char* rigFiles[] = { "data/yellow_god.json", "data/spineboy-ess.json" };
+    for (i32 fileIndex {}; fileIndex < (i32)ArrayCount(rigFiles); ++fileIndex)
+    {
+        bgz::ScopedMemory scopeMemory(&memPart);
+
+        char* text = Json_readFile($(memPart), rigFiles[fileIndex]);
+        _BenchmarkJsonNumbers($(memPart), text, rigFiles[fileIndex], parsesPerFile);
+        _BenchmarkJsonParse($(memPart), text, (i64)strlen(text), rigFiles[fileIndex], parsesPerFile);
+    };
+
+    { //Synthetic rotate timeline of exactly 50 MB. Too big for the game's partitions so it's built on the heap
+        i64 textSize = Megabytes(50);
+        char* text = (char*)globalPlatformServices->Malloc(textSize + 1);
+        BGZ_ASSERT(text);//, "Unable to allocate synthetic json benchmark memory!");
+
+        const char* lastKeyFrame = "{\"time\":0,\"angle\":0}]}}}}}";
+        i64 lastKeyFrameSize = (i64)strlen(lastKeyFrame);
+
+        i64 at = sprintf(text, "{\"animations\":{\"synthetic\":{\"bones\":{\"bone\":{\"rotate\":[");
+        i64 keyFrameCount {};
+        for (; at + 64 + lastKeyFrameSize <= textSize; ++keyFrameCount)
+            at += sprintf(text + at, "{\"time\":%.4f,\"angle\":%.3f,\"curve\":\"stepped\"},", (f32)keyFrameCount * .0333f, (f32)(keyFrameCount % 720) - 360.5f);
+
+        //Whitespace makes up whatever the last key frame doesn't
+        memset(text + at, ' ', textSize - lastKeyFrameSize - at);
+        memcpy(text + textSize - lastKeyFrameSize, lastKeyFrame, lastKeyFrameSize + 1);
+
+        //Partition only holds what the benches push: the copy of the text a parse works on plus the bigger of the tree (6
+        //objects down to the timeline, 4 nodes per key frame) and the number bench's arrays (2 numbers per key frame)
+        i64 treeBytes = (6 + (keyFrameCount + 1) * 4) * (i64)sizeof(Json);
+        i64 numberBenchBytes = ((keyFrameCount + 1) * 2) * (i64)(sizeof(const char*) + sizeof(double) * 2);
+        i64 synthPartSize = (textSize + 1) + (treeBytes > numberBenchBytes ? treeBytes : numberBenchBytes);
+        bgz::Memory_Partition synthPart { globalPlatformServices->Malloc(synthPartSize), 0, synthPartSize };
+        BGZ_ASSERT(synthPart.baseAddress);//, "Unable to allocate synthetic json benchmark memory!");
+
+        _BenchmarkJsonNumbers($(synthPart), text, "synthetic", 1);
+        _BenchmarkJsonParse($(synthPart), text, textSize, "synthetic", 1);
+
+        globalPlatformServices->Free(synthPart.baseAddress);
+        globalPlatformServices->Free(text);
+    };
+};
+#endif
+
 #endif //JSON_IMPL
\ No newline at end of file
@@ -0,0 +1,34 @@
+/*
+    Runs BenchmarkJsonParsing (see json.h) outside the game: the rig files the game loads plus a synthetic 50 MB
+    timeline. On linux each file's line is followed by the process peak RSS (getrusage), so it includes everything the
+    process had resident before it, not just that parse. The game logs the peak working set instead when it runs the
+    benchmark on startup (see RUN_BENCHMARKS_ON_STARTUP in gamecode.cpp).
+
+    Run from the repo root so the rig files are found the same way the game finds them.
+
+    Usage: json_bench [parses per file]
+*/
+
+#include "gamecode.cpp"
+
+#include "cooker_platform.h"
+
+int main(int argc, char** argv)
+{
+    i32 parsesPerFile = argc > 1 ? atoi(argv[1]) : 100;
+
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    if (NOT platformServices.PeakMemoryUsage)
+        fprintf(stderr, "No peak memory usage on this platform, only timings and tree sizes will be reported\n");
+
+    bgz::MemoryBlock benchMemory {};
+    void* benchMemoryPtr = malloc(Megabytes(16));
+    bgz::InitMemoryBlock($(benchMemory), Megabytes(16), Megabytes(1), benchMemoryPtr);
+    bgz::Memory_Partition* benchPart = bgz::CreatePartitionFromMemoryBlock($(benchMemory), Megabytes(12), "bench");
+
+    BenchmarkJsonParsing($(*benchPart), parsesPerFile);
+
+    return 0;
+};
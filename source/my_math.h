@@ -43,7 +43,7 @@ typedef union v3
 #ifdef __cplusplus
     v3() = default;
     v3 (f32 x, f32 y, f32 z) : x(x), y(y), z(z){};
-    v3 (v2 vec2, f32 z) : xy(vec2), z(z){};
+    v3 (v2 vec2, f32 z) : x(vec2.x), y(vec2.y), z(z){};
 #endif
     
     struct
@@ -100,9 +100,9 @@ typedef union v4
 #ifdef __cplusplus
     v4() = default;
     v4(f32 x, f32 y, f32 z, f32 w) : x(x), y(y), z(z), w(w){};
-    v4(v2 xy, v2 zw) : xy(xy), zw(zw){};
-    v4(v2 xy, f32 z, f32 w) : xy(xy), z(z), w(w){};
-    v4(v3 xyz, f32 w) : xyz(xyz), w(w){};
+    v4(v2 xy, v2 zw) : x(xy.x), y(xy.y), z(zw.x), w(zw.y){};
+    v4(v2 xy, f32 z, f32 w) : x(xy.x), y(xy.y), z(z), w(w){};
+    v4(v3 xyz, f32 w) : x(xyz.x), y(xyz.y), z(xyz.z), w(w){};
 #endif
     struct
     {
@@ -181,6 +181,13 @@ struct mat2x2
     f32 elem[2][2];
 };
 
+//2D affine transform (2x2 linear part + translation in the last column)
+struct mat2x3
+{
+    //These are stored ROW MAJOR - elem[ROW][COLUMN]!!!
+    f32 elem[2][3];
+};
+
 inline Mat4x4 IdentityMatrix();
 
 //Other v2's I might use. Torn on whether or not I should template things but I think for 90 percent of what I'm using vectors for floats should be what I want
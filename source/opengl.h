@@ -62,35 +62,78 @@ color = colorChange;
 
 )HereDoc";
 
+//Same as the basic shader but transform and color come in per instance so a run of rects can go down in one draw call
+const char* instancedRectVertexShaderCode =
+R"HereDoc(
+
+#version 430
+
+in layout(location=0) vec3 position;
+in layout(location=2) vec2 texCoord;
+in layout(location=4) mat4 instanceTransform;//Takes up locations 4-7. Same layout the transformationMatrix uniform gets (row major data read in as columns)
+in layout(location=8) vec4 instanceColor;
+
+out vec2 fragTexCoord;
+out vec4 fragColor;
+
+void main()
+{
+
+  gl_Position = vec4(position, 1.0) * instanceTransform;
+fragTexCoord = texCoord;
+fragColor = instanceColor;
+
+};
+
+)HereDoc";
+
+const char* instancedRectFragmentShaderCode =
+R"HereDoc(
+
+#version 430
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+out vec4 color;
+
+uniform sampler2D textureSlotToSampleFrom;
+uniform bool userWantsToDrawFromTexture;
+
+void main()
+{
+
+if(userWantsToDrawFromTexture)
+{
+ color = fragColor * texture(textureSlotToSampleFrom, fragTexCoord);
+}
+else
+{
+color = fragColor;
+};
+
+};
+
+)HereDoc";
+
 const char* textVertexShaderCode =
 R"HereDoc(
 
 #version 430
 
-in layout(location=0) vec3 unitSquareVerts;
+in layout(location=0) vec2 glyphPos_0To1;
+in layout(location=1) vec2 glyphTexCoordinates;
 
-uniform vec2 min_texCoordinates;
-uniform float width_texCoordinates;
-uniform float height_texCoordinates;
 uniform mat4 transformationMatrix;
-uniform vec2 charOffset_topLeft;
-uniform float widthOfChar_normalized;
-uniform float heightOfChar_normalized;
 
 out vec2 texCoordinates;
 
 void main()
 {
 
-float texCoordinates_x = (unitSquareVerts.x * width_texCoordinates) + min_texCoordinates.x;
-float texCoordinates_y = (unitSquareVerts.y * height_texCoordinates) + min_texCoordinates.y;
-texCoordinates = vec2(texCoordinates_x, texCoordinates_y);
+texCoordinates = glyphTexCoordinates;
 
-vec2 charPos_0To1;
-charPos_0To1.x = (unitSquareVerts.x * widthOfChar_normalized) + charOffset_topLeft.x;
-charPos_0To1.y = (unitSquareVerts.y * heightOfChar_normalized) + charOffset_topLeft.y;
-
-  gl_Position = vec4(charPos_0To1, 0.0, 1.0) * transformationMatrix;
+  gl_Position = vec4(glyphPos_0To1, 0.0, 1.0) * transformationMatrix;
 
 };
 
@@ -282,8 +325,54 @@ void DrawQuad(Array<v3, 4> quadVerts_objSpace, Array<v2, 2> uvs)
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
 };
 
-global_variable int basicShader{};
-global_variable int textShader{};
+#define SHADER_MAX_UNIFORMS 16
+
+struct Shader_Uniform
+{
+    char name[32];
+    GLint location;
+};
+
+//A linked program plus its active uniforms, enumerated once at creation so nothing has to look a uniform up by name while drawing
+struct Shader_Program
+{
+    int id{};
+    s32 uniformCount{};
+    Shader_Uniform uniforms[SHADER_MAX_UNIFORMS]{};
+};
+
+//Uniform locations each shader's draws use, resolved from the shader's uniform table right after it's created
+struct Basic_Shader_Uniforms
+{
+    GLint transformationMatrix;
+    GLint userWantsToDrawFromTexture;
+    GLint colorChange;
+};
+
+struct Text_Shader_Uniforms
+{
+    GLint transformationMatrix;
+};
+
+struct InstancedRect_Shader_Uniforms
+{
+    GLint userWantsToDrawFromTexture;
+};
+
+global_variable Shader_Program basicShader{};
+global_variable Shader_Program textShader{};
+global_variable Shader_Program instancedRectShader{};
+global_variable Basic_Shader_Uniforms basicShaderUniforms{};
+global_variable Text_Shader_Uniforms textShaderUniforms{};
+global_variable InstancedRect_Shader_Uniforms instancedRectShaderUniforms{};
+global_variable s32 uniformUpdateCount{};//Reset every frame, ends up in GPU_Frame_Stats
+global_variable s32 uniformLookupCount{};//Since the last frame's stats went out, so the first frame's include shader setup
+
+global_variable GLuint rectInstanceBufferID{};
+global_variable GLsizeiptr rectInstanceBufferSize{};
+
+global_variable GLuint textVertexBufferID{};
+global_variable GLsizeiptr textVertexBufferSize{};
 
 void CheckCompileStatus(GLuint shaderID)
 {
@@ -323,7 +412,7 @@ void CheckLinkStatus(GLuint programID)
     };
 };
 
-int CreateShader(const char* vertexShaderCode, const char* fragmentShaderCode)
+Shader_Program CreateShader(const char* vertexShaderCode, const char* fragmentShaderCode)
 {
     int result_shaderProgramID{};
     
@@ -348,52 +437,150 @@ int CreateShader(const char* vertexShaderCode, const char* fragmentShaderCode)
     
     CheckLinkStatus(result_shaderProgramID);
     
-    return result_shaderProgramID;
+    Shader_Program result{};
+    result.id = result_shaderProgramID;
+    
+    GLint activeUniformCount{}, maxUniformNameLength{};
+    glGetProgramiv(result.id, GL_ACTIVE_UNIFORMS, &activeUniformCount);
+    glGetProgramiv(result.id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxUniformNameLength);
+    BGZ_ASSERT(activeUniformCount <= SHADER_MAX_UNIFORMS);//, "Too many uniforms in shader!");
+    BGZ_ASSERT(maxUniformNameLength <= (GLint)sizeof(Shader_Uniform::name));//, "Uniform name too long!");
+    
+    for(GLint uniformIndex{}; uniformIndex < activeUniformCount; ++uniformIndex)
+    {
+        Shader_Uniform* uniform = &result.uniforms[result.uniformCount++];
+        
+        GLint size{};
+        GLenum type{};
+        glGetActiveUniform(result.id, uniformIndex, sizeof(uniform->name), 0, &size, &type, uniform->name);
+        uniform->location = glGetUniformLocation(result.id, uniform->name);
+        ++uniformLookupCount;
+    };
+    
+    return result;
 };
 
-void SetUniformValue_Bool(int shaderProgramID, const char* nameOfUniformInShader, bool boolVal)
+//Only meant for setup. Asserts if the uniform doesn't exist (or was optimized out of the shader)
+GLint UniformLocation(const Shader_Program& shader, const char* nameOfUniformInShader)
+{
+    for(s32 uniformIndex{}; uniformIndex < shader.uniformCount; ++uniformIndex)
+    {
+        if(StringCmp(shader.uniforms[uniformIndex].name, nameOfUniformInShader))
+            return shader.uniforms[uniformIndex].location;
+    };
+    
+    InvalidCodePath;
+    return -1;
+};
+
+void SetUniformValue_Bool(GLint uniformLocation, bool boolVal)
 {
-    GLint uniformLocation = glGetUniformLocation(shaderProgramID, nameOfUniformInShader);
     BGZ_ASSERT(uniformLocation != -1);
+    ++uniformUpdateCount;
     glUniform1i(uniformLocation, boolVal);
 };
 
 
-void SetUniformValue_Mat4(int shaderProgramID, const char* nameOfUniformInShader, Mat4x4 matrixData)
+void SetUniformValue_Mat4(GLint uniformLocation, Mat4x4 matrixData)
 {
-    GLint uniformLocation = glGetUniformLocation(shaderProgramID, nameOfUniformInShader);
     BGZ_ASSERT(uniformLocation != -1);
+    ++uniformUpdateCount;
     glUniformMatrix4fv(uniformLocation, 1, GL_FALSE, &matrixData.elem[0][0]);
 };
 
-void SetUniformValue_4fv(int shaderProgramID, const char* nameOfUniformInShader, v4 vecData)
+void SetUniformValue_4fv(GLint uniformLocation, v4 vecData)
 {
-    GLint uniformLocation = glGetUniformLocation(shaderProgramID, nameOfUniformInShader);
     BGZ_ASSERT(uniformLocation != -1);
+    ++uniformUpdateCount;
     glUniform4fv(uniformLocation, 1, &vecData.elem[0]);
 };
 
-void SetUniformValue_3fv(int shaderProgramID, const char* nameOfUniformInShader, v3 vecData)
+void SetUniformValue_3fv(GLint uniformLocation, v3 vecData)
 {
-    GLint uniformLocation = glGetUniformLocation(shaderProgramID, nameOfUniformInShader);
     BGZ_ASSERT(uniformLocation != -1);
+    ++uniformUpdateCount;
     glUniform3fv(uniformLocation, 1, &vecData.elem[0]);
 };
 
-void SetUniformValue_2fv(int shaderProgramID, const char* nameOfUniformInShader, v2 vecData)
+void SetUniformValue_2fv(GLint uniformLocation, v2 vecData)
 {
-    GLint uniformLocation = glGetUniformLocation(shaderProgramID, nameOfUniformInShader);
     BGZ_ASSERT(uniformLocation != -1);
+    ++uniformUpdateCount;
     glUniform2fv(uniformLocation, 1, &vecData.elem[0]);
 };
 
-void SetUniformValue_1f(int shaderProgramID, const char* nameOfUniformInShader, f32 floatVal)
+void SetUniformValue_1f(GLint uniformLocation, f32 floatVal)
 {
-    GLint uniformLocation = glGetUniformLocation(shaderProgramID, nameOfUniformInShader);
     BGZ_ASSERT(uniformLocation != -1);
+    ++uniformUpdateCount;
     glUniform1f(uniformLocation, floatVal);
 };
 
+local_func void UseProgram(Render_Bind_State&& bindState, GLuint program)
+{
+    if (RenderBindChanged($(bindState), $(bindState.program), program))
+        glUseProgram(program);
+};
+
+local_func void BindTexture(Render_Bind_State&& bindState, GLuint texture)
+{
+    if (RenderBindChanged($(bindState), $(bindState.texture), texture))
+        glBindTexture(GL_TEXTURE_2D, texture);
+};
+
+local_func void BindVertexArray(Render_Bind_State&& bindState, GLuint vertexArray)
+{
+    if (RenderBindChanged($(bindState), $(bindState.vertexArray), vertexArray))
+        glBindVertexArray(vertexArray);
+};
+
+local_func void DepthFunc(Render_Bind_State&& bindState, GLenum depthFunc)
+{
+    if (RenderBindChanged($(bindState), $(bindState.depthFunc), depthFunc))
+        glDepthFunc(depthFunc);
+};
+
+//Hooks the instance buffer up to the rect's vertex array (locations 4-8, advancing once per instance). The basic shader
+//doesn't read those locations so regular rect draws are unaffected
+local_func void AttachRectInstanceBuffer(u32 rectVertObjID)
+{
+    glGenBuffers(1, &rectInstanceBufferID);
+    
+    glBindVertexArray(rectVertObjID);
+    glBindBuffer(GL_ARRAY_BUFFER, rectInstanceBufferID);
+    
+    for (s32 row {}; row < 4; ++row)
+    {
+        glEnableVertexAttribArray(4 + row);
+        glVertexAttribPointer(4 + row, 4, GL_FLOAT, GL_FALSE, sizeof(GPU_RectInstance), (char*)(offsetof(GPU_RectInstance, transform) + sizeof(v4) * row));
+        glVertexAttribDivisor(4 + row, 1);
+    };
+    
+    glEnableVertexAttribArray(8);
+    glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, sizeof(GPU_RectInstance), (char*)offsetof(GPU_RectInstance, color));
+    glVertexAttribDivisor(8, 1);
+    
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+};
+
+//Repoints the text vertex array (set up by GPUCmd_SendBaseTextVertexData) at the streamed glyph vertices
+local_func void AttachTextVertexStream(u32 textVertObjID)
+{
+    glGenBuffers(1, &textVertexBufferID);
+    
+    glBindVertexArray(textVertObjID);
+    glBindBuffer(GL_ARRAY_BUFFER, textVertexBufferID);
+    
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(GPU_TextVertex), (char*)offsetof(GPU_TextVertex, pos_normalized));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GPU_TextVertex), (char*)offsetof(GPU_TextVertex, texCoords));
+    
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+};
+
 void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferToRender, bgz::Memory_Partition* platformMemoryPart, int windowWidth_pixels, int windowHeight_pixels)
 {
     local_persist bool glIsInitialized { false };
@@ -403,9 +590,26 @@ void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferT
         glIsInitialized = true;
         basicShader = CreateShader(basicVertexShaderCode, basicFragmentShaderCode);
         textShader = CreateShader(textVertexShaderCode, textFragmentShaderCode);
+        instancedRectShader = CreateShader(instancedRectVertexShaderCode, instancedRectFragmentShaderCode);
+        
+        basicShaderUniforms.transformationMatrix = UniformLocation(basicShader, "transformationMatrix");
+        basicShaderUniforms.userWantsToDrawFromTexture = UniformLocation(basicShader, "userWantsToDrawFromTexture");
+        basicShaderUniforms.colorChange = UniformLocation(basicShader, "colorChange");
+        
+        textShaderUniforms.transformationMatrix = UniformLocation(textShader, "transformationMatrix");
+        
+        instancedRectShaderUniforms.userWantsToDrawFromTexture = UniformLocation(instancedRectShader, "userWantsToDrawFromTexture");
     };
     
-    u8* currentRenderBufferEntry = bufferToRender.baseAddress;
+    uniformUpdateCount = 0;
+    
+    GPU_Frame_Stats frameStats {};
+    
+    bgz::ScopedMemory sortScope{platformMemoryPart};
+    Render_Sort_Entry* sortedEntries = SortRenderCmdBuffer(&bufferToRender, platformMemoryPart);
+    
+    Render_Bind_State bindState = BeginRenderBinds();
+    
     Camera3D camera3d = renderingInfo.camera3d;
     
     f32 pixelsPerMeter = renderingInfo._pixelsPerMeter;
@@ -427,6 +631,7 @@ void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferT
     
     for (s32 entryNumber = 0; entryNumber < bufferToRender.entryCount; ++entryNumber)
     {
+        u8* currentRenderBufferEntry = bufferToRender.baseAddress + sortedEntries[entryNumber].entryOffset;
         RenderEntry_Header* entryHeader = (RenderEntry_Header*)currentRenderBufferEntry;
         switch (entryHeader->type)
         {
@@ -474,8 +679,7 @@ void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferT
                 s64 size = vertexData.indicies.Size();
                 
                 glBindVertexArray(0);
-                
-                currentRenderBufferEntry += sizeof(RenderEntry_InitVertexData);
+                bindState.vertexArray = 0;
             }break;
             
             case EntryType_LoadTexture:
@@ -494,100 +698,178 @@ void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferT
                 glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, loadTexEntry.texture.width_pxls, loadTexEntry.texture.height_pxls, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, loadTexEntry.texture.data);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                
+                if (loadTexEntry.mipCount > 1)
+                {
+                    //Mips were generated on the cpu (see texture_cache.h) so just send each level down
+                    for (s32 mipLevel { 1 }; mipLevel < loadTexEntry.mipCount; ++mipLevel)
+                    {
+                        const Bitmap* mip = &loadTexEntry.mips[mipLevel];
+                        glTexImage2D(GL_TEXTURE_2D, mipLevel, GL_RGBA8, mip->width_pxls, mip->height_pxls, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, mip->data);
+                    };
+                    
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, loadTexEntry.mipCount - 1);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+                }
+                else
+                {
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                };
                 
                 //Enable alpha channel for transparency
                 glEnable(GL_BLEND);
                 glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
                 glBindTexture(GL_TEXTURE_2D, 0);
+                bindState.texture = 0;
+            }break;
+            
+            case EntryType_UpdateTexture:
+            {
+                RenderEntry_UpdateTexture updateTexEntry = *(RenderEntry_UpdateTexture*)currentRenderBufferEntry;
+                
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, updateTexEntry.id);
                 
-                currentRenderBufferEntry += sizeof(RenderEntry_LoadTexture);
+                //Re-specifying the whole image (instead of glTexSubImage2D) lets the texture change size
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, updateTexEntry.texture.width_pxls, updateTexEntry.texture.height_pxls, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, updateTexEntry.texture.data);
+                glBindTexture(GL_TEXTURE_2D, 0);
+                bindState.texture = 0;
             }break;
             
             case EntryType_DrawText:
             {
-                RenderEntry_DrawText textEntry = *(RenderEntry_DrawText*)currentRenderBufferEntry;
+                bgz::ScopedMemory scope{platformMemoryPart};
                 
-                Mat4x4 transformToNeg1To1Space =
+                //Every run of consecutive text entries (a whole overlay's worth usually) goes down as one draw
+                Render_Entry_Run textRun = GatherRenderEntryRun(&bufferToRender, sortedEntries, entryNumber);
+                s32 textEntryCount = textRun.entryCount, glyphCount = textRun.itemCount;
+                
+                GPU_TextVertex* verts = PushType(platformMemoryPart, GPU_TextVertex, glyphCount * 6);
+                s32 vertCount {};
+                for (s32 textEntryIndex {}; textEntryIndex < textEntryCount; ++textEntryIndex)
                 {
+                    RenderEntry_DrawText* textEntry = (RenderEntry_DrawText*)(bufferToRender.baseAddress + sortedEntries[entryNumber + textEntryIndex].entryOffset);
+                    Text_Glyph_Quad* glyphs = (Text_Glyph_Quad*)(textEntry + 1);
+                    
+                    for (s32 glyphIndex {}; glyphIndex < textEntry->glyphCount; ++glyphIndex)
                     {
-                        {2, 0, 0, -1},
-                        {0, 2, 0, -1},
-                        {0, 0, 1, 0},
-                        {0, 0, 0, 1}
-                    },
+                        Text_Glyph_Quad glyph = glyphs[glyphIndex];
+                        GPU_TextVertex bottomLeft = { glyph.minCorner_normalized, glyph.minCornerUV };
+                        GPU_TextVertex topLeft = { v2 { glyph.minCorner_normalized.x, glyph.maxCorner_normalized.y }, v2 { glyph.minCornerUV.x, glyph.maxCornerUV.y } };
+                        GPU_TextVertex topRight = { glyph.maxCorner_normalized, glyph.maxCornerUV };
+                        GPU_TextVertex bottomRight = { v2 { glyph.maxCorner_normalized.x, glyph.minCorner_normalized.y }, v2 { glyph.maxCornerUV.x, glyph.minCornerUV.y } };
+                        
+                        //Clockwise to match glFrontFace
+                        verts[vertCount++] = bottomLeft;
+                        verts[vertCount++] = topRight;
+                        verts[vertCount++] = bottomRight;
+                        verts[vertCount++] = bottomLeft;
+                        verts[vertCount++] = topLeft;
+                        verts[vertCount++] = topRight;
+                    };
                 };
                 
-                Mat4x4 fullTransformMatrix = transformToNeg1To1Space;
-                
-                glUseProgram(textShader);
-                
-                glBindTexture(GL_TEXTURE_2D, renderingInfo.textTextureID);
-                glBindVertexArray(renderingInfo.textVertObjID);
-                
-                SetUniformValue_Mat4(textShader, "transformationMatrix", fullTransformMatrix);
-                
-                for(int i{}; i < textEntry.characters.length; ++i)
+                if (vertCount)
                 {
-                    CharRenderInfo charToRender = textEntry.characters[i];
-                    f32 width_UV = charToRender.maxUV.x - charToRender.minUV.x;
-                    f32 height_UV = charToRender.maxUV.y - charToRender.minUV.y;
+                    if (NOT textVertexBufferID)
+                    {
+                        AttachTextVertexStream(renderingInfo.textVertObjID);
+                        bindState.vertexArray = 0;
+                    };
                     
-                    //Perform flip from top left origin/+y down to opengl's expected bottom left origin/+y up coord system
-                    charToRender.pos_pixelCoords.y = charToRender.textBaselinePos_y - (charToRender.pos_pixelCoords.y - charToRender.textBaselinePos_y);
-                    charToRender.pos_pixelCoords.y = (renderingInfo.heightOfScreen_pixels - charToRender.textBaselinePos_y) - (charToRender.textBaselinePos_y - charToRender.pos_pixelCoords.y);
-                    charToRender.minUV.y = charToRender.maxUV.y;
-                    height_UV = -height_UV;
+                    //Orphan + stream, same as the rect instance buffer
+                    GLsizeiptr vertDataSize = sizeof(GPU_TextVertex) * vertCount;
+                    glBindBuffer(GL_ARRAY_BUFFER, textVertexBufferID);
+                    if (vertDataSize > textVertexBufferSize)
+                        textVertexBufferSize = vertDataSize * 2;
+                    glBufferData(GL_ARRAY_BUFFER, textVertexBufferSize, 0, GL_STREAM_DRAW);
+                    glBufferSubData(GL_ARRAY_BUFFER, 0, vertDataSize, verts);
+                    glBindBuffer(GL_ARRAY_BUFFER, 0);
                     
-                    //Set to 0 to 1 values to match verts stored on GPU currently
-                    SetUniformValue_2fv(textShader, "charOffset_topLeft", v2{charToRender.pos_pixelCoords.x / renderingInfo.initialWidthOfScreen_pixels, charToRender.pos_pixelCoords.y / renderingInfo.initialHeightOfScreen_pixels});
-                    SetUniformValue_1f(textShader, "widthOfChar_normalized", charToRender.width_pixels / renderingInfo.initialWidthOfScreen_pixels);
-                    SetUniformValue_1f(textShader, "heightOfChar_normalized", charToRender.height_pixels / renderingInfo.initialHeightOfScreen_pixels);
-                    //Uv stuff
-                    SetUniformValue_2fv(textShader, "min_texCoordinates", charToRender.minUV);
-                    SetUniformValue_1f(textShader, "width_texCoordinates", width_UV);
-                    SetUniformValue_1f(textShader, "height_texCoordinates", height_UV);
+                    Mat4x4 transformToNeg1To1Space =
+                    {
+                        {
+                            {2, 0, 0, -1},
+                            {0, 2, 0, -1},
+                            {0, 0, 1, 0},
+                            {0, 0, 0, 1}
+                        },
+                    };
                     
-                    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
-                }
-                
-                glBindTexture(GL_TEXTURE_2D, 0);
-                glBindVertexArray(0);
-                glUseProgram(0);
+                    UseProgram($(bindState), textShader.id);
+                    
+                    BindTexture($(bindState), renderingInfo.textTextureID);
+                    BindVertexArray($(bindState), renderingInfo.textVertObjID);
+                    
+                    SetUniformValue_Mat4(textShaderUniforms.transformationMatrix, transformToNeg1To1Space);
+                    
+                    DepthFunc($(bindState), GL_ALWAYS);//Overlay, same as EntryType_DrawRectOverlay
+                    
+                    glDrawArrays(GL_TRIANGLES, 0, vertCount);
+                    
+                    ++frameStats.drawCalls;
+                    frameStats.glyphsDrawn += glyphCount;
+                    frameStats.vertsDrawn += vertCount;
+                    frameStats.bytesStreamed += vertDataSize;
+                };
                 
-                currentRenderBufferEntry += sizeof(RenderEntry_DrawText);
+                entryNumber += textEntryCount - 1;
             }break;
             
             case EntryType_DrawRect:
             {
-                RenderEntry_DrawRect rectEntry = *(RenderEntry_DrawRect*)currentRenderBufferEntry;
+                bgz::ScopedMemory scope{platformMemoryPart};
                 
-                Mat4x4 worldTransformMatrix = ProduceWorldTransformMatrix(rectEntry.worldTransform.translation, rectEntry.worldTransform.rotation, rectEntry.worldTransform.scale);
-                Mat4x4 fullTransformMatrix = projectionMatrix * camTransformMatrix * worldTransformMatrix;
+                //Every run of rects sharing a texture (sorting groups them) goes down as a single instanced draw. Instances are
+                //rasterized in order so depth testing/blending comes out the same as drawing them one at a time
+                u32 textureID = ((RenderEntry_DrawRect*)currentRenderBufferEntry)->textureID;
+                s32 instanceCount = GatherRenderEntryRun(&bufferToRender, sortedEntries, entryNumber).itemCount;
                 
-                bool userWantsToDrawFromTexture{};
-                if(rectEntry.textureID)
-                    userWantsToDrawFromTexture = true;
+                Mat4x4 viewProjectionMatrix = projectionMatrix * camTransformMatrix;
+                GPU_RectInstance* instances = PushType(platformMemoryPart, GPU_RectInstance, instanceCount);
+                for (s32 instanceIndex {}; instanceIndex < instanceCount; ++instanceIndex)
+                {
+                    RenderEntry_DrawRect* rectEntry = (RenderEntry_DrawRect*)(bufferToRender.baseAddress + sortedEntries[entryNumber + instanceIndex].entryOffset);
+                    
+                    Mat4x4 worldTransformMatrix = ProduceWorldTransformMatrix(rectEntry->worldTransform.translation, rectEntry->worldTransform.rotation, rectEntry->worldTransform.scale);
+                    instances[instanceIndex].transform = viewProjectionMatrix * worldTransformMatrix;
+                    instances[instanceIndex].color = rectEntry->color;
+                };
                 
-                glUseProgram(basicShader);
+                if (NOT rectInstanceBufferID)
+                {
+                    AttachRectInstanceBuffer(renderingInfo.rectVertObjID);
+                    bindState.vertexArray = 0;
+                };
                 
-                SetUniformValue_Mat4(basicShader, "transformationMatrix", fullTransformMatrix);
-                SetUniformValue_Bool(basicShader, "userWantsToDrawFromTexture", userWantsToDrawFromTexture);
-                SetUniformValue_4fv(basicShader, "colorChange", rectEntry.color);
+                //Orphan the old storage (driver hands back fresh memory instead of waiting on draws still reading it) and stream this run in
+                GLsizeiptr instanceDataSize = sizeof(GPU_RectInstance) * instanceCount;
+                glBindBuffer(GL_ARRAY_BUFFER, rectInstanceBufferID);
+                if (instanceDataSize > rectInstanceBufferSize)
+                    rectInstanceBufferSize = instanceDataSize * 2;
+                glBufferData(GL_ARRAY_BUFFER, rectInstanceBufferSize, 0, GL_STREAM_DRAW);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, instanceDataSize, instances);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
                 
-                glDepthFunc(GL_LESS);
+                UseProgram($(bindState), instancedRectShader.id);
                 
-                glBindTexture(GL_TEXTURE_2D, rectEntry.textureID);
-                glBindVertexArray(renderingInfo.rectVertObjID);
+                SetUniformValue_Bool(instancedRectShaderUniforms.userWantsToDrawFromTexture, textureID != 0);
                 
-                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
+                DepthFunc($(bindState), GL_LESS);
                 
-                glBindTexture(GL_TEXTURE_2D, 0);
-                glBindVertexArray(0);
-                glUseProgram(0);
+                BindTexture($(bindState), textureID);
+                BindVertexArray($(bindState), renderingInfo.rectVertObjID);
+                
+                glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0, instanceCount);
                 
-                currentRenderBufferEntry += sizeof(RenderEntry_DrawRect);
+                ++frameStats.drawCalls;
+                frameStats.rectsDrawn += instanceCount;
+                frameStats.vertsDrawn += 6 * instanceCount;
+                frameStats.bytesStreamed += instanceDataSize;
+                
+                entryNumber += instanceCount - 1;
             }break;
             
             case EntryType_DrawRectOverlay:
@@ -630,24 +912,21 @@ void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferT
                 if(rectEntryOverlay.textureID)
                     userWantsToDrawFromTexture = true;
                 
-                glUseProgram(basicShader);
+                UseProgram($(bindState), basicShader.id);
                 
-                SetUniformValue_Mat4(basicShader, "transformationMatrix", fullTransformMatrix);
-                SetUniformValue_Bool(basicShader, "userWantsToDrawFromTexture", userWantsToDrawFromTexture);
-                SetUniformValue_4fv(basicShader, "colorChange", rectEntryOverlay.colorChange);
+                SetUniformValue_Mat4(basicShaderUniforms.transformationMatrix, fullTransformMatrix);
+                SetUniformValue_Bool(basicShaderUniforms.userWantsToDrawFromTexture, userWantsToDrawFromTexture);
+                SetUniformValue_4fv(basicShaderUniforms.colorChange, rectEntryOverlay.colorChange);
                 
-                glDepthFunc(GL_ALWAYS);
+                DepthFunc($(bindState), GL_ALWAYS);
                 
-                glBindTexture(GL_TEXTURE_2D, rectEntryOverlay.textureID);
-                glBindVertexArray(renderingInfo.rectVertObjID);
+                BindTexture($(bindState), rectEntryOverlay.textureID);
+                BindVertexArray($(bindState), renderingInfo.rectVertObjID);
                 
                 glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
                 
-                glBindTexture(GL_TEXTURE_2D, 0);
-                glBindVertexArray(0);
-                glUseProgram(0);
-                
-                currentRenderBufferEntry += sizeof(RenderEntry_DrawRectOverlay);
+                ++frameStats.drawCalls;
+                frameStats.vertsDrawn += 6;
             }break;
             
             case EntryType_Line:
@@ -668,7 +947,6 @@ void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferT
                 glEnable(GL_TEXTURE_2D);
 #endif
                 
-                currentRenderBufferEntry += sizeof(RenderEntry_Line);
             }break;
             
             case EntryType_DrawCube:
@@ -682,24 +960,21 @@ void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferT
                 if(cube.textureID)
                     userWantsToDrawFromTexture = true;
                 
-                glUseProgram(basicShader);
+                UseProgram($(bindState), basicShader.id);
                 
-                SetUniformValue_Mat4(basicShader, "transformationMatrix", fullTransformMatrix);
-                SetUniformValue_Bool(basicShader, "userWantsToDrawFromTexture", userWantsToDrawFromTexture);
-                SetUniformValue_4fv(basicShader, "colorChange", cube.color);
+                SetUniformValue_Mat4(basicShaderUniforms.transformationMatrix, fullTransformMatrix);
+                SetUniformValue_Bool(basicShaderUniforms.userWantsToDrawFromTexture, userWantsToDrawFromTexture);
+                SetUniformValue_4fv(basicShaderUniforms.colorChange, cube.color);
                 
-                glDepthFunc(GL_LESS);
+                DepthFunc($(bindState), GL_LESS);
                 
-                glBindTexture(GL_TEXTURE_2D, cube.textureID);
-                glBindVertexArray(renderingInfo.cubeVertObjID);
+                BindTexture($(bindState), cube.textureID);
+                BindVertexArray($(bindState), renderingInfo.cubeVertObjID);
                 
                 glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, 0);
                 
-                glBindTexture(GL_TEXTURE_2D, 0);
-                glBindVertexArray(0);
-                glUseProgram(0);
-                
-                currentRenderBufferEntry += sizeof(RenderEntry_DrawCube);
+                ++frameStats.drawCalls;
+                frameStats.vertsDrawn += 36;
             }break;
             
             case EntryType_DrawMesh:
@@ -715,31 +990,40 @@ void RenderViaHardware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferT
                 if(meshEntry.textureID)
                     userWantsToDrawFromTexture = true;
                 
-                glUseProgram(basicShader);
+                UseProgram($(bindState), basicShader.id);
                 
-                SetUniformValue_Mat4(basicShader, "transformationMatrix", fullTransformMatrix);
-                SetUniformValue_Bool(basicShader, "userWantsToDrawFromTexture", userWantsToDrawFromTexture);
-                SetUniformValue_3fv(basicShader, "colorChange", v3{1.0f, 0.0f, 0.0f});
+                SetUniformValue_Mat4(basicShaderUniforms.transformationMatrix, fullTransformMatrix);
+                SetUniformValue_Bool(basicShaderUniforms.userWantsToDrawFromTexture, userWantsToDrawFromTexture);
+                SetUniformValue_3fv(basicShaderUniforms.colorChange, v3{1.0f, 0.0f, 0.0f});
                 
-                glDepthFunc(GL_LESS);
+                DepthFunc($(bindState), GL_LESS);
                 
-                glBindTexture(GL_TEXTURE_2D, meshEntry.textureID);
-                glBindVertexArray(meshEntry.meshID);
+                BindTexture($(bindState), meshEntry.textureID);
+                BindVertexArray($(bindState), meshEntry.meshID);
                 
                 glDrawElements(GL_TRIANGLES, meshEntry.renderIndexLength, GL_UNSIGNED_SHORT, 0);
                 
-                glBindTexture(GL_TEXTURE_2D, 0);
-                glBindVertexArray(0);
-                glUseProgram(0);
-                
-                currentRenderBufferEntry += sizeof(RenderEntry_DrawMesh);
+                ++frameStats.drawCalls;
+                frameStats.vertsDrawn += meshEntry.renderIndexLength;
             }break;
             
             InvalidDefaultCase;
         };
     }
     
+    //Leave gl the way entries used to leave it after each draw
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindVertexArray(0);
+    glUseProgram(0);
+    
+    frameStats.uniformUpdates = uniformUpdateCount;
+    frameStats.uniformLookups = uniformLookupCount;
+    frameStats.bindsIssued = bindState.bindsIssued;
+    frameStats.bindsAvoided = bindState.bindsAvoided;
+    renderingInfo.frameStats = frameStats;
     bufferToRender.entryCount = 0;
+    
+    uniformLookupCount = 0;
 };
 
 #endif //OPENGL_INCLUDE_H
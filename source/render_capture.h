@@ -0,0 +1,517 @@
+#ifndef RENDER_CAPTURE_INCLUDE
+#define RENDER_CAPTURE_INCLUDE
+
+/*
+    Records the command buffers the game hands the renderer into a binary stream that can be replayed later without a
+    gl context, so real gameplay frames can be rerun through the submission path on a machine with no gpu (see
+    render_replay.cpp).
+
+    Stream is a Render_Capture_Header, then per frame a Render_Capture_Frame followed by its entries in push order. Each
+    entry is a Render_Capture_Entry (sort key + sizes), the entry's bytes and then any cpu memory it points at (texture
+    pixels, vertex data) so a replayed frame doesn't depend on anything from the captured run still being around.
+    Everything in the stream starts 16 byte aligned. Entries are stored as is, so a capture only replays in a build
+    with the same entry layouts (bump RENDER_CAPTURE_VERSION when those change).
+
+    Texture and vertex data ids are handed out once for the life of the game so captures should start from the game's
+    first frame, otherwise the resource loads the later frames depend on are missing.
+*/
+
+#define RENDER_CAPTURE_MAGIC 0x50414352 //"RCAP"
+#define RENDER_CAPTURE_VERSION 2
+
+struct Render_Capture_Header
+{
+    u32 magic;
+    u32 version;
+    s32 frameCount;
+    s32 reserved;
+};
+
+//Everything from Rendering_Info the backends read while rendering
+struct Render_Capture_Frame
+{
+    i64 frameIndex;
+    s32 entryCount;
+    s32 entriesSize;//Bytes of Render_Capture_Entry records following this
+    s32 initialWidthOfScreen_pixels;
+    s32 initialHeightOfScreen_pixels;
+    s32 widthOfScreen_pixels;
+    s32 heightOfScreen_pixels;
+    Camera3D camera3d;
+    v3 clearColor;
+    b userWantsToClearDepthBuf;
+    f32 fov;
+    f32 aspectRatio;
+    f32 nearPlane;
+    f32 farPlane;
+    f32 pixelsPerMeter;
+    u32 textTextureID;
+    s32 textVertObjID;
+    s32 rectVertObjID;
+    s32 cubeVertObjID;
+};
+
+struct Render_Capture_Entry
+{
+    u64 key;
+    s32 recordSize;//This header, the entry and its data, padded
+    s32 entrySize;
+    s32 drawOrder;
+    s32 reserved;
+};
+
+struct Render_Capture
+{
+    u8* memory { nullptr };
+    i64 size {};
+    i64 usedAmount {};
+    s32 frameCount {};
+    b full { false };
+};
+
+struct Render_Capture_Reader
+{
+    u8* data { nullptr };
+    i64 size {};
+    i64 readOffset {};
+    s32 frameCount {};
+    s32 framesRead {};
+    i64 frameIndex {};//Of the last frame read
+};
+
+void BeginRenderCapture(Render_Capture&& capture, u8* memory, i64 memorySize);
+//Copies a frame (and the cpu memory its commands point at) into the capture. Has to be called before the frame's rendered
+//since backends reset the command buffer. Returns false once the capture's full, only whole frames are ever kept
+b CaptureRenderFrame(Render_Capture&& capture, const Rendering_Info& renderingInfo, const RenderCmdBuffer& cmdBuffer, i64 frameIndex);
+//Fills in the header. The finished capture is capture.usedAmount bytes at capture.memory
+void EndRenderCapture(Render_Capture&& capture);
+
+//Returns false if the data isn't a capture this build can replay. Data has to stay valid (and writable) while replaying
+b OpenRenderCapture(Render_Capture_Reader&& reader, u8* data, i64 size);
+void RewindRenderCapture(Render_Capture_Reader&& reader);
+//Rebuilds the next captured frame in cmdBuffer (baseAddress and size have to be set) the same way the game recorded it
+//and fills in the parts of renderingInfo the backends read. Returns false once there are no frames left
+b ReadCapturedFrame(Render_Capture_Reader&& reader, Rendering_Info&& renderingInfo, RenderCmdBuffer&& cmdBuffer);
+
+//Stats only backend. Walks the command buffer the way RenderViaHardware does (same sort, same batching into draws and
+//same redundant bind skipping) without touching gl, and fills in renderingInfo.frameStats like it would
+void RenderViaStats(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferToRender, bgz::Memory_Partition* memPart);
+
+#endif
+
+#ifdef RENDER_CAPTURE_IMPL
+
+//Bytes the entry takes up in the command buffer, not counting anything it points at
+local_func s32 _RenderEntrySize(const RenderEntry_Header* entryHeader)
+{
+    switch (entryHeader->type)
+    {
+        case EntryType_InitVertexData: return sizeof(RenderEntry_InitVertexData);
+        case EntryType_DrawRectOverlay: return sizeof(RenderEntry_DrawRectOverlay);
+        case EntryType_Line: return sizeof(RenderEntry_Line);
+        case EntryType_DrawRect: return sizeof(RenderEntry_DrawRect);
+        case EntryType_DrawText: return sizeof(RenderEntry_DrawText) + ((RenderEntry_DrawText*)entryHeader)->glyphCount * (s32)sizeof(Text_Glyph_Quad);
+        case EntryType_DrawRectOutline: return sizeof(RenderEntry_DrawRectOutline);
+        case EntryType_DrawCube: return sizeof(RenderEntry_DrawCube);
+        case EntryType_DrawMesh: return sizeof(RenderEntry_DrawMesh);
+        case EntryType_LoadTexture: return sizeof(RenderEntry_LoadTexture);
+        case EntryType_UpdateTexture: return sizeof(RenderEntry_UpdateTexture);
+        InvalidDefaultCase;
+    };
+
+    return 0;
+};
+
+//Same amount the hardware renderer hands gl
+local_func i64 _BitmapPixelsSize(const Bitmap& bitmap)
+{
+    return (i64)bitmap.width_pxls * bitmap.height_pxls * 4;
+};
+
+local_func void* _CapturePush(Render_Capture&& capture, const void* data, i64 size)
+{
+    i64 alignedSize = Align16(size);
+    if (capture.usedAmount + alignedSize > capture.size)
+        return nullptr;
+
+    void* result = capture.memory + capture.usedAmount;
+    memcpy(result, data, size);
+    capture.usedAmount += alignedSize;
+
+    return result;
+};
+
+void BeginRenderCapture(Render_Capture&& capture, u8* memory, i64 memorySize)
+{
+    capture = Render_Capture {};
+    capture.memory = memory;
+    capture.size = memorySize;
+
+    Render_Capture_Header header {};
+    header.magic = RENDER_CAPTURE_MAGIC;
+    header.version = RENDER_CAPTURE_VERSION;
+    _CapturePush($(capture), &header, sizeof(header));
+};
+
+b CaptureRenderFrame(Render_Capture&& capture, const Rendering_Info& renderingInfo, const RenderCmdBuffer& cmdBuffer, i64 frameIndex)
+{
+    if (capture.full)
+        return false;
+
+    i64 frameStart = capture.usedAmount;
+
+    Render_Capture_Frame frameHeader {};
+    frameHeader.frameIndex = frameIndex;
+    frameHeader.entryCount = cmdBuffer.entryCount;
+    frameHeader.initialWidthOfScreen_pixels = renderingInfo.initialWidthOfScreen_pixels;
+    frameHeader.initialHeightOfScreen_pixels = renderingInfo.initialHeightOfScreen_pixels;
+    frameHeader.widthOfScreen_pixels = renderingInfo.widthOfScreen_pixels;
+    frameHeader.heightOfScreen_pixels = renderingInfo.heightOfScreen_pixels;
+    frameHeader.camera3d = renderingInfo.camera3d;
+    frameHeader.clearColor = renderingInfo.clearColor;
+    frameHeader.userWantsToClearDepthBuf = renderingInfo.userWantsToClearDepthBuf;
+    frameHeader.fov = renderingInfo.fov;
+    frameHeader.aspectRatio = renderingInfo.aspectRatio;
+    frameHeader.nearPlane = renderingInfo.nearPlane;
+    frameHeader.farPlane = renderingInfo.farPlane;
+    frameHeader.pixelsPerMeter = renderingInfo._pixelsPerMeter;
+    frameHeader.textTextureID = renderingInfo.textTextureID;
+    frameHeader.textVertObjID = renderingInfo.textVertObjID;
+    frameHeader.rectVertObjID = renderingInfo.rectVertObjID;
+    frameHeader.cubeVertObjID = renderingInfo.cubeVertObjID;
+
+    Render_Capture_Frame* capturedFrame = (Render_Capture_Frame*)_CapturePush($(capture), &frameHeader, sizeof(frameHeader));
+    b fits = capturedFrame != nullptr;
+
+    //Sort entries were pushed down from the top of the buffer so the first entry pushed is the last one in memory
+    Render_Sort_Entry* pushedSortEntries = (Render_Sort_Entry*)(cmdBuffer.baseAddress + cmdBuffer.size);
+    for (s32 entryIndex { 1 }; fits && entryIndex <= cmdBuffer.entryCount; ++entryIndex)
+    {
+        Render_Sort_Entry sortEntry = pushedSortEntries[-entryIndex];
+        RenderEntry_Header* entryHeader = (RenderEntry_Header*)(cmdBuffer.baseAddress + sortEntry.entryOffset);
+
+        i64 recordStart = capture.usedAmount;
+        Render_Capture_Entry entryRecord {};
+        entryRecord.key = sortEntry.key;
+        entryRecord.drawOrder = sortEntry.drawOrder;
+        entryRecord.entrySize = _RenderEntrySize(entryHeader);
+        Render_Capture_Entry* capturedEntry = (Render_Capture_Entry*)_CapturePush($(capture), &entryRecord, sizeof(entryRecord));
+        fits = capturedEntry && _CapturePush($(capture), entryHeader, entryRecord.entrySize);
+
+        //Pointers in the captured entry are stale, replay points them at the data that follows
+        switch (entryHeader->type)
+        {
+            case EntryType_InitVertexData:
+            {
+                RenderEntry_InitVertexData* vertexData = (RenderEntry_InitVertexData*)entryHeader;
+                fits = fits && _CapturePush($(capture), vertexData->interleavedVertAttribData.elements, sizeof(f32) * vertexData->interleavedVertAttribData.Size());
+                fits = fits && _CapturePush($(capture), vertexData->indicies.elements, sizeof(s16) * vertexData->indicies.Size());
+            }break;
+
+            case EntryType_LoadTexture:
+            {
+                RenderEntry_LoadTexture* loadTexEntry = (RenderEntry_LoadTexture*)entryHeader;
+                if (loadTexEntry->mips)
+                {
+                    fits = fits && _CapturePush($(capture), loadTexEntry->mips, sizeof(Bitmap) * loadTexEntry->mipCount);
+                    for (s32 mipLevel {}; mipLevel < loadTexEntry->mipCount; ++mipLevel)
+                        fits = fits && _CapturePush($(capture), loadTexEntry->mips[mipLevel].data, _BitmapPixelsSize(loadTexEntry->mips[mipLevel]));
+                }
+                else
+                {
+                    fits = fits && _CapturePush($(capture), loadTexEntry->texture.data, _BitmapPixelsSize(loadTexEntry->texture));
+                };
+            }break;
+
+            case EntryType_UpdateTexture:
+            {
+                RenderEntry_UpdateTexture* updateTexEntry = (RenderEntry_UpdateTexture*)entryHeader;
+                fits = fits && _CapturePush($(capture), updateTexEntry->texture.data, _BitmapPixelsSize(updateTexEntry->texture));
+            }break;
+
+            default: break;
+        };
+
+        if (fits)
+            capturedEntry->recordSize = (s32)(capture.usedAmount - recordStart);
+    };
+
+    if (NOT fits)
+    {
+        capture.usedAmount = frameStart;
+        capture.full = true;
+        return false;
+    };
+
+    capturedFrame->entriesSize = (s32)(capture.usedAmount - frameStart - Align16(sizeof(Render_Capture_Frame)));
+    ++capture.frameCount;
+
+    return true;
+};
+
+void EndRenderCapture(Render_Capture&& capture)
+{
+    Render_Capture_Header* header = (Render_Capture_Header*)capture.memory;
+    header->frameCount = capture.frameCount;
+};
+
+b OpenRenderCapture(Render_Capture_Reader&& reader, u8* data, i64 size)
+{
+    reader = Render_Capture_Reader {};
+
+    Render_Capture_Header* header = (Render_Capture_Header*)data;
+    if (size < (i64)sizeof(Render_Capture_Header) || header->magic != RENDER_CAPTURE_MAGIC || header->version != RENDER_CAPTURE_VERSION)
+        return false;
+
+    reader.data = data;
+    reader.size = size;
+    reader.frameCount = header->frameCount;
+    RewindRenderCapture($(reader));
+
+    return true;
+};
+
+void RewindRenderCapture(Render_Capture_Reader&& reader)
+{
+    reader.readOffset = Align16(sizeof(Render_Capture_Header));
+    reader.framesRead = 0;
+    reader.frameIndex = 0;
+};
+
+local_func u8* _CaptureRead(Render_Capture_Reader&& reader, i64 size)
+{
+    BGZ_ASSERT(reader.readOffset + size <= reader.size);//, "Render capture is truncated!");
+
+    u8* result = reader.data + reader.readOffset;
+    reader.readOffset += Align16(size);
+
+    return result;
+};
+
+b ReadCapturedFrame(Render_Capture_Reader&& reader, Rendering_Info&& renderingInfo, RenderCmdBuffer&& cmdBuffer)
+{
+    if (reader.framesRead == reader.frameCount)
+        return false;
+
+    Render_Capture_Frame frameHeader = *(Render_Capture_Frame*)_CaptureRead($(reader), sizeof(Render_Capture_Frame));
+    reader.frameIndex = frameHeader.frameIndex;
+    ++reader.framesRead;
+
+    renderingInfo.initialWidthOfScreen_pixels = frameHeader.initialWidthOfScreen_pixels;
+    renderingInfo.initialHeightOfScreen_pixels = frameHeader.initialHeightOfScreen_pixels;
+    renderingInfo.widthOfScreen_pixels = frameHeader.widthOfScreen_pixels;
+    renderingInfo.heightOfScreen_pixels = frameHeader.heightOfScreen_pixels;
+    renderingInfo.camera3d = frameHeader.camera3d;
+    renderingInfo.clearColor = frameHeader.clearColor;
+    renderingInfo.userWantsToClearDepthBuf = frameHeader.userWantsToClearDepthBuf;
+    renderingInfo.fov = frameHeader.fov;
+    renderingInfo.aspectRatio = frameHeader.aspectRatio;
+    renderingInfo.nearPlane = frameHeader.nearPlane;
+    renderingInfo.farPlane = frameHeader.farPlane;
+    renderingInfo._pixelsPerMeter = frameHeader.pixelsPerMeter;
+    renderingInfo.textTextureID = frameHeader.textTextureID;
+    renderingInfo.textVertObjID = frameHeader.textVertObjID;
+    renderingInfo.rectVertObjID = frameHeader.rectVertObjID;
+    renderingInfo.cubeVertObjID = frameHeader.cubeVertObjID;
+
+    cmdBuffer.usedAmount = 0;
+    cmdBuffer.entryCount = 0;
+
+    for (s32 entryIndex {}; entryIndex < frameHeader.entryCount; ++entryIndex)
+    {
+        i64 recordStart = reader.readOffset;
+        Render_Capture_Entry entryRecord = *(Render_Capture_Entry*)_CaptureRead($(reader), sizeof(Render_Capture_Entry));
+        u8* capturedEntry = _CaptureRead($(reader), entryRecord.entrySize);
+
+        BGZ_ASSERT(cmdBuffer.usedAmount + entryRecord.entrySize <= cmdBuffer.size - (cmdBuffer.entryCount + 1) * (s32)sizeof(Render_Sort_Entry));//Not enough space on render buffer!"
+
+        Render_Sort_Entry* sortEntry = (Render_Sort_Entry*)(cmdBuffer.baseAddress + cmdBuffer.size) - (cmdBuffer.entryCount + 1);
+        sortEntry->key = entryRecord.key;
+        sortEntry->entryOffset = cmdBuffer.usedAmount;
+        sortEntry->drawOrder = entryRecord.drawOrder;
+        ++cmdBuffer.entryCount;
+
+        RenderEntry_Header* entryHeader = (RenderEntry_Header*)(cmdBuffer.baseAddress + cmdBuffer.usedAmount);
+        memcpy(entryHeader, capturedEntry, entryRecord.entrySize);
+        cmdBuffer.usedAmount += entryRecord.entrySize;
+
+        switch (entryHeader->type)
+        {
+            case EntryType_InitVertexData:
+            {
+                RenderEntry_InitVertexData* vertexData = (RenderEntry_InitVertexData*)entryHeader;
+                vertexData->interleavedVertAttribData.elements = (f32*)_CaptureRead($(reader), sizeof(f32) * vertexData->interleavedVertAttribData.Size());
+                vertexData->indicies.elements = (s16*)_CaptureRead($(reader), sizeof(s16) * vertexData->indicies.Size());
+            }break;
+
+            case EntryType_LoadTexture:
+            {
+                RenderEntry_LoadTexture* loadTexEntry = (RenderEntry_LoadTexture*)entryHeader;
+                if (loadTexEntry->mips)
+                {
+                    Bitmap* mips = (Bitmap*)_CaptureRead($(reader), sizeof(Bitmap) * loadTexEntry->mipCount);
+                    for (s32 mipLevel {}; mipLevel < loadTexEntry->mipCount; ++mipLevel)
+                        mips[mipLevel].data = _CaptureRead($(reader), _BitmapPixelsSize(mips[mipLevel]));
+
+                    loadTexEntry->mips = mips;
+                    loadTexEntry->texture.data = mips[0].data;
+                }
+                else
+                {
+                    loadTexEntry->texture.data = _CaptureRead($(reader), _BitmapPixelsSize(loadTexEntry->texture));
+                };
+            }break;
+
+            case EntryType_UpdateTexture:
+            {
+                RenderEntry_UpdateTexture* updateTexEntry = (RenderEntry_UpdateTexture*)entryHeader;
+                updateTexEntry->texture.data = _CaptureRead($(reader), _BitmapPixelsSize(updateTexEntry->texture));
+            }break;
+
+            default: break;
+        };
+
+        BGZ_ASSERT(reader.readOffset - recordStart == entryRecord.recordSize);//, "Render capture entry doesn't match this build's entry layouts!");
+    };
+
+    return true;
+};
+
+//Stand ins for the gl programs and depth funcs RenderViaHardware binds, only compared against each other
+enum Stats_Program
+{
+    StatsProgram_Basic = 1,
+    StatsProgram_Text,
+    StatsProgram_InstancedRect
+};
+
+enum Stats_Depth_Func
+{
+    StatsDepthFunc_Less = 1,
+    StatsDepthFunc_Always
+};
+
+void RenderViaStats(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferToRender, bgz::Memory_Partition* memPart)
+{
+    GPU_Frame_Stats frameStats {};
+
+    bgz::ScopedMemory sortScope{memPart};
+    Render_Sort_Entry* sortedEntries = SortRenderCmdBuffer(&bufferToRender, memPart);
+
+    Render_Bind_State bindState = BeginRenderBinds();
+
+    for (s32 entryNumber = 0; entryNumber < bufferToRender.entryCount; ++entryNumber)
+    {
+        u8* currentRenderBufferEntry = bufferToRender.baseAddress + sortedEntries[entryNumber].entryOffset;
+        RenderEntry_Header* entryHeader = (RenderEntry_Header*)currentRenderBufferEntry;
+        switch (entryHeader->type)
+        {
+            case EntryType_InitVertexData:
+            {
+                bindState.vertexArray = 0;
+            }break;
+
+            case EntryType_LoadTexture:
+            case EntryType_UpdateTexture:
+            {
+                bindState.texture = 0;
+            }break;
+
+            case EntryType_DrawText:
+            {
+                Render_Entry_Run textRun = GatherRenderEntryRun(&bufferToRender, sortedEntries, entryNumber);
+                s32 glyphCount = textRun.itemCount;
+                if (glyphCount)
+                {
+                    RenderBindChanged($(bindState), $(bindState.program), StatsProgram_Text);
+                    RenderBindChanged($(bindState), $(bindState.texture), renderingInfo.textTextureID);
+                    RenderBindChanged($(bindState), $(bindState.vertexArray), renderingInfo.textVertObjID);
+                    RenderBindChanged($(bindState), $(bindState.depthFunc), StatsDepthFunc_Always);
+
+                    ++frameStats.uniformUpdates;
+                    ++frameStats.drawCalls;
+                    frameStats.glyphsDrawn += glyphCount;
+                    frameStats.vertsDrawn += 6 * glyphCount;
+                    frameStats.bytesStreamed += sizeof(GPU_TextVertex) * 6 * glyphCount;
+                };
+
+                entryNumber += textRun.entryCount - 1;
+            }break;
+
+            case EntryType_DrawRect:
+            {
+                u32 textureID = ((RenderEntry_DrawRect*)currentRenderBufferEntry)->textureID;
+                s32 instanceCount = GatherRenderEntryRun(&bufferToRender, sortedEntries, entryNumber).itemCount;
+
+                RenderBindChanged($(bindState), $(bindState.program), StatsProgram_InstancedRect);
+                RenderBindChanged($(bindState), $(bindState.depthFunc), StatsDepthFunc_Less);
+                RenderBindChanged($(bindState), $(bindState.texture), textureID);
+                RenderBindChanged($(bindState), $(bindState.vertexArray), renderingInfo.rectVertObjID);
+
+                ++frameStats.uniformUpdates;
+                ++frameStats.drawCalls;
+                frameStats.rectsDrawn += instanceCount;
+                frameStats.vertsDrawn += 6 * instanceCount;
+                frameStats.bytesStreamed += sizeof(GPU_RectInstance) * instanceCount;
+
+                entryNumber += instanceCount - 1;
+            }break;
+
+            case EntryType_DrawRectOverlay:
+            {
+                RenderEntry_DrawRectOverlay* rectEntryOverlay = (RenderEntry_DrawRectOverlay*)currentRenderBufferEntry;
+
+                RenderBindChanged($(bindState), $(bindState.program), StatsProgram_Basic);
+                RenderBindChanged($(bindState), $(bindState.depthFunc), StatsDepthFunc_Always);
+                RenderBindChanged($(bindState), $(bindState.texture), rectEntryOverlay->textureID);
+                RenderBindChanged($(bindState), $(bindState.vertexArray), renderingInfo.rectVertObjID);
+
+                frameStats.uniformUpdates += 3;
+                ++frameStats.drawCalls;
+                frameStats.vertsDrawn += 6;
+            }break;
+
+            case EntryType_Line:
+            {
+                //Not drawn by the hardware renderer either
+            }break;
+
+            case EntryType_DrawCube:
+            {
+                RenderEntry_DrawCube* cube = (RenderEntry_DrawCube*)currentRenderBufferEntry;
+
+                RenderBindChanged($(bindState), $(bindState.program), StatsProgram_Basic);
+                RenderBindChanged($(bindState), $(bindState.depthFunc), StatsDepthFunc_Less);
+                RenderBindChanged($(bindState), $(bindState.texture), cube->textureID);
+                RenderBindChanged($(bindState), $(bindState.vertexArray), renderingInfo.cubeVertObjID);
+
+                frameStats.uniformUpdates += 3;
+                ++frameStats.drawCalls;
+                frameStats.vertsDrawn += 36;
+            }break;
+
+            case EntryType_DrawMesh:
+            {
+                RenderEntry_DrawMesh* meshEntry = (RenderEntry_DrawMesh*)currentRenderBufferEntry;
+
+                RenderBindChanged($(bindState), $(bindState.program), StatsProgram_Basic);
+                RenderBindChanged($(bindState), $(bindState.depthFunc), StatsDepthFunc_Less);
+                RenderBindChanged($(bindState), $(bindState.texture), meshEntry->textureID);
+                RenderBindChanged($(bindState), $(bindState.vertexArray), meshEntry->meshID);
+
+                frameStats.uniformUpdates += 3;
+                ++frameStats.drawCalls;
+                frameStats.vertsDrawn += meshEntry->renderIndexLength;
+            }break;
+
+            InvalidDefaultCase;
+        };
+    };
+
+    frameStats.bindsIssued = bindState.bindsIssued;
+    frameStats.bindsAvoided = bindState.bindsAvoided;
+    renderingInfo.frameStats = frameStats;
+    bufferToRender.entryCount = 0;
+};
+
+#endif //RENDER_CAPTURE_IMPL
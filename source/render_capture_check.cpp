@@ -0,0 +1,338 @@
+/*
+    Round trip check for render captures (see render_capture.h). Records a few frames through the same GPUCmd_ calls the
+    game makes (vertex data, plain and mipmapped textures, texture updates, world rects/cubes/meshes/lines and overlay
+    rects/text), captures them, reads them back and checks every replayed frame matches what was recorded: the frame's
+    rendering info, sort keys, entry bytes, the cpu memory entries point at and what the stats backend makes of it. Then
+    checks a capture that runs out of room keeps whole frames only. Prints every mismatch and returns 1 if there were any.
+
+    The capture can be written out too, so render_replay has something to replay on machines that can't run the game.
+
+    Usage: render_capture_check <ttf font file> [capture out file]
+*/
+
+#include "gamecode.cpp"
+#undef GAME_RENDERER_STUFF_IMPL
+#define PLATFORM_RENDERER_STUFF_IMPL
+#include "renderer_stuff.h"
+#include "render_capture.h"
+#define RENDER_CAPTURE_IMPL
+#include "render_capture.h"
+#include "cooker_platform.h"
+
+#define CHECK_FRAME_COUNT 4
+
+struct Check_Frame
+{
+    RenderCmdBuffer cmdBuffer;
+    Rendering_Info renderingInfo;
+    i64 captureSizeAfter;//Capture's usedAmount once this frame was captured
+};
+
+global_variable s32 globalCheckFailures;
+
+local_func void _CheckFailed(const char* what, s32 frameIndex, s32 entryIndex)
+{
+    fprintf(stderr, "Round trip mismatch: %s (frame %d, entry %d)\n", what, frameIndex, entryIndex);
+    ++globalCheckFailures;
+};
+
+//Checkerboard, different for every seed so updates and mips can be told apart
+local_func Bitmap _CheckBitmap(bgz::Memory_Partition* memPart, s32 width, s32 height, u32 seed)
+{
+    Bitmap bitmap {};
+    bitmap.width_pxls = width;
+    bitmap.height_pxls = height;
+    bitmap.pitch_pxls = width * BYTES_PER_PIXEL;
+    bitmap.aspectRatio = (f32)width / (f32)height;
+    bitmap.data = (u8*)PushType(memPart, u32, width * height);
+
+    u32* pixels = (u32*)bitmap.data;
+    for (s32 y {}; y < height; ++y)
+        for (s32 x {}; x < width; ++x)
+            pixels[y * width + x] = ((x / 4 + y / 4) & 1) ? 0xFF000000 | (seed * 0x00253FA1) : 0xFF808080 ^ seed;
+
+    return bitmap;
+};
+
+//Records what the game would for frameIndex. Resources only get sent on the first frame, same as the game, so the later
+//frames can't be replayed without it
+local_func void _RecordCheckFrame(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer, s32 frameIndex, bgz::Memory_Partition* memPart,
+                                  u32&& spriteTextureID, u32&& mippedTextureID)
+{
+    if (frameIndex == 0)
+    {
+        GPUCmd_SendCubeVertexData(renderingInfo, cmdBuffer, memPart, Color { 255, 0, 0, 255 });
+        GPUCmd_SendRectVertexData(renderingInfo, cmdBuffer, memPart, Color { 255, 0, 0 });
+        GPUCmd_SendFontAtlas(renderingInfo, cmdBuffer, memPart);
+
+        spriteTextureID = GPUCmd_SendTextureData(cmdBuffer, _CheckBitmap(memPart, 32, 16, 1));
+
+        Bitmap* mips = PushType(memPart, Bitmap, 3);
+        for (s32 mipLevel {}; mipLevel < 3; ++mipLevel)
+            mips[mipLevel] = _CheckBitmap(memPart, 16 >> mipLevel, 16 >> mipLevel, 2 + mipLevel);
+        mippedTextureID = GPUCmd_SendTextureData(cmdBuffer, mips, 3);
+    };
+
+    if (frameIndex == 2)
+        GPUCmd_UpdateTextureData(cmdBuffer, spriteTextureID, _CheckBitmap(memPart, 24, 24, 7));
+
+    GPUCmd_Clear(renderingInfo, Color { 100 + frameIndex, 120, 120 }, frameIndex == 0);
+    GPU_SetCamera3D(renderingInfo, v3 { (f32)frameIndex * .25f, 0.0f, -9.0f }, v3 { 0.0f, (f32)frameIndex * .05f, 0.0f });
+
+    //Rects sharing a depth and texture batch together, so some runs span several entries and some get split by texture
+    for (s32 rectIndex {}; rectIndex < 12; ++rectIndex)
+    {
+        Rect rect = CreateRect(1.0f + rectIndex * .1f, 1.0f, v2 { rectIndex * .5f - 3.0f, (f32)frameIndex * .1f }, Origin::BOTTOM_LEFT, Color { 255, rectIndex * 20, 0, 255 });
+        u32 textureID = rectIndex % 3 == 0 ? 0 : (rectIndex % 3 == 1 ? spriteTextureID : mippedTextureID);
+        GPUCmd_DrawRect(cmdBuffer, rect, (f32)(rectIndex / 4), textureID);
+    };
+
+    GPUCmd_DrawCube(cmdBuffer, CreateCube(v3 { .5f, .5f, .5f }, v3 { 1.0f, 1.0f, 2.0f }, Color { 0, 255, 0, 255 }), spriteTextureID);
+    GPUCmd_DrawMesh(cmdBuffer, renderingInfo->cubeVertObjID, mippedTextureID, Mat4x4 {}, 36);
+    GPUCmd_DrawLine(cmdBuffer, v2 { 0.0f, 0.0f }, v2 { 2.0f, 1.0f }, Color { 0, 0, 255 }, .1f);
+
+    GPUCmd_Overlay_DrawRect(cmdBuffer, CreateRect(200.0f, 50.0f, v2 { 10.0f, 10.0f }, Origin::BOTTOM_LEFT, Color { 0, 0, 0, 128 }), 0.0f, 0);
+
+    char text[64];
+    snprintf(text, sizeof(text), "Frame %d", frameIndex);
+    GPUCmd_Overlay_DrawText(renderingInfo, cmdBuffer, text, v2 { 10.0f, 10.0f }, 0.0f, (f32)renderingInfo->widthOfScreen_pixels);
+    GPUCmd_Overlay_DrawText(renderingInfo, cmdBuffer, "Round trip", v2 { 10.0f, 40.0f }, 0.0f, (f32)renderingInfo->widthOfScreen_pixels);
+};
+
+local_func b _SameBitmap(Bitmap recorded, Bitmap replayed)
+{
+    if (memcmp(recorded.data, replayed.data, _BitmapPixelsSize(recorded)) != 0)
+        return false;
+
+    recorded.data = replayed.data = nullptr;
+    return memcmp(&recorded, &replayed, sizeof(Bitmap)) == 0;
+};
+
+//Entry bytes have to match exactly except for pointers, which replay points at the capture's copy of what they pointed at
+local_func b _SameEntry(const RenderEntry_Header* recorded, const RenderEntry_Header* replayed)
+{
+    if (recorded->type != replayed->type)
+        return false;
+
+    switch (recorded->type)
+    {
+        case EntryType_InitVertexData:
+        {
+            RenderEntry_InitVertexData recordedData = *(RenderEntry_InitVertexData*)recorded;
+            RenderEntry_InitVertexData replayedData = *(RenderEntry_InitVertexData*)replayed;
+            if (recordedData.interleavedVertAttribData.Size() != replayedData.interleavedVertAttribData.Size() || recordedData.indicies.Size() != replayedData.indicies.Size())
+                return false;
+
+            if (memcmp(recordedData.interleavedVertAttribData.elements, replayedData.interleavedVertAttribData.elements, sizeof(f32) * recordedData.interleavedVertAttribData.Size()) != 0 ||
+                memcmp(recordedData.indicies.elements, replayedData.indicies.elements, sizeof(s16) * recordedData.indicies.Size()) != 0)
+                return false;
+
+            recordedData.interleavedVertAttribData.elements = replayedData.interleavedVertAttribData.elements = nullptr;
+            recordedData.indicies.elements = replayedData.indicies.elements = nullptr;
+            return memcmp(&recordedData, &replayedData, sizeof(RenderEntry_InitVertexData)) == 0;
+        };
+
+        case EntryType_LoadTexture:
+        {
+            RenderEntry_LoadTexture recordedTex = *(RenderEntry_LoadTexture*)recorded;
+            RenderEntry_LoadTexture replayedTex = *(RenderEntry_LoadTexture*)replayed;
+            if ((recordedTex.mips == nullptr) != (replayedTex.mips == nullptr) || recordedTex.mipCount != replayedTex.mipCount)
+                return false;
+
+            for (s32 mipLevel {}; recordedTex.mips && mipLevel < recordedTex.mipCount; ++mipLevel)
+            {
+                if (NOT _SameBitmap(recordedTex.mips[mipLevel], replayedTex.mips[mipLevel]))
+                    return false;
+            };
+
+            if (NOT _SameBitmap(recordedTex.texture, replayedTex.texture))
+                return false;
+
+            recordedTex.mips = replayedTex.mips = nullptr;
+            recordedTex.texture.data = replayedTex.texture.data = nullptr;
+            return memcmp(&recordedTex, &replayedTex, sizeof(RenderEntry_LoadTexture)) == 0;
+        };
+
+        case EntryType_UpdateTexture:
+        {
+            RenderEntry_UpdateTexture recordedTex = *(RenderEntry_UpdateTexture*)recorded;
+            RenderEntry_UpdateTexture replayedTex = *(RenderEntry_UpdateTexture*)replayed;
+            if (NOT _SameBitmap(recordedTex.texture, replayedTex.texture))
+                return false;
+
+            recordedTex.texture.data = replayedTex.texture.data = nullptr;
+            return memcmp(&recordedTex, &replayedTex, sizeof(RenderEntry_UpdateTexture)) == 0;
+        };
+
+        default:
+        {
+            return memcmp(recorded, replayed, _RenderEntrySize(recorded)) == 0;
+        };
+    };
+};
+
+//RenderViaStats empties the buffer it renders, so it gets a copy
+local_func GPU_Frame_Stats _StatsFor(Rendering_Info renderingInfo, RenderCmdBuffer cmdBuffer, bgz::Memory_Partition* memPart)
+{
+    RenderViaStats($(renderingInfo), $(cmdBuffer), memPart);
+    return renderingInfo.frameStats;
+};
+
+local_func void _CheckReplayedFrames(u8* captureData, i64 captureSize, Check_Frame* frames, s32 expectedFrameCount, RenderCmdBuffer&& replayBuffer, bgz::Memory_Partition* memPart)
+{
+    Render_Capture_Reader reader {};
+    if (NOT OpenRenderCapture($(reader), captureData, captureSize))
+    {
+        _CheckFailed("capture didn't open", -1, -1);
+        return;
+    };
+
+    if (reader.frameCount != expectedFrameCount)
+        _CheckFailed("frame count", reader.frameCount, -1);
+
+    Rendering_Info replayedInfo {};
+    s32 frameIndex {};
+    while (frameIndex < expectedFrameCount && ReadCapturedFrame($(reader), $(replayedInfo), $(replayBuffer)))
+    {
+        const Rendering_Info& recordedInfo = frames[frameIndex].renderingInfo;
+        const RenderCmdBuffer& recordedBuffer = frames[frameIndex].cmdBuffer;
+
+        if (reader.frameIndex != frameIndex)
+            _CheckFailed("frame index", frameIndex, -1);
+
+        if (replayedInfo.widthOfScreen_pixels != recordedInfo.widthOfScreen_pixels || replayedInfo.heightOfScreen_pixels != recordedInfo.heightOfScreen_pixels ||
+            memcmp(&replayedInfo.camera3d, &recordedInfo.camera3d, sizeof(Camera3D)) != 0 || memcmp(&replayedInfo.clearColor, &recordedInfo.clearColor, sizeof(v3)) != 0 ||
+            replayedInfo.userWantsToClearDepthBuf != recordedInfo.userWantsToClearDepthBuf || replayedInfo.fov != recordedInfo.fov ||
+            replayedInfo.textTextureID != recordedInfo.textTextureID || replayedInfo.textVertObjID != recordedInfo.textVertObjID ||
+            replayedInfo.rectVertObjID != recordedInfo.rectVertObjID || replayedInfo.cubeVertObjID != recordedInfo.cubeVertObjID)
+            _CheckFailed("rendering info", frameIndex, -1);
+
+        if (replayBuffer.entryCount != recordedBuffer.entryCount)
+        {
+            _CheckFailed("entry count", frameIndex, -1);
+        }
+        else
+        {
+            //Sort entries are in push order from the top of each buffer down
+            Render_Sort_Entry* recordedSortEntries = (Render_Sort_Entry*)(recordedBuffer.baseAddress + recordedBuffer.size);
+            Render_Sort_Entry* replayedSortEntries = (Render_Sort_Entry*)(replayBuffer.baseAddress + replayBuffer.size);
+            for (s32 entryIndex { 1 }; entryIndex <= recordedBuffer.entryCount; ++entryIndex)
+            {
+                if (recordedSortEntries[-entryIndex].key != replayedSortEntries[-entryIndex].key ||
+                    recordedSortEntries[-entryIndex].drawOrder != replayedSortEntries[-entryIndex].drawOrder)
+                    _CheckFailed("sort key", frameIndex, entryIndex - 1);
+
+                if (NOT _SameEntry((RenderEntry_Header*)(recordedBuffer.baseAddress + recordedSortEntries[-entryIndex].entryOffset),
+                                   (RenderEntry_Header*)(replayBuffer.baseAddress + replayedSortEntries[-entryIndex].entryOffset)))
+                    _CheckFailed("entry", frameIndex, entryIndex - 1);
+            };
+
+            GPU_Frame_Stats recordedStats = _StatsFor(recordedInfo, recordedBuffer, memPart);
+            GPU_Frame_Stats replayedStats = _StatsFor(replayedInfo, replayBuffer, memPart);
+            if (memcmp(&recordedStats, &replayedStats, sizeof(GPU_Frame_Stats)) != 0)
+                _CheckFailed("stats", frameIndex, -1);
+        };
+
+        ++frameIndex;
+    };
+
+    if (frameIndex != expectedFrameCount)
+        _CheckFailed("frames replayed", frameIndex, -1);
+};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: render_capture_check <ttf font file> [capture out file]\n");
+        return 1;
+    };
+
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    bgz::MemoryBlock checkMemory {};
+    void* checkMemoryPtr = malloc(Megabytes(64));
+    bgz::InitMemoryBlock($(checkMemory), Megabytes(64), Megabytes(1), checkMemoryPtr);
+    bgz::Memory_Partition* checkPart = bgz::CreatePartitionFromMemoryBlock($(checkMemory), Megabytes(60), "check");
+
+    Check_Frame* frames = PushType(checkPart, Check_Frame, CHECK_FRAME_COUNT);
+    Rendering_Info renderingInfo {};
+    global_renderingInfo = &renderingInfo;
+    renderingInfo.initialWidthOfScreen_pixels = renderingInfo.widthOfScreen_pixels = 1280;
+    renderingInfo.initialHeightOfScreen_pixels = renderingInfo.heightOfScreen_pixels = 720;
+    renderingInfo._pixelsPerMeter = 72.0f;
+    GPU_InitRenderer(&renderingInfo, 60.0f, 16.0f / 9.0f, .1f, 100.0f);
+    CreateFontAtlasFromFile_TTF(&renderingInfo, argv[1], 18);
+
+    i64 captureMemorySize = Megabytes(16);
+    u8* captureMemory = (u8*)malloc(captureMemorySize);
+    Render_Capture capture {};
+    BeginRenderCapture($(capture), captureMemory, captureMemorySize);
+
+    //Each frame keeps its own buffer so it can be compared against after the whole capture's been read back. Texture ids
+    //carry on from the frame before like they do in the game's one reused buffer
+    u32 spriteTextureID {}, mippedTextureID {}, textureCount {};
+    for (s32 frameIndex {}; frameIndex < CHECK_FRAME_COUNT; ++frameIndex)
+    {
+        Check_Frame* frame = &frames[frameIndex];
+        *frame = Check_Frame {};
+        frame->cmdBuffer.size = (s32)Megabytes(1);
+        frame->cmdBuffer.baseAddress = (u8*)PushSize(checkPart, frame->cmdBuffer.size);
+        frame->cmdBuffer.textureCount = textureCount;
+
+        _RecordCheckFrame(&renderingInfo, &frame->cmdBuffer, frameIndex, checkPart, $(spriteTextureID), $(mippedTextureID));
+        frame->renderingInfo = renderingInfo;
+        textureCount = frame->cmdBuffer.textureCount;
+
+        if (NOT CaptureRenderFrame($(capture), frame->renderingInfo, frame->cmdBuffer, frameIndex))
+            _CheckFailed("frame didn't fit", frameIndex, -1);
+
+        frame->captureSizeAfter = capture.usedAmount;
+    };
+    EndRenderCapture($(capture));
+
+    RenderCmdBuffer replayBuffer {};
+    replayBuffer.size = (s32)Megabytes(1);
+    replayBuffer.baseAddress = (u8*)PushSize(checkPart, replayBuffer.size);
+
+    _CheckReplayedFrames(capture.memory, capture.usedAmount, frames, CHECK_FRAME_COUNT, $(replayBuffer), checkPart);
+
+    if (argc > 2 && NOT Cooker_WriteEntireFile(argv[2], capture.memory, (ui32)capture.usedAmount))
+    {
+        fprintf(stderr, "Couldn't write %s!\n", argv[2]);
+        ++globalCheckFailures;
+    };
+
+    { //Room for the first frame and half the second. Frames that don't fit get dropped whole and so does everything after
+        i64 truncatedSize = frames[0].captureSizeAfter + (frames[1].captureSizeAfter - frames[0].captureSizeAfter) / 2;
+        Render_Capture truncatedCapture {};
+        BeginRenderCapture($(truncatedCapture), captureMemory, truncatedSize);
+
+        for (s32 frameIndex {}; frameIndex < CHECK_FRAME_COUNT; ++frameIndex)
+        {
+            i64 usedBefore = truncatedCapture.usedAmount;
+            b captured = CaptureRenderFrame($(truncatedCapture), frames[frameIndex].renderingInfo, frames[frameIndex].cmdBuffer, frameIndex);
+            if (captured != (frameIndex == 0))
+                _CheckFailed("truncated capture kept the wrong frames", frameIndex, -1);
+
+            if (NOT captured && truncatedCapture.usedAmount != usedBefore)
+                _CheckFailed("truncated capture kept part of a frame", frameIndex, -1);
+        };
+        EndRenderCapture($(truncatedCapture));
+
+        _CheckReplayedFrames(truncatedCapture.memory, truncatedCapture.usedAmount, frames, 1, $(replayBuffer), checkPart);
+    };
+
+    IsAllTempMemoryCleared(*checkPart);
+
+    if (globalCheckFailures)
+        fprintf(stderr, "Render capture round trip failed (%d mismatches)\n", globalCheckFailures);
+    else
+        printf("Render capture round trip ok (%d frames, %lld bytes)\n", CHECK_FRAME_COUNT, (long long)capture.usedAmount);
+
+    free(captureMemory);
+    free(checkMemoryPtr);
+
+    return globalCheckFailures ? 1 : 0;
+};
@@ -0,0 +1,171 @@
+#ifndef RENDER_FRAME_QUEUE_INCLUDE
+#define RENDER_FRAME_QUEUE_INCLUDE
+
+/*
+    Ring of render frames traded between the game thread (records commands) and the render thread (submits them to
+    gl). While the render thread is working through frame N the game can already be recording frame N + 1 into the
+    next command buffer, so simulation and submission overlap instead of running back to back.
+
+    Frames are always rendered in the order they were submitted. The game can only get maxFramesInFlight frames ahead
+    of the render thread (counting the one it's recording), so a cap of 1 is the old update-then-render behavior.
+    Anything a command points at instead of holding by value (bitmaps, vertex data) has to stay alive until the frame
+    it was recorded in has been released, which is what Rendering_Info::framesInFlight tells the game.
+
+    The queue itself only deals with ordering. Blocking goes through the Wait/Signal callbacks so the platform can
+    back them with whatever it has (auto reset events on win32).
+*/
+
+#define RENDER_FRAME_QUEUE_MAX_FRAMES 4
+
+struct Render_Frame
+{
+    RenderCmdBuffer cmdBuffer {}; //This frame's slice of the command buffer memory
+    Rendering_Info renderingInfo {}; //Copy of the game's renderingInfo (command buffer included) as of submit
+    i64 frameIndex {};
+};
+
+//Each signal only ever has one thread waiting on it. A signal with nobody waiting has to stay set until someone
+//waits, an extra wake up is fine since every wait rechecks the counters
+struct Render_Frame_Signals
+{
+    void* frameSubmitted { nullptr }; //Render thread waits on this
+    void* frameReleased { nullptr }; //Game thread waits on this
+    void (*Wait)(void* signal) { nullptr };
+    void (*Signal)(void* signal) { nullptr };
+};
+
+struct Render_Frame_Queue
+{
+    Render_Frame frames[RENDER_FRAME_QUEUE_MAX_FRAMES];
+    s32 frameCount {};
+    s32 maxFramesInFlight {}; //Only read by the game thread so it can be changed between frames
+    i64 volatile submittedCount {}; //Only written by the game thread
+    i64 volatile releasedCount {}; //Only written by the render thread
+    b volatile shuttingDown { false };
+    Render_Frame_Signals signals {};
+};
+
+void InitRenderFrameQueue(Render_Frame_Queue&& queue, u8* cmdBufferMemory, i64 cmdBufferMemorySize, s32 frameCount, s32 maxFramesInFlight,
+                          Render_Frame_Signals signals);
+//Game thread. Blocks until the latency cap allows another frame then points renderingInfo at its command buffer
+Render_Frame* BeginRenderFrame(Render_Frame_Queue&& queue, Rendering_Info&& renderingInfo);
+void SubmitRenderFrame(Render_Frame_Queue&& queue, Render_Frame* frame, const Rendering_Info& renderingInfo);
+//Game thread. Blocks until everything submitted has been rendered, for when something needs to write memory the render thread reads
+void FlushRenderFrames(Render_Frame_Queue&& queue);
+//Game thread. Whatever's already been submitted still gets rendered
+void ShutdownRenderFrameQueue(Render_Frame_Queue&& queue);
+//Render thread. Blocks until the next frame is submitted. Returns null once the queue is shut down and drained
+Render_Frame* AcquireRenderFrame(Render_Frame_Queue&& queue);
+//Render thread. The frame's command buffer (and anything its commands point at) can be reused once this is called
+void ReleaseRenderFrame(Render_Frame_Queue&& queue, Render_Frame* frame);
+
+#endif
+
+#ifdef RENDER_FRAME_QUEUE_IMPL
+
+void InitRenderFrameQueue(Render_Frame_Queue&& queue, u8* cmdBufferMemory, i64 cmdBufferMemorySize, s32 frameCount, s32 maxFramesInFlight,
+                          Render_Frame_Signals signals)
+{
+    BGZ_ASSERT(frameCount > 0 && frameCount <= RENDER_FRAME_QUEUE_MAX_FRAMES);//, "Unsupported render frame count!");
+    BGZ_ASSERT(maxFramesInFlight > 0 && maxFramesInFlight <= frameCount);//, "Can't have more frames in flight than command buffers!");
+    BGZ_ASSERT(signals.Wait && signals.Signal);
+
+    queue.frameCount = frameCount;
+    queue.maxFramesInFlight = maxFramesInFlight;
+    queue.submittedCount = 0;
+    queue.releasedCount = 0;
+    queue.shuttingDown = false;
+    queue.signals = signals;
+
+    s32 cmdBufferSize = (s32)((cmdBufferMemorySize / frameCount) & ~15);
+    for (s32 frameIndex {}; frameIndex < frameCount; ++frameIndex)
+    {
+        Render_Frame* frame = &queue.frames[frameIndex];
+        frame->cmdBuffer = RenderCmdBuffer {};
+        frame->cmdBuffer.baseAddress = cmdBufferMemory + (i64)frameIndex * cmdBufferSize;
+        frame->cmdBuffer.size = cmdBufferSize;
+    };
+};
+
+Render_Frame* BeginRenderFrame(Render_Frame_Queue&& queue, Rendering_Info&& renderingInfo)
+{
+    s32 maxFramesInFlight = queue.maxFramesInFlight < 1 ? 1 : queue.maxFramesInFlight;
+    maxFramesInFlight = maxFramesInFlight > queue.frameCount ? queue.frameCount : maxFramesInFlight;
+
+    i64 frameIndex = queue.submittedCount;
+    i64 releasedCount = queue.releasedCount;
+    while ((frameIndex + 1) - releasedCount > maxFramesInFlight)
+    {
+        queue.signals.Wait(queue.signals.frameReleased);
+        releasedCount = queue.releasedCount;
+    };
+
+    //Newest finished frame can't be touched by the render thread anymore and isn't reused until this frame is submitted
+    if (releasedCount > 0)
+        renderingInfo.frameStats = queue.frames[(releasedCount - 1) % queue.frameCount].renderingInfo.frameStats;
+
+    Render_Frame* frame = &queue.frames[frameIndex % queue.frameCount];
+    frame->frameIndex = frameIndex;
+    frame->cmdBuffer.usedAmount = 0;
+    frame->cmdBuffer.entryCount = 0;
+
+    //Texture ids are handed out for the life of the game, not per command buffer
+    u32 textureCount = renderingInfo.gameCmdBuffer.textureCount;
+    renderingInfo.gameCmdBuffer = frame->cmdBuffer;
+    renderingInfo.gameCmdBuffer.textureCount = textureCount;
+    renderingInfo.framesInFlight = (s32)(frameIndex - releasedCount);
+
+    return frame;
+};
+
+void SubmitRenderFrame(Render_Frame_Queue&& queue, Render_Frame* frame, const Rendering_Info& renderingInfo)
+{
+    BGZ_ASSERT(frame->frameIndex == queue.submittedCount);//, "Render frames have to be submitted in the order they were begun!");
+    BGZ_ASSERT(renderingInfo.gameCmdBuffer.baseAddress == frame->cmdBuffer.baseAddress);//, "Commands weren't recorded into this frame's buffer!");
+
+    frame->renderingInfo = renderingInfo;
+
+    _mm_sfence(); //Frame has to be completely written before the render thread can see it
+    queue.submittedCount = frame->frameIndex + 1;
+    queue.signals.Signal(queue.signals.frameSubmitted);
+};
+
+void FlushRenderFrames(Render_Frame_Queue&& queue)
+{
+    while (queue.releasedCount != queue.submittedCount)
+        queue.signals.Wait(queue.signals.frameReleased);
+};
+
+void ShutdownRenderFrameQueue(Render_Frame_Queue&& queue)
+{
+    queue.shuttingDown = true;
+    queue.signals.Signal(queue.signals.frameSubmitted);
+};
+
+Render_Frame* AcquireRenderFrame(Render_Frame_Queue&& queue)
+{
+    i64 frameIndex = queue.releasedCount;
+    while (queue.submittedCount == frameIndex)
+    {
+        if (queue.shuttingDown)
+            return nullptr;
+
+        queue.signals.Wait(queue.signals.frameSubmitted);
+    };
+
+    Render_Frame* frame = &queue.frames[frameIndex % queue.frameCount];
+    BGZ_ASSERT(frame->frameIndex == frameIndex);//, "Render frame ring got out of order!");
+
+    return frame;
+};
+
+void ReleaseRenderFrame(Render_Frame_Queue&& queue, Render_Frame* frame)
+{
+    BGZ_ASSERT(frame->frameIndex == queue.releasedCount);//, "Render frames have to be released in the order they were acquired!");
+
+    _mm_sfence(); //Gpu stats written while rendering have to land before the game can read them
+    queue.releasedCount = frame->frameIndex + 1;
+    queue.signals.Signal(queue.signals.frameReleased);
+};
+
+#endif //RENDER_FRAME_QUEUE_IMPL
@@ -0,0 +1,297 @@
+/*
+    Check for render_frame_queue.h that runs without a window or gl. A game thread records frames through GPUCmd_DrawRect
+    while a render thread hands them to a no-op recording backend, the way win64_test.cpp runs the real game and gl
+    backend. Frame N gets N + 1 rects, each one's color saying which frame recorded it. Checks:
+        - Frames are rendered once each, in submit order
+        - The render thread sees every entry the game wrote before submitting (the submit fence), and none of them
+          change while it's rendering (the game never records into a frame that's still in flight)
+        - The game never gets more than maxFramesInFlight frames ahead of the render thread
+        - Stats handed back by BeginRenderFrame come from a frame that was rendered, newer each time (the release fence)
+        - FlushRenderFrames returns with everything submitted rendered
+    Runs at every in flight cap with random delays on both sides, then times each cap with fixed update/render costs to
+    show how much overlap it buys. Prints every failure and returns 1 if there were any.
+
+    Usage: render_frame_queue_check [frames per run]
+*/
+
+//Before gamecode.cpp, its macros break the std threading headers
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <random>
+
+#include "gamecode.cpp"
+#undef GAME_RENDERER_STUFF_IMPL
+#define PLATFORM_RENDERER_STUFF_IMPL
+#include "renderer_stuff.h"
+#include "render_frame_queue.h"
+#define RENDER_FRAME_QUEUE_IMPL
+#include "render_frame_queue.h"
+#include "render_capture.h"
+#define RENDER_CAPTURE_IMPL
+#include "render_capture.h"
+#include "cooker_platform.h"
+
+#define CHECK_FRAME_FLUSH_INTERVAL 97
+
+//Auto reset event, same as the win32 platform layer's
+struct Check_Signal
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    b set { false };
+};
+
+local_func void _WaitForCheckSignal(void* signal)
+{
+    Check_Signal* checkSignal = (Check_Signal*)signal;
+    std::unique_lock<std::mutex> lock { checkSignal->mutex };
+    checkSignal->condition.wait(lock, [checkSignal] { return checkSignal->set; });
+    checkSignal->set = false;
+};
+
+local_func void _SetCheckSignal(void* signal)
+{
+    Check_Signal* checkSignal = (Check_Signal*)signal;
+    {
+        std::lock_guard<std::mutex> lock { checkSignal->mutex };
+        checkSignal->set = true;
+    };
+    checkSignal->condition.notify_one();
+};
+
+//Delays are in microseconds. Negative spins for exactly that long (steady timing), positive sleeps a random amount up to it
+struct Check_Run
+{
+    s32 frameCount;
+    s32 maxFramesInFlight;
+    s32 framesToRender;
+    s32 updateDelay_us;
+    s32 renderDelay_us;
+};
+
+struct Check_Render_Thread_Info
+{
+    Render_Frame_Queue* queue;
+    bgz::Memory_Partition* renderPart;
+    Check_Run run;
+    i64* renderedFrames;//Frame indices in the order they were rendered
+    s32 renderedCount;
+    i64 mostFramesAhead;//Most frames submitted and not released yet the render thread saw
+};
+
+global_variable std::atomic<s32> globalCheckFailures;
+
+local_func void _CheckFailed(const char* what, i64 frameIndex)
+{
+    fprintf(stderr, "Render frame queue check failed: %s (frame %lld)\n", what, (long long)frameIndex);
+    ++globalCheckFailures;
+};
+
+local_func void _CheckDelay(s32 delay_us, std::minstd_rand&& random)
+{
+    if (delay_us < 0)
+    {
+        auto endTime = std::chrono::steady_clock::now() + std::chrono::microseconds(-delay_us);
+        while (std::chrono::steady_clock::now() < endTime)
+            ;
+    }
+    else if (delay_us > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(random() % delay_us));
+    };
+};
+
+local_func f32 _RectColorFor(i64 frameIndex)
+{
+    return (f32)(frameIndex % 251) / 255.0f;
+};
+
+local_func void _RecordCheckFrame(Rendering_Info* renderingInfo, i64 frameIndex)
+{
+    for (s32 rectIndex {}; rectIndex <= frameIndex; ++rectIndex)
+    {
+        Rect rect = CreateRect(1.0f, 1.0f, v2 { (f32)rectIndex, 0.0f }, Origin::BOTTOM_LEFT, Color { 255, 255, 255, 255 });
+        GPUCmd_DrawRect(&renderingInfo->gameCmdBuffer, rect, 0.0f, 0);
+
+        //Tagged after the fact, Color only has 8 bits a channel
+        RenderEntry_DrawRect* rectEntry = (RenderEntry_DrawRect*)(renderingInfo->gameCmdBuffer.baseAddress + renderingInfo->gameCmdBuffer.usedAmount) - 1;
+        rectEntry->color.r = _RectColorFor(frameIndex);
+    };
+};
+
+//Whether every entry in the frame is one of the rects the game recorded for it
+local_func b _FrameHoldsWhatWasRecorded(const Render_Frame* frame)
+{
+    const RenderCmdBuffer& cmdBuffer = frame->renderingInfo.gameCmdBuffer;
+    if (cmdBuffer.entryCount != frame->frameIndex + 1)
+        return false;
+
+    for (s32 entryIndex {}; entryIndex < cmdBuffer.entryCount; ++entryIndex)
+    {
+        RenderEntry_DrawRect* rectEntry = (RenderEntry_DrawRect*)cmdBuffer.baseAddress + entryIndex;
+        if (rectEntry->header.type != EntryType_DrawRect || rectEntry->color.r != _RectColorFor(frame->frameIndex))
+            return false;
+    };
+
+    return true;
+};
+
+//No-op recording backend. Doesn't draw anything, just checks and records what it was handed and fills in frame stats
+//through the stats backend like the gl one would
+local_func void _RenderCheckThread(Check_Render_Thread_Info* info)
+{
+    std::minstd_rand random { 2 };
+    while (Render_Frame* frame = AcquireRenderFrame($(*info->queue)))
+    {
+        i64 framesAhead = info->queue->submittedCount - frame->frameIndex;
+        info->mostFramesAhead = framesAhead > info->mostFramesAhead ? framesAhead : info->mostFramesAhead;
+
+        if (NOT _FrameHoldsWhatWasRecorded(frame))
+            _CheckFailed("render thread didn't see everything recorded before submit", frame->frameIndex);
+
+        _CheckDelay(info->run.renderDelay_us, $(random));
+
+        if (NOT _FrameHoldsWhatWasRecorded(frame))
+            _CheckFailed("frame was written to while in flight", frame->frameIndex);
+
+        if (info->renderedCount < info->run.framesToRender)
+            info->renderedFrames[info->renderedCount] = frame->frameIndex;
+        ++info->renderedCount;
+
+        RenderViaStats($(frame->renderingInfo), $(frame->renderingInfo.gameCmdBuffer), info->renderPart);
+        ReleaseRenderFrame($(*info->queue), frame);
+    };
+};
+
+//Returns how long the run took
+local_func f64 _RunQueueCheck(Check_Run run, u8* cmdBufferMemory, i64 cmdBufferMemorySize, bgz::Memory_Partition* renderPart, i64* renderedFrames)
+{
+    Check_Signal frameSubmitted {}, frameReleased {};
+    Render_Frame_Signals signals {};
+    signals.frameSubmitted = &frameSubmitted;
+    signals.frameReleased = &frameReleased;
+    signals.Wait = &_WaitForCheckSignal;
+    signals.Signal = &_SetCheckSignal;
+
+    Render_Frame_Queue queue {};
+    InitRenderFrameQueue($(queue), cmdBufferMemory, cmdBufferMemorySize, run.frameCount, run.maxFramesInFlight, signals);
+
+    Check_Render_Thread_Info renderThreadInfo {};
+    renderThreadInfo.queue = &queue;
+    renderThreadInfo.renderPart = renderPart;
+    renderThreadInfo.run = run;
+    renderThreadInfo.renderedFrames = renderedFrames;
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::thread renderThread { _RenderCheckThread, &renderThreadInfo };
+
+    Rendering_Info renderingInfo {};
+    std::minstd_rand random { 1 };
+    i64 lastStatsFrame { -1 };
+    for (i64 frameIndex {}; frameIndex < run.framesToRender; ++frameIndex)
+    {
+        Render_Frame* frame = BeginRenderFrame($(queue), $(renderingInfo));
+
+        if (renderingInfo.framesInFlight > run.maxFramesInFlight - 1)
+            _CheckFailed("game got further ahead than the in flight cap", frameIndex);
+
+        //Frame N draws N + 1 rects, all batched into one draw
+        if (renderingInfo.frameStats.drawCalls)
+        {
+            i64 statsFrame = renderingInfo.frameStats.rectsDrawn - 1;
+            if (statsFrame < lastStatsFrame || statsFrame >= frameIndex)
+                _CheckFailed("stats handed back aren't from the newest rendered frame", frameIndex);
+
+            lastStatsFrame = statsFrame;
+        }
+        else if (frameIndex > run.maxFramesInFlight)
+        {
+            _CheckFailed("no stats handed back", frameIndex);
+        };
+
+        _RecordCheckFrame(&renderingInfo, frameIndex);
+        _CheckDelay(run.updateDelay_us, $(random));
+        SubmitRenderFrame($(queue), frame, renderingInfo);
+
+        if (frameIndex % CHECK_FRAME_FLUSH_INTERVAL == 0)
+        {
+            FlushRenderFrames($(queue));
+            if (queue.releasedCount != frameIndex + 1)
+                _CheckFailed("flush returned before everything submitted was rendered", frameIndex);
+        };
+    };
+
+    ShutdownRenderFrameQueue($(queue));
+    renderThread.join();
+    f64 runSecs = std::chrono::duration<f64>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (renderThreadInfo.renderedCount != run.framesToRender)
+        _CheckFailed("frames rendered", renderThreadInfo.renderedCount);
+
+    for (s32 frameIndex {}; frameIndex < run.framesToRender && frameIndex < renderThreadInfo.renderedCount; ++frameIndex)
+    {
+        if (renderedFrames[frameIndex] != frameIndex)
+        {
+            _CheckFailed("frames rendered out of order", frameIndex);
+            break;
+        };
+    };
+
+    if (renderThreadInfo.mostFramesAhead > run.maxFramesInFlight)
+        _CheckFailed("render thread saw more frames in flight than the cap", renderThreadInfo.mostFramesAhead);
+
+    IsAllTempMemoryCleared(*renderPart);
+
+    return runSecs;
+};
+
+int main(int argc, char** argv)
+{
+    s32 framesPerRun = argc > 1 ? atoi(argv[1]) : 500;
+    framesPerRun = framesPerRun < 1 ? 1 : framesPerRun;
+
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    bgz::MemoryBlock checkMemory {};
+    void* checkMemoryPtr = malloc(Megabytes(16));
+    bgz::InitMemoryBlock($(checkMemory), Megabytes(16), Megabytes(1), checkMemoryPtr);
+    bgz::Memory_Partition* renderPart = bgz::CreatePartitionFromMemoryBlock($(checkMemory), Megabytes(14), "render");
+
+    //Enough for the biggest frame in every command buffer
+    i64 cmdBufferMemorySize = (i64)RENDER_FRAME_QUEUE_MAX_FRAMES * Align16((framesPerRun + 1) * (sizeof(RenderEntry_DrawRect) + sizeof(Render_Sort_Entry)));
+    u8* cmdBufferMemory = (u8*)malloc(cmdBufferMemorySize);
+    i64* renderedFrames = (i64*)malloc(sizeof(i64) * framesPerRun);
+
+    for (s32 frameCount { 1 }; frameCount <= RENDER_FRAME_QUEUE_MAX_FRAMES; ++frameCount)
+    {
+        for (s32 maxFramesInFlight { 1 }; maxFramesInFlight <= frameCount; ++maxFramesInFlight)
+        {
+            Check_Run run { frameCount, maxFramesInFlight, framesPerRun, 200, 200 };
+            _RunQueueCheck(run, cmdBufferMemory, cmdBufferMemorySize * frameCount / RENDER_FRAME_QUEUE_MAX_FRAMES, renderPart, renderedFrames);
+        };
+    };
+
+    printf("Frames in flight, ms per frame (2 ms update, 1.5 ms render)\n");
+    for (s32 maxFramesInFlight { 1 }; maxFramesInFlight <= 3; ++maxFramesInFlight)
+    {
+        s32 timedFrames = framesPerRun < 200 ? framesPerRun : 200;
+        Check_Run run { 3, maxFramesInFlight, timedFrames, -2000, -1500 };
+        f64 runSecs = _RunQueueCheck(run, cmdBufferMemory, cmdBufferMemorySize * 3 / RENDER_FRAME_QUEUE_MAX_FRAMES, renderPart, renderedFrames);
+        printf("%d, %.2f\n", maxFramesInFlight, runSecs * 1000.0 / timedFrames);
+    };
+
+    if (globalCheckFailures)
+        fprintf(stderr, "Render frame queue check failed (%d failures)\n", (s32)globalCheckFailures);
+    else
+        printf("Render frame queue ok\n");
+
+    free(renderedFrames);
+    free(cmdBufferMemory);
+    free(checkMemoryPtr);
+
+    return globalCheckFailures ? 1 : 0;
+};
@@ -0,0 +1,154 @@
+/*
+    Offline tool that replays a render capture (see render_capture.h) through the stats only backend, so no gl context
+    or gpu is needed. The first pass prints every frame's counts, which only change when what the game records or how
+    the renderer batches it changes, so they can be diffed against a known good run. Then prints the best time out of
+    all the passes for catching perf regressions in the submission path.
+
+    With --software frames go through RenderViaSoftware instead, into an offscreen target the size of the captured
+    window, and the first pass prints a hash of each frame's pixels in place of the gl only counts. The software renderer
+    comes out the same no matter how many threads render it, so the hashes can be diffed against a known good run too.
+
+    Usage: render_replay <capture file> [passes] [--software]
+*/
+
+#include "gamecode.cpp"
+#undef GAME_RENDERER_STUFF_IMPL
+#define PLATFORM_RENDERER_STUFF_IMPL
+#include "renderer_stuff.h"
+#include "render_capture.h"
+#define RENDER_CAPTURE_IMPL
+#include "render_capture.h"
+#include "software_rendering.h"
+#define SOFTWARE_RENDERING_IMPL
+#include "software_rendering.h"
+#include "cooker_platform.h"
+
+//FNV-1a over the visible pixels, rows past the target's width don't count
+local_func u64 _HashPixels(Software_Render_Target target)
+{
+    u64 hash { 14695981039346656037ull };
+    for (s32 row {}; row < target.height; ++row)
+    {
+        u8* rowBytes = (u8*)(target.pixels + row * target.pitch_pxls);
+        for (s32 byteIndex {}; byteIndex < target.width * 4; ++byteIndex)
+            hash = (hash ^ rowBytes[byteIndex]) * 1099511628211ull;
+    };
+
+    return hash;
+};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: render_replay <capture file> [passes] [--software]\n");
+        return 1;
+    };
+
+    const char* captureFilePath = argv[1];
+    i32 passCount { 10 };
+    b useSoftwareRenderer { false };
+    for (i32 argIndex { 2 }; argIndex < argc; ++argIndex)
+    {
+        if (strcmp(argv[argIndex], "--software") == 0)
+            useSoftwareRenderer = true;
+        else
+            passCount = atoi(argv[argIndex]);
+    };
+    passCount = passCount < 1 ? 1 : passCount;
+
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    bgz::MemoryBlock replayMemory {};
+    void* replayMemoryPtr = malloc(Megabytes(64));
+    bgz::InitMemoryBlock($(replayMemory), Megabytes(64), Megabytes(1), replayMemoryPtr);
+    bgz::Memory_Partition* replayPart = bgz::CreatePartitionFromMemoryBlock($(replayMemory), Megabytes(60), "replay");
+
+    //Same size as one of the game's command buffers
+    RenderCmdBuffer cmdBuffer {};
+    cmdBuffer.size = (s32)Megabytes(10);
+    cmdBuffer.baseAddress = (u8*)PushSize(replayPart, cmdBuffer.size);
+
+    i32 captureSize {};
+    u8* capture = Cooker_ReadEntireFile($(captureSize), captureFilePath);
+
+    Render_Capture_Reader reader {};
+    if (NOT OpenRenderCapture($(reader), capture, captureSize))
+    {
+        fprintf(stderr, "%s isn't a render capture this build can replay!\n", captureFilePath);
+        return 1;
+    };
+
+    Rendering_Info renderingInfo {};
+    GPU_Frame_Stats totalStats {};
+    i64 totalEntryCount {};
+    f64 bestPassSecs { 1e9 };
+
+    //Resized whenever a captured frame's window size changes
+    Software_Render_Target softwareTarget {};
+
+    if (useSoftwareRenderer)
+        printf("frame, entries, draw calls, rects, glyphs, verts, pixel hash\n");
+    else
+        printf("frame, entries, draw calls, rects, glyphs, uniform updates, binds, binds avoided, verts, bytes streamed\n");
+    for (i32 pass {}; pass < passCount; ++pass)
+    {
+        RewindRenderCapture($(reader));
+
+        f64 passSecs {};
+        while (ReadCapturedFrame($(reader), $(renderingInfo), $(cmdBuffer)))
+        {
+            s32 entryCount = cmdBuffer.entryCount;
+
+            if (useSoftwareRenderer && (softwareTarget.width != renderingInfo.widthOfScreen_pixels || softwareTarget.height != renderingInfo.heightOfScreen_pixels))
+            {
+                BGZ_ASSERT(renderingInfo.widthOfScreen_pixels > 0 && renderingInfo.heightOfScreen_pixels > 0);//, "Captured frame has no window size!");
+
+                free(softwareTarget.pixels);
+                softwareTarget.width = softwareTarget.pitch_pxls = renderingInfo.widthOfScreen_pixels;
+                softwareTarget.height = renderingInfo.heightOfScreen_pixels;
+                softwareTarget.pixels = (u32*)malloc(sizeof(u32) * softwareTarget.pitch_pxls * softwareTarget.height);
+            };
+
+            f64 startTime = Cooker_CurrentTimeInSecs();
+            if (useSoftwareRenderer)
+                RenderViaSoftware($(renderingInfo), $(cmdBuffer), softwareTarget, replayPart, &platformServices);
+            else
+                RenderViaStats($(renderingInfo), $(cmdBuffer), replayPart);
+            passSecs += Cooker_CurrentTimeInSecs() - startTime;
+
+            if (pass == 0)
+            {
+                GPU_Frame_Stats stats = renderingInfo.frameStats;
+                if (useSoftwareRenderer)
+                    printf("%lld, %d, %d, %d, %d, %lld, %016llx\n", (long long)reader.frameIndex, entryCount, stats.drawCalls, stats.rectsDrawn,
+                           stats.glyphsDrawn, (long long)stats.vertsDrawn, (unsigned long long)_HashPixels(softwareTarget));
+                else
+                    printf("%lld, %d, %d, %d, %d, %d, %d, %d, %lld, %lld\n", (long long)reader.frameIndex, entryCount, stats.drawCalls, stats.rectsDrawn,
+                           stats.glyphsDrawn, stats.uniformUpdates, stats.bindsIssued, stats.bindsAvoided, (long long)stats.vertsDrawn, (long long)stats.bytesStreamed);
+
+                totalEntryCount += entryCount;
+                totalStats.drawCalls += stats.drawCalls;
+                totalStats.bindsIssued += stats.bindsIssued;
+                totalStats.bindsAvoided += stats.bindsAvoided;
+                totalStats.vertsDrawn += stats.vertsDrawn;
+            };
+        };
+
+        bestPassSecs = passSecs < bestPassSecs ? passSecs : bestPassSecs;
+    };
+
+    IsAllTempMemoryCleared(*replayPart);
+
+    printf("Replayed %d frames (%lld entries, %d draw calls, %d binds, %d binds avoided, %lld verts)\n", reader.frameCount, (long long)totalEntryCount,
+           totalStats.drawCalls, totalStats.bindsIssued, totalStats.bindsAvoided, (long long)totalStats.vertsDrawn);
+    printf("Best of %d passes: %.3f ms (%.4f ms per frame)\n", passCount, bestPassSecs * 1000.0,
+           reader.frameCount ? bestPassSecs * 1000.0 / reader.frameCount : 0.0);
+
+    Cooker_FreeFileMemory(capture);
+    free(softwareTarget.pixels);
+    free(replayMemoryPtr);
+
+    return 0;
+};
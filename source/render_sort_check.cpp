@@ -0,0 +1,210 @@
+/*
+    Check for the order SortRenderCmdBuffer hands entries to the backends in (see RenderSortKey). Records small frames
+    through the same GPUCmd_ calls the game makes and checks:
+        - World entries at the same depth that overlap draw in push order, whatever their shader, texture or vertex array
+        - World entries at different depths draw back to front, and all of them before any overlay entry
+        - Overlay entries keep their push order
+        - Entries pushed between Begin/EndDisjointDraws get grouped by state, but stay after what was pushed before them
+          and before what was pushed after them
+        - A frame recorded into sub-buffers and merged sorts the same as one recorded straight into the buffer
+    Prints every mismatch and returns 1 if there were any.
+
+    Usage: render_sort_check
+*/
+
+#include "gamecode.cpp"
+#undef GAME_RENDERER_STUFF_IMPL
+#define PLATFORM_RENDERER_STUFF_IMPL
+#include "renderer_stuff.h"
+#include "cooker_platform.h"
+
+#define CHECK_MAX_ENTRIES 64
+
+global_variable s32 globalCheckFailures;
+
+//Offsets of entries in the order the check expects them drawn
+struct Check_Order
+{
+    s32 entryOffsets[CHECK_MAX_ENTRIES];
+    s32 entryCount;
+};
+
+local_func s32 _LastEntryOffset(const RenderCmdBuffer* cmdBuffer)
+{
+    return ((Render_Sort_Entry*)(cmdBuffer->baseAddress + cmdBuffer->size) - cmdBuffer->entryCount)->entryOffset;
+};
+
+//Every rect is the same unit square at the origin so they all overlap
+local_func s32 _PushRect(RenderCmdBuffer* cmdBuffer, f32 depth, u32 textureID)
+{
+    GPUCmd_DrawRect(cmdBuffer, CreateRect(1.0f, 1.0f, v2 { 0.0f, 0.0f }, Origin::BOTTOM_LEFT, Color { 255, 255, 255, 255 }), depth, textureID);
+    return _LastEntryOffset(cmdBuffer);
+};
+
+local_func s32 _PushCube(RenderCmdBuffer* cmdBuffer, f32 depth, u32 textureID)
+{
+    GPUCmd_DrawCube(cmdBuffer, CreateCube(v3 { .5f, .5f, .5f }, v3 { 0.0f, 0.0f, depth }, Color { 0, 255, 0, 255 }), textureID);
+    return _LastEntryOffset(cmdBuffer);
+};
+
+local_func s32 _PushMesh(RenderCmdBuffer* cmdBuffer, f32 depth, s32 meshID, u32 textureID)
+{
+    Mat4x4 worldTransform {};
+    worldTransform.elem[2][3] = depth;
+    GPUCmd_DrawMesh(cmdBuffer, meshID, textureID, worldTransform, 36);
+    return _LastEntryOffset(cmdBuffer);
+};
+
+local_func s32 _PushOverlayRect(RenderCmdBuffer* cmdBuffer, u32 textureID)
+{
+    GPUCmd_Overlay_DrawRect(cmdBuffer, CreateRect(1.0f, 1.0f, v2 { 0.0f, 0.0f }, Origin::BOTTOM_LEFT, Color { 255, 0, 0, 255 }), 0.0f, textureID);
+    return _LastEntryOffset(cmdBuffer);
+};
+
+local_func void _Expect(Check_Order&& order, s32 entryOffset)
+{
+    BGZ_ASSERT(order.entryCount < CHECK_MAX_ENTRIES);
+    order.entryOffsets[order.entryCount++] = entryOffset;
+};
+
+local_func void _ResetCheckBuffer(RenderCmdBuffer* cmdBuffer)
+{
+    cmdBuffer->usedAmount = 0;
+    cmdBuffer->entryCount = 0;
+};
+
+local_func void _CheckSortedOrder(const char* what, RenderCmdBuffer* cmdBuffer, const Check_Order& expected, bgz::Memory_Partition* memPart)
+{
+    bgz::ScopedMemory scopeMemory(memPart);
+
+    if (cmdBuffer->entryCount != expected.entryCount)
+    {
+        fprintf(stderr, "%s: %d entries sorted, expected %d\n", what, cmdBuffer->entryCount, expected.entryCount);
+        ++globalCheckFailures;
+        return;
+    };
+
+    Render_Sort_Entry* sortedEntries = SortRenderCmdBuffer(cmdBuffer, memPart);
+    for (s32 entryIndex {}; entryIndex < expected.entryCount; ++entryIndex)
+    {
+        if (sortedEntries[entryIndex].entryOffset != expected.entryOffsets[entryIndex])
+        {
+            fprintf(stderr, "%s: entry %d drawn at position %d, expected entry %d\n", what, sortedEntries[entryIndex].entryOffset, entryIndex,
+                    expected.entryOffsets[entryIndex]);
+            ++globalCheckFailures;
+        };
+    };
+};
+
+int main(int argc, char** argv)
+{
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    bgz::MemoryBlock checkMemory {};
+    void* checkMemoryPtr = malloc(Megabytes(4));
+    bgz::InitMemoryBlock($(checkMemory), Megabytes(4), Megabytes(1), checkMemoryPtr);
+    bgz::Memory_Partition* checkPart = bgz::CreatePartitionFromMemoryBlock($(checkMemory), Megabytes(2), "check");
+
+    RenderCmdBuffer cmdBuffer {};
+    cmdBuffer.size = (s32)Kilobytes(64);
+    cmdBuffer.baseAddress = (u8*)PushSize(checkPart, cmdBuffer.size);
+
+    { //Overlapping entries at one depth with their state interleaved so grouping it would reorder them
+        _ResetCheckBuffer(&cmdBuffer);
+        Check_Order expected {};
+        _Expect($(expected), _PushRect(&cmdBuffer, 0.0f, 2));
+        _Expect($(expected), _PushRect(&cmdBuffer, 0.0f, 1));
+        _Expect($(expected), _PushMesh(&cmdBuffer, 0.0f, 3, 1));
+        _Expect($(expected), _PushRect(&cmdBuffer, 0.0f, 2));
+        _Expect($(expected), _PushCube(&cmdBuffer, 0.0f, 0));
+        _Expect($(expected), _PushMesh(&cmdBuffer, 0.0f, 1, 0));
+        _Expect($(expected), _PushRect(&cmdBuffer, 0.0f, 0));
+        _Expect($(expected), _PushRect(&cmdBuffer, 0.0f, 1));
+        _CheckSortedOrder("Same depth", &cmdBuffer, expected, checkPart);
+    };
+
+    { //Back to front first, push order within a depth, overlays last in push order
+        _ResetCheckBuffer(&cmdBuffer);
+        s32 overlay0 = _PushOverlayRect(&cmdBuffer, 2);
+        s32 near0 = _PushRect(&cmdBuffer, -1.0f, 1);
+        s32 middle0 = _PushRect(&cmdBuffer, 0.0f, 2);
+        s32 far0 = _PushRect(&cmdBuffer, 10.0f, 2);
+        s32 overlay1 = _PushOverlayRect(&cmdBuffer, 1);
+        s32 middle1 = _PushRect(&cmdBuffer, 0.0f, 1);
+        s32 far1 = _PushMesh(&cmdBuffer, 10.0f, 1, 0);
+        s32 near1 = _PushRect(&cmdBuffer, -1.0f, 0);
+
+        Check_Order expected {};
+        s32 order[] = { far0, far1, middle0, middle1, near0, near1, overlay0, overlay1 };
+        for (s32 orderIndex {}; orderIndex < (s32)ArrayCount(order); ++orderIndex)
+            _Expect($(expected), order[orderIndex]);
+        _CheckSortedOrder("Depth and layers", &cmdBuffer, expected, checkPart);
+    };
+
+    { //Disjoint draws get grouped by texture, nothing moves across the batch
+        _ResetCheckBuffer(&cmdBuffer);
+        s32 before = _PushRect(&cmdBuffer, 0.0f, 3);
+
+        BeginDisjointDraws(&cmdBuffer);
+        s32 tex2_0 = _PushRect(&cmdBuffer, 0.0f, 2);
+        s32 tex1_0 = _PushRect(&cmdBuffer, 0.0f, 1);
+        s32 tex2_1 = _PushRect(&cmdBuffer, 0.0f, 2);
+        s32 tex1_1 = _PushRect(&cmdBuffer, 0.0f, 1);
+        EndDisjointDraws(&cmdBuffer);
+
+        s32 after = _PushRect(&cmdBuffer, 0.0f, 0);
+
+        Check_Order expected {};
+        s32 order[] = { before, tex1_0, tex1_1, tex2_0, tex2_1, after };
+        for (s32 orderIndex {}; orderIndex < (s32)ArrayCount(order); ++orderIndex)
+            _Expect($(expected), order[orderIndex]);
+        _CheckSortedOrder("Disjoint draws", &cmdBuffer, expected, checkPart);
+    };
+
+    { //Same entries straight into the buffer, then split over sub-buffers with some pushed to the parent in between
+        _ResetCheckBuffer(&cmdBuffer);
+        Check_Order expected {};
+        for (s32 entryIndex {}; entryIndex < 12; ++entryIndex)
+            _Expect($(expected), _PushRect(&cmdBuffer, 0.0f, (u32)(entryIndex % 3)));
+
+        bgz::ScopedMemory scopeMemory(checkPart);
+        Render_Sort_Entry* serialEntries = SortRenderCmdBuffer(&cmdBuffer, checkPart);
+        _CheckSortedOrder("Serial", &cmdBuffer, expected, checkPart);
+
+        _ResetCheckBuffer(&cmdBuffer);
+        RenderCmdBuffer subBuffers[2] {};
+        subBuffers[0] = BeginRenderCmdSubBuffer(&cmdBuffer, (s32)Kilobytes(8));
+        subBuffers[1] = BeginRenderCmdSubBuffer(&cmdBuffer, (s32)Kilobytes(8));
+
+        //Recorded out of order like worker threads might, merged in the order they were begun
+        for (s32 entryIndex { 4 }; entryIndex < 8; ++entryIndex)
+            _PushRect(&subBuffers[1], 0.0f, (u32)(entryIndex % 3));
+        for (s32 entryIndex {}; entryIndex < 4; ++entryIndex)
+            _PushRect(&subBuffers[0], 0.0f, (u32)(entryIndex % 3));
+
+        MergeRenderCmdSubBuffer(&cmdBuffer, &subBuffers[0]);
+        MergeRenderCmdSubBuffer(&cmdBuffer, &subBuffers[1]);
+        for (s32 entryIndex { 8 }; entryIndex < 12; ++entryIndex)
+            _PushRect(&cmdBuffer, 0.0f, (u32)(entryIndex % 3));
+
+        Render_Sort_Entry* mergedEntries = SortRenderCmdBuffer(&cmdBuffer, checkPart);
+        for (s32 entryIndex {}; entryIndex < expected.entryCount; ++entryIndex)
+        {
+            if (serialEntries[entryIndex].key != mergedEntries[entryIndex].key || serialEntries[entryIndex].drawOrder != mergedEntries[entryIndex].drawOrder)
+            {
+                fprintf(stderr, "Sub-buffers: entry at position %d doesn't match the serial recording\n", entryIndex);
+                ++globalCheckFailures;
+            };
+        };
+    };
+
+    if (globalCheckFailures)
+    {
+        fprintf(stderr, "Render sort check FAILED (%d mismatches)\n", globalCheckFailures);
+        return 1;
+    };
+
+    printf("Render sort check ok\n");
+    return 0;
+};
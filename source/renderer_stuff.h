@@ -6,6 +6,7 @@
 #endif
 
 #include "stb/stb_truetype.h"
+#include <immintrin.h>
 
 #include "my_math.h"
 #include "memory_handling.h"
@@ -110,6 +111,7 @@ struct Mesh
     Mat4x4 worldTransform{};
 };
 
+//Entries are pushed up from baseAddress and every entry's Render_Sort_Entry is pushed down from the top of the buffer
 struct RenderCmdBuffer
 {
     u8* baseAddress { nullptr };
@@ -117,6 +119,15 @@ struct RenderCmdBuffer
     s32 size {};
     s32 entryCount {};
     u32 textureCount{};
+    b inDisjointDraws {};
+    s32 disjointDrawOrder {};//Draw order every entry pushed between Begin/EndDisjointDraws gets
+};
+
+struct Render_Sort_Entry
+{
+    u64 key;//See RenderSortKey
+    s32 entryOffset;//From the command buffer's baseAddress
+    s32 drawOrder;//Push order, sorts between a world entry's depth and its state bits (see SortRenderCmdBuffer)
 };
 
 struct Bitmap
@@ -128,7 +139,34 @@ struct Bitmap
     s32 pitch_pxls {};
     f32 opacity { 1.0f };
     v2 scale { 1.0f, 1.0f };
-    bool isLoadedOnGPU{false};//TODO: Eventually remove
+};
+
+//Filled in by the hardware renderer each time it renders a command buffer
+struct GPU_Frame_Stats
+{
+    s32 drawCalls {};
+    s32 rectsDrawn {};
+    s32 glyphsDrawn {};
+    s32 uniformUpdates {};
+    s32 uniformLookups {};//glGetUniformLocation calls. Only shader setup should make any (see Shader_Program)
+    s32 bindsIssued {};//Program, texture, vertex array and depth func changes actually sent to gl
+    s32 bindsAvoided {};//Ones skipped because sorting left the same state bound from the entry before
+    s64 vertsDrawn {};//Vertices the draw calls asked for (indices for indexed draws)
+    s64 bytesStreamed {};//Rect instance data + text vertex data
+};
+
+//Per instance data for the hardware renderer's instanced rect shader, streamed every draw
+struct GPU_RectInstance
+{
+    Mat4x4 transform;
+    v4 color;
+};
+
+//Glyph quads get expanded to 2 triangles each and streamed every draw
+struct GPU_TextVertex
+{
+    v2 pos_normalized;
+    v2 texCoords;
 };
 
 struct Rendering_Info
@@ -151,6 +189,8 @@ struct Rendering_Info
     f32 nearPlane{};
     f32 farPlane{};
     f32 _pixelsPerMeter {};
+    GPU_Frame_Stats frameStats {};//Last rendered frame's
+    s32 framesInFlight {};//Submitted frames not rendered yet as of this update. Cpu memory a command points at has to outlive them
     s32 numTotalRenderablesLoaded{};//TODO: Eventually use this to determine array length I think
     
     //Font stuff
@@ -195,7 +235,17 @@ enum Render_Entry_Type
     EntryType_DrawCube,
     EntryType_DrawMesh,
     EntryType_Texture,
-    EntryType_LoadTexture
+    EntryType_LoadTexture,
+    EntryType_UpdateTexture
+};
+
+//Entries get executed layer by layer. Resource entries (vertex data/texture loads) go first in the order they were pushed so
+//everything drawn this frame can use them, overlay entries go last in the order they were pushed
+enum Render_Layer
+{
+    RenderLayer_Resource,
+    RenderLayer_World,
+    RenderLayer_Overlay
 };
 
 struct RenderEntry_Header
@@ -207,25 +257,34 @@ struct RenderEntry_LoadTexture
 {
     RenderEntry_Header header;
     Bitmap texture;
+    const Bitmap* mips{nullptr};//Full chain starting with level 0 (same as texture) when mipCount > 1
+    s32 mipCount{1};
     u32 id{};
 };
 
-struct CharRenderInfo
+//Replaces the contents (and size) of a texture that was already loaded
+struct RenderEntry_UpdateTexture
 {
-    char character{};
-    f32 width_pixels{};
-    f32 height_pixels{};
-    v2 pos_pixelCoords{};
-    v2 minUV{};
-    v2 maxUV{};
-    f32 depth{};
-    f32 textBaselinePos_y{};
+    RenderEntry_Header header;
+    Bitmap texture;
+    u32 id{};
 };
 
+//Corners are already flipped to opengl's bottom left origin/+y up coord system and divided down to 0 to 1 screen space
+//so the backend can copy them straight into its text vertex stream
+struct Text_Glyph_Quad
+{
+    v2 minCorner_normalized{};
+    v2 maxCorner_normalized{};
+    v2 minCornerUV{};
+    v2 maxCornerUV{};
+};
+
+//Followed directly in the command buffer by glyphCount Text_Glyph_Quads, so strings can be any length
 struct RenderEntry_DrawText
 {
     RenderEntry_Header header;
-    bgz::DbgArray<CharRenderInfo, 100> characters;
+    s32 glyphCount{};
     f32 depth{};
 };
 
@@ -324,6 +383,142 @@ struct RenderEntry_Line
 };
 
 Bitmap LoadBitmap_BGRA(const char* fileName);
+void CreateFontAtlasFromFile_TTF(Rendering_Info* renderingInfo, const char* ttfFontFile, int pixelHeightForFont);
+void PremultiplyAlphaAndSwapRB(u32* pixels, s32 pixelCount);
+
+#if DEVELOPMENT_BUILD
+void BenchmarkBitmapPremultiply(const char* imageFilePath, s32 passes);
+
+//The hardware renderer's numbers only come back through Rendering_Info::frameStats once the render thread gets to a frame, so
+//this benchmark runs over many frames. Each scene is recorded in place of the game's frame until enough of its frames came back
+enum GPU_Benchmark_Scene_Type
+{
+    GPUBenchmarkScene_TextOverlay,
+    GPUBenchmarkScene_Rects,
+};
+
+struct GPU_Benchmark_Scene
+{
+    GPU_Benchmark_Scene_Type type;
+    s32 count;//Glyphs for text overlays, rects for rect grids
+};
+
+struct GPU_Benchmark
+{
+    s32 sceneIndex {};
+    s32 sceneFrame {};
+    f64 measureStartTime {};
+    GPU_Frame_Stats statTotals {};
+};
+
+//Returns false once every scene has been logged, the game's own frame should be recorded from then on
+b RecordGPUBenchmarkFrame(GPU_Benchmark&& bench, Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer);
+#endif
+
+//Sort key layout, most significant bits first:
+//  63-62 layer (see Render_Layer)
+//  61-30 depth, flipped so farther entries sort first (world layer only)
+//  29-26 entry type, which picks the shader/fixed vertex array the backend draws it with
+//  25-10 texture
+//   9-0  vertex array (meshes only, everything else uses its entry type's)
+//World entries end up back to front. Anything at the same depth draws in push order (each entry's drawOrder sorts above
+//the state bits) unless it was pushed between Begin/EndDisjointDraws, which share a draw order and so get grouped by state.
+//Overlay and resource entries only get a layer so they keep their push order. Recording helpers are inline so the
+//platform layer can record frames too (see BenchmarkSoftwareRenderer)
+inline u64 RenderSortKey(Render_Layer layer, f32 depth, Render_Entry_Type entryType, u32 textureID, u32 vertObjID)
+{
+    BGZ_ASSERT(entryType < (1 << 4) && textureID < (1 << 16) && vertObjID < (1 << 10));//, "Sort key field overflow!");
+    
+    u64 key = (u64)layer << 62;
+    if (layer == RenderLayer_World)
+    {
+        //Float bits -> unsigned int that sorts the same way the floats do, then inverted for far to near
+        u32 depthBits {};
+        memcpy(&depthBits, &depth, sizeof(depthBits));
+        depthBits = (depthBits & 0x80000000) ? ~depthBits : (depthBits | 0x80000000);
+        
+        key |= (u64)(~depthBits) << 30;
+        key |= (u64)entryType << 26;
+        key |= (u64)textureID << 10;
+        key |= (u64)vertObjID;
+    };
+    
+    return key;
+};
+
+inline void* _RenderCmdBuf_Push(RenderCmdBuffer* commandBuf, s32 sizeOfCommand)
+{
+    BGZ_ASSERT(commandBuf->usedAmount + sizeOfCommand <= commandBuf->size - commandBuf->entryCount * (s32)sizeof(Render_Sort_Entry));//Not enough space on render buffer!"
+    
+    void* memoryPointer = (void*)(commandBuf->baseAddress + commandBuf->usedAmount);
+    commandBuf->usedAmount += (sizeOfCommand);
+    return memoryPointer;
+};
+
+//Pushes a new entry along with its sort entry
+inline void* _RenderCmdBuf_PushEntry(RenderCmdBuffer* commandBuf, s32 sizeOfCommand, u64 sortKey)
+{
+    BGZ_ASSERT(commandBuf->usedAmount + sizeOfCommand <= commandBuf->size - (commandBuf->entryCount + 1) * (s32)sizeof(Render_Sort_Entry));//Not enough space on render buffer!"
+    
+    Render_Sort_Entry* sortEntry = (Render_Sort_Entry*)(commandBuf->baseAddress + commandBuf->size) - (commandBuf->entryCount + 1);
+    sortEntry->key = sortKey;
+    sortEntry->entryOffset = commandBuf->usedAmount;
+    sortEntry->drawOrder = commandBuf->inDisjointDraws ? commandBuf->disjointDrawOrder : commandBuf->entryCount;
+    ++commandBuf->entryCount;
+    
+    void* memoryPointer = (void*)(commandBuf->baseAddress + commandBuf->usedAmount);
+    commandBuf->usedAmount += (sizeOfCommand);
+    return memoryPointer;
+};
+#define RenderCmdBuf_PushEntry(commandBuffer, commandType, sortKey) (commandType*)_RenderCmdBuf_PushEntry(commandBuffer, sizeof(commandType), sortKey)
+
+//Only for entries that can't overlap each other (tiles of one image, a grid). They share a draw order so the ones at the
+//same depth can be reordered to group their state
+inline void BeginDisjointDraws(RenderCmdBuffer* commandBuf)
+{
+    BGZ_ASSERT(NOT commandBuf->inDisjointDraws);//, "Disjoint draws don't nest!");
+    commandBuf->inDisjointDraws = true;
+    commandBuf->disjointDrawOrder = commandBuf->entryCount;
+};
+
+inline void EndDisjointDraws(RenderCmdBuffer* commandBuf)
+{
+    commandBuf->inDisjointDraws = false;
+};
+
+Render_Sort_Entry* SortRenderCmdBuffer(RenderCmdBuffer* cmdBuffer, bgz::Memory_Partition* memPart);
+
+//Sorted entries that a backend draws with one call: consecutive DrawText entries, or consecutive DrawRects sharing a
+//texture. Every other entry is a run of its own
+struct Render_Entry_Run
+{
+    s32 entryCount;
+    s32 itemCount;//Glyphs for a text run, rects for a rect run
+};
+
+Render_Entry_Run GatherRenderEntryRun(RenderCmdBuffer* cmdBuffer, Render_Sort_Entry* sortedEntries, s32 firstEntry);
+
+//What a backend last bound, so entries sorted next to each other that share state don't rebind it. The values are
+//whatever the backend binds (gl names and enums for the hardware renderer)
+struct Render_Bind_State
+{
+    u32 program;
+    u32 texture;
+    u32 vertexArray;
+    u32 depthFunc;
+    s32 bindsIssued;
+    s32 bindsAvoided;
+};
+
+Render_Bind_State BeginRenderBinds();
+b RenderBindChanged(Render_Bind_State&& bindState, u32&& boundValue, u32 value);
+
+//Sub-buffers let other threads record part of a frame. Each one is linear allocated out of the parent's free space and
+//is pushed to like any other command buffer, except textures can't be loaded through it (ids come from the parent).
+//Begin and merge them on the parent's thread, merging in the order they were begun, so the frame comes out the same
+//no matter which thread recorded what or finished first
+RenderCmdBuffer BeginRenderCmdSubBuffer(RenderCmdBuffer* parent, s32 size);
+void MergeRenderCmdSubBuffer(RenderCmdBuffer* parent, RenderCmdBuffer* subBuffer);
 
 //Helpers
 f32 BitmapWidth_Meters(Bitmap bitmap);
@@ -344,6 +539,8 @@ void GPU_Update3DCamera(RenderCmdBuffer* rendererCmdBuffer, v3 camWorldPos, v3 c
 s32  GPUCmd_SendVertexData(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer, bgz::Memory_Partition* memPart, RunTimeArr<f32> vertAttributes, int stride,  RunTimeArr<s16> indicies, VertexAttributeList vertAttribList);
 void GPUCmd_SendRectVertexData(Rendering_Info* renderingInfo, RenderCmdBuffer* renderCmdBuffer, bgz::Memory_Partition* memPart, Color initialColor);
 u32  GPUCmd_SendTextureData(RenderCmdBuffer* cmdBuffer, Bitmap bitmap);
+u32  GPUCmd_SendTextureData(RenderCmdBuffer* cmdBuffer, const Bitmap* mips, s32 mipCount);
+void GPUCmd_UpdateTextureData(RenderCmdBuffer* cmdBuffer, u32 textureID, Bitmap bitmap);
 void GPUCmd_SendFontAtlas(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer, bgz::Memory_Partition* memPart);
 s32  GPUCmd_SendBaseTextVertexData(Rendering_Info* renderingInfo, RenderCmdBuffer* renderCmdBuffer,  bgz::Memory_Partition* memPart);
 void GPUCmd_Clear(Rendering_Info* renderingInfo, Color clearColor, bool clearDepthBuffer);
@@ -566,15 +763,44 @@ void SetMinMax(Rect&& rect, v2 newMin, v2 newMax)
     rect._localMin = localMin_v4.xy;
 };
 
-void* _RenderCmdBuf_Push(RenderCmdBuffer* commandBuf, s32 sizeOfCommand)
+RenderCmdBuffer BeginRenderCmdSubBuffer(RenderCmdBuffer* parent, s32 size)
 {
-    BGZ_ASSERT(commandBuf->usedAmount < commandBuf->size);//Not enough space on render buffer!"
+    s32 subBufferOffset = Align16(parent->usedAmount);
+    size &= ~15; //Keeps the sub-buffer's sort entries aligned
+    BGZ_ASSERT(size > 0 && subBufferOffset + size <= parent->size - parent->entryCount * (s32)sizeof(Render_Sort_Entry));//Not enough space on render buffer!"
     
-    void* memoryPointer = (void*)(commandBuf->baseAddress + commandBuf->usedAmount);
-    commandBuf->usedAmount += (sizeOfCommand);
-    return memoryPointer;
+    RenderCmdBuffer subBuffer {};
+    subBuffer.baseAddress = parent->baseAddress + subBufferOffset;
+    subBuffer.size = size;
+    subBuffer.textureCount = parent->textureCount;
+    parent->usedAmount = subBufferOffset + size;
+    
+    return subBuffer;
+};
+
+//Entries stay where they were recorded, only the sort entries move over to the parent. Whatever the sub-buffer didn't
+//use is wasted until the parent is reset
+void MergeRenderCmdSubBuffer(RenderCmdBuffer* parent, RenderCmdBuffer* subBuffer)
+{
+    BGZ_ASSERT(subBuffer->baseAddress >= parent->baseAddress && subBuffer->baseAddress + subBuffer->size <= parent->baseAddress + parent->usedAmount);//, "Not a sub-buffer of this command buffer!");
+    BGZ_ASSERT(subBuffer->textureCount == parent->textureCount);//, "Textures can only be loaded through the frame's main command buffer!");
+    BGZ_ASSERT(NOT subBuffer->inDisjointDraws && NOT parent->inDisjointDraws);//, "Merging in the middle of disjoint draws!");
+    BGZ_ASSERT(parent->usedAmount <= parent->size - (parent->entryCount + subBuffer->entryCount) * (s32)sizeof(Render_Sort_Entry));//Not enough space on render buffer!"
+    
+    //Both buffers push sort entries down from their top so copying them top down keeps the sub-buffer's push order
+    s32 subBufferOffset = (s32)(subBuffer->baseAddress - parent->baseAddress);
+    Render_Sort_Entry* subSortEntries = (Render_Sort_Entry*)(subBuffer->baseAddress + subBuffer->size);
+    Render_Sort_Entry* parentSortEntries = (Render_Sort_Entry*)(parent->baseAddress + parent->size) - parent->entryCount;
+    for (s32 entryIndex { 1 }; entryIndex <= subBuffer->entryCount; ++entryIndex)
+    {
+        parentSortEntries[-entryIndex] = subSortEntries[-entryIndex];
+        parentSortEntries[-entryIndex].entryOffset += subBufferOffset;
+        parentSortEntries[-entryIndex].drawOrder += parent->entryCount;
+    };
+    
+    parent->entryCount += subBuffer->entryCount;
+    subBuffer->entryCount = 0;
 };
-#define RenderCmdBuf_Push(commandBuffer, commandType) (commandType*)_RenderCmdBuf_Push(commandBuffer, sizeof(commandType))
 
 void GPU_InitRenderer(Rendering_Info* renderingInfo, f32 fov, f32 aspectRatio, f32 nearPlane, f32 farPlane)
 {
@@ -588,7 +814,7 @@ void GPU_InitRenderer(Rendering_Info* renderingInfo, f32 fov, f32 aspectRatio, f
 
 s32  GPUCmd_SendVertexData(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer, bgz::Memory_Partition* memPart, RunTimeArr<f32> vertAttribs, int stride, RunTimeArr<s16> indicies, VertexAttributeList vertAttribList)
 {
-    RenderEntry_InitVertexData* vertexData = RenderCmdBuf_Push(cmdBuffer, RenderEntry_InitVertexData);
+    RenderEntry_InitVertexData* vertexData = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_InitVertexData, RenderSortKey(RenderLayer_Resource, 0.0f, EntryType_InitVertexData, 0, 0));
     
     InitArr($(vertexData->interleavedVertAttribData), memPart, vertAttribs.Size());
     InitArr($(vertexData->indicies), memPart, indicies.Size());
@@ -600,8 +826,6 @@ s32  GPUCmd_SendVertexData(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBu
     vertexData->interleavedVertAttribData = CopyArray(memPart, vertAttribs);
     vertexData->indicies = CopyArray(memPart, indicies);
     
-    ++cmdBuffer->entryCount;
-    
     return renderingInfo->numTotalRenderablesLoaded;
 };
 
@@ -713,7 +937,7 @@ void GPUCmd_SendCubeVertexData(Rendering_Info* renderingInfo, RenderCmdBuffer* c
     };
 };
 
-//Verts I send to gpu for text will be between 0 and 1 for easier text transformations
+//Mostly just reserves the text's vertex array. The hardware renderer points it at the glyph quads it streams in each frame
 s32 GPUCmd_SendBaseTextVertexData(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer,  bgz::Memory_Partition* memPart)
 {
     Array<v3, 4> vertPositions{ v3{0.0f, 0.0f, 0.0f}, v3{1.0f, 0.0f, 0.0f}, v3{1.0f, 1.0f, 0.0f}, v3{0.0f, 1.0f, 0.0f} };
@@ -749,17 +973,46 @@ u32 GPUCmd_SendTextureData(RenderCmdBuffer* cmdBuffer, Bitmap bitmap)
 {
     BGZ_ASSERT(bitmap.data);//Invalid/null texture data!"
     
-    RenderEntry_LoadTexture* loadTextureEntry = RenderCmdBuf_Push(cmdBuffer, RenderEntry_LoadTexture);
+    RenderEntry_LoadTexture* loadTextureEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_LoadTexture, RenderSortKey(RenderLayer_Resource, 0.0f, EntryType_LoadTexture, 0, 0));
+    *loadTextureEntry = RenderEntry_LoadTexture {};//Command buffer memory gets reused, so mips/mipCount can't be left as whatever was there
     
     loadTextureEntry->header.type = EntryType_LoadTexture;
     loadTextureEntry->texture = bitmap;
     loadTextureEntry->id = ++cmdBuffer->textureCount;
     
-    ++cmdBuffer->entryCount;
+    return cmdBuffer->textureCount;
+};
+
+//Uploads a prebuilt mip chain and samples it trilinear. The mips array and its data have to stay valid until the command buffer has been rendered
+u32 GPUCmd_SendTextureData(RenderCmdBuffer* cmdBuffer, const Bitmap* mips, s32 mipCount)
+{
+    BGZ_ASSERT(mips && mips[0].data);//Invalid/null texture data!"
+    
+    RenderEntry_LoadTexture* loadTextureEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_LoadTexture, RenderSortKey(RenderLayer_Resource, 0.0f, EntryType_LoadTexture, 0, 0));
+    *loadTextureEntry = RenderEntry_LoadTexture {};
+    
+    loadTextureEntry->header.type = EntryType_LoadTexture;
+    loadTextureEntry->texture = mips[0];
+    loadTextureEntry->mips = mips;
+    loadTextureEntry->mipCount = mipCount;
+    loadTextureEntry->id = ++cmdBuffer->textureCount;
     
     return cmdBuffer->textureCount;
 };
 
+//Bitmap data has to stay valid until the command buffer has been rendered
+void GPUCmd_UpdateTextureData(RenderCmdBuffer* cmdBuffer, u32 textureID, Bitmap bitmap)
+{
+    BGZ_ASSERT(bitmap.data);//Invalid/null texture data!"
+    BGZ_ASSERT(textureID && textureID <= cmdBuffer->textureCount);//Texture was never loaded!"
+    
+    RenderEntry_UpdateTexture* updateTextureEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_UpdateTexture, RenderSortKey(RenderLayer_Resource, 0.0f, EntryType_UpdateTexture, 0, 0));
+    
+    updateTextureEntry->header.type = EntryType_UpdateTexture;
+    updateTextureEntry->texture = bitmap;
+    updateTextureEntry->id = textureID;
+};
+
 void GPUCmd_SendFontAtlas(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer, bgz::Memory_Partition* memPart)
 {
     renderingInfo->textTextureID = GPUCmd_SendTextureData(cmdBuffer, renderingInfo->fontAtlas);
@@ -775,25 +1028,26 @@ void GPUCmd_Clear(Rendering_Info* renderingInfo, Color clearColor, bool clearDep
 
 void GPUCmd_DrawLine(RenderCmdBuffer* cmdBuffer, v2 minPoint, v2 maxPoint, Color color, f32 thickness)
 {
-    RenderEntry_Line* lineEntry = RenderCmdBuf_Push(cmdBuffer, RenderEntry_Line);
+    RenderEntry_Line* lineEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_Line, RenderSortKey(RenderLayer_World, 0.0f, EntryType_Line, 0, 0));
     
     lineEntry->header.type = EntryType_Line;
     lineEntry->minPoint = minPoint;
     lineEntry->maxPoint = maxPoint;
     lineEntry->color = ConvertColorTo0to1Values(color);
     lineEntry->thickness = thickness;
-    
-    ++cmdBuffer->entryCount;
 };
 
 void GPUCmd_Overlay_DrawText(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer, const char* string, v2 screenPos, f32 depth, f32 maxScreenPos_x, int pixelHeight)
 {
-    RenderEntry_DrawText* textEntry = RenderCmdBuf_Push(cmdBuffer, RenderEntry_DrawText);
+    RenderEntry_DrawText* textEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawText, RenderSortKey(RenderLayer_Overlay, depth, EntryType_DrawText, 0, 0));
     
     textEntry->header.type = EntryType_DrawText;
-    textEntry->characters.length = 0;
+    textEntry->glyphCount = 0;
     textEntry->depth = depth;
     
+    f32 initialWidthOfScreen_pixels = (f32)renderingInfo->initialWidthOfScreen_pixels;
+    f32 initialHeightOfScreen_pixels = (f32)renderingInfo->initialHeightOfScreen_pixels;
+    
     sizet strLen = strlen(string);
     f32 xScreenPosOfFontBaseline_pixels{screenPos.x}, yScreenPosOfFontBaseline_pixels{screenPos.y + (renderingInfo->fontHeight)};
     f32 startingXPos{};
@@ -812,26 +1066,25 @@ void GPUCmd_Overlay_DrawText(Rendering_Info* renderingInfo, RenderCmdBuffer* cmd
         if(i == 0)
             startingXPos = q.x0;
         
-        CharRenderInfo characterInfo{};
-        characterInfo.textBaselinePos_y = yScreenPosOfFontBaseline_pixels;
-        characterInfo.minUV = v2{q.s0, q.t0};
-        characterInfo.maxUV = v2{q.s1, q.t1};
-        characterInfo.height_pixels = height;
-        characterInfo.width_pixels = width;
-        characterInfo.pos_pixelCoords = v2{ startingXPos, q.y1};
-        characterInfo.character = (char)character;
+        //Perform flip from top left origin/+y down to opengl's expected bottom left origin/+y up coord system. The bottom of
+        //the glyph (q.y1) becomes its min y, and v flips along with it
+        f32 bottomOfChar_pixels = renderingInfo->heightOfScreen_pixels - q.y1;
+        
+        Text_Glyph_Quad* glyph = (Text_Glyph_Quad*)_RenderCmdBuf_Push(cmdBuffer, sizeof(Text_Glyph_Quad));
+        glyph->minCorner_normalized = v2{startingXPos / initialWidthOfScreen_pixels, bottomOfChar_pixels / initialHeightOfScreen_pixels};
+        glyph->maxCorner_normalized = v2{(startingXPos + width) / initialWidthOfScreen_pixels, (bottomOfChar_pixels + height) / initialHeightOfScreen_pixels};
+        glyph->minCornerUV = v2{q.s0, q.t1};
+        glyph->maxCornerUV = v2{q.s1, q.t0};
         
         startingXPos += width;/*setup for next char*/
         
-        textEntry->characters.Push(characterInfo);
+        ++textEntry->glyphCount;
     };
-    
-    ++cmdBuffer->entryCount;
 };
 
 void GPUCmd_DrawCube(RenderCmdBuffer* cmdBuffer, Cube cubeToDraw, u32 textureID = 0)
 {
-    RenderEntry_DrawCube* cubeEntry = RenderCmdBuf_Push(cmdBuffer, RenderEntry_DrawCube);
+    RenderEntry_DrawCube* cubeEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawCube, RenderSortKey(RenderLayer_World, cubeToDraw.worldTransform.translation.z, EntryType_DrawCube, 0, 0));
     *cubeEntry = {};
     
     //Because there are already verts stored in GPU memmory for a cube we just need to adjust the scale
@@ -843,13 +1096,11 @@ void GPUCmd_DrawCube(RenderCmdBuffer* cmdBuffer, Cube cubeToDraw, u32 textureID
     cubeEntry->worldTransform.translation = cubeToDraw.worldTransform.translation;
     cubeEntry->worldTransform.rotation = cubeToDraw.worldTransform.rotation;
     cubeEntry->color = ConvertColorTo0to1Values(cubeToDraw.color);
-    
-    ++cmdBuffer->entryCount;
 };
 
 void GPUCmd_DrawRect(RenderCmdBuffer* cmdBuffer, Rect rectToDraw, f32 depth, u32 textureID = 0)
 {
-    RenderEntry_DrawRect* rectEntry = RenderCmdBuf_Push(cmdBuffer, RenderEntry_DrawRect);
+    RenderEntry_DrawRect* rectEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawRect, RenderSortKey(RenderLayer_World, depth, EntryType_DrawRect, textureID, 0));
     
     {//Setup world transform which takes into account previously stored rect vert information from GPUCMD_SendRectVertData call
         switch(rectToDraw.origin)
@@ -878,13 +1129,11 @@ void GPUCmd_DrawRect(RenderCmdBuffer* cmdBuffer, Rect rectToDraw, f32 depth, u32
     rectEntry->worldTransform = rectToDraw._worldTransform;
     rectEntry->textureID = textureID;
     rectEntry->color = ConvertColorTo0to1Values(rectToDraw.color);
-    
-    ++cmdBuffer->entryCount;
 };
 
 void GPUCmd_Overlay_DrawRect(RenderCmdBuffer* cmdBuffer, Rect rectToDraw, f32 depth, u32 textureID)
 {
-    RenderEntry_DrawRectOverlay* rectEntryOverlay = RenderCmdBuf_Push(cmdBuffer, RenderEntry_DrawRectOverlay);
+    RenderEntry_DrawRectOverlay* rectEntryOverlay = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawRectOverlay, RenderSortKey(RenderLayer_Overlay, depth, EntryType_DrawRectOverlay, textureID, 0));
     
     rectEntryOverlay->header.type = EntryType_DrawRectOverlay;
     rectEntryOverlay->textureID = textureID;
@@ -894,13 +1143,11 @@ void GPUCmd_Overlay_DrawRect(RenderCmdBuffer* cmdBuffer, Rect rectToDraw, f32 de
     rectEntryOverlay->_localMax = rectToDraw._localMax;
     rectEntryOverlay->origin = rectToDraw.origin;
     rectEntryOverlay->zDepth = depth;
-    
-    ++cmdBuffer->entryCount;
 };
 
 void GPUCmd_Overlay_DrawRect(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer, v2 pos, Color color, f32 width, f32 height, Origin origin, f32 depth, u32 textureID)
 {
-    RenderEntry_DrawRectOverlay* rectEntryOverlay = RenderCmdBuf_Push(cmdBuffer, RenderEntry_DrawRectOverlay);
+    RenderEntry_DrawRectOverlay* rectEntryOverlay = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawRectOverlay, RenderSortKey(RenderLayer_Overlay, depth, EntryType_DrawRectOverlay, textureID, 0));
     
     Rect rectToDraw = CreateRect(width, height, pos, origin, color);
     
@@ -912,8 +1159,6 @@ void GPUCmd_Overlay_DrawRect(Rendering_Info* renderingInfo, RenderCmdBuffer* cmd
     rectEntryOverlay->_localMax = rectToDraw._localMax;
     rectEntryOverlay->origin = rectToDraw.origin;
     rectEntryOverlay->zDepth = depth;
-    
-    ++cmdBuffer->entryCount;
 };
 
 void GPUCmd_Overlay_DrawRectOutline(RenderCmdBuffer* cmdBuffer, Rect rectToOutline, f32 depth, f32 lineThickness, Color color)
@@ -975,15 +1220,13 @@ void GPUCmd_DrawRectOutline(RenderCmdBuffer* cmdBuffer, Rect rectToOutline, f32
 
 void GPUCmd_DrawMesh(RenderCmdBuffer* cmdBuffer, s32 meshID, s32 textureID, Mat4x4 worldTransform, int renderIndexLength)
 {
-    RenderEntry_DrawMesh* meshEntry = RenderCmdBuf_Push(cmdBuffer, RenderEntry_DrawMesh);
+    RenderEntry_DrawMesh* meshEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawMesh, RenderSortKey(RenderLayer_World, worldTransform.elem[2][3], EntryType_DrawMesh, textureID, meshID));
     
     meshEntry->header.type = EntryType_DrawMesh;
     meshEntry->meshID = meshID;
     meshEntry->textureID = textureID;
     meshEntry->worldTransform = worldTransform;
     meshEntry->renderIndexLength = renderIndexLength;
-    
-    ++cmdBuffer->entryCount;
 };
 
 void GPU_SetCamera3D(Rendering_Info* renderingInfo, v3 cameraStartingPos, v3 camStartingRotation)
@@ -998,6 +1241,62 @@ void GPU_Update3DCamera(Rendering_Info* renderingInfo, v3 cameraTranslation, v3
     renderingInfo->camera3d.rotation += camRotation;
 };
 
+inline u32 _PremultiplyAlphaAndSwapRB(u32 pixel_RGBA)
+{
+    u32 r = (pixel_RGBA >> 0) & 0xFF;
+    u32 g = (pixel_RGBA >> 8) & 0xFF;
+    u32 b = (pixel_RGBA >> 16) & 0xFF;
+    u32 a = (pixel_RGBA >> 24) & 0xFF;
+    
+    //c * a / 255 rounded to nearest
+    r = (r * a + 127) / 255;
+    g = (g * a + 127) / 255;
+    b = (b * a + 127) / 255;
+    
+    return (a << 24) | (r << 16) | (g << 8) | (b << 0);
+};
+
+//Converts stb's RGBA pixels in place to the pre-multiplied BGRA the renderer expects
+void PremultiplyAlphaAndSwapRB(u32* pixels, s32 pixelCount)
+{
+    s32 pixelIndex {};
+    
+#if __AVX2__
+    __m256i zero = _mm256_setzero_si256();
+    __m256i alphaMultiplier = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);//Alpha is multiplied by 255 so it comes out unchanged
+    __m256i roundingBias = _mm256_set1_epi16(127);
+    __m256i reciprocalOf255 = _mm256_set1_epi16((s16)0x8081);//(x * 0x8081) >> 23 == x / 255 for every 16 bit x
+    __m256i swapRB = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    
+    for (; pixelIndex + 8 <= pixelCount; pixelIndex += 8)
+    {
+        __m256i pixels_RGBA = _mm256_loadu_si256((__m256i*)(pixels + pixelIndex));
+        
+        //Widen to 16 bits per channel (2 pixels per 128 bit lane in each half)
+        __m256i channelsLo = _mm256_unpacklo_epi8(pixels_RGBA, zero);
+        __m256i channelsHi = _mm256_unpackhi_epi8(pixels_RGBA, zero);
+        
+        __m256i alphasLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(channelsLo, 0xFF), 0xFF);
+        __m256i alphasHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(channelsHi, 0xFF), 0xFF);
+        alphasLo = _mm256_blend_epi16(alphasLo, alphaMultiplier, 0x88);
+        alphasHi = _mm256_blend_epi16(alphasHi, alphaMultiplier, 0x88);
+        
+        //c * a + 127 tops out at 65152 so it fits in an unsigned 16 bit lane
+        channelsLo = _mm256_add_epi16(_mm256_mullo_epi16(channelsLo, alphasLo), roundingBias);
+        channelsHi = _mm256_add_epi16(_mm256_mullo_epi16(channelsHi, alphasHi), roundingBias);
+        channelsLo = _mm256_srli_epi16(_mm256_mulhi_epu16(channelsLo, reciprocalOf255), 7);
+        channelsHi = _mm256_srli_epi16(_mm256_mulhi_epu16(channelsHi, reciprocalOf255), 7);
+        
+        __m256i pixels_BGRA = _mm256_shuffle_epi8(_mm256_packus_epi16(channelsLo, channelsHi), swapRB);
+        _mm256_storeu_si256((__m256i*)(pixels + pixelIndex), pixels_BGRA);
+    };
+#endif
+    
+    for (; pixelIndex < pixelCount; ++pixelIndex)
+        pixels[pixelIndex] = _PremultiplyAlphaAndSwapRB(pixels[pixelIndex]);
+};
+
 Bitmap LoadBitmap_BGRA(const char* fileName)
 {
     Bitmap result;
@@ -1013,21 +1312,7 @@ Bitmap LoadBitmap_BGRA(const char* fileName)
         BGZ_ASSERT(bitmapData);//Invalid image data!"
         
         s32 totalPixelCountOfImg = result.width_pxls * result.height_pxls;
-        u32* bitmapPixel = (u32*)bitmapData;
-        
-        //Swap R and B channels of image
-        for (int i = 0; i < totalPixelCountOfImg; ++i)
-        {
-            auto color = UnPackPixelValues(*bitmapPixel, RGBA);
-            
-            //Pre-multiplied alpha
-            f32 alphaBlend = color.a / 255.0f;
-            color.rgb *= alphaBlend;
-            
-            u32 newSwappedPixelColor = (((u8)color.a << 24) | ((u8)color.r << 16) | ((u8)color.g << 8) | ((u8)color.b << 0));
-            
-            *bitmapPixel++ = newSwappedPixelColor;
-        }
+        PremultiplyAlphaAndSwapRB((u32*)bitmapData, totalPixelCountOfImg);
         
         result.data = (u8*)bitmapData;
     };
@@ -1038,6 +1323,237 @@ Bitmap LoadBitmap_BGRA(const char* fileName)
     return result;
 };
 
+#if DEVELOPMENT_BUILD
+void BenchmarkBitmapPremultiply(const char* imageFilePath, s32 passes)
+{
+    s32 width {}, height {}, numOfLoadedChannels {};
+    u32* sourcePixels = (u32*)stbi_load(imageFilePath, &width, &height, &numOfLoadedChannels, 4);
+    BGZ_ASSERT(sourcePixels);//Invalid image data!"
+    
+    s32 pixelCount = width * height;
+    u32* floatPixels = MallocType(heap, u32, pixelCount);
+    u32* scalarPixels = MallocType(heap, u32, pixelCount);
+    u32* simdPixels = MallocType(heap, u32, pixelCount);
+    
+    { //Exactness: every (channel, alpha) pair plus the odd pixel counts that hit the scalar tail
+        s32 pairCount = 256 * 256 + 7;
+        u32* allPairs = MallocType(heap, u32, pairCount);
+        u32* expected = MallocType(heap, u32, pairCount);
+        for (s32 i {}; i < pairCount; ++i)
+        {
+            u32 c = (u32)i & 0xFF, a = ((u32)i >> 8) & 0xFF;
+            allPairs[i] = (a << 24) | (((c * 7) & 0xFF) << 16) | ((255 - c) << 8) | c;
+        };
+        
+        for (s32 i {}; i < pairCount; ++i)
+            expected[i] = _PremultiplyAlphaAndSwapRB(allPairs[i]);
+        
+        PremultiplyAlphaAndSwapRB(allPairs, pairCount);
+        
+        s32 mismatchCount {};
+        for (s32 i {}; i < pairCount; ++i)
+            mismatchCount += allPairs[i] != expected[i];
+        
+        BGZ_ASSERT(mismatchCount == 0);//, "Simd premultiply doesn't match the scalar path!");
+        BGZ_CONSOLE("Premultiply exactness test (%d pixels): %s\n", pairCount, mismatchCount == 0 ? "passed" : "FAILED");
+        
+        DeAlloc(heap, expected);
+        DeAlloc(heap, allPairs);
+    };
+    
+    f64 floatSecs {}, scalarSecs {}, simdSecs {};
+    for (s32 pass {}; pass < passes; ++pass)
+    {
+        //What LoadBitmap_BGRA used to do
+        memcpy(floatPixels, sourcePixels, pixelCount * sizeof(u32));
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (s32 i {}; i < pixelCount; ++i)
+        {
+            auto color = UnPackPixelValues(floatPixels[i], RGBA);
+            color.rgb *= color.a / 255.0f;
+            floatPixels[i] = (((u8)color.a << 24) | ((u8)color.r << 16) | ((u8)color.g << 8) | ((u8)color.b << 0));
+        };
+        floatSecs += globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        memcpy(scalarPixels, sourcePixels, pixelCount * sizeof(u32));
+        startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (s32 i {}; i < pixelCount; ++i)
+            scalarPixels[i] = _PremultiplyAlphaAndSwapRB(scalarPixels[i]);
+        scalarSecs += globalPlatformServices->CurrentTimeInSecs() - startTime;
+        
+        memcpy(simdPixels, sourcePixels, pixelCount * sizeof(u32));
+        startTime = globalPlatformServices->CurrentTimeInSecs();
+        PremultiplyAlphaAndSwapRB(simdPixels, pixelCount);
+        simdSecs += globalPlatformServices->CurrentTimeInSecs() - startTime;
+    };
+    
+    //The old float path truncated instead of rounding so it can be off by one on pre-multiplied channels
+    s32 simdMismatches {}, floatDifferences {};
+    for (s32 i {}; i < pixelCount; ++i)
+    {
+        simdMismatches += simdPixels[i] != scalarPixels[i];
+        floatDifferences += simdPixels[i] != floatPixels[i];
+    };
+    BGZ_ASSERT(simdMismatches == 0);//, "Simd premultiply doesn't match the scalar path!");
+    
+    f64 megaPixels = (f64)pixelCount * (f64)passes / 1000000.0;
+    BGZ_CONSOLE("Premultiply bench %s (%dx%d): float %.0f MPixels/s, scalar int %.0f MPixels/s, simd %.0f MPixels/s (%.2fx), simd mismatches %d, pixels rounded differently than old float path %d\n",
+                imageFilePath, width, height, megaPixels / floatSecs, megaPixels / scalarSecs, megaPixels / simdSecs, floatSecs / simdSecs,
+                simdMismatches, floatDifferences);
+    
+    DeAlloc(heap, simdPixels);
+    DeAlloc(heap, scalarPixels);
+    DeAlloc(heap, floatPixels);
+    stbi_image_free(sourcePixels);
+};
+
+//A column of debug readouts (like the bone/hit box dumps you'd put up while tuning a fighter) with a backing panel behind every 10 lines
+local_func void _RecordBenchmarkTextOverlay(Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer, s32 glyphCount)
+{
+    const f32 columnWidth_pixels = 480.0f;
+    f32 lineHeight_pixels = renderingInfo->fontHeight + 2.0f;
+    s32 linesPerColumn = (s32)((renderingInfo->heightOfScreen_pixels - 20.0f) / lineHeight_pixels);
+    
+    s32 glyphsRecorded {};
+    for (s32 lineIndex {}; glyphsRecorded < glyphCount; ++lineIndex)
+    {
+        v2 linePos_pixels = { 10.0f + (f32)(lineIndex / linesPerColumn) * columnWidth_pixels, 10.0f + (f32)(lineIndex % linesPerColumn) * lineHeight_pixels };
+        
+        if (lineIndex % 10 == 0)
+            GPUCmd_Overlay_DrawRect(renderingInfo, cmdBuffer, linePos_pixels, Color { 0, 0, 0, 160 }, columnWidth_pixels - 10.0f, lineHeight_pixels * 10.0f,
+                                    Origin::BOTTOM_LEFT, 0.0f);
+        
+        char line[64];
+        s32 lineLength = snprintf(line, sizeof(line), "bone %03d pos (%7.2f, %7.2f) rot %7.2f", lineIndex, (f32)lineIndex * 1.25f, (f32)lineIndex * -.5f,
+                                  (f32)(lineIndex * 7 % 360));
+        if (lineLength > glyphCount - glyphsRecorded)
+            line[lineLength = glyphCount - glyphsRecorded] = '\0';
+        
+        GPUCmd_Overlay_DrawText(renderingInfo, cmdBuffer, line, linePos_pixels, 0.0f, (f32)renderingInfo->widthOfScreen_pixels);
+        glyphsRecorded += lineLength;
+    };
+};
+
+//Untextured world rects on a grid that fills the middle of the view, all at the same depth like a field of particles
+local_func void _RecordBenchmarkRects(RenderCmdBuffer* cmdBuffer, s32 rectCount)
+{
+    s32 rectsPerRow = (s32)Sqrt((f32)rectCount) + 1;
+    f32 cellSize = 8.0f / (f32)rectsPerRow;
+    
+    BeginDisjointDraws(cmdBuffer);
+    for (s32 rectIndex {}; rectIndex < rectCount; ++rectIndex)
+    {
+        s32 column = rectIndex % rectsPerRow, row = rectIndex / rectsPerRow;
+        
+        Rect rect = CreateRect(cellSize * .8f, cellSize * .8f, v2 { 0.0f, 0.0f }, Origin::BOTTOM_LEFT, Color { 255, (column * 16) % 256, (row * 16) % 256, 255 });
+        rect._worldTransform.translation.x = -4.0f + (f32)column * cellSize;
+        rect._worldTransform.translation.y = -4.0f + (f32)row * cellSize;
+        GPUCmd_DrawRect(cmdBuffer, rect, 0.0f);
+    };
+    EndDisjointDraws(cmdBuffer);
+};
+
+b RecordGPUBenchmarkFrame(GPU_Benchmark&& bench, Rendering_Info* renderingInfo, RenderCmdBuffer* cmdBuffer)
+{
+    const GPU_Benchmark_Scene scenes[] = {
+        { GPUBenchmarkScene_TextOverlay, 400 },
+        { GPUBenchmarkScene_TextOverlay, 4000 },
+        { GPUBenchmarkScene_Rects, 100 },
+        { GPUBenchmarkScene_Rects, 10000 },
+        { GPUBenchmarkScene_Rects, 100000 },
+    };
+    
+    //Warm up frames have to outlast the frames in flight so every measured frame's stats come from this scene
+    const s32 warmUpFrames = 16;
+    const s32 measuredFrames = 120;
+    
+    const s32 sceneCount = (s32)ArrayCount(scenes);
+    
+    if (bench.sceneIndex == sceneCount)
+        return false;
+    
+    if (bench.sceneFrame == warmUpFrames)
+    {
+        bench.measureStartTime = globalPlatformServices->CurrentTimeInSecs();
+        bench.statTotals = {};
+    }
+    else if (bench.sceneFrame > warmUpFrames)
+    {
+        GPU_Frame_Stats frameStats = renderingInfo->frameStats;
+        bench.statTotals.drawCalls += frameStats.drawCalls;
+        bench.statTotals.rectsDrawn += frameStats.rectsDrawn;
+        bench.statTotals.glyphsDrawn += frameStats.glyphsDrawn;
+        bench.statTotals.uniformUpdates += frameStats.uniformUpdates;
+        bench.statTotals.uniformLookups += frameStats.uniformLookups;
+        bench.statTotals.bindsIssued += frameStats.bindsIssued;
+        bench.statTotals.bindsAvoided += frameStats.bindsAvoided;
+    };
+    
+    if (bench.sceneFrame == warmUpFrames + measuredFrames)
+    {
+        //Each frame waits on the render thread once the queue is full, so this is how long the slower of the two takes per frame
+        f64 msPerFrame = (globalPlatformServices->CurrentTimeInSecs() - bench.measureStartTime) * 1000.0 / measuredFrames;
+        
+        GPU_Frame_Stats perFrame = bench.statTotals;
+        perFrame.drawCalls /= measuredFrames;
+        perFrame.rectsDrawn /= measuredFrames;
+        perFrame.glyphsDrawn /= measuredFrames;
+        perFrame.uniformUpdates /= measuredFrames;
+        perFrame.uniformLookups /= measuredFrames;
+        perFrame.bindsIssued /= measuredFrames;
+        perFrame.bindsAvoided /= measuredFrames;
+        
+        //Draws plus the per entry state changes. Buffer streaming and the fixed setup/teardown calls every frame makes aren't counted
+        s32 glCalls = perFrame.drawCalls + perFrame.uniformUpdates + perFrame.uniformLookups + perFrame.bindsIssued;
+        
+        switch (scenes[bench.sceneIndex].type)
+        {
+            case GPUBenchmarkScene_TextOverlay:
+            {
+                //Before the uniform cache every uniform set looked its location up by name first
+                BGZ_CONSOLE("GPU bench text overlay (%d glyphs): %d gl calls per frame (%d without the uniform cache), %d draw calls, %d uniform sets, %d uniform lookups, %d binds (%d avoided), %.3f ms per frame\n",
+                            perFrame.glyphsDrawn, glCalls, glCalls + perFrame.uniformUpdates, perFrame.drawCalls, perFrame.uniformUpdates, perFrame.uniformLookups,
+                            perFrame.bindsIssued, perFrame.bindsAvoided, msPerFrame);
+            }break;
+            
+            case GPUBenchmarkScene_Rects:
+            {
+                BGZ_CONSOLE("GPU bench rects (%d rects): %d gl calls per frame, %d draw calls, %d uniform sets, %d binds (%d avoided), %.3f ms per frame\n",
+                            perFrame.rectsDrawn, glCalls, perFrame.drawCalls, perFrame.uniformUpdates, perFrame.bindsIssued, perFrame.bindsAvoided, msPerFrame);
+            }break;
+            
+            InvalidDefaultCase;
+        };
+        
+        ++bench.sceneIndex;
+        bench.sceneFrame = 0;
+        
+        if (bench.sceneIndex == sceneCount)
+            return false;
+    };
+    
+    GPU_Benchmark_Scene scene = scenes[bench.sceneIndex];
+    switch (scene.type)
+    {
+        case GPUBenchmarkScene_TextOverlay:
+        {
+            _RecordBenchmarkTextOverlay(renderingInfo, cmdBuffer, scene.count);
+        }break;
+        
+        case GPUBenchmarkScene_Rects:
+        {
+            _RecordBenchmarkRects(cmdBuffer, scene.count);
+        }break;
+        
+        InvalidDefaultCase;
+    };
+    
+    ++bench.sceneFrame;
+    
+    return true;
+};
+#endif
+
 void CreateFontAtlasFromFile_TTF(Rendering_Info* renderingInfo, const char* ttfFontFile, int pixelHeightForFont)
 {
     Bitmap result;
@@ -1051,7 +1567,7 @@ void CreateFontAtlasFromFile_TTF(Rendering_Info* renderingInfo, const char* ttfF
     //TODO: User should define atlas size
     int bitmapWidth_pxls = 512;
     int bitmapHeight_pxls = 512;
-    unsigned char* bitmap = (unsigned char*)globalPlatformServices->Malloc(bitmapWidth_pxls * bitmapHeight_pxls);//Current not freed anywhere
+    unsigned char* bitmap = (unsigned char*)globalPlatformServices->Malloc(bitmapWidth_pxls * bitmapHeight_pxls);
     
     //Make sure text height specified will fit within above bitmap
     int pixelWidth = (int)(pixelHeightForFont * 1.5f);//Just over estimating pixel width per char as I'm sure it will vary and won't be this much per char
@@ -1094,6 +1610,8 @@ void CreateFontAtlasFromFile_TTF(Rendering_Info* renderingInfo, const char* ttfF
         ++sourcePixel;
     }
     
+    globalPlatformServices->Free(bitmap);
+    
     //Can use this to test and make sure bitmap came out okay
     //stbi_write_png("out.png", bitmapWidth_pxls, bitmapHeight_pxls, 4, startOfDest, bitmapWidth_pxls * BYTES_PER_PIXEL);
     
@@ -1141,6 +1659,118 @@ Quad _ProduceQuadFromBottomLeftPoint(v2 originPoint, f32 width, f32 height)
 
 #ifdef PLATFORM_RENDERER_STUFF_IMPL
 
+//Returns the command buffer's sort entries in execution order (allocated from memPart). LSD radix sort a byte at a time,
+//which keeps entries with equal keys in push order
+//Radix digits, least significant first: the key's state bits (29-0), the draw order, then the key's layer + depth (63-30).
+//So entries sort by layer and depth, then push order, and only entries sharing a draw order get grouped by state
+local_func u32 _RenderSortDigit(Render_Sort_Entry sortEntry, s32 digitIndex)
+{
+    if (digitIndex < 4)
+        return (u32)(sortEntry.key >> (digitIndex * 8)) & (digitIndex < 3 ? 0xFF : 0x3F);
+    if (digitIndex < 8)
+        return ((u32)sortEntry.drawOrder >> ((digitIndex - 4) * 8)) & 0xFF;
+    
+    return (u32)(sortEntry.key >> (30 + (digitIndex - 8) * 8)) & 0xFF;
+};
+
+Render_Sort_Entry* SortRenderCmdBuffer(RenderCmdBuffer* cmdBuffer, bgz::Memory_Partition* memPart)
+{
+    s32 entryCount = cmdBuffer->entryCount;
+    Render_Sort_Entry* source = PushType(memPart, Render_Sort_Entry, entryCount);
+    Render_Sort_Entry* dest = PushType(memPart, Render_Sort_Entry, entryCount);
+    
+    //Sort entries were pushed down from the top of the buffer so the first entry pushed is the last one in memory
+    Render_Sort_Entry* pushedSortEntries = (Render_Sort_Entry*)(cmdBuffer->baseAddress + cmdBuffer->size) - entryCount;
+    for (s32 entryIndex {}; entryIndex < entryCount; ++entryIndex)
+        source[entryIndex] = pushedSortEntries[entryCount - 1 - entryIndex];
+    
+    for (s32 digitIndex {}; digitIndex < 13 && entryCount; ++digitIndex)
+    {
+        s32 bucketOffsets[256] {};
+        for (s32 entryIndex {}; entryIndex < entryCount; ++entryIndex)
+            ++bucketOffsets[_RenderSortDigit(source[entryIndex], digitIndex)];
+        
+        //Every entry has the same digit here (true for most of the key most frames) so this pass wouldn't move anything
+        if (bucketOffsets[_RenderSortDigit(source[0], digitIndex)] == entryCount)
+            continue;
+        
+        s32 totalCount {};
+        for (s32 bucket {}; bucket < 256; ++bucket)
+        {
+            s32 bucketCount = bucketOffsets[bucket];
+            bucketOffsets[bucket] = totalCount;
+            totalCount += bucketCount;
+        };
+        
+        for (s32 entryIndex {}; entryIndex < entryCount; ++entryIndex)
+            dest[bucketOffsets[_RenderSortDigit(source[entryIndex], digitIndex)]++] = source[entryIndex];
+        
+        Render_Sort_Entry* sorted = dest;
+        dest = source;
+        source = sorted;
+    };
+    
+    return source;
+};
+
+Render_Entry_Run GatherRenderEntryRun(RenderCmdBuffer* cmdBuffer, Render_Sort_Entry* sortedEntries, s32 firstEntry)
+{
+    Render_Entry_Run run { 1, 0 };
+    
+    RenderEntry_Header* firstHeader = (RenderEntry_Header*)(cmdBuffer->baseAddress + sortedEntries[firstEntry].entryOffset);
+    if (firstHeader->type != EntryType_DrawText && firstHeader->type != EntryType_DrawRect)
+        return run;
+    
+    u32 textureID = firstHeader->type == EntryType_DrawRect ? ((RenderEntry_DrawRect*)firstHeader)->textureID : 0;
+    
+    run.entryCount = 0;
+    while (firstEntry + run.entryCount < cmdBuffer->entryCount)
+    {
+        RenderEntry_Header* header = (RenderEntry_Header*)(cmdBuffer->baseAddress + sortedEntries[firstEntry + run.entryCount].entryOffset);
+        if (header->type != firstHeader->type)
+            break;
+        
+        if (header->type == EntryType_DrawText)
+        {
+            run.itemCount += ((RenderEntry_DrawText*)header)->glyphCount;
+        }
+        else
+        {
+            if (((RenderEntry_DrawRect*)header)->textureID != textureID)
+                break;
+            
+            ++run.itemCount;
+        };
+        
+        ++run.entryCount;
+    };
+    
+    return run;
+};
+
+//Nothing's known to be bound going in since the platform layer can touch gl between frames
+Render_Bind_State BeginRenderBinds()
+{
+    Render_Bind_State bindState {};
+    bindState.program = bindState.texture = bindState.vertexArray = bindState.depthFunc = (u32)-1;
+    
+    return bindState;
+};
+
+//Returns whether the backend needs to actually issue the bind (boundValue is one of bindState's members)
+b RenderBindChanged(Render_Bind_State&& bindState, u32&& boundValue, u32 value)
+{
+    if (boundValue == value)
+    {
+        ++bindState.bindsAvoided;
+        return false;
+    };
+    
+    boundValue = value;
+    ++bindState.bindsIssued;
+    return true;
+};
+
 v2 sp_DilateAboutArbitraryPoint(v2 PointOfDilation, f32 ScaleFactor, v2 vectorToDilate)
 {
     v2 dilatedVector{};
@@ -0,0 +1,59 @@
+/*
+    Offline tool that loads a spine rig the same way the game does (json -> game units -> baked clips) and writes it out
+    as a cooked .rig file the game can map straight into memory (see cooked_rig.h).
+
+    Usage: rig_cooker <atlas file> <json file> <output .rig file> [pixels per meter]
+
+    Pixels per meter has to match what the game runs at (window height * .1, so 72 for the default 720p window)
+    otherwise the game will ignore the cooked file and fall back to loading the json.
+*/
+
+#include "gamecode.cpp"
+
+#include "cooker_platform.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "Usage: rig_cooker <atlas file> <json file> <output .rig file> [pixels per meter]\n");
+        return 1;
+    };
+
+    const char* atlasFilePath = argv[1];
+    const char* jsonFilePath = argv[2];
+    const char* cookedFilePath = argv[3];
+    f32 pixelsPerMeter = argc > 4 ? (f32)atof(argv[4]) : 72.0f;
+
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    bgz::MemoryBlock cookerMemory {};
+    void* cookerMemoryPtr = malloc(Megabytes(256));
+    bgz::InitMemoryBlock($(cookerMemory), Megabytes(256), Megabytes(1), cookerMemoryPtr);
+    bgz::Memory_Partition* loadPart = bgz::CreatePartitionFromMemoryBlock($(cookerMemory), Megabytes(200), "load");
+
+    Skeleton skel {};
+    AnimationData animData {};
+    if (NOT _LoadRig($(skel), $(animData), $(*loadPart), atlasFilePath, jsonFilePath, pixelsPerMeter))
+    {
+        fprintf(stderr, "%s has animations that don't fit an Animation's key frame/hit box storage, not cooking it!\n", jsonFilePath);
+        return 1;
+    };
+    BakeAnimationClips($(animData), $(*loadPart));
+
+    ui32 cookedFileMemorySize = (ui32)Megabytes(32);
+    void* cookedFileMemory = PushSize(loadPart, cookedFileMemorySize);
+    ui32 cookedFileSize = CookRig(cookedFileMemory, cookedFileMemorySize, skel, animData, pixelsPerMeter);
+
+    if (NOT Cooker_WriteEntireFile(cookedFilePath, cookedFileMemory, cookedFileSize))
+    {
+        fprintf(stderr, "Unable to write %s!\n", cookedFilePath);
+        return 1;
+    };
+
+    printf("Cooked %s (%d bones, %d animations, %u bytes at %.1f pixels per meter)\n", cookedFilePath, skel.boneCount,
+           (i32)bgz::Size(&animData.animMap.animations), cookedFileSize, pixelsPerMeter);
+
+    return 0;
+};
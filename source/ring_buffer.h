@@ -88,21 +88,21 @@ class Ring_Buffer
     
     i64 Size()
     {
-        i64 size = this->maxSize;
+        i64 usedSize = this->maxSize;
         
         if (NOT this->full)
         {
             if (this->write >= this->read)
             {
-                size = this->write - this->read;
+                usedSize = this->write - this->read;
             }
             else
             {
-                size = this->maxSize + this->write - this->read;
+                usedSize = this->maxSize + this->write - this->read;
             };
         };
         
-        return size;
+        return usedSize;
     };
     
     void ClearRemaining()
@@ -1,6 +1,8 @@
 #ifndef RUNTIME_ARRAY_H
 #define RUNTIME_ARRAY_H
 
+#include <string.h>
+
 template <typename Type>
 struct RunTimeArr
 {
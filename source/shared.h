@@ -101,7 +101,15 @@ struct Platform_Services
     void (*Free)(void*);
     void (*AddWorkQueueEntry)(platform_work_queue_callback, void*);
     void (*FinishAllWork)(void);
+    bool (*DoNextWorkQueueEntry)(void); //Lets a thread waiting on queued work help out. Returns false if there was nothing to take
+    void (*SetWorkerThreadCount)(s32); //Workers past this count stop taking entries (for measuring thread scaling)
+    s32 maxWorkerThreadCount {};
     void (*Sleep)(unsigned int);
+    f64 (*CurrentTimeInSecs)(void);
+    i64 (*PeakMemoryUsage)(void); //Most bytes the process has had resident at once (peak RSS/working set). Null where it isn't implemented
+    i64 (*ReadCacheMissCount)(void); //Hardware counted cache misses of the calling thread so far, -1 if there's no counter. Null where it isn't implemented
+    void* (*MapEntireFile)(i32&&, const char*); //Copy on write view (writes never reach the file), always followed by a zero byte. Returns null if the file can't be opened
+    void (*UnmapFile)(void*);
     b DLLJustReloaded { false };
     f32 prevFrameTimeInSecs {};
     f32 targetFrameTimeInSecs {};
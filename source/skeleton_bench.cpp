@@ -0,0 +1,47 @@
+/*
+    Runs BenchmarkSkeletonWorldTransforms (see 2d_skeleton.h) outside the game, on a rig loaded the same way the game
+    loads it plus the synthetic deep chains. On linux each line also has the cache misses per update read from the cpu's
+    hardware counter (the one `perf stat -e cache-misses` reads), as long as the machine exposes it.
+
+    Usage: skeleton_bench <atlas file> <json file> [updates]
+*/
+
+#include "gamecode.cpp"
+
+#include "cooker_platform.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: skeleton_bench <atlas file> <json file> [updates]\n");
+        return 1;
+    };
+
+    const char* atlasFilePath = argv[1];
+    const char* jsonFilePath = argv[2];
+    i32 updates = argc > 3 ? atoi(argv[3]) : 100000;
+
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    if (platformServices.ReadCacheMissCount && platformServices.ReadCacheMissCount() < 0)
+        fprintf(stderr, "No hardware cache miss counter on this machine, only timings will be reported\n");
+
+    bgz::MemoryBlock benchMemory {};
+    void* benchMemoryPtr = malloc(Megabytes(16));
+    bgz::InitMemoryBlock($(benchMemory), Megabytes(16), Megabytes(1), benchMemoryPtr);
+    bgz::Memory_Partition* benchPart = bgz::CreatePartitionFromMemoryBlock($(benchMemory), Megabytes(12), "bench");
+
+    Skeleton skel {};
+    InitSkel($(skel), $(*benchPart), atlasFilePath, jsonFilePath);
+    if (skel.boneCount == 0)
+    {
+        fprintf(stderr, "Unable to load a skeleton from %s!\n", jsonFilePath);
+        return 1;
+    };
+
+    BenchmarkSkeletonWorldTransforms(&skel, jsonFilePath, $(*benchPart), updates);
+
+    return 0;
+};
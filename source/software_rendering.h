@@ -1,663 +1,1311 @@
 #ifndef SOFTWARE_RENDERING_INCLUDE_H
 #define SOFTWARE_RENDERING_INCLUDE_H
 
-//Diabling software rendering for now
-#if 0
-
-#include "renderer_stuff.h"
-#include <string.h>
-#include "shared.h"
-
 /*
-    TODO:
+    Cpu backend for the same command buffers RenderViaHardware takes, for when there's no gpu around (servers, tests,
+    replaying captures). Entries get sorted the same way, then every draw is turned into screen space triangles once
+    and each triangle's index is binned into the tiles its bounds overlap. Tiles get rasterized in parallel through the
+    platform work queue, 8 pixels at a time with AVX2, each one only walking its own bin. A tile's pixels are only
+    ever touched by the job that owns it so the frame comes out the same no matter how many threads render it.
+
+    Output follows the hardware renderer (same transforms, back face culling, texture filtering and blend func) except:
+        - There's no depth buffer. The sort already draws the world back to front so it only matters for triangles
+          of the same entry overlapping, which back face culling takes care of for cubes
+        - Mipmapped textures use one mip for the whole triangle instead of blending between two per pixel
+        - Line entries are skipped, same as the hardware renderer
 */
 
-#if 0
-//For static images
-local_func void
-DrawImage(Bitmap&& buffer, Rectf rect, Bitmap image)
-{
-    ui32* imagePixel = (ui32*)image.data;
-    
-    //Since I'm dealing with int pixels below
-    Recti targetRect{};
-    targetRect.min = RoundFloat32ToInt32(rect.min);
-    targetRect.max = RoundFloat32ToInt32(rect.max);
-    
-    {//Make sure we don't try to draw outside current screen space
-        if(targetRect.min.x < 0)
-            targetRect.min.x = 0;
-        
-        if(targetRect.min.y < 0)
-            targetRect.min.y = 0;
-        
-        if(targetRect.max.x > buffer.size.width)
-            targetRect.max.x = buffer.size.width;
-        
-        if(targetRect.max.y > buffer.size.height)
-            targetRect.max.y = buffer.size.height;
-    };
-    
-    ui8* currentRow = ((ui8*)buffer.data + targetRect.min.x*BYTES_PER_PIXEL+ targetRect.min.y*buffer.pitch);
-    for(i32 column = targetRect.min.y; column < targetRect.max.y; ++column)
-    {
-        ui32* destPixel = (ui32*)currentRow;
-        
-        for(i32 row = targetRect.min.x; row < targetRect.max.x; ++row)
-        {
-            
-#if 0 //Non-premultiplied alpha - aka post multiplied alpha (assuming premultiplication hasn't been done already)
-            auto[blendedPixel_R,blendedPixel_G,blendedPixel_B] = LinearBlend(*imagePixel, *destPixel, BGRA);
-            
-            
-            *destPixel = ((0xFF << 24) |
-                          (blendedPixel_R << 16) |
-                          (blendedPixel_G << 8) |
-                          (blendedPixel_B << 0));
-            ++destPixel;
-            ++imagePixel;
-#else
-            //Pre-multiplied alpha
-            v4 backgroundColors = UnPackPixelValues(*destPixel, BGRA);
-            v4 foregroundColors = UnPackPixelValues(*imagePixel, BGRA);
-            f32 alphaBlend = foregroundColors.a / 255.0f;
-            v4 finalBlendedColor = (1.0f - alphaBlend)*backgroundColors + foregroundColors;
-            
-            *destPixel = ((0xFF << 24) |
-                          ((ui8)finalBlendedColor.r << 16) |
-                          ((ui8)finalBlendedColor.g << 8) |
-                          ((ui8)finalBlendedColor.b << 0));
-            
-            ++destPixel;
-            ++imagePixel;
+#define SOFTWARE_RENDER_TILE_SIZE 64 //Pixels. Has to be a multiple of 8, which is how many pixels get shaded at once
+#define SOFTWARE_RENDER_MAX_JOBS 64 //Work queue entries per frame. Each one renders every SOFTWARE_RENDER_MAX_JOBS'th tile
+#define SOFTWARE_TEXTURE_MAX_MIPS 16
+
+struct Software_Render_Target
+{
+    u32* pixels { nullptr }; //BGRA, first row is the bottom of the screen (same as gl and a bottom up DIB section)
+    s32 width {};
+    s32 height {};
+    s32 pitch_pxls {};
+};
+
+//Renders synchronously, the calling thread helps with the tiles. Everything runs on the calling thread if the platform
+//has no work queue
+void RenderViaSoftware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferToRender, Software_Render_Target target,
+                       bgz::Memory_Partition* platformMemoryPart, Platform_Services* platformServices);
+
+#if DEVELOPMENT_BUILD
+void BenchmarkSoftwareRenderer(bgz::Memory_Partition* memPart, Platform_Services* platformServices, v2i screenSize, s32 spriteCount, s32 passes);
+void BenchmarkSoftwareRenderBinning(bgz::Memory_Partition* memPart, Platform_Services* platformServices, v2i screenSize, s32 passes);
 #endif
-        }
-        
-        currentRow += buffer.pitch;
-    }
+
+#endif //SOFTWARE_RENDERING_INCLUDE_H
+
+#ifdef SOFTWARE_RENDERING_IMPL
+
+struct Software_Texture_Level
+{
+    u32* pixels { nullptr };
+    s32 width {};
+    s32 height {};
+};
+
+struct Software_Texture
+{
+    Software_Texture_Level levels[SOFTWARE_TEXTURE_MAX_MIPS] {};
+    s32 levelCount {};
+    b bilinear { false }; //Only mipmapped textures get linear filtering on the hardware side, the rest are nearest
+};
+
+//Copied out of the InitVertexData entry since the game's arrays only have to live until the frame's rendered
+struct Software_Vertex_Data
+{
+    v3* positions { nullptr };
+    v2* uvs { nullptr }; //Null if there were no tex coords, gl reads 0, 0 for a disabled attribute
+    s16* indices { nullptr };
+    s32 vertCount {};
+    s32 indexCount {};
+};
+
+//Stand ins for gl's texture and vertex array objects, indexed by the ids the game was handed
+struct Software_Resources
+{
+    Software_Texture* textures { nullptr };
+    s32 textureCapacity {};
+    Software_Vertex_Data* vertexData { nullptr };
+    s32 vertexDataCapacity {};
+};
+
+global_variable Software_Resources globalSoftwareResources;
+
+//f(x, y) = x * dx + y * dy + c, evaluated at pixel centers
+struct Software_Plane
+{
+    f32 dx, dy, c;
+};
+
+//Screen space triangle, set up once per frame and read by every tile it's binned into
+struct Software_Triangle
+{
+    Software_Plane edges[3]; //Pixel is inside if all three are >= 0 (only == 0 on inclusive edges)
+    b edgeIsInclusive[3]; //Fill rule, so a pixel right on an edge shared by two triangles only gets drawn once
+    Software_Plane invW; //1/w, u/w and v/w are linear in screen space (u and v aren't once there's perspective)
+    Software_Plane uOverW;
+    Software_Plane vOverW;
+    v4 color;
+    const Software_Texture_Level* texture; //Null = untextured
+    b bilinear;
+    s32 minX, minY, maxX, maxY; //Pixel bounds clamped to the target, max exclusive
+};
+
+struct Software_Triangle_List
+{
+    Software_Triangle* triangles;
+    s32 count;
+    s32 capacity;
+    s32 targetWidth;
+    s32 targetHeight;
+};
+
+struct Software_Clip_Vert
+{
+    v4 pos; //Clip space
+    v2 uv;
+};
+
+struct Software_Frame
+{
+    Software_Render_Target target;
+    u32 clearPixel;
+    s32 tileCountX;
+    s32 tileCountY;
+    const Software_Triangle* triangles;
+    const s32* binOffsets; //tileCount + 1 of them, a tile's bin is binTriangles[binOffsets[tile]] up to binTriangles[binOffsets[tile + 1]]
+    const s32* binTriangles; //Triangle indices, in draw order within each bin
 };
 
-//Avoids a lot of the calcuations found in DrawImageSlowly for better performance (Since background won't rotate or
-//do other fancier things. Though it will still scale)
-//TODO: Will probably end up removing and just combine with DrawImage call so there is just one imaging drawing func
-local_func void
-DrawBackground(Image&& buffer, Quad targetQuad, Bitmap image)
-{
-    ui32* imagePixel = (ui32*)image.data;
-    
-    v2 targetQuadOrigin = targetQuad.bottomLeft;
-    v2 targetQuadXAxis = targetQuad.bottomRight - targetQuadOrigin;
-    v2 targetQuadYAxis = targetQuad.topLeft - targetQuadOrigin;
-    
-    ui8* currentRow = (ui8*)buffer.data;
-    f32 invertedXAxisSqd = 1.0f / MagnitudeSqd(targetQuadXAxis);
-    f32 invertedYAxisSqd = 1.0f / MagnitudeSqd(targetQuadYAxis);
-    
-    for(i32 screenPixelColumn = 0; screenPixelColumn < buffer.size.height; ++screenPixelColumn)
-    {
-        ui32* destPixel = (ui32*)currentRow;
-        
-        for(i32 screenPixelRow = 0; screenPixelRow < buffer.size.width; ++screenPixelRow)
+struct Software_Tile_Job
+{
+    const Software_Frame* frame;
+    s32 firstTile;
+    s32 tileStride;
+    b volatile done;
+};
+
+local_func void* _GrowResourceTable(void* table, s32&& capacity, s32 neededIndex, sizet elementSize, Platform_Services* platformServices)
+{
+    if (neededIndex < capacity)
+        return table;
+
+    s32 newCapacity = capacity ? capacity : 16;
+    while (newCapacity <= neededIndex)
+        newCapacity *= 2;
+
+    table = platformServices->Realloc(table, newCapacity * elementSize);
+    memset((u8*)table + capacity * elementSize, 0, (newCapacity - capacity) * elementSize);
+    capacity = newCapacity;
+
+    return table;
+};
+
+local_func void _StoreTextureLevel(Software_Texture_Level* level, Bitmap bitmap, Platform_Services* platformServices)
+{
+    sizet size = (sizet)bitmap.width_pxls * bitmap.height_pxls * sizeof(u32);
+    level->pixels = (u32*)platformServices->Realloc(level->pixels, size);
+    memcpy(level->pixels, bitmap.data, size);
+    level->width = bitmap.width_pxls;
+    level->height = bitmap.height_pxls;
+};
+
+local_func Software_Texture* _SoftwareTexture(u32 textureID)
+{
+    if (NOT textureID || textureID >= (u32)globalSoftwareResources.textureCapacity)
+        return nullptr;
+
+    Software_Texture* texture = &globalSoftwareResources.textures[textureID];
+    return texture->levelCount ? texture : nullptr;
+};
+
+local_func Software_Vertex_Data* _SoftwareVertexData(s32 vertObjID)
+{
+    BGZ_ASSERT(vertObjID > 0 && vertObjID < globalSoftwareResources.vertexDataCapacity);//, "Drawing with vertex data that was never sent!");
+    return &globalSoftwareResources.vertexData[vertObjID];
+};
+
+local_func Software_Plane _PlaneThroughTriangle(v2 p0, v2 p1, v2 p2, f32 value0, f32 value1, f32 value2, f32 invArea2)
+{
+    v2 edge1 = p1 - p0;
+    v2 edge2 = p2 - p0;
+
+    Software_Plane plane {};
+    plane.dx = ((value1 - value0) * edge2.y - (value2 - value0) * edge1.y) * invArea2;
+    plane.dy = ((value2 - value0) * edge1.x - (value1 - value0) * edge2.x) * invArea2;
+    plane.c = value0 - plane.dx * p0.x - plane.dy * p0.y;
+
+    return plane;
+};
+
+//Edges are built from vertex positions alone, so the same edge walked the other way by the neighboring triangle comes
+//out exactly negated and every pixel on it is inside exactly one of them
+local_func void _SetupEdge(Software_Triangle* tri, s32 edgeIndex, v2 from, v2 to)
+{
+    Software_Plane edge {};
+    edge.dx = from.y - to.y;
+    edge.dy = to.x - from.x;
+    edge.c = from.x * to.y - from.y * to.x;
+
+    tri->edges[edgeIndex] = edge;
+    tri->edgeIsInclusive[edgeIndex] = edge.dx > 0.0f || (edge.dx == 0.0f && edge.dy < 0.0f);
+};
+
+local_func void _SetupScreenTriangle(Software_Triangle_List* list, Software_Clip_Vert vert0, Software_Clip_Vert vert1, Software_Clip_Vert vert2,
+                                     v4 color, const Software_Texture* texture)
+{
+    Software_Clip_Vert verts[3] = { vert0, vert1, vert2 };
+    v2 screenPos[3];
+    f32 invW[3];
+    for (s32 vertIndex {}; vertIndex < 3; ++vertIndex)
+    {
+        invW[vertIndex] = 1.0f / verts[vertIndex].pos.w;
+        screenPos[vertIndex].x = (verts[vertIndex].pos.x * invW[vertIndex] + 1.0f) * .5f * (f32)list->targetWidth;
+        screenPos[vertIndex].y = (verts[vertIndex].pos.y * invW[vertIndex] + 1.0f) * .5f * (f32)list->targetHeight;
+    };
+
+    //Front faces are clockwise (glFrontFace(GL_CW)). Anything else is culled like the hardware renderer does
+    f32 area2 = (screenPos[1].x - screenPos[0].x) * (screenPos[2].y - screenPos[0].y) - (screenPos[2].x - screenPos[0].x) * (screenPos[1].y - screenPos[0].y);
+    if (NOT (area2 < 0.0f))
+        return;
+
+    f32 minXf = Min(screenPos[0].x, Min(screenPos[1].x, screenPos[2].x));
+    f32 minYf = Min(screenPos[0].y, Min(screenPos[1].y, screenPos[2].y));
+    f32 maxXf = Max(screenPos[0].x, Max(screenPos[1].x, screenPos[2].x));
+    f32 maxYf = Max(screenPos[0].y, Max(screenPos[1].y, screenPos[2].y));
+    minXf = Max(minXf, 0.0f);
+    minYf = Max(minYf, 0.0f);
+    maxXf = Min(maxXf, (f32)list->targetWidth);
+    maxYf = Min(maxYf, (f32)list->targetHeight);
+    if (minXf >= maxXf || minYf >= maxYf)
+        return;
+
+    BGZ_ASSERT(list->count < list->capacity);
+    Software_Triangle* tri = &list->triangles[list->count++];
+    *tri = Software_Triangle {};
+    tri->minX = FloorF32ToI32(minXf);
+    tri->minY = FloorF32ToI32(minYf);
+    tri->maxX = CeilF32ToI32(maxXf);
+    tri->maxY = CeilF32ToI32(maxYf);
+    tri->color = color;
+
+    //Walk it counter clockwise so the inside is on the left of every edge
+    _SetupEdge(tri, 0, screenPos[0], screenPos[2]);
+    _SetupEdge(tri, 1, screenPos[2], screenPos[1]);
+    _SetupEdge(tri, 2, screenPos[1], screenPos[0]);
+
+    if (texture)
+    {
+        f32 invArea2 = 1.0f / area2;
+        v2 uv0 = verts[0].uv, uv1 = verts[1].uv, uv2 = verts[2].uv;
+        tri->invW = _PlaneThroughTriangle(screenPos[0], screenPos[1], screenPos[2], invW[0], invW[1], invW[2], invArea2);
+        tri->uOverW = _PlaneThroughTriangle(screenPos[0], screenPos[1], screenPos[2], uv0.x * invW[0], uv1.x * invW[1], uv2.x * invW[2], invArea2);
+        tri->vOverW = _PlaneThroughTriangle(screenPos[0], screenPos[1], screenPos[2], uv0.y * invW[0], uv1.y * invW[1], uv2.y * invW[2], invArea2);
+
+        //Mip whose texels come closest to 1 per pixel over the whole triangle. Each level down has a quarter of the texels
+        s32 mipLevel {};
+        const Software_Texture_Level* baseLevel = &texture->levels[0];
+        f32 uvArea2 = AbsoluteValFloat((uv1.x - uv0.x) * (uv2.y - uv0.y) - (uv2.x - uv0.x) * (uv1.y - uv0.y));
+        f32 texelsPerPixel = (uvArea2 * (f32)baseLevel->width * (f32)baseLevel->height) / AbsoluteValFloat(area2);
+        while (mipLevel + 1 < texture->levelCount && texelsPerPixel >= 2.0f)
+        {
+            texelsPerPixel *= .25f;
+            ++mipLevel;
+        };
+
+        tri->texture = &texture->levels[mipLevel];
+        tri->bilinear = texture->bilinear;
+    };
+};
+
+local_func Software_Clip_Vert _LerpClipVert(Software_Clip_Vert a, Software_Clip_Vert b, f32 t)
+{
+    Software_Clip_Vert result {};
+    result.pos = a.pos + t * (b.pos - a.pos);
+    result.uv = a.uv + t * (b.uv - a.uv);
+
+    return result;
+};
+
+//Only the near plane gets clipped against (w goes to 0 behind the camera). Everything else is handled by clamping to
+//the target when rasterizing
+local_func void _SetupTriangle(Software_Triangle_List* list, Software_Clip_Vert vert0, Software_Clip_Vert vert1, Software_Clip_Vert vert2,
+                               v4 color, const Software_Texture* texture)
+{
+    Software_Clip_Vert verts[3] = { vert0, vert1, vert2 };
+    f32 nearDistances[3];
+    s32 outsideCount {}, beyondFarCount {};
+    for (s32 vertIndex {}; vertIndex < 3; ++vertIndex)
+    {
+        nearDistances[vertIndex] = verts[vertIndex].pos.z + verts[vertIndex].pos.w;
+        outsideCount += nearDistances[vertIndex] < 0.0f;
+        beyondFarCount += verts[vertIndex].pos.z > verts[vertIndex].pos.w;
+    };
+
+    if (outsideCount == 3 || beyondFarCount == 3)
+        return;
+
+    if (NOT outsideCount)
+    {
+        _SetupScreenTriangle(list, vert0, vert1, vert2, color, texture);
+        return;
+    };
+
+    //Clipping a triangle against one plane leaves 3 or 4 verts, in the same winding order
+    Software_Clip_Vert clipped[4];
+    s32 clippedCount {};
+    for (s32 vertIndex {}; vertIndex < 3; ++vertIndex)
+    {
+        s32 nextIndex = (vertIndex + 1) % 3;
+        f32 distance = nearDistances[vertIndex], nextDistance = nearDistances[nextIndex];
+
+        if (distance >= 0.0f)
+            clipped[clippedCount++] = verts[vertIndex];
+
+        if ((distance >= 0.0f) != (nextDistance >= 0.0f))
+            clipped[clippedCount++] = _LerpClipVert(verts[vertIndex], verts[nextIndex], distance / (distance - nextDistance));
+    };
+
+    for (s32 fanIndex { 2 }; fanIndex < clippedCount; ++fanIndex)
+        _SetupScreenTriangle(list, clipped[0], clipped[fanIndex - 1], clipped[fanIndex], color, texture);
+};
+
+local_func void _SetupVertexDataTriangles(Software_Triangle_List* list, const Software_Vertex_Data* vertexData, s32 indexCount, Mat4x4 fullTransformMatrix,
+                                          v4 color, const Software_Texture* texture)
+{
+    BGZ_ASSERT(indexCount <= vertexData->indexCount);
+
+    for (s32 index {}; index + 2 < indexCount; index += 3)
+    {
+        Software_Clip_Vert verts[3];
+        for (s32 cornerIndex {}; cornerIndex < 3; ++cornerIndex)
         {
-            v2 screenPixelCoord{(f32)screenPixelRow, (f32)screenPixelColumn};
-            v2 d {screenPixelCoord - targetQuadOrigin};
-            
-            f32 u = invertedXAxisSqd * DotProduct(d, targetQuadXAxis);
-            f32 v = invertedYAxisSqd * DotProduct(d, targetQuadYAxis);
-            
-            f32 texelPos_x = 1.0f + (u*(f32)(image.size.width));
-            f32 texelPos_y = 1.0f + (v*(f32)(image.size.height));
-            
-            BGZ_ASSERT(texelPos_x <= (f32)image.size.width);//, "Trying to fill in pixel outside current background image width boundry!");
-            BGZ_ASSERT(texelPos_y <= (f32)image.size.height);//, "Trying to fill in pixel outside current background image height boundry!");
-            
-            ui32* backgroundTexel = (ui32*)(((ui8*)image.data) + ((ui32)texelPos_y*image.pitch) + ((ui32)texelPos_x*sizeof(ui32)));//size of pixel
-            
-            v4 imagePixel = UnPackPixelValues(*backgroundTexel, BGRA);
-            
-            *destPixel = ((0xFF << 24) |
-                          ((ui8)imagePixel.r << 16) |
-                          ((ui8)imagePixel.g << 8) |
-                          ((ui8)imagePixel.b << 0));
-            
-            ++destPixel;
+            s16 vertIndex = vertexData->indices[index + cornerIndex];
+            verts[cornerIndex].pos = fullTransformMatrix * v4 { vertexData->positions[vertIndex], 1.0f };
+            verts[cornerIndex].uv = vertexData->uvs ? vertexData->uvs[vertIndex] : v2 { 0.0f, 0.0f };
+        };
+
+        _SetupTriangle(list, verts[0], verts[1], verts[2], color, texture);
+    };
+};
+
+//Glyph corners are already 0 to 1 across the screen, which maps straight to clip space with w = 1
+local_func Software_Clip_Vert _GlyphCorner(v2 pos_normalized, v2 uv)
+{
+    Software_Clip_Vert vert {};
+    vert.pos = v4 { pos_normalized.x * 2.0f - 1.0f, pos_normalized.y * 2.0f - 1.0f, 0.0f, 1.0f };
+    vert.uv = uv;
+
+    return vert;
+};
+
+local_func u32 _PackPixel(f32 r, f32 g, f32 b, f32 a)
+{
+    Clamp($(r), 0.0f, 255.0f);
+    Clamp($(g), 0.0f, 255.0f);
+    Clamp($(b), 0.0f, 255.0f);
+    Clamp($(a), 0.0f, 255.0f);
+
+    return ((u32)(a + .5f) << 24) | ((u32)(r + .5f) << 16) | ((u32)(g + .5f) << 8) | ((u32)(b + .5f) << 0);
+};
+
+inline f32 _EvalPlane(Software_Plane plane, f32 x, f32 y)
+{
+    return (plane.dx * x + plane.dy * y) + plane.c;
+};
+
+local_func v4 _TexelColor(const Software_Texture_Level* texture, s32 x, s32 y)
+{
+    x = x < 0 ? 0 : (x >= texture->width ? texture->width - 1 : x);
+    y = y < 0 ? 0 : (y >= texture->height ? texture->height - 1 : y);
+
+    return UnPackPixelValues(texture->pixels[y * texture->width + x], BGRA);
+};
+
+//Returns channels in 0 to 255. Clamps to edge like the hardware textures
+local_func v4 _SampleTexture(const Software_Texture_Level* texture, b bilinear, f32 u, f32 v)
+{
+    f32 texelX = u * (f32)texture->width;
+    f32 texelY = v * (f32)texture->height;
+
+    if (NOT bilinear)
+        return _TexelColor(texture, FloorF32ToI32(texelX), FloorF32ToI32(texelY));
+
+    texelX -= .5f;
+    texelY -= .5f;
+    f32 flooredX = Floor(texelX), flooredY = Floor(texelY);
+    f32 fractionX = texelX - flooredX, fractionY = texelY - flooredY;
+    s32 x = (s32)flooredX, y = (s32)flooredY;
+
+    v4 bottom = Lerp(_TexelColor(texture, x, y), _TexelColor(texture, x + 1, y), fractionX);
+    v4 top = Lerp(_TexelColor(texture, x, y + 1), _TexelColor(texture, x + 1, y + 1), fractionX);
+
+    return Lerp(bottom, top, fractionY);
+};
+
+//Same math as _ShadePixels_8Wide, used for whatever's left of a row and when AVX2 isn't available
+local_func void _ShadePixel(const Software_Triangle* tri, u32* pixel, s32 x, f32 pixelY)
+{
+    f32 pixelX = (f32)x + .5f;
+    for (s32 edgeIndex {}; edgeIndex < 3; ++edgeIndex)
+    {
+        f32 edgeValue = _EvalPlane(tri->edges[edgeIndex], pixelX, pixelY);
+        if (edgeValue < 0.0f || (edgeValue == 0.0f && NOT tri->edgeIsInclusive[edgeIndex]))
+            return;
+    };
+
+    v4 texel { 255.0f, 255.0f, 255.0f, 255.0f };
+    if (tri->texture)
+    {
+        f32 w = 1.0f / _EvalPlane(tri->invW, pixelX, pixelY);
+        f32 u = _EvalPlane(tri->uOverW, pixelX, pixelY) * w;
+        f32 v = _EvalPlane(tri->vOverW, pixelX, pixelY) * w;
+        texel = _SampleTexture(tri->texture, tri->bilinear, u, v);
+    };
+
+    //Src alpha, one minus src alpha on every channel, same as the hardware renderer's blend func
+    v4 src = v4 { tri->color.r * texel.r, tri->color.g * texel.g, tri->color.b * texel.b, tri->color.a * texel.a };
+    v4 dest = UnPackPixelValues(*pixel, BGRA);
+    f32 srcAlpha = src.a / 255.0f;
+    v4 blended = srcAlpha * src + (1.0f - srcAlpha) * dest;
+
+    *pixel = _PackPixel(blended.r, blended.g, blended.b, blended.a);
+};
+
+#if __AVX2__
+inline __m256 _EvalPlane_8Wide(Software_Plane plane, __m256 x, f32 y)
+{
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.dx), x), _mm256_set1_ps(plane.dy * y)), _mm256_set1_ps(plane.c));
+};
+
+inline void _UnpackPixels_8Wide(__m256i pixels, __m256&& r, __m256&& g, __m256&& b, __m256&& a)
+{
+    __m256i byteMask = _mm256_set1_epi32(0xFF);
+    b = _mm256_cvtepi32_ps(_mm256_and_si256(pixels, byteMask));
+    g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask));
+    r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask));
+    a = _mm256_cvtepi32_ps(_mm256_srli_epi32(pixels, 24));
+};
+
+inline __m256i _GatherTexels_8Wide(const Software_Texture_Level* texture, __m256i x, __m256i y)
+{
+    __m256i zero = _mm256_setzero_si256();
+    x = _mm256_min_epi32(_mm256_max_epi32(x, zero), _mm256_set1_epi32(texture->width - 1));
+    y = _mm256_min_epi32(_mm256_max_epi32(y, zero), _mm256_set1_epi32(texture->height - 1));
+    __m256i texelIndices = _mm256_add_epi32(_mm256_mullo_epi32(y, _mm256_set1_epi32(texture->width)), x);
+
+    return _mm256_i32gather_epi32((const int*)texture->pixels, texelIndices, 4);
+};
+
+inline __m256 _Lerp_8Wide(__m256 a, __m256 b, __m256 t)
+{
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+};
+
+//Shades pixels x to x + 7 of a row. All 8 have to be on the target
+local_func void _ShadePixels_8Wide(const Software_Triangle* tri, u32* pixels, s32 x, f32 pixelY)
+{
+    __m256 zero = _mm256_setzero_ps();
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 pixelX = _mm256_add_ps(_mm256_set1_ps((f32)x + .5f), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+
+    __m256 insideMask = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (s32 edgeIndex {}; edgeIndex < 3; ++edgeIndex)
+    {
+        __m256 edgeValue = _EvalPlane_8Wide(tri->edges[edgeIndex], pixelX, pixelY);
+        __m256 edgeMask = tri->edgeIsInclusive[edgeIndex] ? _mm256_cmp_ps(edgeValue, zero, _CMP_GE_OQ) : _mm256_cmp_ps(edgeValue, zero, _CMP_GT_OQ);
+        insideMask = _mm256_and_ps(insideMask, edgeMask);
+    };
+
+    if (NOT _mm256_movemask_ps(insideMask))
+        return;
+
+    __m256 texel_r = _mm256_set1_ps(255.0f), texel_g = texel_r, texel_b = texel_r, texel_a = texel_r;
+    if (tri->texture)
+    {
+        const Software_Texture_Level* texture = tri->texture;
+
+        __m256 w = _mm256_div_ps(one, _EvalPlane_8Wide(tri->invW, pixelX, pixelY));
+        __m256 texelX = _mm256_mul_ps(_mm256_mul_ps(_EvalPlane_8Wide(tri->uOverW, pixelX, pixelY), w), _mm256_set1_ps((f32)texture->width));
+        __m256 texelY = _mm256_mul_ps(_mm256_mul_ps(_EvalPlane_8Wide(tri->vOverW, pixelX, pixelY), w), _mm256_set1_ps((f32)texture->height));
+
+        if (NOT tri->bilinear)
+        {
+            __m256i texels = _GatherTexels_8Wide(texture, _mm256_cvttps_epi32(_mm256_floor_ps(texelX)), _mm256_cvttps_epi32(_mm256_floor_ps(texelY)));
+            _UnpackPixels_8Wide(texels, $(texel_r), $(texel_g), $(texel_b), $(texel_a));
         }
-        
-        currentRow += buffer.pitch;
-    }
+        else
+        {
+            __m256 half = _mm256_set1_ps(.5f);
+            texelX = _mm256_sub_ps(texelX, half);
+            texelY = _mm256_sub_ps(texelY, half);
+            __m256 flooredX = _mm256_floor_ps(texelX), flooredY = _mm256_floor_ps(texelY);
+            __m256 fractionX = _mm256_sub_ps(texelX, flooredX), fractionY = _mm256_sub_ps(texelY, flooredY);
+            __m256i x0 = _mm256_cvttps_epi32(flooredX), y0 = _mm256_cvttps_epi32(flooredY);
+            __m256i x1 = _mm256_add_epi32(x0, _mm256_set1_epi32(1)), y1 = _mm256_add_epi32(y0, _mm256_set1_epi32(1));
+
+            __m256 texel00_r, texel00_g, texel00_b, texel00_a;
+            __m256 texel10_r, texel10_g, texel10_b, texel10_a;
+            __m256 texel01_r, texel01_g, texel01_b, texel01_a;
+            __m256 texel11_r, texel11_g, texel11_b, texel11_a;
+            _UnpackPixels_8Wide(_GatherTexels_8Wide(texture, x0, y0), $(texel00_r), $(texel00_g), $(texel00_b), $(texel00_a));
+            _UnpackPixels_8Wide(_GatherTexels_8Wide(texture, x1, y0), $(texel10_r), $(texel10_g), $(texel10_b), $(texel10_a));
+            _UnpackPixels_8Wide(_GatherTexels_8Wide(texture, x0, y1), $(texel01_r), $(texel01_g), $(texel01_b), $(texel01_a));
+            _UnpackPixels_8Wide(_GatherTexels_8Wide(texture, x1, y1), $(texel11_r), $(texel11_g), $(texel11_b), $(texel11_a));
+
+            texel_r = _Lerp_8Wide(_Lerp_8Wide(texel00_r, texel10_r, fractionX), _Lerp_8Wide(texel01_r, texel11_r, fractionX), fractionY);
+            texel_g = _Lerp_8Wide(_Lerp_8Wide(texel00_g, texel10_g, fractionX), _Lerp_8Wide(texel01_g, texel11_g, fractionX), fractionY);
+            texel_b = _Lerp_8Wide(_Lerp_8Wide(texel00_b, texel10_b, fractionX), _Lerp_8Wide(texel01_b, texel11_b, fractionX), fractionY);
+            texel_a = _Lerp_8Wide(_Lerp_8Wide(texel00_a, texel10_a, fractionX), _Lerp_8Wide(texel01_a, texel11_a, fractionX), fractionY);
+        };
+    };
+
+    __m256 src_r = _mm256_mul_ps(_mm256_set1_ps(tri->color.r), texel_r);
+    __m256 src_g = _mm256_mul_ps(_mm256_set1_ps(tri->color.g), texel_g);
+    __m256 src_b = _mm256_mul_ps(_mm256_set1_ps(tri->color.b), texel_b);
+    __m256 src_a = _mm256_mul_ps(_mm256_set1_ps(tri->color.a), texel_a);
+
+    __m256i destPixels = _mm256_loadu_si256((__m256i*)pixels);
+    __m256 dest_r, dest_g, dest_b, dest_a;
+    _UnpackPixels_8Wide(destPixels, $(dest_r), $(dest_g), $(dest_b), $(dest_a));
+
+    __m256 srcAlpha = _mm256_div_ps(src_a, _mm256_set1_ps(255.0f));
+    __m256 invSrcAlpha = _mm256_sub_ps(one, srcAlpha);
+    __m256 blended_r = _mm256_add_ps(_mm256_mul_ps(srcAlpha, src_r), _mm256_mul_ps(invSrcAlpha, dest_r));
+    __m256 blended_g = _mm256_add_ps(_mm256_mul_ps(srcAlpha, src_g), _mm256_mul_ps(invSrcAlpha, dest_g));
+    __m256 blended_b = _mm256_add_ps(_mm256_mul_ps(srcAlpha, src_b), _mm256_mul_ps(invSrcAlpha, dest_b));
+    __m256 blended_a = _mm256_add_ps(_mm256_mul_ps(srcAlpha, src_a), _mm256_mul_ps(invSrcAlpha, dest_a));
+
+    //Round + clamp each channel to a byte then pack back into BGRA
+    __m256i zeroi = _mm256_setzero_si256();
+    __m256i maxChannel = _mm256_set1_epi32(255);
+    __m256i channel_r = _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(blended_r), zeroi), maxChannel);
+    __m256i channel_g = _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(blended_g), zeroi), maxChannel);
+    __m256i channel_b = _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(blended_b), zeroi), maxChannel);
+    __m256i channel_a = _mm256_min_epi32(_mm256_max_epi32(_mm256_cvtps_epi32(blended_a), zeroi), maxChannel);
+    __m256i blendedPixels = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(channel_a, 24), _mm256_slli_epi32(channel_r, 16)),
+                                            _mm256_or_si256(_mm256_slli_epi32(channel_g, 8), channel_b));
+
+    __m256i outPixels = _mm256_blendv_epi8(destPixels, blendedPixels, _mm256_castps_si256(insideMask));
+    _mm256_storeu_si256((__m256i*)pixels, outPixels);
 };
 #endif
 
-local_func void
-DrawRectangle(ui32* colorBufferData, v2i colorBufferSize, i32 colorBufferPitch, Quad targetRect_screenCoords, v3 rectColor, Rect clipRect)
-{
-    v2 origin = targetRect_screenCoords.bottomLeft.xy;
-    v2 targetRectXAxis = targetRect_screenCoords.bottomRight.xy - targetRect_screenCoords.bottomLeft.xy;
-    v2 targetRectYAxis = targetRect_screenCoords.topLeft.xy - targetRect_screenCoords.bottomLeft.xy;
-    
-    ui32 pixelColor = { (0xFF << 24) | (RoundFloat32ToUInt32(rectColor.r * 255.0f) << 16) | (RoundFloat32ToUInt32(rectColor.g * 255.0f) << 8) | (RoundFloat32ToUInt32(rectColor.b * 255.0f) << 0) };
-    
-    f32 widthMax = Max(clipRect).x;
-    f32 heightMax = Max(clipRect).y;
-    
-    f32 xMin = widthMax;
-    f32 xMax = Min(clipRect).x;
-    f32 yMin = heightMax;
-    f32 yMax = Min(clipRect).y;
-    
-    { //Optimization to avoid iterating over every pixel on the screen - HH ep 92
-        Array<v2, 4> vecs = { origin, origin + targetRectXAxis, origin + targetRectXAxis + targetRectYAxis, origin + targetRectYAxis };
-        for (i32 vecIndex = 0; vecIndex < vecs.Size(); ++vecIndex)
+local_func void _RasterizeTriangle(const Software_Triangle* tri, Software_Render_Target target, s32 tileMinX, s32 tileMinY, s32 tileMaxX, s32 tileMaxY)
+{
+    s32 minX = tri->minX > tileMinX ? tri->minX : tileMinX;
+    s32 minY = tri->minY > tileMinY ? tri->minY : tileMinY;
+    s32 maxX = tri->maxX < tileMaxX ? tri->maxX : tileMaxX;
+    s32 maxY = tri->maxY < tileMaxY ? tri->maxY : tileMaxY;
+    if (minX >= maxX || minY >= maxY)
+        return;
+
+    //Blocks of 8 start on the tile's 8 pixel boundaries, so a pixel always gets shaded by the same path (and comes out
+    //exactly the same) no matter which triangle is covering it
+    s32 startX = tileMinX + ((minX - tileMinX) & ~7);
+    s32 blockEndX = tileMinX + ((tileMaxX - tileMinX) & ~7);
+
+    for (s32 y { minY }; y < maxY; ++y)
+    {
+        u32* row = target.pixels + (sizet)y * target.pitch_pxls;
+        f32 pixelY = (f32)y + .5f;
+        s32 x = startX;
+
+#if __AVX2__
+        for (; x < maxX && x + 8 <= blockEndX; x += 8)
+            _ShadePixels_8Wide(tri, row + x, x, pixelY);
+#endif
+
+        for (; x < maxX; ++x)
+            _ShadePixel(tri, row + x, x, pixelY);
+    };
+};
+
+//Clears the tile to the frame's clear color and gives back its pixel bounds (max exclusive)
+local_func void _BeginSoftwareTile(const Software_Frame* frame, s32 tileIndex, s32&& tileMinX, s32&& tileMinY, s32&& tileMaxX, s32&& tileMaxY)
+{
+    Software_Render_Target target = frame->target;
+    tileMinX = (tileIndex % frame->tileCountX) * SOFTWARE_RENDER_TILE_SIZE;
+    tileMinY = (tileIndex / frame->tileCountX) * SOFTWARE_RENDER_TILE_SIZE;
+    tileMaxX = tileMinX + SOFTWARE_RENDER_TILE_SIZE < target.width ? tileMinX + SOFTWARE_RENDER_TILE_SIZE : target.width;
+    tileMaxY = tileMinY + SOFTWARE_RENDER_TILE_SIZE < target.height ? tileMinY + SOFTWARE_RENDER_TILE_SIZE : target.height;
+
+    for (s32 y { tileMinY }; y < tileMaxY; ++y)
+    {
+        u32* row = target.pixels + (sizet)y * target.pitch_pxls;
+        for (s32 x { tileMinX }; x < tileMaxX; ++x)
+            row[x] = frame->clearPixel;
+    };
+};
+
+local_func void _RenderSoftwareTile(const Software_Frame* frame, s32 tileIndex)
+{
+    s32 tileMinX {}, tileMinY {}, tileMaxX {}, tileMaxY {};
+    _BeginSoftwareTile(frame, tileIndex, $(tileMinX), $(tileMinY), $(tileMaxX), $(tileMaxY));
+
+    for (s32 binIndex { frame->binOffsets[tileIndex] }; binIndex < frame->binOffsets[tileIndex + 1]; ++binIndex)
+        _RasterizeTriangle(&frame->triangles[frame->binTriangles[binIndex]], frame->target, tileMinX, tileMinY, tileMaxX, tileMaxY);
+};
+
+local_func PLATFORM_WORK_QUEUE_CALLBACK(_RenderSoftwareTilesWork)
+{
+    Software_Tile_Job* job = (Software_Tile_Job*)data;
+
+    s32 tileCount = job->frame->tileCountX * job->frame->tileCountY;
+    for (s32 tileIndex { job->firstTile }; tileIndex < tileCount; tileIndex += job->tileStride)
+        _RenderSoftwareTile(job->frame, tileIndex);
+
+    _mm_sfence(); //Tile's pixels have to be visible before whoever's waiting sees done
+    job->done = true;
+};
+
+//Jobs are jobSize apart and each one starts with a Software_Tile_Job. Tiles are dealt out round robin so each job gets
+//a spread of the screen instead of one (possibly empty) strip
+local_func void _RunSoftwareTileJobs(platform_work_queue_callback* callback, void* jobs, sizet jobSize, s32 jobCount, const Software_Frame* frame,
+                                     Platform_Services* platformServices)
+{
+    for (s32 jobIndex {}; jobIndex < jobCount; ++jobIndex)
+    {
+        Software_Tile_Job* job = (Software_Tile_Job*)((u8*)jobs + jobIndex * jobSize);
+        job->frame = frame;
+        job->firstTile = jobIndex;
+        job->tileStride = jobCount;
+        job->done = false;
+    };
+
+    if (platformServices->AddWorkQueueEntry)
+    {
+        for (s32 jobIndex {}; jobIndex < jobCount; ++jobIndex)
+            platformServices->AddWorkQueueEntry(callback, (u8*)jobs + jobIndex * jobSize);
+
+        //Help out instead of just waiting. Doesn't use FinishAllWork since the game can have its own work queued
+        for (s32 jobIndex {}; jobIndex < jobCount; ++jobIndex)
         {
-            v2 testVec = vecs[vecIndex];
-            i32 flooredX = FloorF32ToI32(testVec.x);
-            i32 ceiledX = CeilF32ToI32(testVec.x);
-            i32 flooredY = FloorF32ToI32(testVec.y);
-            i32 ceiledY = CeilF32ToI32(testVec.y);
-            
-            if (xMin > flooredX)
+            Software_Tile_Job* job = (Software_Tile_Job*)((u8*)jobs + jobIndex * jobSize);
+            while (NOT job->done)
             {
-                xMin = (f32)flooredX;
-            }
-            if (yMin > flooredY)
+                if (NOT platformServices->DoNextWorkQueueEntry())
+                    platformServices->Sleep(0);
+            };
+        };
+    }
+    else
+    {
+        for (s32 jobIndex {}; jobIndex < jobCount; ++jobIndex)
+            callback((u8*)jobs + jobIndex * jobSize);
+    };
+};
+
+local_func Software_Frame _SoftwareFrame(Software_Render_Target target, const Rendering_Info* renderingInfo)
+{
+    Software_Frame frame {};
+    frame.target = target;
+    frame.clearPixel = _PackPixel(renderingInfo->clearColor.r * 255.0f, renderingInfo->clearColor.g * 255.0f, renderingInfo->clearColor.b * 255.0f, 0.0f);
+    frame.tileCountX = (target.width + SOFTWARE_RENDER_TILE_SIZE - 1) / SOFTWARE_RENDER_TILE_SIZE;
+    frame.tileCountY = (target.height + SOFTWARE_RENDER_TILE_SIZE - 1) / SOFTWARE_RENDER_TILE_SIZE;
+
+    return frame;
+};
+
+local_func Mat4x4 _SoftwareViewProjectionMatrix(const Rendering_Info* renderingInfo)
+{
+    Camera3D camera3d = renderingInfo->camera3d;
+
+    Mat4x4 xRotMatrix = XRotation(camera3d.rotation.x);
+    Mat4x4 yRotMatrix = YRotation(camera3d.rotation.y);
+    Mat4x4 zRotMatrix = ZRotation(camera3d.rotation.z);
+    Mat4x4 fullRotMatrix = xRotMatrix * yRotMatrix * zRotMatrix;
+    v3 xAxis = GetColumn(fullRotMatrix, 0);
+    v3 yAxis = GetColumn(fullRotMatrix, 1);
+    v3 zAxis = GetColumn(fullRotMatrix, 2);
+
+    Mat4x4 camTransformMatrix = ProduceCameraTransformMatrix(xAxis, yAxis, zAxis, camera3d.worldPos);
+    Mat4x4 projectionMatrix = ProduceProjectionTransformMatrix_UsingFOV(renderingInfo->fov, renderingInfo->aspectRatio, renderingInfo->nearPlane, renderingInfo->farPlane);
+
+    return projectionMatrix * camTransformMatrix;
+};
+
+//Copies vertex data and textures the game sent into globalSoftwareResources. Does nothing for draw entries
+local_func void _LoadSoftwareResource(u8* entry, Platform_Services* platformServices)
+{
+    RenderEntry_Header* entryHeader = (RenderEntry_Header*)entry;
+    switch (entryHeader->type)
+    {
+        case EntryType_InitVertexData:
+        {
+            RenderEntry_InitVertexData vertexData = *(RenderEntry_InitVertexData*)entry;
+            BGZ_ASSERT(vertexData.vertexAttributes.pos.exists && vertexData.stride > 0);
+
+            globalSoftwareResources.vertexData = (Software_Vertex_Data*)_GrowResourceTable(globalSoftwareResources.vertexData, $(globalSoftwareResources.vertexDataCapacity),
+                                                                                           vertexData.vertObjectID, sizeof(Software_Vertex_Data), platformServices);
+            Software_Vertex_Data* softwareVertexData = &globalSoftwareResources.vertexData[vertexData.vertObjectID];
+
+            //Attributes sit at the same offsets the hardware renderer points gl at
+            softwareVertexData->vertCount = (s32)(vertexData.interleavedVertAttribData.Size() / vertexData.stride);
+            softwareVertexData->indexCount = (s32)vertexData.indicies.Size();
+            softwareVertexData->positions = (v3*)platformServices->Realloc(softwareVertexData->positions, sizeof(v3) * softwareVertexData->vertCount);
+            softwareVertexData->indices = (s16*)platformServices->Realloc(softwareVertexData->indices, sizeof(s16) * softwareVertexData->indexCount);
+
+            if (vertexData.vertexAttributes.texCoord.exists)
             {
-                yMin = (f32)flooredY;
+                softwareVertexData->uvs = (v2*)platformServices->Realloc(softwareVertexData->uvs, sizeof(v2) * softwareVertexData->vertCount);
             }
-            if (xMax < ceiledX)
+            else if (softwareVertexData->uvs)
             {
-                xMax = (f32)ceiledX;
-            }
-            if (yMax < ceiledY)
+                platformServices->Free(softwareVertexData->uvs);
+                softwareVertexData->uvs = nullptr;
+            };
+
+            for (s32 vertIndex {}; vertIndex < softwareVertexData->vertCount; ++vertIndex)
             {
-                yMax = (f32)ceiledY;
-            }
-        }
-        
-        if (xMin < Min(clipRect).x)
-        {
-            xMin = Min(clipRect).x;
-        }
-        if (yMin < Min(clipRect).y)
+                f32* vertAttribs = vertexData.interleavedVertAttribData.elements + vertIndex * vertexData.stride;
+                softwareVertexData->positions[vertIndex] = v3 { vertAttribs[0], vertAttribs[1], vertexData.vertexAttributes.pos.numFloats > 2 ? vertAttribs[2] : 0.0f };
+                if (softwareVertexData->uvs)
+                    softwareVertexData->uvs[vertIndex] = v2 { vertAttribs[6], vertAttribs[7] };
+            };
+
+            memcpy(softwareVertexData->indices, vertexData.indicies.elements, sizeof(s16) * softwareVertexData->indexCount);
+        }break;
+
+        case EntryType_LoadTexture:
         {
-            yMin = Min(clipRect).y;
-        }
-        if (xMax > widthMax)
+            RenderEntry_LoadTexture loadTexEntry = *(RenderEntry_LoadTexture*)entry;
+            BGZ_ASSERT(loadTexEntry.mipCount <= SOFTWARE_TEXTURE_MAX_MIPS);
+
+            globalSoftwareResources.textures = (Software_Texture*)_GrowResourceTable(globalSoftwareResources.textures, $(globalSoftwareResources.textureCapacity),
+                                                                                     (s32)loadTexEntry.id, sizeof(Software_Texture), platformServices);
+            Software_Texture* texture = &globalSoftwareResources.textures[loadTexEntry.id];
+
+            if (loadTexEntry.mipCount > 1)
+            {
+                for (s32 mipLevel {}; mipLevel < loadTexEntry.mipCount; ++mipLevel)
+                    _StoreTextureLevel(&texture->levels[mipLevel], loadTexEntry.mips[mipLevel], platformServices);
+
+                texture->levelCount = loadTexEntry.mipCount;
+                texture->bilinear = true;
+            }
+            else
+            {
+                _StoreTextureLevel(&texture->levels[0], loadTexEntry.texture, platformServices);
+                texture->levelCount = 1;
+                texture->bilinear = false;
+            };
+        }break;
+
+        case EntryType_UpdateTexture:
         {
-            xMax = widthMax;
-        }
-        if (yMax > heightMax)
+            RenderEntry_UpdateTexture updateTexEntry = *(RenderEntry_UpdateTexture*)entry;
+
+            Software_Texture* texture = _SoftwareTexture(updateTexEntry.id);
+            BGZ_ASSERT(texture);//, "Updating a texture that was never loaded!");
+
+            //Only the base level gets replaced, same as the hardware renderer
+            _StoreTextureLevel(&texture->levels[0], updateTexEntry.texture, platformServices);
+            texture->levelCount = 1;
+        }break;
+
+        default:
         {
-            yMax = heightMax;
-        }
+        }break;
     };
-    
-    f32 invertedXAxisSqd = 1.0f / MagnitudeSqd(targetRectXAxis);
-    f32 invertedYAxisSqd = 1.0f / MagnitudeSqd(targetRectYAxis);
-    
-    ui8* currentRow = (ui8*)colorBufferData + (i32)xMin * 4 + (i32)yMin * colorBufferPitch;
-    for (f32 screenY = yMin; screenY < yMax; ++screenY)
+};
+
+//Most triangles an entry can turn into. Clipping against the near plane can split a triangle in 2
+local_func s32 _MaxSoftwareTriangleCount(u8* entry, const Rendering_Info* renderingInfo)
+{
+    RenderEntry_Header* entryHeader = (RenderEntry_Header*)entry;
+    switch (entryHeader->type)
     {
-        ui32* destPixel = (ui32*)currentRow;
-        
-        for (f32 screenX = xMin; screenX < xMax; ++screenX)
-        {
-            v2 screenPixelCoord { screenX, screenY };
-            v2 d { screenPixelCoord - origin };
-            
-            f32 u = invertedXAxisSqd * DotProduct(d, targetRectXAxis);
-            f32 v = invertedYAxisSqd * DotProduct(d, targetRectYAxis);
-            
-            //Used to decide, given what screen pixel were on, whether or not that screen pixel falls
-            //within the target rect's bounds or not
-            if (u >= 0.0f && u <= 1.0f && v >= 0.0f && v <= 1.0f)
-            {
-                *destPixel = pixelColor;
-            }
-            
-            ++destPixel;
-        }
-        
-        currentRow += colorBufferPitch;
-    }
+        case EntryType_DrawText:
+            return ((RenderEntry_DrawText*)entry)->glyphCount * 2;
+
+        case EntryType_DrawRect:
+        case EntryType_DrawRectOverlay:
+            return (_SoftwareVertexData(renderingInfo->rectVertObjID)->indexCount / 3) * 2;
+
+        case EntryType_DrawCube:
+            return (_SoftwareVertexData(renderingInfo->cubeVertObjID)->indexCount / 3) * 2;
+
+        case EntryType_DrawMesh:
+            return (((RenderEntry_DrawMesh*)entry)->renderIndexLength / 3) * 2;
+
+        case EntryType_InitVertexData:
+        case EntryType_LoadTexture:
+        case EntryType_UpdateTexture:
+        case EntryType_Line:
+            return 0;
+
+        InvalidDefaultCase;
+    };
+
+    return 0;
 };
 
-#include <immintrin.h>
-void DrawTexture_Optimized(ui32* colorBufferData, v2i colorBufferSize, i32 colorBufferPitch, Quad targetRect_screenCoords, RenderEntry_Texture image, Rect clipRect)
-{
-    v2 origin = targetRect_screenCoords.bottomLeft.xy;
-    v2 targetRectXAxis = targetRect_screenCoords.bottomRight.xy - targetRect_screenCoords.bottomLeft.xy;
-    v2 targetRectYAxis = targetRect_screenCoords.topLeft.xy - targetRect_screenCoords.bottomLeft.xy;
-    
-    i32 widthMax = (i32)Max(clipRect).x;
-    i32 heightMax = (i32)Max(clipRect).y;
-    
-    i32 xMin = widthMax;
-    i32 xMax = (i32)Min(clipRect).x;
-    i32 yMin = heightMax;
-    i32 yMax = (i32)Min(clipRect).y;
-    
-    { //Optimization to avoid iterating over every pixel on the screen - HH ep 92
-        Array<v2, 4> vecs = { origin, origin + targetRectXAxis, origin + targetRectXAxis + targetRectYAxis, origin + targetRectYAxis };
-        for (i32 vecIndex = 0; vecIndex < vecs.Size(); ++vecIndex)
+//Appends a draw entry's screen space triangles to the list. Resources have to be loaded already
+local_func void _SetupEntryTriangles(Software_Triangle_List* list, u8* entry, const Rendering_Info* renderingInfo, Mat4x4 viewProjectionMatrix, GPU_Frame_Stats* frameStats)
+{
+    //Same as the hardware renderer's, takes 0 to 1 screen space to clip space
+    Mat4x4 transformToNeg1To1Space =
+    {
         {
-            v2 testVec = vecs[vecIndex];
-            i32 flooredX = FloorF32ToI32(testVec.x);
-            i32 ceiledX = CeilF32ToI32(testVec.x);
-            i32 flooredY = FloorF32ToI32(testVec.y);
-            i32 ceiledY = CeilF32ToI32(testVec.y);
-            
-            if (xMin > flooredX)
-                xMin = flooredX;
-            if (yMin > flooredY)
-                yMin = flooredY;
-            if (xMax < ceiledX)
-                xMax = ceiledX;
-            if (yMax < ceiledY)
-                yMax = ceiledY;
-        }
-        
-        if (xMin < (i32)Min(clipRect).x)
-            xMin = (i32)Min(clipRect).x;
-        if (yMin < Min(clipRect).y)
-            yMin = (i32)Min(clipRect).y;
-        if (xMax > widthMax)
-            xMax = widthMax;
-        if (yMax > heightMax)
-            yMax = heightMax;
-    };
-    
-    i32 simdWidth_inBytes = 8;
-    
-    //Align to 8-byte boundry
-    if ((xMin % simdWidth_inBytes) != 0)
-        xMin = (i32)RoundDown((sizet)xMin, simdWidth_inBytes);
-    
-    //Pre calcuations for optimization
-    f32 invertedXAxisSqd = 1.0f / MagnitudeSqd(targetRectXAxis);
-    f32 invertedYAxisSqd = 1.0f / MagnitudeSqd(targetRectYAxis);
-    i32 imageWidth = image.size.width - 3;
-    i32 imageHeight = image.size.height - 3;
-    v2 normalizedXAxis = invertedXAxisSqd * targetRectXAxis;
-    v2 normalizedYAxis = invertedYAxisSqd * targetRectYAxis;
-    
-    i32 sizeOfPixel_inBytes = 4;
-    ui8* currentRow = (ui8*)colorBufferData + (i32)xMin * sizeOfPixel_inBytes + (i32)yMin * colorBufferPitch;
-    for (i32 screenY = yMin; screenY < yMax; ++screenY)
-    {
-        ui32* destPixel = (ui32*)currentRow;
-        for (i32 screenX = xMin; screenX < xMax; screenX += simdWidth_inBytes)
+            {2, 0, 0, -1},
+            {0, 2, 0, -1},
+            {0, 0, 1, 0},
+            {0, 0, 0, 1}
+        },
+    };
+
+    RenderEntry_Header* entryHeader = (RenderEntry_Header*)entry;
+    switch (entryHeader->type)
+    {
+        case EntryType_DrawText:
         {
-            //Initial setup variables for SIMD code
-            __m256 one = _mm256_set1_ps(1.0f);
-            __m256 zero = _mm256_set1_ps(0.0f);
-            __m256 imgWidth = _mm256_set1_ps((f32)imageWidth);
-            __m256 imgHeight = _mm256_set1_ps((f32)imageHeight);
-            __m256 normalizedXAxis_x = _mm256_set1_ps(normalizedXAxis.x);
-            __m256 normalizedXAxis_y = _mm256_set1_ps(normalizedXAxis.y);
-            __m256 normalizedYAxis_x = _mm256_set1_ps(normalizedYAxis.x);
-            __m256 normalizedYAxis_y = _mm256_set1_ps(normalizedYAxis.y);
-            __m256 targetRectOrigin_x = _mm256_set1_ps(origin.x);
-            __m256 targetRectOrigin_y = _mm256_set1_ps(origin.y);
-            
-            __m256 screenPixelCoords_x = _mm256_set_ps((f32)(screenX + 7), (f32)(screenX + 6), (f32)(screenX + 5), (f32)(screenX + 4), (f32)(screenX + 3), (f32)(screenX + 2), (f32)(screenX + 1), (f32)(screenX + 0));
-            __m256 screenPixelCoords_y = _mm256_set1_ps((f32)screenY);
-            
-            __m256 uvRangeForTexture_u = _mm256_set1_ps(image.uvBounds[1].u - image.uvBounds[0].u);
-            __m256 uvRangeForTexture_v = _mm256_set1_ps(image.uvBounds[1].v - image.uvBounds[0].v);
-            
-            __m256 minUVBounds_u = _mm256_set1_ps(image.uvBounds[0].u);
-            __m256 minUVBounds_v = _mm256_set1_ps(image.uvBounds[0].v);
-            
-            //Gather normalized coordinates (uv's) in order to find the correct texel position below
-            __m256 dXs = _mm256_sub_ps(screenPixelCoords_x, targetRectOrigin_x);
-            __m256 dYs = _mm256_sub_ps(screenPixelCoords_y, targetRectOrigin_y);
-            __m256 Us = _mm256_add_ps(_mm256_mul_ps(dXs, normalizedXAxis_x), _mm256_mul_ps(dYs, normalizedXAxis_y));
-            __m256 Vs = _mm256_add_ps(_mm256_mul_ps(dXs, normalizedYAxis_x), _mm256_mul_ps(dYs, normalizedYAxis_y));
-            
-            /* clang-format off */
-            //Using a mask to determine what colors final 8 wide pixel destintion buffer should except
-            //(background texels or image texels). This replaces the need for a conditional
-            __m256i writeMask = _mm256_castps_si256(_mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(Us, zero, _CMP_GE_OQ),
-                                                                                _mm256_cmp_ps(Us, one, _CMP_LE_OQ)),
-                                                                  _mm256_and_ps(_mm256_cmp_ps(Vs, zero, _CMP_GE_OQ),
-                                                                                _mm256_cmp_ps(Vs, one, _CMP_LE_OQ))));
-            /* clang-format on */
-            
-            __m256i clipMask = _mm256_set1_epi32(0xFFFFFFFF);
-            
-            //See how much final 8 pixel wide dest buffer will expand past the max boundry of screen region (if at all)
-            //and adjust it
-            if (screenX > ((i32)widthMax - simdWidth_inBytes))
-            {
-                i32 diff = (i32)widthMax - (i32)screenX;
-                i32 amountOfScreenOverflow = simdWidth_inBytes - diff;
-                
-                i32 index { 7 };
-                while (amountOfScreenOverflow)
-                {
-                    clipMask.m256i_u32[index] = 0;
-                    index -= 1;
-                    --amountOfScreenOverflow;
-                };
-            };
-            
-            //Clamp UVs to prevent accessing memory that is invalid
-            Us = _mm256_min_ps(_mm256_max_ps(Us, zero), one);
-            Vs = _mm256_min_ps(_mm256_max_ps(Vs, zero), one);
-            
-            __m256 textureUs = _mm256_add_ps(minUVBounds_u, _mm256_mul_ps(uvRangeForTexture_u, Us));
-            __m256 textureVs = _mm256_add_ps(minUVBounds_v, _mm256_mul_ps(uvRangeForTexture_v, Vs));
-            
-            __m256 texelCoords_x = _mm256_mul_ps(textureUs, imgWidth);
-            __m256 texelCoords_y = _mm256_mul_ps(textureVs, imgHeight);
-            
-            __m256i sampleTexelAs {}, sampleTexelBs {}, sampleTexelCs {}, sampleTexelDs {};
-            for (i32 index {}; index < 8; ++index)
+            RenderEntry_DrawText* textEntry = (RenderEntry_DrawText*)entry;
+            Text_Glyph_Quad* glyphs = (Text_Glyph_Quad*)(textEntry + 1);
+            const Software_Texture* fontAtlas = _SoftwareTexture(renderingInfo->textTextureID);
+
+            //Text shader outputs the atlas texel as is
+            v4 white { 1.0f, 1.0f, 1.0f, 1.0f };
+            for (s32 glyphIndex {}; glyphIndex < textEntry->glyphCount; ++glyphIndex)
             {
-                BGZ_ASSERT((texelCoords_x.m256_f32[index] >= 0) && (texelCoords_x.m256_f32[index] <= (i32)image.size.width));//, "x coord is out of range!: ");
-                BGZ_ASSERT((texelCoords_y.m256_f32[index] >= 0) && (texelCoords_y.m256_f32[index] <= (i32)image.size.height));//, "y coord is out of range!");
-                
-                //Gather 4 texels (in a square pattern) from certain texel Ptr
-                ui8* texelPtr = ((ui8*)image.colorData) + ((ui32)texelCoords_y.m256_f32[index] * image.pitch_pxls) + ((ui32)texelCoords_x.m256_f32[index] * sizeof(ui32)); //size of pixel
-                sampleTexelAs.m256i_u32[index] = *(ui32*)(texelPtr);
-                sampleTexelBs.m256i_u32[index] = *(ui32*)(texelPtr + sizeof(ui32));
-                sampleTexelCs.m256i_u32[index] = *(ui32*)(texelPtr + image.pitch_pxls);
-                sampleTexelDs.m256i_u32[index] = *(ui32*)(texelPtr + image.pitch_pxls + sizeof(ui32));
-            };
-            
-#if __AVX2__
-            //Unpack 4 sample texels to prepare for bilinear blend
-            __m256i maskFF = _mm256_set1_epi32(0xFF);
-            __m256 texelA_b = _mm256_cvtepi32_ps(_mm256_and_si256(sampleTexelAs, maskFF));
-            __m256 texelA_g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelAs, 8), maskFF));
-            __m256 texelA_r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelAs, 16), maskFF));
-            __m256 texelA_a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelAs, 24), maskFF));
-            __m256 texelB_b = _mm256_cvtepi32_ps(_mm256_and_si256(sampleTexelBs, maskFF));
-            __m256 texelB_g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelBs, 8), maskFF));
-            __m256 texelB_r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelBs, 16), maskFF));
-            __m256 texelB_a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelBs, 24), maskFF));
-            __m256 texelC_b = _mm256_cvtepi32_ps(_mm256_and_si256(sampleTexelCs, maskFF));
-            __m256 texelC_g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelCs, 8), maskFF));
-            __m256 texelC_r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelCs, 16), maskFF));
-            __m256 texelC_a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelCs, 24), maskFF));
-            __m256 texelD_b = _mm256_cvtepi32_ps(_mm256_and_si256(sampleTexelDs, maskFF));
-            __m256 texelD_g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelDs, 8), maskFF));
-            __m256 texelD_r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelDs, 16), maskFF));
-            __m256 texelD_a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(sampleTexelDs, 24), maskFF));
-            __m256i backGroundPixels = _mm256_load_si256((__m256i*)destPixel);
-            __m256 backgroundColors_b = _mm256_cvtepi32_ps(_mm256_and_si256(backGroundPixels, maskFF));
-            __m256 backgroundColors_g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(backGroundPixels, 8), maskFF));
-            __m256 backgroundColors_r = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(backGroundPixels, 16), maskFF));
-            __m256 backgroundColors_a = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(backGroundPixels, 24), maskFF));
-            
-#elif __AVX__
-            //Unpack 4 sample texels to prepare for bilinear blend
-            __m256i* ptrToSampleTexelAs = &sampleTexelAs;
-            __m256 texelA_b = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelAs + 28), (f32) * ((ui8*)ptrToSampleTexelAs + 24), (f32) * ((ui8*)ptrToSampleTexelAs + 20), (f32) * ((ui8*)ptrToSampleTexelAs + 16), (f32) * ((ui8*)ptrToSampleTexelAs + 12), (f32) * ((ui8*)ptrToSampleTexelAs + 8), (f32) * ((ui8*)ptrToSampleTexelAs + 4), (f32) * ((ui8*)ptrToSampleTexelAs + 0));
-            __m256 texelA_g = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelAs + 29), (f32) * ((ui8*)ptrToSampleTexelAs + 25), (f32) * ((ui8*)ptrToSampleTexelAs + 21), (f32) * ((ui8*)ptrToSampleTexelAs + 17), (f32) * ((ui8*)ptrToSampleTexelAs + 13), (f32) * ((ui8*)ptrToSampleTexelAs + 9), (f32) * ((ui8*)ptrToSampleTexelAs + 5), (f32) * ((ui8*)ptrToSampleTexelAs + 1));
-            __m256 texelA_r = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelAs + 30), (f32) * ((ui8*)ptrToSampleTexelAs + 26), (f32) * ((ui8*)ptrToSampleTexelAs + 22), (f32) * ((ui8*)ptrToSampleTexelAs + 18), (f32) * ((ui8*)ptrToSampleTexelAs + 14), (f32) * ((ui8*)ptrToSampleTexelAs + 10), (f32) * ((ui8*)ptrToSampleTexelAs + 6), (f32) * ((ui8*)ptrToSampleTexelAs + 2));
-            __m256 texelA_a = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelAs + 31), (f32) * ((ui8*)ptrToSampleTexelAs + 27), (f32) * ((ui8*)ptrToSampleTexelAs + 23), (f32) * ((ui8*)ptrToSampleTexelAs + 19), (f32) * ((ui8*)ptrToSampleTexelAs + 15), (f32) * ((ui8*)ptrToSampleTexelAs + 11), (f32) * ((ui8*)ptrToSampleTexelAs + 7), (f32) * ((ui8*)ptrToSampleTexelAs + 3));
-            
-            __m256i* ptrToSampleTexelBs = &sampleTexelBs;
-            __m256 texelB_b = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelBs + 28), (f32) * ((ui8*)ptrToSampleTexelBs + 24), (f32) * ((ui8*)ptrToSampleTexelBs + 20), (f32) * ((ui8*)ptrToSampleTexelBs + 16), (f32) * ((ui8*)ptrToSampleTexelBs + 12), (f32) * ((ui8*)ptrToSampleTexelBs + 8), (f32) * ((ui8*)ptrToSampleTexelBs + 4), (f32) * ((ui8*)ptrToSampleTexelBs + 0));
-            __m256 texelB_g = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelBs + 29), (f32) * ((ui8*)ptrToSampleTexelBs + 25), (f32) * ((ui8*)ptrToSampleTexelBs + 21), (f32) * ((ui8*)ptrToSampleTexelBs + 17), (f32) * ((ui8*)ptrToSampleTexelBs + 13), (f32) * ((ui8*)ptrToSampleTexelBs + 9), (f32) * ((ui8*)ptrToSampleTexelBs + 5), (f32) * ((ui8*)ptrToSampleTexelBs + 1));
-            __m256 texelB_r = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelBs + 30), (f32) * ((ui8*)ptrToSampleTexelBs + 26), (f32) * ((ui8*)ptrToSampleTexelBs + 22), (f32) * ((ui8*)ptrToSampleTexelBs + 18), (f32) * ((ui8*)ptrToSampleTexelBs + 14), (f32) * ((ui8*)ptrToSampleTexelBs + 10), (f32) * ((ui8*)ptrToSampleTexelBs + 6), (f32) * ((ui8*)ptrToSampleTexelBs + 2));
-            __m256 texelB_a = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelBs + 31), (f32) * ((ui8*)ptrToSampleTexelBs + 27), (f32) * ((ui8*)ptrToSampleTexelBs + 23), (f32) * ((ui8*)ptrToSampleTexelBs + 19), (f32) * ((ui8*)ptrToSampleTexelBs + 15), (f32) * ((ui8*)ptrToSampleTexelBs + 11), (f32) * ((ui8*)ptrToSampleTexelBs + 7), (f32) * ((ui8*)ptrToSampleTexelBs + 3));
-            
-            __m256i* ptrToSampleTexelCs = &sampleTexelCs;
-            __m256 texelC_b = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelCs + 28), (f32) * ((ui8*)ptrToSampleTexelCs + 24), (f32) * ((ui8*)ptrToSampleTexelCs + 20), (f32) * ((ui8*)ptrToSampleTexelCs + 16), (f32) * ((ui8*)ptrToSampleTexelCs + 12), (f32) * ((ui8*)ptrToSampleTexelCs + 8), (f32) * ((ui8*)ptrToSampleTexelCs + 4), (f32) * ((ui8*)ptrToSampleTexelCs + 0));
-            __m256 texelC_g = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelCs + 29), (f32) * ((ui8*)ptrToSampleTexelCs + 25), (f32) * ((ui8*)ptrToSampleTexelCs + 21), (f32) * ((ui8*)ptrToSampleTexelCs + 17), (f32) * ((ui8*)ptrToSampleTexelCs + 13), (f32) * ((ui8*)ptrToSampleTexelCs + 9), (f32) * ((ui8*)ptrToSampleTexelCs + 5), (f32) * ((ui8*)ptrToSampleTexelCs + 1));
-            __m256 texelC_r = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelCs + 30), (f32) * ((ui8*)ptrToSampleTexelCs + 26), (f32) * ((ui8*)ptrToSampleTexelCs + 22), (f32) * ((ui8*)ptrToSampleTexelCs + 18), (f32) * ((ui8*)ptrToSampleTexelCs + 14), (f32) * ((ui8*)ptrToSampleTexelCs + 10), (f32) * ((ui8*)ptrToSampleTexelCs + 6), (f32) * ((ui8*)ptrToSampleTexelCs + 2));
-            __m256 texelC_a = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelCs + 31), (f32) * ((ui8*)ptrToSampleTexelCs + 27), (f32) * ((ui8*)ptrToSampleTexelCs + 23), (f32) * ((ui8*)ptrToSampleTexelCs + 19), (f32) * ((ui8*)ptrToSampleTexelCs + 15), (f32) * ((ui8*)ptrToSampleTexelCs + 11), (f32) * ((ui8*)ptrToSampleTexelCs + 7), (f32) * ((ui8*)ptrToSampleTexelCs + 3));
-            
-            __m256i* ptrToSampleTexelDs = &sampleTexelDs;
-            __m256 texelD_b = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelDs + 28), (f32) * ((ui8*)ptrToSampleTexelDs + 24), (f32) * ((ui8*)ptrToSampleTexelDs + 20), (f32) * ((ui8*)ptrToSampleTexelDs + 16), (f32) * ((ui8*)ptrToSampleTexelDs + 12), (f32) * ((ui8*)ptrToSampleTexelDs + 8), (f32) * ((ui8*)ptrToSampleTexelDs + 4), (f32) * ((ui8*)ptrToSampleTexelDs + 0));
-            __m256 texelD_g = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelDs + 29), (f32) * ((ui8*)ptrToSampleTexelDs + 25), (f32) * ((ui8*)ptrToSampleTexelDs + 21), (f32) * ((ui8*)ptrToSampleTexelDs + 17), (f32) * ((ui8*)ptrToSampleTexelDs + 13), (f32) * ((ui8*)ptrToSampleTexelDs + 9), (f32) * ((ui8*)ptrToSampleTexelDs + 5), (f32) * ((ui8*)ptrToSampleTexelDs + 1));
-            __m256 texelD_r = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelDs + 30), (f32) * ((ui8*)ptrToSampleTexelDs + 26), (f32) * ((ui8*)ptrToSampleTexelDs + 22), (f32) * ((ui8*)ptrToSampleTexelDs + 18), (f32) * ((ui8*)ptrToSampleTexelDs + 14), (f32) * ((ui8*)ptrToSampleTexelDs + 10), (f32) * ((ui8*)ptrToSampleTexelDs + 6), (f32) * ((ui8*)ptrToSampleTexelDs + 2));
-            __m256 texelD_a = _mm256_set_ps((f32) * ((ui8*)ptrToSampleTexelDs + 31), (f32) * ((ui8*)ptrToSampleTexelDs + 27), (f32) * ((ui8*)ptrToSampleTexelDs + 23), (f32) * ((ui8*)ptrToSampleTexelDs + 19), (f32) * ((ui8*)ptrToSampleTexelDs + 15), (f32) * ((ui8*)ptrToSampleTexelDs + 11), (f32) * ((ui8*)ptrToSampleTexelDs + 7), (f32) * ((ui8*)ptrToSampleTexelDs + 3));
-            
-            __m256i backGroundPixels = _mm256_load_si256((__m256i*)destPixel);
-            __m256i* ptrToBackgroundPixels = &backGroundPixels;
-            __m256 backgroundColors_b = _mm256_set_ps((f32) * ((ui8*)ptrToBackgroundPixels + 28), (f32) * ((ui8*)ptrToBackgroundPixels + 24), (f32) * ((ui8*)ptrToBackgroundPixels + 20), (f32) * ((ui8*)ptrToBackgroundPixels + 16), (f32) * ((ui8*)ptrToBackgroundPixels + 12), (f32) * ((ui8*)ptrToBackgroundPixels + 8), (f32) * ((ui8*)ptrToBackgroundPixels + 4), (f32) * ((ui8*)ptrToBackgroundPixels + 0));
-            __m256 backgroundColors_g = _mm256_set_ps((f32) * ((ui8*)ptrToBackgroundPixels + 29), (f32) * ((ui8*)ptrToBackgroundPixels + 25), (f32) * ((ui8*)ptrToBackgroundPixels + 21), (f32) * ((ui8*)ptrToBackgroundPixels + 17), (f32) * ((ui8*)ptrToBackgroundPixels + 13), (f32) * ((ui8*)ptrToBackgroundPixels + 9), (f32) * ((ui8*)ptrToBackgroundPixels + 5), (f32) * ((ui8*)ptrToBackgroundPixels + 1));
-            __m256 backgroundColors_r = _mm256_set_ps((f32) * ((ui8*)ptrToBackgroundPixels + 30), (f32) * ((ui8*)ptrToBackgroundPixels + 26), (f32) * ((ui8*)ptrToBackgroundPixels + 22), (f32) * ((ui8*)ptrToBackgroundPixels + 18), (f32) * ((ui8*)ptrToBackgroundPixels + 14), (f32) * ((ui8*)ptrToBackgroundPixels + 10), (f32) * ((ui8*)ptrToBackgroundPixels + 6), (f32) * ((ui8*)ptrToBackgroundPixels + 2));
-            __m256 backgroundColors_a = _mm256_set_ps((f32) * ((ui8*)ptrToBackgroundPixels + 31), (f32) * ((ui8*)ptrToBackgroundPixels + 27), (f32) * ((ui8*)ptrToBackgroundPixels + 23), (f32) * ((ui8*)ptrToBackgroundPixels + 19), (f32) * ((ui8*)ptrToBackgroundPixels + 15), (f32) * ((ui8*)ptrToBackgroundPixels + 11), (f32) * ((ui8*)ptrToBackgroundPixels + 7), (f32) * ((ui8*)ptrToBackgroundPixels + 3));
-#endif
-            
-            //Bilinear blend
-            __m256 percentToLerpInX = _mm256_sub_ps(texelCoords_x, _mm256_floor_ps(texelCoords_x));
-            __m256 percentToLerpInY = _mm256_sub_ps(texelCoords_y, _mm256_floor_ps(texelCoords_y));
-            __m256 oneMinusXLerp = _mm256_sub_ps(one, percentToLerpInX);
-            __m256 oneMinusYLerp = _mm256_sub_ps(one, percentToLerpInY);
-            __m256 coefficient1 = _mm256_mul_ps(oneMinusYLerp, oneMinusXLerp);
-            __m256 coefficient2 = _mm256_mul_ps(oneMinusYLerp, percentToLerpInX);
-            __m256 coefficient3 = _mm256_mul_ps(percentToLerpInY, oneMinusXLerp);
-            __m256 coefficient4 = _mm256_mul_ps(percentToLerpInY, percentToLerpInX);
-            __m256 newBlendedTexel_r = _mm256_add_ps(
-                                                     _mm256_add_ps(_mm256_mul_ps(coefficient1, texelA_r), _mm256_mul_ps(coefficient2, texelB_r)),
-                                                     _mm256_add_ps(_mm256_mul_ps(coefficient3, texelC_r), _mm256_mul_ps(coefficient4, texelD_r)));
-            __m256 newBlendedTexel_g = _mm256_add_ps(
-                                                     _mm256_add_ps(_mm256_mul_ps(coefficient1, texelA_g), _mm256_mul_ps(coefficient2, texelB_g)),
-                                                     _mm256_add_ps(_mm256_mul_ps(coefficient3, texelC_g), _mm256_mul_ps(coefficient4, texelD_g)));
-            __m256 newBlendedTexel_b = _mm256_add_ps(
-                                                     _mm256_add_ps(_mm256_mul_ps(coefficient1, texelA_b), _mm256_mul_ps(coefficient2, texelB_b)),
-                                                     _mm256_add_ps(_mm256_mul_ps(coefficient3, texelC_b), _mm256_mul_ps(coefficient4, texelD_b)));
-            __m256 newBlendedTexel_a = _mm256_add_ps(
-                                                     _mm256_add_ps(_mm256_mul_ps(coefficient1, texelA_a), _mm256_mul_ps(coefficient2, texelB_a)),
-                                                     _mm256_add_ps(_mm256_mul_ps(coefficient3, texelC_a), _mm256_mul_ps(coefficient4, texelD_a)));
-            
-            //Linear blend (w/ pre multiplied alpha)
-            __m256 maxColorValue = _mm256_set1_ps(255.0f);
-            __m256 alphaBlend = _mm256_div_ps(newBlendedTexel_a, maxColorValue);
-            __m256 oneMinusAlphaBlend = _mm256_sub_ps(one, alphaBlend);
-            __m256 finalBlendedColor_r = _mm256_add_ps(_mm256_mul_ps(oneMinusAlphaBlend, backgroundColors_r), newBlendedTexel_r);
-            __m256 finalBlendedColor_g = _mm256_add_ps(_mm256_mul_ps(oneMinusAlphaBlend, backgroundColors_g), newBlendedTexel_g);
-            __m256 finalBlendedColor_b = _mm256_add_ps(_mm256_mul_ps(oneMinusAlphaBlend, backgroundColors_b), newBlendedTexel_b);
-            __m256 finalBlendedColor_a = _mm256_add_ps(_mm256_mul_ps(oneMinusAlphaBlend, backgroundColors_a), newBlendedTexel_a);
-            
-#if __AVX2__
-            { //Convert and Pack into dest pixels to write out
-                __m256i finalBlendedColori_r = _mm256_cvtps_epi32(finalBlendedColor_r);
-                __m256i finalBlendedColori_g = _mm256_cvtps_epi32(finalBlendedColor_g);
-                __m256i finalBlendedColori_b = _mm256_cvtps_epi32(finalBlendedColor_b);
-                __m256i finalBlendedColori_a = _mm256_cvtps_epi32(finalBlendedColor_a);
-                
-                //Move pixels (through bitwise operations and shifting) from RRRR GGGG etc. format to expected BGRA format
-                __m256i out = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(finalBlendedColori_r, 16), _mm256_slli_epi32(finalBlendedColori_g, 8)), finalBlendedColori_b), _mm256_slli_epi32(finalBlendedColori_a, 24));
-                
-                //Use write mask in order to correctly fill 8 wide pixel lane (properly writing either the texel color or
-                //the background color)
-                __m256i maskedOut = _mm256_or_si256(_mm256_and_si256(writeMask, out),
-                                                    _mm256_andnot_si256(writeMask, backGroundPixels));
-                
-                maskedOut = _mm256_or_si256(_mm256_and_si256(clipMask, maskedOut),
-                                            _mm256_andnot_si256(clipMask, *(__m256i*)destPixel));
-                
-                *(__m256i*)destPixel = maskedOut;
-            };
-            
-#elif __AVX__
-            { //Convert and Pack into dest pixels to write out
-                __m256i finalBlendedColori_r = _mm256_cvtps_epi32(finalBlendedColor_r);
-                __m256i finalBlendedColori_g = _mm256_cvtps_epi32(finalBlendedColor_g);
-                __m256i finalBlendedColori_b = _mm256_cvtps_epi32(finalBlendedColor_b);
-                __m256i finalBlendedColori_a = _mm256_cvtps_epi32(finalBlendedColor_a);
-                
-                __m256i backgroundColorsi_r = _mm256_cvtps_epi32(backgroundColors_r);
-                __m256i backgroundColorsi_g = _mm256_cvtps_epi32(backgroundColors_g);
-                __m256i backgroundColorsi_b = _mm256_cvtps_epi32(backgroundColors_b);
-                __m256i backgroundColorsi_a = _mm256_cvtps_epi32(backgroundColors_a);
-                
-                //Since AVX doesn't have certain bitwise operations I need to extract 128 bit values from
-                //256 bit ones and then use the available bitwise operations on those
-                __m128i pixelSet1_r = _mm256_extractf128_si256(finalBlendedColori_r, 0);
-                __m128i pixelSet2_r = _mm256_extractf128_si256(finalBlendedColori_r, 1);
-                __m128i pixelSet1_g = _mm256_extractf128_si256(finalBlendedColori_g, 0);
-                __m128i pixelSet2_g = _mm256_extractf128_si256(finalBlendedColori_g, 1);
-                __m128i pixelSet1_b = _mm256_extractf128_si256(finalBlendedColori_b, 0);
-                __m128i pixelSet2_b = _mm256_extractf128_si256(finalBlendedColori_b, 1);
-                __m128i pixelSet1_a = _mm256_extractf128_si256(finalBlendedColori_a, 0);
-                __m128i pixelSet2_a = _mm256_extractf128_si256(finalBlendedColori_a, 1);
-                __m128i backgroundPixelSet1_r = _mm256_extractf128_si256(backgroundColorsi_r, 0);
-                __m128i backgroundPixelSet2_r = _mm256_extractf128_si256(backgroundColorsi_r, 1);
-                __m128i backgroundPixelSet1_g = _mm256_extractf128_si256(backgroundColorsi_g, 0);
-                __m128i backgroundPixelSet2_g = _mm256_extractf128_si256(backgroundColorsi_g, 1);
-                __m128i backgroundPixelSet1_b = _mm256_extractf128_si256(backgroundColorsi_b, 0);
-                __m128i backgroundPixelSet2_b = _mm256_extractf128_si256(backgroundColorsi_b, 1);
-                __m128i backgroundPixelSet1_a = _mm256_extractf128_si256(backgroundColorsi_a, 0);
-                __m128i backgroundPixelSet2_a = _mm256_extractf128_si256(backgroundColorsi_a, 1);
-                __m128i writeMaskSet1 = _mm256_extractf128_si256(writeMask, 0);
-                __m128i writeMaskSet2 = _mm256_extractf128_si256(writeMask, 1);
-                __m128i clipMaskSet1 = _mm256_extractf128_si256(clipMask, 0);
-                __m128i clipMaskSet2 = _mm256_extractf128_si256(clipMask, 1);
-                
-                //Move pixels (through bitwise operations and shifting) from RRRR GGGG ... format to expected BGRA format
-                __m128i pixels1Through4 = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_slli_epi32(pixelSet1_r, 16), _mm_slli_epi32(pixelSet1_g, 8)), pixelSet1_b), _mm_slli_epi32(pixelSet1_a, 24));
-                __m128i pixels5Through8 = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_slli_epi32(pixelSet2_r, 16), _mm_slli_epi32(pixelSet2_g, 8)), pixelSet2_b), _mm_slli_epi32(pixelSet2_a, 24));
-                __m128i backgroundPixels1Through4 = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_slli_epi32(backgroundPixelSet1_r, 16), _mm_slli_epi32(backgroundPixelSet1_g, 8)), backgroundPixelSet1_b), _mm_slli_epi32(backgroundPixelSet1_a, 24));
-                __m128i backgroundPixels5Through8 = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_slli_epi32(backgroundPixelSet2_r, 16), _mm_slli_epi32(backgroundPixelSet2_g, 8)), backgroundPixelSet2_b), _mm_slli_epi32(backgroundPixelSet2_a, 24));
-                
-                //Use write mask in order to correctly fill 8 wide pixel lane (properly writing either the texel color or
-                //the background color)
-                __m128i maskedOutSet1 = _mm_or_si128(_mm_and_si128(writeMaskSet1, pixels1Through4),
-                                                     _mm_andnot_si128(writeMaskSet1, backgroundPixels1Through4));
-                
-                __m128i maskedOutSet2 = _mm_or_si128(_mm_and_si128(writeMaskSet2, pixels5Through8),
-                                                     _mm_andnot_si128(writeMaskSet2, backgroundPixels5Through8));
-                
-                maskedOutSet1 = _mm_or_si128(_mm_and_si128(clipMaskSet1, maskedOutSet1),
-                                             _mm_andnot_si128(clipMaskSet1, *(__m128i*)destPixel));
-                
-                maskedOutSet2 = _mm_or_si128(_mm_and_si128(clipMaskSet2, maskedOutSet2),
-                                             _mm_andnot_si128(clipMaskSet2, _mm256_extractf128_si256(*(__m256i*)destPixel, 1)));
-                
-                //Pack 128 bit pixel values back into 256 bit values to write out
-                __m256i maskedOut = _mm256_castsi128_si256(maskedOutSet1);
-                maskedOut = _mm256_insertf128_si256(maskedOut, maskedOutSet2, 1);
-                
-                *(__m256i*)destPixel = maskedOut;
+                Text_Glyph_Quad glyph = glyphs[glyphIndex];
+                Software_Clip_Vert bottomLeft = _GlyphCorner(glyph.minCorner_normalized, glyph.minCornerUV);
+                Software_Clip_Vert topLeft = _GlyphCorner(v2 { glyph.minCorner_normalized.x, glyph.maxCorner_normalized.y }, v2 { glyph.minCornerUV.x, glyph.maxCornerUV.y });
+                Software_Clip_Vert topRight = _GlyphCorner(glyph.maxCorner_normalized, glyph.maxCornerUV);
+                Software_Clip_Vert bottomRight = _GlyphCorner(v2 { glyph.maxCorner_normalized.x, glyph.minCorner_normalized.y }, v2 { glyph.maxCornerUV.x, glyph.minCornerUV.y });
+
+                //Clockwise, same as the hardware renderer's text stream
+                _SetupTriangle(list, bottomLeft, topRight, bottomRight, white, fontAtlas);
+                _SetupTriangle(list, bottomLeft, topLeft, topRight, white, fontAtlas);
             };
-            
-#endif
-            
-            destPixel += 8;
+
+            ++frameStats->drawCalls;
+            frameStats->glyphsDrawn += textEntry->glyphCount;
+        }break;
+
+        case EntryType_DrawRect:
+        {
+            RenderEntry_DrawRect* rectEntry = (RenderEntry_DrawRect*)entry;
+
+            Mat4x4 worldTransformMatrix = ProduceWorldTransformMatrix(rectEntry->worldTransform.translation, rectEntry->worldTransform.rotation, rectEntry->worldTransform.scale);
+            const Software_Vertex_Data* rectVertexData = _SoftwareVertexData(renderingInfo->rectVertObjID);
+            _SetupVertexDataTriangles(list, rectVertexData, rectVertexData->indexCount, viewProjectionMatrix * worldTransformMatrix, rectEntry->color,
+                                      _SoftwareTexture(rectEntry->textureID));
+
+            ++frameStats->drawCalls;
+            ++frameStats->rectsDrawn;
+        }break;
+
+        case EntryType_DrawRectOverlay:
+        {
+            RenderEntry_DrawRectOverlay rectEntryOverlay = *(RenderEntry_DrawRectOverlay*)entry;
+
+            //Same flip + conversion to 0 to 1 space as the hardware renderer
+            f32 rectWidth = AbsoluteValFloat(rectEntryOverlay._localMax.x - rectEntryOverlay._localMin.x);
+            f32 rectHeight = AbsoluteValFloat(rectEntryOverlay._localMax.y - rectEntryOverlay._localMin.y);
+            rectEntryOverlay.transform.translation.y = AbsoluteValFloat(rectEntryOverlay.transform.translation.y - renderingInfo->heightOfScreen_pixels) - rectHeight;
+
+            rectWidth *= rectEntryOverlay.transform.scale.x;
+            rectHeight *= rectEntryOverlay.transform.scale.y;
+            rectWidth /= renderingInfo->initialWidthOfScreen_pixels;
+            rectHeight /= renderingInfo->initialHeightOfScreen_pixels;
+            rectEntryOverlay.transform.scale.x = rectWidth;
+            rectEntryOverlay.transform.scale.y = rectHeight;
+            rectEntryOverlay.transform.translation.x /= renderingInfo->initialWidthOfScreen_pixels;
+            rectEntryOverlay.transform.translation.y /= renderingInfo->initialHeightOfScreen_pixels;
+
+            Mat4x4 worldTransform = ProduceWorldTransformMatrix(rectEntryOverlay.transform.translation, rectEntryOverlay.transform.rotation, rectEntryOverlay.transform.scale);
+            const Software_Vertex_Data* rectVertexData = _SoftwareVertexData(renderingInfo->rectVertObjID);
+            _SetupVertexDataTriangles(list, rectVertexData, rectVertexData->indexCount, transformToNeg1To1Space * worldTransform, rectEntryOverlay.colorChange,
+                                      _SoftwareTexture(rectEntryOverlay.textureID));
+
+            ++frameStats->drawCalls;
+        }break;
+
+        case EntryType_DrawCube:
+        {
+            RenderEntry_DrawCube* cube = (RenderEntry_DrawCube*)entry;
+
+            Mat4x4 worldTransformMatrix = ProduceWorldTransformMatrix(cube->worldTransform.translation, cube->worldTransform.rotation, cube->worldTransform.scale);
+            const Software_Vertex_Data* cubeVertexData = _SoftwareVertexData(renderingInfo->cubeVertObjID);
+            _SetupVertexDataTriangles(list, cubeVertexData, cubeVertexData->indexCount, viewProjectionMatrix * worldTransformMatrix, cube->color,
+                                      _SoftwareTexture(cube->textureID));
+
+            ++frameStats->drawCalls;
+        }break;
+
+        case EntryType_DrawMesh:
+        {
+            RenderEntry_DrawMesh* meshEntry = (RenderEntry_DrawMesh*)entry;
+
+            //Hardware renderer always draws meshes red
+            _SetupVertexDataTriangles(list, _SoftwareVertexData((s32)meshEntry->meshID), meshEntry->renderIndexLength, viewProjectionMatrix * meshEntry->worldTransform,
+                                      v4 { 1.0f, 0.0f, 0.0f, 1.0f }, _SoftwareTexture((u32)meshEntry->textureID));
+
+            ++frameStats->drawCalls;
+        }break;
+
+        default:
+        {
+            //Resources get loaded before any draws are set up, lines aren't drawn
+        }break;
+    };
+};
+
+void RenderViaSoftware(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferToRender, Software_Render_Target target,
+                       bgz::Memory_Partition* platformMemoryPart, Platform_Services* platformServices)
+{
+    BGZ_ASSERT(target.pixels && target.width > 0 && target.height > 0 && target.pitch_pxls >= target.width);
+
+    GPU_Frame_Stats frameStats {};
+
+    bgz::ScopedMemory sortScope{platformMemoryPart};
+    Render_Sort_Entry* sortedEntries = SortRenderCmdBuffer(&bufferToRender, platformMemoryPart);
+    Mat4x4 viewProjectionMatrix = _SoftwareViewProjectionMatrix(&renderingInfo);
+
+    //Resource entries sort first, so by the time any draw is reached everything it uses has been loaded
+    s32 maxTriangleCount {};
+    for (s32 entryNumber = 0; entryNumber < bufferToRender.entryCount; ++entryNumber)
+    {
+        u8* currentRenderBufferEntry = bufferToRender.baseAddress + sortedEntries[entryNumber].entryOffset;
+        _LoadSoftwareResource(currentRenderBufferEntry, platformServices);
+        maxTriangleCount += _MaxSoftwareTriangleCount(currentRenderBufferEntry, &renderingInfo);
+    };
+
+    //Every entry gets transformed and set up once up front, instead of once per tile it might touch
+    Software_Triangle_List triangleList {};
+    triangleList.triangles = PushType(platformMemoryPart, Software_Triangle, maxTriangleCount);
+    triangleList.capacity = maxTriangleCount;
+    triangleList.targetWidth = target.width;
+    triangleList.targetHeight = target.height;
+
+    for (s32 entryNumber = 0; entryNumber < bufferToRender.entryCount; ++entryNumber)
+    {
+        u8* currentRenderBufferEntry = bufferToRender.baseAddress + sortedEntries[entryNumber].entryOffset;
+        _SetupEntryTriangles(&triangleList, currentRenderBufferEntry, &renderingInfo, viewProjectionMatrix, &frameStats);
+    };
+
+    //Bin every triangle into the tiles its bounds overlap (count, prefix sum, fill) so triangles stay in draw order per tile
+    Software_Frame frame = _SoftwareFrame(target, &renderingInfo);
+    frame.triangles = triangleList.triangles;
+
+    s32 tileCount = frame.tileCountX * frame.tileCountY;
+    s32* binOffsets = PushType(platformMemoryPart, s32, tileCount + 1);
+    memset(binOffsets, 0, sizeof(s32) * (tileCount + 1));
+
+    for (s32 triIndex {}; triIndex < triangleList.count; ++triIndex)
+    {
+        const Software_Triangle* tri = &triangleList.triangles[triIndex];
+        for (s32 tileY { tri->minY / SOFTWARE_RENDER_TILE_SIZE }; tileY <= (tri->maxY - 1) / SOFTWARE_RENDER_TILE_SIZE; ++tileY)
+            for (s32 tileX { tri->minX / SOFTWARE_RENDER_TILE_SIZE }; tileX <= (tri->maxX - 1) / SOFTWARE_RENDER_TILE_SIZE; ++tileX)
+                ++binOffsets[tileY * frame.tileCountX + tileX + 1];
+    };
+
+    for (s32 tileIndex {}; tileIndex < tileCount; ++tileIndex)
+        binOffsets[tileIndex + 1] += binOffsets[tileIndex];
+
+    s32* binCursors = PushType(platformMemoryPart, s32, tileCount);
+    memcpy(binCursors, binOffsets, sizeof(s32) * tileCount);
+    s32* binTriangles = PushType(platformMemoryPart, s32, binOffsets[tileCount] ? binOffsets[tileCount] : 1);
+
+    for (s32 triIndex {}; triIndex < triangleList.count; ++triIndex)
+    {
+        const Software_Triangle* tri = &triangleList.triangles[triIndex];
+        for (s32 tileY { tri->minY / SOFTWARE_RENDER_TILE_SIZE }; tileY <= (tri->maxY - 1) / SOFTWARE_RENDER_TILE_SIZE; ++tileY)
+            for (s32 tileX { tri->minX / SOFTWARE_RENDER_TILE_SIZE }; tileX <= (tri->maxX - 1) / SOFTWARE_RENDER_TILE_SIZE; ++tileX)
+                binTriangles[binCursors[tileY * frame.tileCountX + tileX]++] = triIndex;
+    };
+
+    frame.binOffsets = binOffsets;
+    frame.binTriangles = binTriangles;
+
+    s32 jobCount = tileCount < SOFTWARE_RENDER_MAX_JOBS ? tileCount : SOFTWARE_RENDER_MAX_JOBS;
+    Software_Tile_Job* jobs = PushType(platformMemoryPart, Software_Tile_Job, jobCount);
+    _RunSoftwareTileJobs(&_RenderSoftwareTilesWork, jobs, sizeof(Software_Tile_Job), jobCount, &frame, platformServices);
+
+    frameStats.vertsDrawn = 3 * (s64)triangleList.count;
+    renderingInfo.frameStats = frameStats;
+    bufferToRender.entryCount = 0;
+};
+
+#if DEVELOPMENT_BUILD
+//Checkerboard with a soft edged alpha, so sprites exercise texturing and blending
+local_func Bitmap _BenchmarkSpriteBitmap(bgz::Memory_Partition* memPart, s32 size)
+{
+    Bitmap bitmap {};
+    bitmap.width_pxls = bitmap.height_pxls = size;
+    bitmap.pitch_pxls = size * BYTES_PER_PIXEL;
+    bitmap.aspectRatio = 1.0f;
+    bitmap.data = (u8*)PushType(memPart, u32, size * size);
+
+    u32* pixels = (u32*)bitmap.data;
+    for (s32 y {}; y < size; ++y)
+    {
+        for (s32 x {}; x < size; ++x)
+        {
+            s32 distanceToEdgeX = x < size - 1 - x ? x : size - 1 - x;
+            s32 distanceToEdgeY = y < size - 1 - y ? y : size - 1 - y;
+            s32 distanceToEdge = distanceToEdgeX < distanceToEdgeY ? distanceToEdgeX : distanceToEdgeY;
+            u32 alpha = distanceToEdge < 4 ? (u32)(distanceToEdge * 64) : 255;
+            u32 shade = ((x / 8 + y / 8) & 1) ? 255 : 128;
+            pixels[y * size + x] = (alpha << 24) | (shade << 16) | (shade << 8) | 64;
         };
-        
-        currentRow += colorBufferPitch;
     };
+
+    return bitmap;
 };
 
-void RenderToImage(Bitmap&& renderTarget, Bitmap sourceImage, Quad targetArea) {
-    //DrawImageSlowly($(renderTarget), targetArea, sourceImage, 0.0f);
+//Rect vertex data laid out the way GPUCmd_SendRectVertexData sends it
+local_func void _BenchmarkRecordRectVertexData(RenderCmdBuffer* cmdBuffer, bgz::Memory_Partition* memPart, s32 vertObjID)
+{
+    RenderEntry_InitVertexData* vertexData = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_InitVertexData, RenderSortKey(RenderLayer_Resource, 0.0f, EntryType_InitVertexData, 0, 0));
+    *vertexData = RenderEntry_InitVertexData {};
+    vertexData->header.type = EntryType_InitVertexData;
+    vertexData->stride = 3 + 3 + 2;
+    vertexData->vertexAttributes = VertexAttributeList { /*pos*/{true, 3}, /*color*/{true, 3}, /*texCoords*/{true, 2} };
+    vertexData->vertObjectID = vertObjID;
+
+    f32 verts[] =
+    {
+        0.0f, 0.0f, 0.0f,   1.0f, 1.0f, 1.0f,   0.0f, 0.0f,
+        1.0f, 0.0f, 0.0f,   1.0f, 1.0f, 1.0f,   1.0f, 0.0f,
+        1.0f, 1.0f, 0.0f,   1.0f, 1.0f, 1.0f,   1.0f, 1.0f,
+        0.0f, 1.0f, 0.0f,   1.0f, 1.0f, 1.0f,   0.0f, 1.0f
+    };
+    s16 indices[] = { 0, 2, 1, 0, 3, 2 };
+
+    InitArr($(vertexData->interleavedVertAttribData), memPart, ArrayCount(verts));
+    InitArr($(vertexData->indicies), memPart, ArrayCount(indices));
+    memcpy(vertexData->interleavedVertAttribData.elements, verts, sizeof(verts));
+    memcpy(vertexData->indicies.elements, indices, sizeof(indices));
+};
+
+//Sets up a 1080p style camera, sends the rect vertex data plus a sprite and font texture and renders them so the
+//timed frames only have draws in them. Returns the sprite texture's id
+local_func u32 _BenchmarkInitSoftwareScene(bgz::Memory_Partition* memPart, Platform_Services* platformServices, Software_Render_Target target,
+                                           Rendering_Info&& renderingInfo, RenderCmdBuffer&& cmdBuffer, s32 spriteCount)
+{
+    renderingInfo = Rendering_Info {};
+    renderingInfo.initialWidthOfScreen_pixels = renderingInfo.widthOfScreen_pixels = target.width;
+    renderingInfo.initialHeightOfScreen_pixels = renderingInfo.heightOfScreen_pixels = target.height;
+    renderingInfo.fov = 60.0f;
+    renderingInfo.aspectRatio = (f32)target.width / (f32)target.height;
+    renderingInfo.nearPlane = .1f;
+    renderingInfo.farPlane = 100.0f;
+    renderingInfo.camera3d.worldPos = v3 { 0.0f, 0.0f, -9.0f };
+    renderingInfo.clearColor = v3 { .47f, .47f, .47f };
+
+    cmdBuffer = RenderCmdBuffer {};
+    cmdBuffer.size = (s32)Megabytes(1) + spriteCount * (s32)(sizeof(RenderEntry_DrawRect) + sizeof(Render_Sort_Entry));
+    cmdBuffer.baseAddress = (u8*)PushSize(memPart, cmdBuffer.size);
+
+    renderingInfo.rectVertObjID = 1;
+    _BenchmarkRecordRectVertexData(&cmdBuffer, memPart, renderingInfo.rectVertObjID);
+
+    u32 spriteTextureID = ++cmdBuffer.textureCount;
+    RenderEntry_LoadTexture* loadTexEntry = RenderCmdBuf_PushEntry(&cmdBuffer, RenderEntry_LoadTexture, RenderSortKey(RenderLayer_Resource, 0.0f, EntryType_LoadTexture, 0, 0));
+    *loadTexEntry = RenderEntry_LoadTexture {};
+    loadTexEntry->header.type = EntryType_LoadTexture;
+    loadTexEntry->texture = _BenchmarkSpriteBitmap(memPart, 64);
+    loadTexEntry->id = spriteTextureID;
+
+    renderingInfo.textTextureID = ++cmdBuffer.textureCount;
+    loadTexEntry = RenderCmdBuf_PushEntry(&cmdBuffer, RenderEntry_LoadTexture, RenderSortKey(RenderLayer_Resource, 0.0f, EntryType_LoadTexture, 0, 0));
+    *loadTexEntry = RenderEntry_LoadTexture {};
+    loadTexEntry->header.type = EntryType_LoadTexture;
+    loadTexEntry->texture = _BenchmarkSpriteBitmap(memPart, 256);
+    loadTexEntry->id = renderingInfo.textTextureID;
+
+    RenderViaSoftware($(renderingInfo), $(cmdBuffer), target, memPart, platformServices);
+    cmdBuffer.usedAmount = 0;
+
+    return spriteTextureID;
+};
+
+//Full screen overlay rect, spriteCount textured + alpha blended world sprites spriteSize meters across and a line of text
+local_func void _BenchmarkRecordSpriteFrame(RenderCmdBuffer* cmdBuffer, Software_Render_Target target, u32 spriteTextureID, s32 spriteCount, f32 spriteSize)
+{
+    RenderEntry_DrawRectOverlay* backgroundEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawRectOverlay, RenderSortKey(RenderLayer_Overlay, 0.0f, EntryType_DrawRectOverlay, 0, 0));
+    *backgroundEntry = RenderEntry_DrawRectOverlay {};
+    backgroundEntry->header.type = EntryType_DrawRectOverlay;
+    backgroundEntry->_localMax = v2 { (f32)target.width, (f32)target.height };
+    backgroundEntry->transform.scale = v3 { 1.0f, 1.0f, 0.0f };
+    backgroundEntry->colorChange = v4 { .2f, .3f, .5f, .5f };
+
+    //Scattered over what the camera sees at depths 0 to 2, back to front sorting happens in the renderer
+    u32 randomState { 1 };
+    auto RandomUnilateral = [&randomState]() -> f32 {
+        randomState = randomState * 1664525 + 1013904223;
+        return (f32)(randomState >> 8) / (f32)(1 << 24);
+    };
+
+    for (s32 spriteIndex {}; spriteIndex < spriteCount; ++spriteIndex)
+    {
+        f32 depth = RandomUnilateral() * 2.0f;
+        RenderEntry_DrawRect* rectEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawRect, RenderSortKey(RenderLayer_World, depth, EntryType_DrawRect, spriteTextureID, 0));
+        *rectEntry = RenderEntry_DrawRect {};
+        rectEntry->header.type = EntryType_DrawRect;
+        rectEntry->worldTransform.translation = v3 { RandomUnilateral() * 18.0f - 9.0f, RandomUnilateral() * 10.0f - 5.0f, depth };
+        rectEntry->worldTransform.scale = v3 { spriteSize, spriteSize, 1.0f };
+        rectEntry->color = v4 { 1.0f, RandomUnilateral(), RandomUnilateral(), 1.0f };
+        rectEntry->textureID = spriteTextureID;
+    };
+
+    s32 glyphCount = 64;
+    RenderEntry_DrawText* textEntry = RenderCmdBuf_PushEntry(cmdBuffer, RenderEntry_DrawText, RenderSortKey(RenderLayer_Overlay, 0.0f, EntryType_DrawText, 0, 0));
+    textEntry->header.type = EntryType_DrawText;
+    textEntry->glyphCount = glyphCount;
+    textEntry->depth = 0.0f;
+    Text_Glyph_Quad* glyphs = (Text_Glyph_Quad*)_RenderCmdBuf_Push(cmdBuffer, sizeof(Text_Glyph_Quad) * glyphCount);
+    for (s32 glyphIndex {}; glyphIndex < glyphCount; ++glyphIndex)
+    {
+        glyphs[glyphIndex].minCorner_normalized = v2 { .02f + glyphIndex * .015f, .9f };
+        glyphs[glyphIndex].maxCorner_normalized = v2 { .02f + glyphIndex * .015f + .012f, .95f };
+        glyphs[glyphIndex].minCornerUV = v2 { (glyphIndex % 16) / 16.0f, (glyphIndex / 16) / 16.0f };
+        glyphs[glyphIndex].maxCornerUV = glyphs[glyphIndex].minCornerUV + v2 { 1.0f / 16.0f, 1.0f / 16.0f };
+    };
 };
 
-struct Screen_Region_Render_Work
+struct Software_Unbinned_Tile_Job
 {
-    Rendering_Info renderingInfo;
-    void* colorBufferData;
-    v2i colorBufferSize;
-    i32 colorBufferPitch;
-    Rect screenRegionCoords;
+    Software_Tile_Job tileJob;
+    const RenderCmdBuffer* cmdBuffer;
+    const Render_Sort_Entry* sortedEntries;
+    const Rendering_Info* renderingInfo;
+    Mat4x4 viewProjectionMatrix;
+    Software_Triangle_List entryTriangles; //Scratch, big enough for any one entry
 };
 
-//Multi-threaded
-PLATFORM_WORK_QUEUE_CALLBACK(DrawScreenRegion)
+//What tiles used to do before binning (like the old DrawScreenRegion). Every tile walks the whole command buffer and
+//sets up every entry again, so it's tiles * entries transforms a frame
+local_func PLATFORM_WORK_QUEUE_CALLBACK(_RenderSoftwareTilesWork_Unbinned)
 {
-    Screen_Region_Render_Work* work = (Screen_Region_Render_Work*)data;
-    
-    ui8* currentRenderBufferEntry = work->renderingInfo.gameCmdBuffer.baseAddress;
-    Camera2D* camera = &work->renderingInfo.camera;
-    
-    f32 pixelsPerMeter = work->renderingInfo._pixelsPerMeter;
-    v2 screenSize_meters = (CastV2IToV2F(work->colorBufferSize) / pixelsPerMeter);
-    camera->dilatePoint_inScreenCoords = (screenSize_meters / 2.0f) + (Hadamard(screenSize_meters, camera->dilatePointOffset_normalized));
-    
-    v2 screenDimensions_meters = CastV2IToV2F(work->colorBufferSize) / pixelsPerMeter;
-    camera->viewCenter = screenDimensions_meters / 2.0f;
-    
-    for (i32 entryNumber = 0; entryNumber < work->renderingInfo.cmdBuffer.entryCount; ++entryNumber)
+    Software_Unbinned_Tile_Job* job = (Software_Unbinned_Tile_Job*)data;
+    const Software_Frame* frame = job->tileJob.frame;
+
+    s32 tileCount = frame->tileCountX * frame->tileCountY;
+    for (s32 tileIndex { job->tileJob.firstTile }; tileIndex < tileCount; tileIndex += job->tileJob.tileStride)
     {
-        RenderEntry_Header* entryHeader = (RenderEntry_Header*)currentRenderBufferEntry;
-        switch (entryHeader->type)
+        s32 tileMinX {}, tileMinY {}, tileMaxX {}, tileMaxY {};
+        _BeginSoftwareTile(frame, tileIndex, $(tileMinX), $(tileMinY), $(tileMaxX), $(tileMaxY));
+
+        for (s32 entryNumber = 0; entryNumber < job->cmdBuffer->entryCount; ++entryNumber)
         {
-            case EntryType_Texture:
-            {
-                RenderEntry_Texture textureEntry = *(RenderEntry_Texture*)currentRenderBufferEntry;
-                
-                Quad imageTargetRect_camera = CameraTransform(textureEntry.targetRect_worldCoords, *camera);
-                Quad imageTargetRect_screen = ProjectionTransform_Ortho(imageTargetRect_camera, pixelsPerMeter);
-                
-                DrawTexture_Optimized((ui32*)work->colorBufferData, work->colorBufferSize, work->colorBufferPitch, imageTargetRect_screen, textureEntry, work->screenRegionCoords);
-                
-                currentRenderBufferEntry += sizeof(RenderEntry_Texture);
-            }
-            break;
-            
-            case EntryType_Rect:
-            {
-                RenderEntry_Rect rectEntry = *(RenderEntry_Rect*)currentRenderBufferEntry;
-                
-                Quad targetRect_camera = CameraTransform(rectEntry.worldCoords, *camera);
-                Quad targetRect_screen = ProjectionTransform_Ortho(targetRect_camera, pixelsPerMeter);
-                
-                DrawRectangle((ui32*)work->colorBufferData, work->colorBufferSize, work->colorBufferPitch, targetRect_screen, rectEntry.color, work->screenRegionCoords);
-                
-                currentRenderBufferEntry += sizeof(RenderEntry_Rect);
-            }
-            break;
-            
-            case EntryType_Line:
-            {
-                RenderEntry_Line lineEntry = *(RenderEntry_Line*)currentRenderBufferEntry;
-            }
-            break;
-            
-            InvalidDefaultCase;
+            u8* currentRenderBufferEntry = job->cmdBuffer->baseAddress + job->sortedEntries[entryNumber].entryOffset;
+
+            GPU_Frame_Stats ignoredStats {};
+            job->entryTriangles.count = 0;
+            _SetupEntryTriangles(&job->entryTriangles, currentRenderBufferEntry, job->renderingInfo, job->viewProjectionMatrix, &ignoredStats);
+
+            for (s32 triIndex {}; triIndex < job->entryTriangles.count; ++triIndex)
+                _RasterizeTriangle(&job->entryTriangles.triangles[triIndex], frame->target, tileMinX, tileMinY, tileMaxX, tileMaxY);
         };
     };
+
+    _mm_sfence();
+    job->tileJob.done = true;
 };
 
-struct Platform_Services;
-void RenderViaSoftware(Rendering_Info&& renderingInfo, void* colorBufferData, v2i colorBufferSize, i32 colorBufferPitch, Platform_Services* platformServices)
+//RenderViaSoftware without the binning pre-pass, for comparing against. Comes out pixel for pixel the same
+local_func void _RenderViaSoftware_Unbinned(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferToRender, Software_Render_Target target,
+                                            bgz::Memory_Partition* platformMemoryPart, Platform_Services* platformServices)
 {
-    BGZ_ASSERT(((uintptr)colorBufferData & 63) == 0);//, "Color buffer memory coming in not aligned to 32 byte boundry!");
-    
-    //TODO: If these numbers change then you might need to think about aligning your regions to 8 byte boundarys
-    f32 const screenRegionCount_x = 8.0f;
-    f32 const screenRegionCount_y = 8.0f;
-    i32 workIndex {};
-    Array<Screen_Region_Render_Work, (i64)(screenRegionCount_x * screenRegionCount_y)> workArray {};
-    
-    f32 singleScreenRegion_width = colorBufferSize.width / screenRegionCount_x;
-    f32 singleScreenRegion_height = colorBufferSize.height / screenRegionCount_y;
-    
-    for (ui32 screenRegion_y {}; screenRegion_y < screenRegionCount_y; ++screenRegion_y)
+    bgz::ScopedMemory sortScope{platformMemoryPart};
+    Render_Sort_Entry* sortedEntries = SortRenderCmdBuffer(&bufferToRender, platformMemoryPart);
+
+    s32 maxEntryTriangleCount {};
+    for (s32 entryNumber = 0; entryNumber < bufferToRender.entryCount; ++entryNumber)
     {
-        for (ui32 screenRegion_x {}; screenRegion_x < screenRegionCount_x; ++screenRegion_x)
+        u8* currentRenderBufferEntry = bufferToRender.baseAddress + sortedEntries[entryNumber].entryOffset;
+        _LoadSoftwareResource(currentRenderBufferEntry, platformServices);
+
+        s32 entryTriangleCount = _MaxSoftwareTriangleCount(currentRenderBufferEntry, &renderingInfo);
+        maxEntryTriangleCount = entryTriangleCount > maxEntryTriangleCount ? entryTriangleCount : maxEntryTriangleCount;
+    };
+
+    Software_Frame frame = _SoftwareFrame(target, &renderingInfo);
+    s32 tileCount = frame.tileCountX * frame.tileCountY;
+    s32 jobCount = tileCount < SOFTWARE_RENDER_MAX_JOBS ? tileCount : SOFTWARE_RENDER_MAX_JOBS;
+
+    Software_Unbinned_Tile_Job* jobs = PushType(platformMemoryPart, Software_Unbinned_Tile_Job, jobCount);
+    for (s32 jobIndex {}; jobIndex < jobCount; ++jobIndex)
+    {
+        jobs[jobIndex].cmdBuffer = &bufferToRender;
+        jobs[jobIndex].sortedEntries = sortedEntries;
+        jobs[jobIndex].renderingInfo = &renderingInfo;
+        jobs[jobIndex].viewProjectionMatrix = _SoftwareViewProjectionMatrix(&renderingInfo);
+        jobs[jobIndex].entryTriangles = Software_Triangle_List {};
+        jobs[jobIndex].entryTriangles.triangles = PushType(platformMemoryPart, Software_Triangle, maxEntryTriangleCount ? maxEntryTriangleCount : 1);
+        jobs[jobIndex].entryTriangles.capacity = maxEntryTriangleCount;
+        jobs[jobIndex].entryTriangles.targetWidth = target.width;
+        jobs[jobIndex].entryTriangles.targetHeight = target.height;
+    };
+
+    _RunSoftwareTileJobs(&_RenderSoftwareTilesWork_Unbinned, jobs, sizeof(Software_Unbinned_Tile_Job), jobCount, &frame, platformServices);
+
+    bufferToRender.entryCount = 0;
+};
+
+//Renders a frame of spriteCount world sprites. Once with everything on the calling thread, then through the work queue
+//with 1 to max worker threads. Every run has to come out pixel for pixel the same as the single threaded one
+void BenchmarkSoftwareRenderer(bgz::Memory_Partition* memPart, Platform_Services* platformServices, v2i screenSize, s32 spriteCount, s32 passes)
+{
+    bgz::ScopedMemory scopeMemory(memPart);
+
+    Software_Render_Target target {};
+    target.width = screenSize.width;
+    target.height = screenSize.height;
+    target.pitch_pxls = screenSize.width;
+    target.pixels = PushType(memPart, u32, screenSize.width * screenSize.height);
+    u32* serialPixels = PushType(memPart, u32, screenSize.width * screenSize.height);
+
+    Rendering_Info renderingInfo {};
+    RenderCmdBuffer cmdBuffer {};
+    u32 spriteTextureID = _BenchmarkInitSoftwareScene(memPart, platformServices, target, $(renderingInfo), $(cmdBuffer), spriteCount);
+    _BenchmarkRecordSpriteFrame(&cmdBuffer, target, spriteTextureID, spriteCount, .5f);
+
+    RenderCmdBuffer frameCmdBuffer = cmdBuffer;
+    f64 framePixels = (f64)screenSize.width * (f64)screenSize.height;
+
+    Platform_Services serialServices = *platformServices;
+    serialServices.AddWorkQueueEntry = nullptr;
+
+    f64 serialSecs { 1e9 };
+    for (s32 pass {}; pass < passes; ++pass)
+    {
+        cmdBuffer = frameCmdBuffer;
+
+        f64 startTime = platformServices->CurrentTimeInSecs();
+        RenderViaSoftware($(renderingInfo), $(cmdBuffer), target, memPart, &serialServices);
+        f64 secs = platformServices->CurrentTimeInSecs() - startTime;
+
+        serialSecs = secs < serialSecs ? secs : serialSecs;
+    };
+    memcpy(serialPixels, target.pixels, sizeof(u32) * screenSize.width * screenSize.height);
+
+    BGZ_CONSOLE("Software render bench (%dx%d, %d sprites, %lld triangles): serial %.3f ms (%.1f MPixels/s)\n", screenSize.width, screenSize.height, spriteCount,
+                (long long)(renderingInfo.frameStats.vertsDrawn / 3), serialSecs * 1000.0, framePixels / serialSecs / 1e6);
+
+    for (s32 threadCount { 1 }; threadCount <= platformServices->maxWorkerThreadCount; ++threadCount)
+    {
+        platformServices->SetWorkerThreadCount(threadCount);
+
+        f64 parallelSecs { 1e9 };
+        for (s32 pass {}; pass < passes; ++pass)
         {
-            v2 screenRegion_min = v2 { screenRegion_x * singleScreenRegion_width, screenRegion_y * singleScreenRegion_height };
-            v2 screenRegion_max = v2 { screenRegion_min.x + singleScreenRegion_width, screenRegion_min.y + singleScreenRegion_height };
-            Rect screenRegionCoords { screenRegion_min, screenRegion_max };
-            
-            Screen_Region_Render_Work* renderWork = &workArray[workIndex];
-            
-            renderWork->renderingInfo = renderingInfo;
-            renderWork->colorBufferData = colorBufferData;
-            renderWork->colorBufferSize = colorBufferSize;
-            renderWork->colorBufferPitch = colorBufferPitch;
-            renderWork->screenRegionCoords = screenRegionCoords;
-            
-            //Multi-Threaded
-            platformServices->AddWorkQueueEntry(DrawScreenRegion, renderWork);
-            
-            workIndex++;
+            cmdBuffer = frameCmdBuffer;
+            memset(target.pixels, 0, sizeof(u32) * screenSize.width * screenSize.height);
+
+            f64 startTime = platformServices->CurrentTimeInSecs();
+            RenderViaSoftware($(renderingInfo), $(cmdBuffer), target, memPart, platformServices);
+            f64 secs = platformServices->CurrentTimeInSecs() - startTime;
+
+            parallelSecs = secs < parallelSecs ? secs : parallelSecs;
         };
+
+        BGZ_ASSERT(memcmp(serialPixels, target.pixels, sizeof(u32) * screenSize.width * screenSize.height) == 0);//, "Tiles rendered on the work queue don't match rendering serially!");
+        BGZ_CONSOLE("Software render bench: %d worker threads %.3f ms (%.1f MPixels/s, %.2fx serial)\n", threadCount, parallelSecs * 1000.0,
+                    framePixels / parallelSecs / 1e6, serialSecs / parallelSecs);
     };
-    
-    platformServices->FinishAllWork();
-    
-    renderingInfo.cmdBuffer.entryCount = 0;
+
+    platformServices->SetWorkerThreadCount(platformServices->maxWorkerThreadCount);
 };
 
-#endif //SOFTWARE_RENDERING_INCLUDE_H
-#endif//disabling software rendering for now
\ No newline at end of file
+//Small sprite scenes (a few pixels to a side at 1080p) where setting up entries is most of the work, rendered with
+//and without binning on every worker thread
+void BenchmarkSoftwareRenderBinning(bgz::Memory_Partition* memPart, Platform_Services* platformServices, v2i screenSize, s32 passes)
+{
+    s32 spriteCounts[] = { 1000, 50000 };
+    for (s32 sceneIndex {}; sceneIndex < ArrayCount(spriteCounts); ++sceneIndex)
+    {
+        bgz::ScopedMemory scopeMemory(memPart);
+        s32 spriteCount = spriteCounts[sceneIndex];
+
+        Software_Render_Target target {};
+        target.width = screenSize.width;
+        target.height = screenSize.height;
+        target.pitch_pxls = screenSize.width;
+        target.pixels = PushType(memPart, u32, screenSize.width * screenSize.height);
+        u32* unbinnedPixels = PushType(memPart, u32, screenSize.width * screenSize.height);
+
+        Rendering_Info renderingInfo {};
+        RenderCmdBuffer cmdBuffer {};
+        u32 spriteTextureID = _BenchmarkInitSoftwareScene(memPart, platformServices, target, $(renderingInfo), $(cmdBuffer), spriteCount);
+        _BenchmarkRecordSpriteFrame(&cmdBuffer, target, spriteTextureID, spriteCount, .05f);
+
+        RenderCmdBuffer frameCmdBuffer = cmdBuffer;
+
+        f64 unbinnedSecs { 1e9 }, binnedSecs { 1e9 };
+        for (s32 pass {}; pass < passes; ++pass)
+        {
+            cmdBuffer = frameCmdBuffer;
+            f64 startTime = platformServices->CurrentTimeInSecs();
+            _RenderViaSoftware_Unbinned($(renderingInfo), $(cmdBuffer), target, memPart, platformServices);
+            f64 secs = platformServices->CurrentTimeInSecs() - startTime;
+            unbinnedSecs = secs < unbinnedSecs ? secs : unbinnedSecs;
+        };
+        memcpy(unbinnedPixels, target.pixels, sizeof(u32) * screenSize.width * screenSize.height);
+
+        for (s32 pass {}; pass < passes; ++pass)
+        {
+            cmdBuffer = frameCmdBuffer;
+            f64 startTime = platformServices->CurrentTimeInSecs();
+            RenderViaSoftware($(renderingInfo), $(cmdBuffer), target, memPart, platformServices);
+            f64 secs = platformServices->CurrentTimeInSecs() - startTime;
+            binnedSecs = secs < binnedSecs ? secs : binnedSecs;
+        };
+
+        BGZ_ASSERT(memcmp(unbinnedPixels, target.pixels, sizeof(u32) * screenSize.width * screenSize.height) == 0);//, "Binned frame doesn't match the unbinned one!");
+        BGZ_CONSOLE("Software render binning bench (%dx%d, %d sprites, %d worker threads): unbinned %.3f ms, binned %.3f ms (%.2fx)\n", screenSize.width, screenSize.height,
+                    spriteCount, platformServices->AddWorkQueueEntry ? platformServices->maxWorkerThreadCount : 0, unbinnedSecs * 1000.0, binnedSecs * 1000.0,
+                    unbinnedSecs / binnedSecs);
+    };
+};
+#endif
+
+#endif //SOFTWARE_RENDERING_IMPL
@@ -0,0 +1,596 @@
+#ifndef TEXTURE_CACHE_INCLUDE
+#define TEXTURE_CACHE_INCLUDE
+
+#include "renderer_stuff.h"
+
+/*
+    Loads image files as gpu textures, once. Entries are keyed by a hash of the file's contents (plus the mip filter) so
+    the same image under two paths is still only loaded once. The decoded, premultiplied and mipped result is persisted
+    to diskCacheDir so from the second launch on a texture is just mapped in and uploaded, no jpg/png decode or mip
+    generation.
+
+    Cache file: Texture_Cache_File_Header followed by the full mip chain (level 0 first, each level sized by NextMipSize
+    from the one before down to 1x1) in the same BGRA premultiplied, bottom up row layout LoadBitmap_BGRA gives.
+*/
+
+#define TEXTURE_CACHE_MAGIC 0x58455447 //"GTEX"
+#define TEXTURE_CACHE_VERSION 2
+#define TEXTURE_CACHE_MAX_MIPS 16
+
+enum class Mip_Filter : i32
+{
+    BOX, //2x2 average
+    KAISER //8 tap kaiser windowed sinc. Sharper, less aliasing. Expects premultiplied pixels
+};
+
+struct Texture_Cache_File_Header
+{
+    ui32 magic;
+    ui32 version;
+    ui64 contentHash;
+    Mip_Filter filter;
+    i32 width_pxls, height_pxls;
+    i32 mipCount;
+    f64 cookSecs; //Decode + mip generation time a cache hit skips
+    ui32 fileSize;
+};
+
+struct Texture_Cache_Entry
+{
+    ui64 contentHash {};
+    Mip_Filter filter {};
+    i32 refCount {};
+    u32 textureID {};
+    i32 mipCount {};
+    Bitmap mips[TEXTURE_CACHE_MAX_MIPS] {}; //Point into cacheFile
+    void* cacheFile { nullptr }; //Header + mip chain. Mapped if it came from disk, heap otherwise
+    b cacheFileMapped {};
+};
+
+struct Texture_Cache_Stats
+{
+    i32 memoryHits {}; //Already loaded this run (deduplicated)
+    i32 diskHits {};
+    i32 misses {};
+    f64 loadSecs {}; //Total time spent in AcquireTexture
+    f64 secsSaved {}; //Decode + mip time the disk hits skipped, minus what loading them cost
+};
+
+struct Texture_Cache
+{
+    Array<Texture_Cache_Entry, 32> entries;
+    const char* diskCacheDir { nullptr }; //Null to always decode (nothing read or written)
+    Texture_Cache_Stats stats {};
+};
+
+//Mip data has to stay valid until the command buffer it was uploaded with has been rendered, so don't release a
+//texture in the same frame it was acquired. Returns null if the image file can't be read
+Texture_Cache_Entry* AcquireTexture(Texture_Cache&& cache, RenderCmdBuffer* cmdBuffer, const char* imageFilePath, Mip_Filter filter = Mip_Filter::KAISER);
+//Gpu texture stays allocated since the renderer has no way to delete textures yet
+void ReleaseTexture(Texture_Cache&& cache, Texture_Cache_Entry* texture);
+
+//Size of the level below, the way gl expects it: max(1, floor(size / 2)). A chain sized any other way leaves the
+//texture mipmap incomplete (samples as black)
+inline i32 NextMipSize(i32 size_pxls)
+{
+    return size_pxls / 2 > 1 ? size_pxls / 2 : 1;
+};
+
+//Writes a NextMipSize(w) x NextMipSize(h) level. Odd edges fold their last row/column into the level's last row/column
+void DownsampleHalf(u8* destPixels, const u8* srcPixels, i32 srcWidth_pxls, i32 srcHeight_pxls, Mip_Filter filter);
+
+#if DEVELOPMENT_BUILD
+void BenchmarkTextureCache(bgz::Memory_Partition&& memPart, const char* diskCacheDir);
+#endif
+
+#endif
+
+#ifdef TEXTURE_CACHE_IMPL
+
+local_func ui64 _HashFileContents(const u8* data, i32 size)
+{
+    //FNV-1a
+    ui64 hash = 14695981039346656037ull;
+    for (i32 i {}; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    };
+
+    return hash;
+};
+
+//2x2 averages. With an odd edge the last dest pixel's footprint takes in the leftover source row/column too (2x3 or 3x3)
+local_func void _DownsampleHalf_Box(u8* dest, const u8* src, i32 srcWidth, i32 srcHeight)
+{
+    i32 destWidth = NextMipSize(srcWidth), destHeight = NextMipSize(srcHeight);
+    for (i32 y {}; y < destHeight; ++y)
+    {
+        i32 srcY0 = y * 2, srcYEnd = (y == destHeight - 1) ? srcHeight : y * 2 + 2;
+        u8* destRow = dest + y * destWidth * 4;
+
+        i32 x {};
+#if __AVX2__
+        if (srcYEnd - srcY0 == 2)
+        {
+            const u8* srcRow0 = src + srcY0 * srcWidth * 4;
+            const u8* srcRow1 = srcRow0 + srcWidth * 4;
+
+            //4 dest pixels (8 source pixels from each row) at a time, summed in 16 bits. A last pixel with a column folded in
+            //is left to the scalar loop
+            __m256i zero = _mm256_setzero_si256();
+            __m256i roundingBias = _mm256_set1_epi16(2);
+            i32 simdDestWidth = (srcWidth & 1) ? destWidth - 1 : destWidth;
+            for (; x + 4 <= simdDestWidth; x += 4)
+            {
+                __m256i row0 = _mm256_loadu_si256((const __m256i*)(srcRow0 + x * 8));
+                __m256i row1 = _mm256_loadu_si256((const __m256i*)(srcRow1 + x * 8));
+
+                //Per 128 bit lane: lo holds source pixels 0,1 (4,5), hi holds 2,3 (6,7)
+                __m256i sumLo = _mm256_add_epi16(_mm256_unpacklo_epi8(row0, zero), _mm256_unpacklo_epi8(row1, zero));
+                __m256i sumHi = _mm256_add_epi16(_mm256_unpackhi_epi8(row0, zero), _mm256_unpackhi_epi8(row1, zero));
+                sumLo = _mm256_add_epi16(sumLo, _mm256_shuffle_epi32(sumLo, _MM_SHUFFLE(1, 0, 3, 2)));
+                sumHi = _mm256_add_epi16(sumHi, _mm256_shuffle_epi32(sumHi, _MM_SHUFFLE(1, 0, 3, 2)));
+
+                __m256i sum = _mm256_unpacklo_epi64(sumLo, sumHi);
+                sum = _mm256_srli_epi16(_mm256_add_epi16(sum, roundingBias), 2);
+
+                __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), _MM_SHUFFLE(3, 1, 2, 0));
+                _mm_storeu_si128((__m128i*)(destRow + x * 4), _mm256_castsi256_si128(packed));
+            };
+        };
+#endif
+        for (; x < destWidth; ++x)
+        {
+            i32 srcX0 = x * 2, srcXEnd = (x == destWidth - 1) ? srcWidth : x * 2 + 2;
+            i32 footprintSize = (srcXEnd - srcX0) * (srcYEnd - srcY0);
+            for (i32 channel {}; channel < 4; ++channel)
+            {
+                i32 sum {};
+                for (i32 srcY { srcY0 }; srcY < srcYEnd; ++srcY)
+                    for (i32 srcX { srcX0 }; srcX < srcXEnd; ++srcX)
+                        sum += src[(srcY * srcWidth + srcX) * 4 + channel];
+
+                destRow[x * 4 + channel] = (u8)((sum + footprintSize / 2) / footprintSize);
+            };
+        };
+    };
+};
+
+#define KAISER_TAP_COUNT 8
+
+local_func f64 _BesselI0(f64 x)
+{
+    f64 sum { 1.0 }, term { 1.0 };
+    for (i32 k { 1 }; k < 32; ++k)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    };
+
+    return sum;
+};
+
+//Weights for source pixels 2x - 3 ... 2x + 4 of a 2:1 reduction. Sinc cut off at the new nyquist, kaiser window
+//(alpha 4) over the 4 source pixel radius. Same for every dest pixel since the filter is always centered between
+//two source pixels
+local_func void _KaiserWeights(f32* weights)
+{
+    f64 alpha { 4.0 }, radius { 4.0 }, sum {};
+    f64 rawWeights[KAISER_TAP_COUNT] {};
+    for (i32 tap {}; tap < KAISER_TAP_COUNT; ++tap)
+    {
+        f64 distance = (f64)tap - 3.5;
+        f64 x = distance / 2.0;
+        f64 sinc = (x == 0.0) ? 1.0 : sin((f64)PI * x) / ((f64)PI * x);
+        f64 t = distance / radius;
+        f64 window = _BesselI0(alpha * sqrt(1.0 - t * t)) / _BesselI0(alpha);
+        rawWeights[tap] = sinc * window;
+        sum += rawWeights[tap];
+    };
+
+    for (i32 tap {}; tap < KAISER_TAP_COUNT; ++tap)
+        weights[tap] = (f32)(rawWeights[tap] / sum);
+};
+
+inline __m128 _UnpackPixel(const u8* pixel)
+{
+#if __AVX2__
+    return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const i32*)pixel)));
+#else
+    return _mm_set_ps((f32)pixel[3], (f32)pixel[2], (f32)pixel[1], (f32)pixel[0]);
+#endif
+};
+
+//Negative lobes can over/undershoot so clamp to 0-255 and keep color <= alpha so it stays valid premultiplied
+inline u32 _PackPixel(__m128 pixel)
+{
+    pixel = _mm_min_ps(_mm_max_ps(pixel, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    __m128 alpha = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+    __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    pixel = _mm_or_ps(_mm_and_ps(alphaMask, pixel), _mm_andnot_ps(alphaMask, _mm_min_ps(pixel, alpha)));
+
+    __m128i packed = _mm_cvtps_epi32(pixel);
+    packed = _mm_packs_epi32(packed, packed);
+    packed = _mm_packus_epi16(packed, packed);
+    return (u32)_mm_cvtsi128_si32(packed);
+};
+
+//Separable: the vertical taps are collapsed into a single float row first so the scratch memory is one source row. An odd
+//edge's leftover row/column is inside the last dest pixel's taps so it still gets folded in
+local_func void _DownsampleHalf_Kaiser(u8* dest, const u8* src, i32 srcWidth, i32 srcHeight)
+{
+    i32 destWidth = NextMipSize(srcWidth), destHeight = NextMipSize(srcHeight);
+
+    f32 weights[KAISER_TAP_COUNT] {};
+    _KaiserWeights(weights);
+
+    __m128* filteredRow = (__m128*)_mm_malloc(sizeof(__m128) * srcWidth, 16);
+
+    for (i32 y {}; y < destHeight; ++y)
+    {
+        const u8* srcRows[KAISER_TAP_COUNT] {};
+        for (i32 tap {}; tap < KAISER_TAP_COUNT; ++tap)
+        {
+            i32 srcY = y * 2 - 3 + tap;
+            srcY = srcY < 0 ? 0 : (srcY >= srcHeight ? srcHeight - 1 : srcY);
+            srcRows[tap] = src + srcY * srcWidth * 4;
+        };
+
+        for (i32 x {}; x < srcWidth; ++x)
+        {
+            __m128 sum = _mm_setzero_ps();
+            for (i32 tap {}; tap < KAISER_TAP_COUNT; ++tap)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[tap]), _UnpackPixel(srcRows[tap] + x * 4)));
+            filteredRow[x] = sum;
+        };
+
+        u32* destRow = (u32*)(dest + y * destWidth * 4);
+        for (i32 x {}; x < destWidth; ++x)
+        {
+            __m128 sum = _mm_setzero_ps();
+            for (i32 tap {}; tap < KAISER_TAP_COUNT; ++tap)
+            {
+                i32 srcX = x * 2 - 3 + tap;
+                srcX = srcX < 0 ? 0 : (srcX >= srcWidth ? srcWidth - 1 : srcX);
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[tap]), filteredRow[srcX]));
+            };
+
+            destRow[x] = _PackPixel(sum);
+        };
+    };
+
+    _mm_free(filteredRow);
+};
+
+void DownsampleHalf(u8* destPixels, const u8* srcPixels, i32 srcWidth_pxls, i32 srcHeight_pxls, Mip_Filter filter)
+{
+    switch (filter)
+    {
+        case Mip_Filter::BOX:
+        {
+            _DownsampleHalf_Box(destPixels, srcPixels, srcWidth_pxls, srcHeight_pxls);
+        }break;
+
+        case Mip_Filter::KAISER:
+        {
+            _DownsampleHalf_Kaiser(destPixels, srcPixels, srcWidth_pxls, srcHeight_pxls);
+        }break;
+
+        InvalidDefaultCase;
+    };
+};
+
+local_func i32 _MipChainSize(i32&& mipCount, i32 width, i32 height)
+{
+    i32 size {};
+    mipCount = 0;
+    for (;;)
+    {
+        size += width * height * BYTES_PER_PIXEL;
+        ++mipCount;
+
+        if (width == 1 && height == 1)
+            break;
+
+        width = NextMipSize(width);
+        height = NextMipSize(height);
+    };
+
+    BGZ_ASSERT(mipCount <= TEXTURE_CACHE_MAX_MIPS);//, "Image is too big!");
+
+    return size;
+};
+
+local_func void _TextureCacheFilePath(char* cacheFilePath, i32 cacheFilePathSize, const char* diskCacheDir, ui64 contentHash, Mip_Filter filter)
+{
+    snprintf(cacheFilePath, cacheFilePathSize, "%s/%016llx_%d.tex", diskCacheDir, (unsigned long long)contentHash, (i32)filter);
+};
+
+local_func b _IsValidTextureCacheFile(const void* cacheFile, i32 cacheFileSize, ui64 contentHash, Mip_Filter filter)
+{
+    const Texture_Cache_File_Header* header = (const Texture_Cache_File_Header*)cacheFile;
+    return cacheFileSize >= (i32)sizeof(Texture_Cache_File_Header) && header->magic == TEXTURE_CACHE_MAGIC && header->version == TEXTURE_CACHE_VERSION
+           && header->contentHash == contentHash && header->filter == filter && header->fileSize == (ui32)cacheFileSize;
+};
+
+//Decodes the image and builds the cache file (header + mip chain) in heap memory
+local_func void* _CookTexture(const u8* imageFile, i32 imageFileSize, ui64 contentHash, Mip_Filter filter)
+{
+    f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+
+    stbi_set_flip_vertically_on_load(true);
+
+    s32 width {}, height {}, channelsInFile {};
+    u8* pixels = stbi_load_from_memory(imageFile, imageFileSize, &width, &height, &channelsInFile, 4);
+    BGZ_ASSERT(pixels);//Invalid image data!"
+
+    PremultiplyAlphaAndSwapRB((u32*)pixels, width * height);
+
+    i32 mipCount {};
+    i32 mipChainSize = _MipChainSize($(mipCount), width, height);
+    ui32 cacheFileSize = (ui32)sizeof(Texture_Cache_File_Header) + (ui32)mipChainSize;
+    void* cacheFile = globalPlatformServices->Malloc(cacheFileSize);
+
+    u8* level = (u8*)cacheFile + sizeof(Texture_Cache_File_Header);
+    memcpy(level, pixels, width * height * BYTES_PER_PIXEL);
+    stbi_image_free(pixels);
+
+    i32 levelWidth = width, levelHeight = height;
+    for (i32 mipIndex { 1 }; mipIndex < mipCount; ++mipIndex)
+    {
+        u8* nextLevel = level + levelWidth * levelHeight * BYTES_PER_PIXEL;
+        DownsampleHalf(nextLevel, level, levelWidth, levelHeight, filter);
+
+        level = nextLevel;
+        levelWidth = NextMipSize(levelWidth);
+        levelHeight = NextMipSize(levelHeight);
+    };
+
+    Texture_Cache_File_Header* header = (Texture_Cache_File_Header*)cacheFile;
+    *header = Texture_Cache_File_Header {};
+    header->magic = TEXTURE_CACHE_MAGIC;
+    header->version = TEXTURE_CACHE_VERSION;
+    header->contentHash = contentHash;
+    header->filter = filter;
+    header->width_pxls = width;
+    header->height_pxls = height;
+    header->mipCount = mipCount;
+    header->fileSize = cacheFileSize;
+    header->cookSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+    return cacheFile;
+};
+
+Texture_Cache_Entry* AcquireTexture(Texture_Cache&& cache, RenderCmdBuffer* cmdBuffer, const char* imageFilePath, Mip_Filter filter)
+{
+    f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+
+    i32 imageFileSize {};
+    u8* imageFile = globalPlatformServices->ReadEntireFile($(imageFileSize), imageFilePath);
+    if (NOT imageFile)
+    {
+        BGZ_CONSOLE("Unable to read texture image %s\n", imageFilePath);
+        return nullptr;
+    };
+
+    ui64 contentHash = _HashFileContents(imageFile, imageFileSize);
+
+    Texture_Cache_Entry* freeEntry { nullptr };
+    for (i32 entryIndex {}; entryIndex < cache.entries.Size(); ++entryIndex)
+    {
+        Texture_Cache_Entry* entry = &cache.entries[entryIndex];
+
+        if (entry->refCount > 0)
+        {
+            if (entry->contentHash == contentHash && entry->filter == filter)
+            {
+                ++entry->refCount;
+                ++cache.stats.memoryHits;
+                globalPlatformServices->Free(imageFile);
+                cache.stats.loadSecs += globalPlatformServices->CurrentTimeInSecs() - startTime;
+                return entry;
+            };
+        }
+        else if (NOT freeEntry)
+        {
+            freeEntry = entry;
+        };
+    };
+
+    BGZ_ASSERT(freeEntry);//, "Texture cache is full!");
+
+    Texture_Cache_Entry* entry = freeEntry;
+    *entry = Texture_Cache_Entry {};
+    entry->contentHash = contentHash;
+    entry->filter = filter;
+    entry->refCount = 1;
+
+    char cacheFilePath[512] {};
+    if (cache.diskCacheDir)
+    {
+        _TextureCacheFilePath(cacheFilePath, sizeof(cacheFilePath), cache.diskCacheDir, contentHash, filter);
+
+        i32 cacheFileSize {};
+        void* cacheFile = globalPlatformServices->MapEntireFile($(cacheFileSize), cacheFilePath);
+        if (cacheFile && _IsValidTextureCacheFile(cacheFile, cacheFileSize, contentHash, filter))
+        {
+            entry->cacheFile = cacheFile;
+            entry->cacheFileMapped = true;
+        }
+        else if (cacheFile)
+        {
+            globalPlatformServices->UnmapFile(cacheFile);
+        };
+    };
+
+    if (entry->cacheFileMapped)
+    {
+        ++cache.stats.diskHits;
+    }
+    else
+    {
+        ++cache.stats.misses;
+        entry->cacheFile = _CookTexture(imageFile, imageFileSize, contentHash, filter);
+
+        if (cache.diskCacheDir)
+        {
+            const Texture_Cache_File_Header* header = (const Texture_Cache_File_Header*)entry->cacheFile;
+            if (NOT globalPlatformServices->WriteEntireFile(cacheFilePath, entry->cacheFile, header->fileSize))
+                BGZ_CONSOLE("Unable to write texture cache file %s (does %s exist?)\n", cacheFilePath, cache.diskCacheDir);
+        };
+    };
+
+    globalPlatformServices->Free(imageFile);
+
+    const Texture_Cache_File_Header* header = (const Texture_Cache_File_Header*)entry->cacheFile;
+    entry->mipCount = header->mipCount;
+
+    u8* level = (u8*)entry->cacheFile + sizeof(Texture_Cache_File_Header);
+    i32 levelWidth = header->width_pxls, levelHeight = header->height_pxls;
+    for (i32 mipIndex {}; mipIndex < entry->mipCount; ++mipIndex)
+    {
+        Bitmap* mip = &entry->mips[mipIndex];
+        mip->data = level;
+        mip->width_pxls = levelWidth;
+        mip->height_pxls = levelHeight;
+        mip->aspectRatio = (f32)levelWidth / (f32)levelHeight;
+        mip->pitch_pxls = levelWidth * BYTES_PER_PIXEL;
+
+        level += levelWidth * levelHeight * BYTES_PER_PIXEL;
+        levelWidth = NextMipSize(levelWidth);
+        levelHeight = NextMipSize(levelHeight);
+    };
+
+    entry->textureID = GPUCmd_SendTextureData(cmdBuffer, entry->mips, entry->mipCount);
+
+    f64 loadSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+    cache.stats.loadSecs += loadSecs;
+    if (entry->cacheFileMapped)
+        cache.stats.secsSaved += header->cookSecs - loadSecs;
+
+    return entry;
+};
+
+void ReleaseTexture(Texture_Cache&& cache, Texture_Cache_Entry* texture)
+{
+    BGZ_ASSERT(texture->refCount > 0);//, "Releasing a texture that isn't loaded!");
+
+    --texture->refCount;
+    if (texture->refCount == 0)
+    {
+        if (texture->cacheFileMapped)
+            globalPlatformServices->UnmapFile(texture->cacheFile);
+        else
+            globalPlatformServices->Free(texture->cacheFile);
+
+        *texture = Texture_Cache_Entry {};
+    };
+};
+
+#if DEVELOPMENT_BUILD
+//Times each mip filter (and the simd box filter against its scalar tail) on the stage images, then loads the same
+//set of textures cold (always decoding), warm (from the disk cache) and deduplicated (second acquire of each).
+//Uploads go into a scratch command buffer that never gets rendered
+void BenchmarkTextureCache(bgz::Memory_Partition&& memPart, const char* diskCacheDir)
+{
+    Array<const char*, 4> imageFilePaths = { "data/4k.jpg", "data/1080p.jpg", "data/mountain.jpg", "data/yellow_god.png" };
+
+    bgz::ScopedMemory scopeMemory(&memPart);
+
+    RenderCmdBuffer cmdBuffer {};
+    cmdBuffer.size = (s32)Megabytes(1);
+    cmdBuffer.baseAddress = (u8*)PushSize(&memPart, cmdBuffer.size);
+
+    { //Mip filters on the biggest image
+        Bitmap source = LoadBitmap_BGRA(imageFilePaths[0]);
+        i32 destWidth = NextMipSize(source.width_pxls), destHeight = NextMipSize(source.height_pxls);
+        i32 destSize = destWidth * destHeight * BYTES_PER_PIXEL;
+        u8* boxPixels = (u8*)globalPlatformServices->Malloc(destSize);
+        u8* scalarBoxPixels = (u8*)globalPlatformServices->Malloc(destSize);
+        u8* kaiserPixels = (u8*)globalPlatformServices->Malloc(destSize);
+
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        _DownsampleHalf_Box(boxPixels, source.data, source.width_pxls, source.height_pxls);
+        f64 boxSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        //Plain scalar version of the same footprints (odd edges folded into the last row/column)
+        startTime = globalPlatformServices->CurrentTimeInSecs();
+        for (i32 y {}; y < destHeight; ++y)
+        {
+            i32 srcY0 = y * 2, srcYEnd = (y == destHeight - 1) ? source.height_pxls : y * 2 + 2;
+            for (i32 x {}; x < destWidth; ++x)
+            {
+                i32 srcX0 = x * 2, srcXEnd = (x == destWidth - 1) ? source.width_pxls : x * 2 + 2;
+                i32 footprintSize = (srcXEnd - srcX0) * (srcYEnd - srcY0);
+                for (i32 channel {}; channel < 4; ++channel)
+                {
+                    i32 sum {};
+                    for (i32 srcY { srcY0 }; srcY < srcYEnd; ++srcY)
+                        for (i32 srcX { srcX0 }; srcX < srcXEnd; ++srcX)
+                            sum += source.data[(srcY * source.width_pxls + srcX) * 4 + channel];
+
+                    scalarBoxPixels[(y * destWidth + x) * 4 + channel] = (u8)((sum + footprintSize / 2) / footprintSize);
+                };
+            };
+        };
+        f64 scalarBoxSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        startTime = globalPlatformServices->CurrentTimeInSecs();
+        _DownsampleHalf_Kaiser(kaiserPixels, source.data, source.width_pxls, source.height_pxls);
+        f64 kaiserSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        b boxMatches = memcmp(boxPixels, scalarBoxPixels, destSize) == 0;
+        BGZ_ASSERT(boxMatches);//, "Simd box filter doesn't match the scalar path!");
+
+        BGZ_CONSOLE("Mip filter bench (%s %dx%d -> half): box simd %.2f ms, box scalar %.2f ms (%s), kaiser %.2f ms\n", imageFilePaths[0],
+                    source.width_pxls, source.height_pxls, boxSecs * 1000.0, scalarBoxSecs * 1000.0, boxMatches ? "matches" : "MISMATCH", kaiserSecs * 1000.0);
+
+        globalPlatformServices->Free(kaiserPixels);
+        globalPlatformServices->Free(scalarBoxPixels);
+        globalPlatformServices->Free(boxPixels);
+        DeAlloc(heap, source.data);
+    };
+
+    Texture_Cache* cache = PushType(&memPart, Texture_Cache, 1);
+    Texture_Cache_Entry** textures = PushType(&memPart, Texture_Cache_Entry*, imageFilePaths.Size() * 2);
+
+    f64 coldSecs {};
+    { //Cold: no disk cache so every texture is decoded and mipped
+        *cache = Texture_Cache {};
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            textures[imageIndex] = AcquireTexture($(*cache), &cmdBuffer, imageFilePaths[imageIndex]);
+        coldSecs = cache->stats.loadSecs;
+
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            ReleaseTexture($(*cache), textures[imageIndex]);
+    };
+
+    { //Prime the disk cache (a no-op past the first launch), then warm loads + a deduplicated second acquire of each
+        *cache = Texture_Cache {};
+        cache->diskCacheDir = diskCacheDir;
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            ReleaseTexture($(*cache), AcquireTexture($(*cache), &cmdBuffer, imageFilePaths[imageIndex]));
+
+        *cache = Texture_Cache {};
+        cache->diskCacheDir = diskCacheDir;
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            textures[imageIndex] = AcquireTexture($(*cache), &cmdBuffer, imageFilePaths[imageIndex]);
+        f64 warmSecs = cache->stats.loadSecs;
+
+        for (i32 imageIndex {}; imageIndex < imageFilePaths.Size(); ++imageIndex)
+            textures[imageFilePaths.Size() + imageIndex] = AcquireTexture($(*cache), &cmdBuffer, imageFilePaths[imageIndex]);
+        f64 dedupSecs = cache->stats.loadSecs - warmSecs;
+
+        Texture_Cache_Stats stats = cache->stats;
+        BGZ_CONSOLE("Texture cache bench (%d images): cold %.2f ms, warm %.2f ms (%.1fx, %d disk hits / %d misses, %.2f ms saved), deduplicated %.2f ms (%d memory hits)\n",
+                    imageFilePaths.Size(), coldSecs * 1000.0, warmSecs * 1000.0, coldSecs / warmSecs, stats.diskHits, stats.misses, stats.secsSaved * 1000.0,
+                    dedupSecs * 1000.0, stats.memoryHits);
+
+        for (i32 textureIndex {}; textureIndex < imageFilePaths.Size() * 2; ++textureIndex)
+            ReleaseTexture($(*cache), textures[textureIndex]);
+    };
+};
+#endif
+
+#endif //TEXTURE_CACHE_IMPL
@@ -0,0 +1,145 @@
+/*
+    Checks the texture cache's mip chains are the ones gl expects: each level max(1, floor(size / 2)) of the level before,
+    floor(log2(max(w, h))) + 1 levels in all. Anything else leaves the texture mipmap incomplete and it samples as black.
+    Cooks images of a bunch of odd and even sizes (plus any image files passed in) through AcquireTexture, the same
+    chain that's handed to GPUCmd_SendTextureData, with both mip filters. Also checks the simd box filter against a plain
+    average of the same footprints. Prints every mismatch and returns 1 if there were any.
+
+    Usage: texture_mip_check [image files...]
+*/
+
+#include "gamecode.cpp"
+#include "cooker_platform.h"
+
+global_variable s32 globalCheckFailures;
+
+local_func void _CheckMipChain(Texture_Cache&& cache, RenderCmdBuffer* cmdBuffer, const char* imageFilePath, Mip_Filter filter)
+{
+    cmdBuffer->usedAmount = 0;
+    cmdBuffer->entryCount = 0;
+
+    Texture_Cache_Entry* texture = AcquireTexture($(cache), cmdBuffer, imageFilePath, filter);
+    if (NOT texture)
+    {
+        fprintf(stderr, "Unable to load %s!\n", imageFilePath);
+        ++globalCheckFailures;
+        return;
+    };
+
+    i32 width = texture->mips[0].width_pxls, height = texture->mips[0].height_pxls;
+
+    i32 expectedMipCount { 1 };
+    for (i32 largestEdge = width > height ? width : height; largestEdge > 1; largestEdge >>= 1)
+        ++expectedMipCount;
+
+    if (texture->mipCount != expectedMipCount)
+    {
+        fprintf(stderr, "%s (%dx%d, filter %d): %d mip levels, gl expects %d\n", imageFilePath, width, height, (i32)filter, texture->mipCount, expectedMipCount);
+        ++globalCheckFailures;
+    };
+
+    for (i32 mipIndex {}; mipIndex < texture->mipCount && mipIndex < expectedMipCount; ++mipIndex)
+    {
+        i32 expectedWidth = (width >> mipIndex) > 1 ? width >> mipIndex : 1;
+        i32 expectedHeight = (height >> mipIndex) > 1 ? height >> mipIndex : 1;
+
+        const Bitmap* mip = &texture->mips[mipIndex];
+        if (mip->width_pxls != expectedWidth || mip->height_pxls != expectedHeight)
+        {
+            fprintf(stderr, "%s (%dx%d, filter %d): mip %d is %dx%d, gl expects %dx%d\n", imageFilePath, width, height, (i32)filter, mipIndex,
+                    mip->width_pxls, mip->height_pxls, expectedWidth, expectedHeight);
+            ++globalCheckFailures;
+        };
+    };
+
+    ReleaseTexture($(cache), texture);
+};
+
+local_func void _CheckBoxFilter(const u8* src, i32 srcWidth, i32 srcHeight)
+{
+    i32 destWidth = NextMipSize(srcWidth), destHeight = NextMipSize(srcHeight);
+    u8* dest = (u8*)malloc(destWidth * destHeight * 4);
+    DownsampleHalf(dest, src, srcWidth, srcHeight, Mip_Filter::BOX);
+
+    s32 mismatchCount {};
+    for (i32 y {}; y < destHeight; ++y)
+    {
+        i32 srcY0 = y * 2, srcYEnd = (y == destHeight - 1) ? srcHeight : y * 2 + 2;
+        for (i32 x {}; x < destWidth; ++x)
+        {
+            i32 srcX0 = x * 2, srcXEnd = (x == destWidth - 1) ? srcWidth : x * 2 + 2;
+            i32 footprintSize = (srcXEnd - srcX0) * (srcYEnd - srcY0);
+            for (i32 channel {}; channel < 4; ++channel)
+            {
+                i32 sum {};
+                for (i32 srcY { srcY0 }; srcY < srcYEnd; ++srcY)
+                    for (i32 srcX { srcX0 }; srcX < srcXEnd; ++srcX)
+                        sum += src[(srcY * srcWidth + srcX) * 4 + channel];
+
+                mismatchCount += dest[(y * destWidth + x) * 4 + channel] != (u8)((sum + footprintSize / 2) / footprintSize);
+            };
+        };
+    };
+
+    if (mismatchCount)
+    {
+        fprintf(stderr, "Box filter %dx%d -> %dx%d: %d channels don't match a plain average\n", srcWidth, srcHeight, destWidth, destHeight, mismatchCount);
+        ++globalCheckFailures;
+    };
+
+    free(dest);
+};
+
+int main(int argc, char** argv)
+{
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    RenderCmdBuffer cmdBuffer {};
+    cmdBuffer.size = (s32)Megabytes(1);
+    cmdBuffer.baseAddress = (u8*)malloc(cmdBuffer.size);
+
+    Texture_Cache* cache = (Texture_Cache*)calloc(1, sizeof(Texture_Cache));
+    *cache = Texture_Cache {};
+
+    //Odd edges at the top level and further down the chain (4k's 2160 goes 135 -> 67), wide, tall and 1 pixel edges
+    v2i sizes[] = { { 3840, 2160 }, { 1920, 1080 }, { 257, 129 }, { 33, 65 }, { 1000, 3 }, { 5, 3 }, { 7, 1 }, { 1, 7 }, { 1, 1 }, { 64, 64 } };
+    const char* checkImagePath = "texture_mip_check.png";
+
+    for (i32 sizeIndex {}; sizeIndex < (i32)ArrayCount(sizes); ++sizeIndex)
+    {
+        v2i size = sizes[sizeIndex];
+
+        u32* pixels = (u32*)malloc(size.width * size.height * 4);
+        for (i32 pixelIndex {}; pixelIndex < size.width * size.height; ++pixelIndex)
+            pixels[pixelIndex] = 0xFF000000 | ((u32)pixelIndex * 2654435761u >> 8);
+
+        _CheckBoxFilter((const u8*)pixels, size.width, size.height);
+
+        if (NOT stbi_write_png(checkImagePath, size.width, size.height, 4, pixels, size.width * 4))
+        {
+            fprintf(stderr, "Unable to write %s!\n", checkImagePath);
+            return 1;
+        };
+        free(pixels);
+
+        _CheckMipChain($(*cache), &cmdBuffer, checkImagePath, Mip_Filter::BOX);
+        _CheckMipChain($(*cache), &cmdBuffer, checkImagePath, Mip_Filter::KAISER);
+    };
+    remove(checkImagePath);
+
+    for (i32 argIndex { 1 }; argIndex < argc; ++argIndex)
+    {
+        _CheckMipChain($(*cache), &cmdBuffer, argv[argIndex], Mip_Filter::BOX);
+        _CheckMipChain($(*cache), &cmdBuffer, argv[argIndex], Mip_Filter::KAISER);
+    };
+
+    if (globalCheckFailures)
+    {
+        fprintf(stderr, "Texture mip check FAILED (%d mismatches)\n", globalCheckFailures);
+        return 1;
+    };
+
+    printf("Texture mip check ok (%d sizes, %d image files)\n", (i32)ArrayCount(sizes), argc - 1);
+    return 0;
+};
@@ -0,0 +1,47 @@
+/*
+    Offline tool that cuts a large image (e.g. a stage background) into fixed size tiles with a mip chain and writes
+    them out as a .tiles file the game streams from at runtime (see tiled_image.h).
+
+    Usage: tile_cooker <image file> <output .tiles file> [tile size in pixels]
+*/
+
+#include "gamecode.cpp"
+#include "cooker_platform.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: tile_cooker <image file> <output .tiles file> [tile size in pixels]\n");
+        return 1;
+    };
+
+    const char* imageFilePath = argv[1];
+    const char* tiledFilePath = argv[2];
+    i32 tileSize_pxls = argc > 3 ? atoi(argv[3]) : 256;
+
+    Platform_Services platformServices {};
+    Cooker_InitPlatformServices($(platformServices));
+
+    ui32 tiledFileSize {};
+    void* tiledFile = CookTiledImage($(tiledFileSize), imageFilePath, tileSize_pxls);
+    if (NOT tiledFile)
+    {
+        fprintf(stderr, "Unable to load %s!\n", imageFilePath);
+        return 1;
+    };
+
+    if (NOT Cooker_WriteEntireFile(tiledFilePath, tiledFile, tiledFileSize))
+    {
+        fprintf(stderr, "Unable to write %s!\n", tiledFilePath);
+        return 1;
+    };
+
+    Tiled_Image_Header* header = (Tiled_Image_Header*)tiledFile;
+    printf("Cooked %s (%dx%d, %d mips of %dpx tiles, %u bytes)\n", tiledFilePath, header->width_pxls, header->height_pxls,
+           header->mipCount, header->tileSize_pxls, tiledFileSize);
+
+    Cooker_Free(tiledFile);
+
+    return 0;
+};
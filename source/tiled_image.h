@@ -0,0 +1,607 @@
+#ifndef TILED_IMAGE_INCLUDE
+#define TILED_IMAGE_INCLUDE
+
+#include "renderer_stuff.h"
+#include "texture_cache.h"
+
+/*
+    Tiled image (.tiles) file format. Written offline by tile_cooker from a big image (e.g. the stage background) so at
+    runtime only the tiles the camera can see, at the detail level it needs, ever get decoded and uploaded.
+
+    Layout (offsets are all from the start of the file):
+        Tiled_Image_Header
+        Tiled_Image_Mip[mipCount]    Level 0 is full res, each level after is sized by NextMipSize from the one before. The last
+                                     level always fits in a single tile
+        Tiled_Image_Tile[...]        Per mip, row major starting from the bottom left tile
+        Encoded tile data            jpg (png if the source image had alpha). Stored so stb's flipped load gives rows
+                                     bottom up like the rest of our bitmaps
+
+    Edge tiles are only as big as the pixels they cover so tiles at the right/top of a level can be smaller than tileSize.
+*/
+
+#define TILED_IMAGE_MAGIC 0x454C4954 //"TILE"
+#define TILED_IMAGE_VERSION 1
+#define TILED_IMAGE_MAX_MIPS 16
+
+struct Tiled_Image_Header
+{
+    ui32 magic;
+    ui32 version;
+    ui32 fileSize;
+    i32 width_pxls, height_pxls;
+    i32 tileSize_pxls;
+    i32 mipCount;
+};
+
+struct Tiled_Image_Mip
+{
+    i32 width_pxls, height_pxls;
+    i32 tileCountX, tileCountY;
+    ui32 tiles; //Tiled_Image_Tile[tileCountX * tileCountY]
+};
+
+struct Tiled_Image_Tile
+{
+    ui32 dataOffset;
+    ui32 dataSize;
+    i32 width_pxls, height_pxls;
+};
+
+//Returns the cooked file in heap memory (free with globalPlatformServices->Free). Null if the image couldn't be loaded
+void* CookTiledImage(ui32&& fileSize, const char* imageFilePath, i32 tileSize_pxls);
+
+//Runtime streaming. A fixed pool of tile slots acts as an LRU cache: each slot owns one gpu texture that gets reused
+//for whatever tile it's holding. Slot 0 is pinned to the coarsest level (the whole image in one tile) and is drawn
+//behind everything so tiles that are still decoding have a blurry stand in instead of a hole
+#define TILED_BACKGROUND_SLOT_COUNT 48
+#define TILED_BACKGROUND_DECODES_PER_FRAME 8
+
+enum class Tile_Slot_State : i32
+{
+    EMPTY,
+    DECODING,
+    DECODED,
+    UPLOADED
+};
+
+struct Tiled_Background;
+struct Background_Tile_Slot
+{
+    Tiled_Background* background { nullptr };
+    i32 mipLevel { -1 };
+    i32 tileIndex { -1 };
+    u32 textureID {}; //0 until the slot's first upload creates its texture
+    i64 gpuBytes {};
+    Bitmap bitmap {}; //Decoded pixels. Only kept until the frame they were uploaded in has been rendered (see _TilePixelsInFlight)
+    i64 lastUsedFrame {};
+    i64 uploadedFrame {};
+    Tile_Slot_State volatile state { Tile_Slot_State::EMPTY };
+};
+
+struct Tiled_Background_Stats
+{
+    i32 mipLevel {};
+    i32 visibleTileCount {};
+    i32 missingTileCount {}; //Visible but not uploaded yet
+    i32 decodesQueuedThisFrame {};
+    i64 bytesUploadedThisFrame {};
+    i64 totalBytesUploaded {};
+    i64 cpuBytesResident {}; //Decoded tile pixels waiting on upload
+    i64 gpuBytesResident {};
+};
+
+struct Tiled_Background
+{
+    void* file { nullptr }; //Mapped .tiles file. Encoded tiles are decoded straight out of it
+    const Tiled_Image_Header* header { nullptr };
+    const Tiled_Image_Mip* mips { nullptr };
+    v2 size_meters {};
+    Array<Background_Tile_Slot, TILED_BACKGROUND_SLOT_COUNT> slots;
+    i64 frameIndex {};
+    Tiled_Background_Stats stats {};
+};
+
+b LoadTiledBackground(Tiled_Background&& background, const char* tiledImageFilePath, f32 height_meters);
+//Call once a frame with the part of the stage (in stage meters, bottom left origin) that's on screen. framesInFlight is
+//how many already submitted frames the renderer hasn't gotten to yet (see Rendering_Info), their uploads still need the pixels
+void UpdateTiledBackground(Tiled_Background&& background, RenderCmdBuffer* cmdBuffer, v2 viewMin_meters, v2 viewMax_meters, i32 viewHeight_pxls, f32 depth,
+                           i32 framesInFlight);
+//Gpu textures stay allocated since the renderer has no way to delete them yet
+void UnloadTiledBackground(Tiled_Background&& background);
+
+#if DEVELOPMENT_BUILD
+void BenchmarkTiledBackgroundZoom(bgz::Memory_Partition&& memPart, const char* tiledImageFilePath, f32 height_meters, i32 viewHeight_pxls, f32 pixelsPerMeter);
+#endif
+
+#endif
+
+#ifdef TILED_IMAGE_IMPL
+
+struct _Tiled_Image_Writer
+{
+    u8* data;
+    ui32 size;
+    ui32 capacity;
+};
+
+local_func void _TiledImageWriterReserve(_Tiled_Image_Writer* writer, ui32 size)
+{
+    if (writer->size + size > writer->capacity)
+    {
+        while (writer->size + size > writer->capacity)
+            writer->capacity *= 2;
+
+        writer->data = (u8*)globalPlatformServices->Realloc(writer->data, writer->capacity);
+    };
+};
+
+local_func void _WriteEncodedTileData(void* context, void* data, int size)
+{
+    _Tiled_Image_Writer* writer = (_Tiled_Image_Writer*)context;
+    _TiledImageWriterReserve(writer, (ui32)size);
+    memcpy(writer->data + writer->size, data, size);
+    writer->size += (ui32)size;
+};
+
+void* CookTiledImage(ui32&& fileSize, const char* imageFilePath, i32 tileSize_pxls)
+{
+    BGZ_ASSERT(tileSize_pxls > 0);//, "Invalid tile size!");
+
+    stbi_set_flip_vertically_on_load(true);
+
+    s32 width {}, height {}, channelsInFile {};
+    u8* levelPixels[TILED_IMAGE_MAX_MIPS] {};
+    levelPixels[0] = stbi_load(imageFilePath, &width, &height, &channelsInFile, 4);
+    if (NOT levelPixels[0])
+        return nullptr;
+
+    b hasAlpha = channelsInFile == 2 || channelsInFile == 4;
+
+    Tiled_Image_Mip mips[TILED_IMAGE_MAX_MIPS] {};
+    mips[0].width_pxls = width;
+    mips[0].height_pxls = height;
+
+    i32 mipCount { 1 };
+    while (mips[mipCount - 1].width_pxls > tileSize_pxls || mips[mipCount - 1].height_pxls > tileSize_pxls)
+    {
+        BGZ_ASSERT(mipCount < TILED_IMAGE_MAX_MIPS);//, "Image is too big for the tile size!");
+
+        Tiled_Image_Mip* prevMip = &mips[mipCount - 1];
+        Tiled_Image_Mip* mip = &mips[mipCount];
+        mip->width_pxls = NextMipSize(prevMip->width_pxls);
+        mip->height_pxls = NextMipSize(prevMip->height_pxls);
+
+        levelPixels[mipCount] = (u8*)globalPlatformServices->Malloc(mip->width_pxls * mip->height_pxls * 4);
+        DownsampleHalf(levelPixels[mipCount], levelPixels[mipCount - 1], prevMip->width_pxls, prevMip->height_pxls, Mip_Filter::BOX); //Not premultiplied yet so no kaiser
+        ++mipCount;
+    };
+
+    //Tables go first so each tile's data offset is known as soon as it's been encoded and appended
+    ui32 tablesSize = sizeof(Tiled_Image_Header) + sizeof(Tiled_Image_Mip) * mipCount;
+    for (i32 mipIndex {}; mipIndex < mipCount; ++mipIndex)
+    {
+        Tiled_Image_Mip* mip = &mips[mipIndex];
+        mip->tileCountX = (mip->width_pxls + tileSize_pxls - 1) / tileSize_pxls;
+        mip->tileCountY = (mip->height_pxls + tileSize_pxls - 1) / tileSize_pxls;
+        mip->tiles = tablesSize;
+        tablesSize += sizeof(Tiled_Image_Tile) * mip->tileCountX * mip->tileCountY;
+    };
+
+    _Tiled_Image_Writer writer {};
+    writer.capacity = tablesSize + (ui32)Megabytes(1);
+    writer.data = (u8*)globalPlatformServices->Calloc(1, writer.capacity);
+    writer.size = tablesSize;
+
+    u8* tilePixels = (u8*)globalPlatformServices->Malloc(tileSize_pxls * tileSize_pxls * 4);
+    stbi_flip_vertically_on_write(1); //Rows are bottom up in memory
+
+    for (i32 mipIndex {}; mipIndex < mipCount; ++mipIndex)
+    {
+        Tiled_Image_Mip* mip = &mips[mipIndex];
+        for (i32 tileY {}; tileY < mip->tileCountY; ++tileY)
+        {
+            for (i32 tileX {}; tileX < mip->tileCountX; ++tileX)
+            {
+                i32 firstPixelX = tileX * tileSize_pxls, firstPixelY = tileY * tileSize_pxls;
+                i32 tileWidth = (mip->width_pxls - firstPixelX < tileSize_pxls) ? mip->width_pxls - firstPixelX : tileSize_pxls;
+                i32 tileHeight = (mip->height_pxls - firstPixelY < tileSize_pxls) ? mip->height_pxls - firstPixelY : tileSize_pxls;
+
+                for (i32 row {}; row < tileHeight; ++row)
+                    memcpy(tilePixels + row * tileWidth * 4, levelPixels[mipIndex] + ((firstPixelY + row) * mip->width_pxls + firstPixelX) * 4, tileWidth * 4);
+
+                Tiled_Image_Tile tile {};
+                tile.dataOffset = writer.size;
+                tile.width_pxls = tileWidth;
+                tile.height_pxls = tileHeight;
+
+                if (hasAlpha)
+                    stbi_write_png_to_func(&_WriteEncodedTileData, &writer, tileWidth, tileHeight, 4, tilePixels, tileWidth * 4);
+                else
+                    stbi_write_jpg_to_func(&_WriteEncodedTileData, &writer, tileWidth, tileHeight, 4, tilePixels, 90);
+
+                tile.dataSize = writer.size - tile.dataOffset;
+
+                //Writer memory can move while encoding so the table entry is only written once the tile is done
+                Tiled_Image_Tile* tiles = (Tiled_Image_Tile*)(writer.data + mip->tiles);
+                tiles[tileY * mip->tileCountX + tileX] = tile;
+            };
+        };
+    };
+
+    stbi_flip_vertically_on_write(0);
+
+    Tiled_Image_Header* header = (Tiled_Image_Header*)writer.data;
+    header->magic = TILED_IMAGE_MAGIC;
+    header->version = TILED_IMAGE_VERSION;
+    header->fileSize = writer.size;
+    header->width_pxls = width;
+    header->height_pxls = height;
+    header->tileSize_pxls = tileSize_pxls;
+    header->mipCount = mipCount;
+    memcpy(writer.data + sizeof(Tiled_Image_Header), mips, sizeof(Tiled_Image_Mip) * mipCount);
+
+    globalPlatformServices->Free(tilePixels);
+    stbi_image_free(levelPixels[0]);
+    for (i32 mipIndex { 1 }; mipIndex < mipCount; ++mipIndex)
+        globalPlatformServices->Free(levelPixels[mipIndex]);
+
+    fileSize = writer.size;
+    return writer.data;
+};
+
+local_func const Tiled_Image_Tile* _GetTile(const Tiled_Background* background, i32 mipLevel, i32 tileIndex)
+{
+    const Tiled_Image_Tile* tiles = (const Tiled_Image_Tile*)((u8*)background->file + background->mips[mipLevel].tiles);
+    return &tiles[tileIndex];
+};
+
+local_func PLATFORM_WORK_QUEUE_CALLBACK(_DecodeBackgroundTile)
+{
+    Background_Tile_Slot* slot = (Background_Tile_Slot*)data;
+    const Tiled_Image_Tile* tile = _GetTile(slot->background, slot->mipLevel, slot->tileIndex);
+
+    stbi_set_flip_vertically_on_load(true);
+
+    s32 width {}, height {}, channelsInFile {};
+    u8* pixels = stbi_load_from_memory((u8*)slot->background->file + tile->dataOffset, (int)tile->dataSize, &width, &height, &channelsInFile, 4);
+    BGZ_ASSERT(pixels && width == tile->width_pxls && height == tile->height_pxls);//, "Corrupt tile data!");
+
+    PremultiplyAlphaAndSwapRB((u32*)pixels, width * height);
+
+    slot->bitmap = Bitmap {};
+    slot->bitmap.data = pixels;
+    slot->bitmap.width_pxls = width;
+    slot->bitmap.height_pxls = height;
+    slot->bitmap.aspectRatio = (f32)width / (f32)height;
+    slot->bitmap.pitch_pxls = (u32)width * BYTES_PER_PIXEL;
+
+    _mm_sfence(); //Pixels have to be visible before the game thread sees DECODED
+    slot->state = Tile_Slot_State::DECODED;
+};
+
+local_func void _QueueTileDecode(Background_Tile_Slot* slot, i32 mipLevel, i32 tileIndex, i64 frameIndex)
+{
+    slot->mipLevel = mipLevel;
+    slot->tileIndex = tileIndex;
+    slot->lastUsedFrame = frameIndex;
+    slot->state = Tile_Slot_State::DECODING;
+    globalPlatformServices->AddWorkQueueEntry(&_DecodeBackgroundTile, slot);
+};
+
+local_func void _FreeTilePixels(Background_Tile_Slot* slot)
+{
+    if (slot->bitmap.data)
+    {
+        stbi_image_free(slot->bitmap.data);
+        slot->bitmap.data = nullptr;
+    };
+};
+
+//Uploads only copy the pixels once the renderer gets to the frame they were recorded in, which can be a few frames behind
+local_func b _TilePixelsInFlight(const Tiled_Background& background, const Background_Tile_Slot* slot, i32 framesInFlight)
+{
+    return slot->state == Tile_Slot_State::UPLOADED && background.frameIndex - slot->uploadedFrame <= framesInFlight;
+};
+
+local_func void _UploadTileIfDecoded(Tiled_Background&& background, Background_Tile_Slot* slot, RenderCmdBuffer* cmdBuffer)
+{
+    if (slot->state != Tile_Slot_State::DECODED)
+        return;
+
+    //A slot's first upload creates its texture, after that the texture just gets its contents replaced
+    if (NOT slot->textureID)
+        slot->textureID = GPUCmd_SendTextureData(cmdBuffer, slot->bitmap);
+    else
+        GPUCmd_UpdateTextureData(cmdBuffer, slot->textureID, slot->bitmap);
+
+    slot->gpuBytes = (i64)slot->bitmap.width_pxls * slot->bitmap.height_pxls * BYTES_PER_PIXEL;
+    slot->uploadedFrame = background.frameIndex;
+    slot->state = Tile_Slot_State::UPLOADED;
+
+    background.stats.bytesUploadedThisFrame += slot->gpuBytes;
+    background.stats.totalBytesUploaded += slot->gpuBytes;
+};
+
+local_func Background_Tile_Slot* _FindTileSlot(Tiled_Background&& background, i32 mipLevel, i32 tileIndex)
+{
+    for (i32 slotIndex {}; slotIndex < background.slots.Size(); ++slotIndex)
+    {
+        Background_Tile_Slot* slot = &background.slots[slotIndex];
+        if (slot->state != Tile_Slot_State::EMPTY && slot->mipLevel == mipLevel && slot->tileIndex == tileIndex)
+            return slot;
+    };
+
+    return nullptr;
+};
+
+//Least recently used slot that isn't pinned, mid decode, needed this frame or still being uploaded. Null if every slot is busy
+local_func Background_Tile_Slot* _EvictTileSlot(Tiled_Background&& background, i32 framesInFlight)
+{
+    Background_Tile_Slot* oldestSlot { nullptr };
+    for (i32 slotIndex { 1 }; slotIndex < background.slots.Size(); ++slotIndex)
+    {
+        Background_Tile_Slot* slot = &background.slots[slotIndex];
+        if (slot->state == Tile_Slot_State::EMPTY)
+            return slot;
+
+        if (slot->state != Tile_Slot_State::DECODING && slot->lastUsedFrame < background.frameIndex && NOT _TilePixelsInFlight(background, slot, framesInFlight))
+        {
+            if (NOT oldestSlot || slot->lastUsedFrame < oldestSlot->lastUsedFrame)
+                oldestSlot = slot;
+        };
+    };
+
+    if (oldestSlot)
+        _FreeTilePixels(oldestSlot);
+
+    return oldestSlot;
+};
+
+local_func void _DrawBackgroundTile(RenderCmdBuffer* cmdBuffer, v2 min_meters, v2 size_meters, f32 depth, u32 textureID)
+{
+    Rect tileRect = CreateRect(size_meters.x, size_meters.y, min_meters, Origin::BOTTOM_LEFT, Color { 255, 255, 255, 255 });
+    tileRect._worldTransform.translation.x = min_meters.x;
+    tileRect._worldTransform.translation.y = min_meters.y;
+    GPUCmd_DrawRect(cmdBuffer, tileRect, depth, textureID);
+};
+
+b LoadTiledBackground(Tiled_Background&& background, const char* tiledImageFilePath, f32 height_meters)
+{
+    i32 fileSize {};
+    void* file = globalPlatformServices->MapEntireFile($(fileSize), tiledImageFilePath);
+    if (NOT file)
+        return false;
+
+    const Tiled_Image_Header* header = (const Tiled_Image_Header*)file;
+    if (fileSize < (i32)sizeof(Tiled_Image_Header) || header->magic != TILED_IMAGE_MAGIC || header->version != TILED_IMAGE_VERSION
+        || header->fileSize != (ui32)fileSize)
+    {
+        BGZ_CONSOLE("%s is out of date or corrupt (re-run tile_cooker)\n", tiledImageFilePath);
+        globalPlatformServices->UnmapFile(file);
+        return false;
+    };
+
+    background = Tiled_Background {};
+    background.file = file;
+    background.header = header;
+    background.mips = (const Tiled_Image_Mip*)((u8*)file + sizeof(Tiled_Image_Header));
+    background.size_meters = { height_meters * ((f32)header->width_pxls / (f32)header->height_pxls), height_meters };
+
+    for (i32 slotIndex {}; slotIndex < background.slots.Size(); ++slotIndex)
+        background.slots[slotIndex].background = &background;
+
+    _QueueTileDecode(&background.slots[0], header->mipCount - 1, 0, 0);
+
+    return true;
+};
+
+void UpdateTiledBackground(Tiled_Background&& background, RenderCmdBuffer* cmdBuffer, v2 viewMin_meters, v2 viewMax_meters, i32 viewHeight_pxls, f32 depth,
+                           i32 framesInFlight)
+{
+    BGZ_ASSERT(background.file);//, "Background isn't loaded!");
+
+    ++background.frameIndex;
+
+    Tiled_Background_Stats* stats = &background.stats;
+    stats->visibleTileCount = 0;
+    stats->missingTileCount = 0;
+    stats->decodesQueuedThisFrame = 0;
+    stats->bytesUploadedThisFrame = 0;
+
+    //Uploads the renderer has gotten through don't need their pixels anymore
+    for (i32 slotIndex {}; slotIndex < background.slots.Size(); ++slotIndex)
+    {
+        Background_Tile_Slot* slot = &background.slots[slotIndex];
+        if (slot->state == Tile_Slot_State::UPLOADED && NOT _TilePixelsInFlight(background, slot, framesInFlight))
+            _FreeTilePixels(slot);
+    };
+
+    const Tiled_Image_Header* header = background.header;
+
+    //Coarsest mip that still has at least one texel per screen pixel along y
+    f32 viewFraction = (viewMax_meters.y - viewMin_meters.y) / background.size_meters.y;
+    i32 mipLevel {};
+    while (mipLevel + 1 < header->mipCount && (f32)background.mips[mipLevel + 1].height_pxls * viewFraction >= (f32)viewHeight_pxls)
+        ++mipLevel;
+    stats->mipLevel = mipLevel;
+
+    Background_Tile_Slot* coarsestSlot = &background.slots[0];
+    coarsestSlot->lastUsedFrame = background.frameIndex;
+    _UploadTileIfDecoded($(background), coarsestSlot, cmdBuffer);
+    if (coarsestSlot->state == Tile_Slot_State::UPLOADED)
+        _DrawBackgroundTile(cmdBuffer, v2 { 0.0f, 0.0f }, background.size_meters, depth, coarsestSlot->textureID);
+
+    if (mipLevel == header->mipCount - 1)
+    {
+        stats->visibleTileCount = 1;
+        stats->missingTileCount = coarsestSlot->state == Tile_Slot_State::UPLOADED ? 0 : 1;
+    }
+    else
+    {
+        const Tiled_Image_Mip* mip = &background.mips[mipLevel];
+        v2 pixelsPerMeter = { (f32)mip->width_pxls / background.size_meters.x, (f32)mip->height_pxls / background.size_meters.y };
+        f32 tileSize = (f32)header->tileSize_pxls;
+
+        i32 firstTileX = FloorF32ToI32((viewMin_meters.x * pixelsPerMeter.x) / tileSize);
+        i32 firstTileY = FloorF32ToI32((viewMin_meters.y * pixelsPerMeter.y) / tileSize);
+        i32 lastTileX = FloorF32ToI32((viewMax_meters.x * pixelsPerMeter.x) / tileSize);
+        i32 lastTileY = FloorF32ToI32((viewMax_meters.y * pixelsPerMeter.y) / tileSize);
+        firstTileX = firstTileX < 0 ? 0 : firstTileX;
+        firstTileY = firstTileY < 0 ? 0 : firstTileY;
+        lastTileX = lastTileX >= mip->tileCountX ? mip->tileCountX - 1 : lastTileX;
+        lastTileY = lastTileY >= mip->tileCountY ? mip->tileCountY - 1 : lastTileY;
+
+        //Mark everything visible as used first so claiming a slot for a missing tile can't evict a visible one
+        for (i32 tileY { firstTileY }; tileY <= lastTileY; ++tileY)
+        {
+            for (i32 tileX { firstTileX }; tileX <= lastTileX; ++tileX)
+            {
+                Background_Tile_Slot* slot = _FindTileSlot($(background), mipLevel, tileY * mip->tileCountX + tileX);
+                if (slot)
+                    slot->lastUsedFrame = background.frameIndex;
+            };
+        };
+
+        //Tiles of one mip never overlap each other (the coarsest mip under them is a little farther back)
+        BeginDisjointDraws(cmdBuffer);
+        for (i32 tileY { firstTileY }; tileY <= lastTileY; ++tileY)
+        {
+            for (i32 tileX { firstTileX }; tileX <= lastTileX; ++tileX)
+            {
+                i32 tileIndex = tileY * mip->tileCountX + tileX;
+                ++stats->visibleTileCount;
+
+                Background_Tile_Slot* slot = _FindTileSlot($(background), mipLevel, tileIndex);
+                if (NOT slot)
+                {
+                    ++stats->missingTileCount;
+
+                    if (stats->decodesQueuedThisFrame < TILED_BACKGROUND_DECODES_PER_FRAME)
+                    {
+                        Background_Tile_Slot* freeSlot = _EvictTileSlot($(background), framesInFlight);
+                        if (freeSlot)
+                        {
+                            _QueueTileDecode(freeSlot, mipLevel, tileIndex, background.frameIndex);
+                            ++stats->decodesQueuedThisFrame;
+                        };
+                    };
+
+                    continue;
+                };
+
+                _UploadTileIfDecoded($(background), slot, cmdBuffer);
+                if (slot->state != Tile_Slot_State::UPLOADED)
+                {
+                    ++stats->missingTileCount;
+                    continue;
+                };
+
+                const Tiled_Image_Tile* tile = _GetTile(&background, mipLevel, tileIndex);
+                v2 tileMin_meters = { (f32)(tileX * header->tileSize_pxls) / pixelsPerMeter.x, (f32)(tileY * header->tileSize_pxls) / pixelsPerMeter.y };
+                v2 tileSize_meters = { (f32)tile->width_pxls / pixelsPerMeter.x, (f32)tile->height_pxls / pixelsPerMeter.y };
+                _DrawBackgroundTile(cmdBuffer, tileMin_meters, tileSize_meters, depth - .01f, slot->textureID);
+            };
+        };
+        EndDisjointDraws(cmdBuffer);
+    };
+
+    stats->cpuBytesResident = 0;
+    stats->gpuBytesResident = 0;
+    for (i32 slotIndex {}; slotIndex < background.slots.Size(); ++slotIndex)
+    {
+        Background_Tile_Slot* slot = &background.slots[slotIndex];
+        if (slot->bitmap.data && slot->state != Tile_Slot_State::DECODING)
+            stats->cpuBytesResident += (i64)slot->bitmap.width_pxls * slot->bitmap.height_pxls * BYTES_PER_PIXEL;
+        stats->gpuBytesResident += slot->gpuBytes;
+    };
+};
+
+void UnloadTiledBackground(Tiled_Background&& background)
+{
+    for (i32 slotIndex {}; slotIndex < background.slots.Size(); ++slotIndex)
+    {
+        Background_Tile_Slot* slot = &background.slots[slotIndex];
+        while (slot->state == Tile_Slot_State::DECODING)
+        {
+            if (NOT globalPlatformServices->DoNextWorkQueueEntry())
+                globalPlatformServices->Sleep(0);
+        };
+
+        _FreeTilePixels(slot);
+    };
+
+    globalPlatformServices->UnmapFile(background.file);
+    background.file = nullptr;
+};
+
+#if DEVELOPMENT_BUILD
+//Sweeps the zoom from fully zoomed out to close up, letting each zoom level's decodes finish before moving on, and
+//reports what the tile cache holds/uploads at each step against keeping the whole image resident. Uses its own
+//command buffer that never gets rendered so it doesn't touch the real textures
+void BenchmarkTiledBackgroundZoom(bgz::Memory_Partition&& memPart, const char* tiledImageFilePath, f32 height_meters, i32 viewHeight_pxls, f32 pixelsPerMeter)
+{
+    bgz::ScopedMemory scopeMemory(&memPart);
+
+    Tiled_Background* background = PushType(&memPart, Tiled_Background, 1);
+    *background = Tiled_Background {};
+    if (NOT LoadTiledBackground($(*background), tiledImageFilePath, height_meters))
+    {
+        BGZ_CONSOLE("Tiled background bench (%s): no up to date tiled file, skipping\n", tiledImageFilePath);
+        return;
+    };
+
+    RenderCmdBuffer cmdBuffer {};
+    cmdBuffer.size = (s32)Megabytes(4);
+    cmdBuffer.baseAddress = (u8*)PushSize(&memPart, cmdBuffer.size);
+
+    const Tiled_Image_Header* header = background->header;
+    i64 wholeImageBytes = (i64)header->width_pxls * header->height_pxls * BYTES_PER_PIXEL;
+    BGZ_CONSOLE("Tiled background bench (%s, %dx%d, %d mips, %dpx tiles): whole image would be %lld KB cpu + gpu\n", tiledImageFilePath,
+                header->width_pxls, header->height_pxls, header->mipCount, header->tileSize_pxls, wholeImageBytes / 1024);
+
+    f32 viewAspect = 16.0f / 9.0f;
+    f32 viewHeightAtZoom1_meters = (f32)viewHeight_pxls / pixelsPerMeter;
+    v2 stageCenter = background->size_meters / 2.0f;
+
+    Array<f32, 7> zoomFactors = { .25f, .5f, 1.0f, 2.0f, 4.0f, 8.0f, 1.0f };
+    for (i32 zoomIndex {}; zoomIndex < zoomFactors.Size(); ++zoomIndex)
+    {
+        f32 zoomFactor = zoomFactors[zoomIndex];
+        v2 viewSize = { viewHeightAtZoom1_meters * viewAspect / zoomFactor, viewHeightAtZoom1_meters / zoomFactor };
+        v2 viewMin = stageCenter - viewSize / 2.0f, viewMax = stageCenter + viewSize / 2.0f;
+
+        i64 bytesUploaded {}, peakCpuBytes {};
+        i32 framesToSettle {};
+        f64 startTime = globalPlatformServices->CurrentTimeInSecs();
+        do
+        {
+            cmdBuffer.usedAmount = 0;
+            cmdBuffer.entryCount = 0;
+
+            UpdateTiledBackground($(*background), &cmdBuffer, viewMin, viewMax, viewHeight_pxls, 10.0f, 0 /*framesInFlight*/);
+            bytesUploaded += background->stats.bytesUploadedThisFrame;
+            peakCpuBytes = background->stats.cpuBytesResident > peakCpuBytes ? background->stats.cpuBytesResident : peakCpuBytes;
+            ++framesToSettle;
+
+            //Stand in for the frame time the decodes would normally get
+            while (globalPlatformServices->DoNextWorkQueueEntry())
+                ;
+            for (i32 slotIndex {}; slotIndex < background->slots.Size(); ++slotIndex)
+            {
+                while (background->slots[slotIndex].state == Tile_Slot_State::DECODING)
+                    globalPlatformServices->Sleep(0);
+            };
+        } while (background->stats.missingTileCount > 0 && framesToSettle < 64);
+        f64 settleSecs = globalPlatformServices->CurrentTimeInSecs() - startTime;
+
+        Tiled_Background_Stats stats = background->stats;
+        BGZ_CONSOLE("  zoom %.2f: mip %d, %d tiles visible, settled in %d frames (%.2f ms), uploaded %lld KB, peak cpu %lld KB, gpu resident %lld KB\n",
+                    zoomFactor, stats.mipLevel, stats.visibleTileCount, framesToSettle, settleSecs * 1000.0, bytesUploaded / 1024, peakCpuBytes / 1024,
+                    stats.gpuBytesResident / 1024);
+    };
+
+    UnloadTiledBackground($(*background));
+};
+#endif
+
+#endif //TILED_IMAGE_IMPL
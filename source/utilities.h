@@ -110,4 +110,15 @@ StringCmp(const char* str1, const char* str2)
         return 1;
     else
         return 0;
+};
+
+//Copies a null terminated string into the memory partition (for keeping names around after the file they came from is freed)
+inline char*
+PushString(bgz::Memory_Partition* memPart, const char* string)
+{
+    sizet length = strlen(string);
+    char* result = PushType(memPart, char, length + 1);
+    memcpy(result, string, length + 1);
+    
+    return result;
 };
\ No newline at end of file
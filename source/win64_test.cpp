@@ -12,6 +12,7 @@
 #include <xinput.h>
 #include <io.h>
 #include <fcntl.h>
+#include <psapi.h>
 #include <stdio.h>
 #include "GL/glew.h"
 #include "GL/wglew.h"
@@ -26,6 +27,8 @@
 #include "my_math.h"
 #include "utilities.h"
 #include "renderer_stuff.h"
+#include "render_frame_queue.h"
+#include "render_capture.h"
 #include "win64_test.h"
 #include "shared.h"
 #include "software_rendering.h"
@@ -39,6 +42,12 @@
 #include "stb/stb_image.h"
 #define PLATFORM_RENDERER_STUFF_IMPL
 #include "renderer_stuff.h"
+#define RENDER_FRAME_QUEUE_IMPL
+#include "render_frame_queue.h"
+#define RENDER_CAPTURE_IMPL
+#include "render_capture.h"
+#define SOFTWARE_RENDERING_IMPL
+#include "software_rendering.h"
 #define MEMORY_HANDLING_IMPL
 #include "boagz/memory_handling.h"
 
@@ -47,6 +56,18 @@ global_variable u32 globalWindowHeight { 720 };
 global_variable Win32_Offscreen_Buffer globalBackBuffer_forSoftwareRendering;
 global_variable bgz::MemoryBlock gameMemory;
 global_variable bool  GameRunning {};
+global_variable HGLRC globalOpenGLContext;
+
+#define RENDER_FRAME_COUNT 3 //Command buffers the game and render thread trade back and forth
+#define RENDER_FRAMES_IN_FLIGHT 2 //How far the game can get ahead of the render thread. 1 = update and render never overlap
+global_variable Render_Frame_Queue globalRenderFrameQueue;
+
+#define RENDER_CAPTURE_FRAMES 0 //Frames captured from startup for render_replay. 0 = off
+#define RENDER_CAPTURE_FILE "data/render_capture.rcap"
+global_variable Render_Capture globalRenderCapture;
+
+#define RENDER_THROUGH_HARDWARE true //false = RenderViaSoftware into the DIB section, blitted with StretchDIBits
+#define RUN_SOFTWARE_RENDER_BENCHMARK false //Times the software renderer at 1080p on startup with 1 up to every worker thread
 
 local_func void
 Win32_LogErr(const char* ErrMessage)
@@ -104,6 +125,85 @@ local_func void Win32_Sleep(unsigned int milliseconds)
     Sleep(milliseconds);
 };
 
+local_func i64 Win32_PeakMemoryUsage()
+{
+    PROCESS_MEMORY_COUNTERS memoryCounters {};
+    if (NOT GetProcessMemoryInfo(GetCurrentProcess(), &memoryCounters, sizeof(memoryCounters)))
+        return 0;
+    
+    return (i64)memoryCounters.PeakWorkingSetSize;
+};
+
+local_func f64 Win32_CurrentTimeInSecs()
+{
+    LARGE_INTEGER clockTicksPerSecond, currentClockTickCount;
+    QueryPerformanceFrequency(&clockTicksPerSecond);
+    QueryPerformanceCounter(&currentClockTickCount);
+    
+    return (f64)currentClockTickCount.QuadPart / (f64)clockTicksPerSecond.QuadPart;
+};
+
+local_func void* Win32_MapEntireFile(s32&& length, const char* filePath)
+{
+    void* result { nullptr };
+    length = 0;
+    
+    HANDLE fileHandle = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, 0, 0);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER fileSize {};
+        if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0 && fileSize.QuadPart <= 0x7FFFFFFF)
+        {
+            //PAGE_WRITECOPY so game code can adjust data in place without it ever being written back to the file
+            HANDLE mappingHandle = CreateFileMappingA(fileHandle, 0, PAGE_WRITECOPY, 0, 0, 0);
+            if (mappingHandle)
+            {
+                result = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+                CloseHandle(mappingHandle); //View keeps the mapping alive
+            };
+            
+            //The rest of a view's last page reads as zero, which text read in place (json) relies on to stop. A file
+            //ending right on a page boundary has nothing after it, so it's read into its own zeroed memory instead
+            SYSTEM_INFO systemInfo {};
+            GetSystemInfo(&systemInfo);
+            if (result && fileSize.QuadPart % systemInfo.dwPageSize == 0)
+            {
+                UnmapViewOfFile(result);
+                
+                DWORD bytesRead {};
+                result = VirtualAlloc(0, (SIZE_T)fileSize.QuadPart + 1, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+                if (result && NOT (ReadFile(fileHandle, result, (DWORD)fileSize.QuadPart, &bytesRead, 0) && bytesRead == (DWORD)fileSize.QuadPart))
+                {
+                    VirtualFree(result, 0, MEM_RELEASE);
+                    result = nullptr;
+                };
+            };
+            
+            if (result)
+                length = (s32)fileSize.QuadPart;
+        };
+        
+        CloseHandle(fileHandle);
+    };
+    
+    return result;
+};
+
+local_func void Win32_UnmapFile(void* mappedFile)
+{
+    if (mappedFile)
+    {
+        //Page aligned files are read into VirtualAlloc'd memory rather than mapped (see Win32_MapEntireFile)
+        MEMORY_BASIC_INFORMATION memInfo {};
+        VirtualQuery(mappedFile, &memInfo, sizeof(memInfo));
+        
+        if (memInfo.Type == MEM_MAPPED)
+            UnmapViewOfFile(mappedFile);
+        else
+            VirtualFree(mappedFile, 0, MEM_RELEASE);
+    };
+};
+
 local_func bool
 Win32_WriteEntireFile(const char* FileName, void* memory, u32 MemorySize)
 {
@@ -261,6 +361,7 @@ Win32_InitInputRecording(Win32_Game_Replay_State&& GameReplayState)
     GameReplayState.InputRecording = true;
     GameReplayState.TotalInputStructsRecorded = 0;
     GameReplayState.InputCount = 0;
+    FlushRenderFrames($(globalRenderFrameQueue)); //Render thread's scratch memory is part of game memory too
     memcpy(GameReplayState.OriginalRecordedGameState, gameMemory.permanentStorage, gameMemory.totalSize);
 };
 
@@ -277,7 +378,9 @@ Win32_InitInputPlayBack(Win32_Game_Replay_State&& GameReplayState)
 {
     GameReplayState.InputPlayBack = true;
     GameReplayState.InputCount = 0;
-    //Set game state back to when it was first recorded for proper looping playback
+    //Set game state back to when it was first recorded for proper looping playback. Render thread can't be reading the
+    //command buffers while they get written over
+    FlushRenderFrames($(globalRenderFrameQueue));
     memcpy(gameMemory.permanentStorage, GameReplayState.OriginalRecordedGameState, gameMemory.totalSize);
 }
 
@@ -305,6 +408,7 @@ Win32_PlayBackInput(Game_Input&& Input, Win32_Game_Replay_State&& GameReplayStat
     else
     {
         GameReplayState.InputCount = 0;
+        FlushRenderFrames($(globalRenderFrameQueue));
         memcpy(gameMemory.permanentStorage, GameReplayState.OriginalRecordedGameState, gameMemory.totalSize);
     }
 }
@@ -359,8 +463,7 @@ Win32_ResizeDIBSection(Win32_Offscreen_Buffer&& buffer, int width, int height)
 
 local_func void Win32_DisplayBackBuffer(HDC deviceContext, int windowWidth, int windowHeight)
 {
-    bool renderThroughHardware { true };
-    if (renderThroughHardware)
+    if (RENDER_THROUGH_HARDWARE)
     {
         SwapBuffers(deviceContext);
     }
@@ -391,14 +494,19 @@ local_func void Win32_DisplayBackBuffer(HDC deviceContext, int windowWidth, int
 
 local_func void Win32_RenderToBackBuffer(Rendering_Info&& renderingInfo, RenderCmdBuffer&& bufferToRender, bgz::Memory_Partition* platformMemoryPart, int windowWidth, int windowHeight, Platform_Services platformServices)
 {
-    bool renderThroughHardware { true };
-    if (renderThroughHardware)
+    if (RENDER_THROUGH_HARDWARE)
     {
         RenderViaHardware($(renderingInfo), $(bufferToRender), platformMemoryPart, windowWidth, windowHeight);
     }
     else
     {
-        //RenderViaSoftware($(renderingInfo), globalBackBuffer_forSoftwareRendering.memory, v2i { globalBackBuffer_forSoftwareRendering.width, globalBackBuffer_forSoftwareRendering.height }, globalBackBuffer_forSoftwareRendering.pitch, &platformServices);
+        Software_Render_Target target {};
+        target.pixels = (u32*)globalBackBuffer_forSoftwareRendering.memory;
+        target.width = globalBackBuffer_forSoftwareRendering.width;
+        target.height = globalBackBuffer_forSoftwareRendering.height;
+        target.pitch_pxls = globalBackBuffer_forSoftwareRendering.pitch / globalBackBuffer_forSoftwareRendering.bytesPerPixel;
+        
+        RenderViaSoftware($(renderingInfo), $(bufferToRender), target, platformMemoryPart, &platformServices);
     };
     
     //Clear out render command buffer
@@ -471,6 +579,7 @@ Win32_ProgramWindowCallback(HWND WindowHandle, UINT Message, WPARAM wParam, LPAR
                     if (SetPixelFormat(WindowContext, SuggestedPixelFormatIndex, &SuggestedPixelFormat))
                     {
                         HGLRC OpenGLRenderingContext = wglCreateContext(WindowContext);
+                        globalOpenGLContext = OpenGLRenderingContext;
                         
                         if (OpenGLRenderingContext)
                         {
@@ -599,44 +708,54 @@ struct Work_Queue
     HANDLE semaphoreHandle;
     s32 volatile entryCompletionGoal;
     s32 volatile entryCompletionCount;
+    s32 volatile addLock; //Game and render thread both queue work
     s32 volatile nextEntryToWrite;
     s32 volatile nextEntryToRead;
+    s32 volatile activeThreadCount;
+    s32 threadCount;
     Work_Queue_Entry entries[256];
 };
 
-global_variable Work_Queue globalWorkQueue;
-
 struct Thread_Info
 {
     s32 logicalThreadIndex;
+    HANDLE wakeEvent; //Parked threads wait on this instead of the semaphore (see SetWorkerThreadCount)
 };
 
+global_variable Work_Queue globalWorkQueue;
+global_variable Thread_Info* globalWorkerThreads;
+
 void AddToWorkQueue(platform_work_queue_callback* callback, void* data)
 {
+    while (_InterlockedCompareExchange((LONG volatile*)&globalWorkQueue.addLock, 1, 0) != 0)
+        _mm_pause();
+    
     s32 newNextEntryToWrite = (globalWorkQueue.nextEntryToWrite + 1) % ArrayCount(globalWorkQueue.entries);
     Assert(newNextEntryToWrite != globalWorkQueue.nextEntryToRead);
     
     Work_Queue_Entry entry { callback, data };
     globalWorkQueue.entries[globalWorkQueue.nextEntryToWrite] = entry;
-    ++globalWorkQueue.entryCompletionGoal;
+    _InterlockedIncrement((LONG volatile*)&globalWorkQueue.entryCompletionGoal);
     
     _WriteBarrier();
     _mm_sfence();
     
-    ++globalWorkQueue.nextEntryToWrite = newNextEntryToWrite;
+    globalWorkQueue.nextEntryToWrite = newNextEntryToWrite;
+    _InterlockedExchange((LONG volatile*)&globalWorkQueue.addLock, 0);
+    
     ReleaseSemaphore(globalWorkQueue.semaphoreHandle, 1, 0);
 };
 
 bool DoWork();
+//Waits on everything queued so far. Counts only ever go up (no resetting them here) since another thread can be
+//adding work while this one waits
 void FinishAllWork()
 {
-    while (globalWorkQueue.entryCompletionGoal != globalWorkQueue.entryCompletionCount)
+    s32 entryCompletionGoal = globalWorkQueue.entryCompletionGoal;
+    while ((s32)((u32)globalWorkQueue.entryCompletionCount - (u32)entryCompletionGoal) < 0)
     {
         DoWork();
     };
-    
-    globalWorkQueue.entryCompletionCount = 0;
-    globalWorkQueue.entryCompletionGoal = 0;
 };
 
 bool DoWork()
@@ -667,6 +786,18 @@ bool DoWork()
     return isThereStillWork;
 };
 
+//Threads past the count park on their own wake event, so the semaphore's tokens only ever go to threads that will do
+//the work. Threads being parked notice the next time they finish an entry or get woken
+void SetWorkerThreadCount(s32 threadCount)
+{
+    BGZ_ASSERT(threadCount > 0 && threadCount <= globalWorkQueue.threadCount);
+    globalWorkQueue.activeThreadCount = threadCount;
+    _mm_sfence();
+    
+    for (s32 threadIndex {}; threadIndex < threadCount; ++threadIndex)
+        SetEvent(globalWorkerThreads[threadIndex].wakeEvent);
+};
+
 DWORD WINAPI
 ThreadProc(LPVOID param)
 {
@@ -674,19 +805,103 @@ ThreadProc(LPVOID param)
     
     while (1)
     {
-        if (DoWork())
+        if (info->logicalThreadIndex >= globalWorkQueue.activeThreadCount)
+        {
+            WaitForSingleObjectEx(info->wakeEvent, INFINITE, FALSE); //Parked by SetWorkerThreadCount
+        }
+        else if (DoWork())
         {
             //Keep doing work
         }
         else
         {
             WaitForSingleObjectEx(globalWorkQueue.semaphoreHandle, INFINITE, FALSE);
+            
+            //Got parked while waiting. Pass the wake up on so the entry it was for still gets done by an active thread
+            if (info->logicalThreadIndex >= globalWorkQueue.activeThreadCount)
+                ReleaseSemaphore(globalWorkQueue.semaphoreHandle, 1, 0);
         }
     };
     
     return 0;
 };
 
+local_func void
+Win32_WaitForRenderFrameSignal(void* signal)
+{
+    WaitForSingleObjectEx((HANDLE)signal, INFINITE, FALSE);
+};
+
+local_func void
+Win32_SetRenderFrameSignal(void* signal)
+{
+    SetEvent((HANDLE)signal);
+};
+
+local_func void
+Win32_WriteRenderCapture(Platform_Services* platformServices)
+{
+    EndRenderCapture($(globalRenderCapture));
+    if (platformServices->WriteEntireFile(RENDER_CAPTURE_FILE, globalRenderCapture.memory, (u32)globalRenderCapture.usedAmount))
+        BGZ_CONSOLE("Captured %d frames to %s\n", globalRenderCapture.frameCount, RENDER_CAPTURE_FILE);
+    else
+        Win32_LogErr("Unable to write render capture!");
+    
+    VirtualFree(globalRenderCapture.memory, 0, MEM_RELEASE);
+    globalRenderCapture = Render_Capture {};
+};
+
+struct Win32_Render_Thread_Info
+{
+    HDC deviceContext;
+    bgz::Memory_Partition* platformMemoryPart;
+    Platform_Services platformServices;
+};
+
+//Owns the gl context. Everything gl happens on this thread once it's started
+DWORD WINAPI
+RenderThreadProc(LPVOID param)
+{
+    Win32_Render_Thread_Info* info = (Win32_Render_Thread_Info*)param;
+    
+    if (NOT wglMakeCurrent(info->deviceContext, globalOpenGLContext))
+    {
+        Win32_LogErr("Unable to make opengl context current on the render thread!");
+        InvalidCodePath;
+    };
+    
+    while (Render_Frame* frame = AcquireRenderFrame($(globalRenderFrameQueue)))
+    {
+        Rendering_Info* renderingInfo = &frame->renderingInfo;
+        
+        if (globalRenderCapture.memory)
+        {
+            b captured = CaptureRenderFrame($(globalRenderCapture), *renderingInfo, renderingInfo->gameCmdBuffer, frame->frameIndex);
+            if (NOT captured || globalRenderCapture.frameCount == RENDER_CAPTURE_FRAMES)
+                Win32_WriteRenderCapture(&info->platformServices);
+        };
+        
+        glClearColor(renderingInfo->clearColor.r, renderingInfo->clearColor.g, renderingInfo->clearColor.b,  0.0f);
+        if(renderingInfo->userWantsToClearDepthBuf)
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        else
+            glClear(GL_COLOR_BUFFER_BIT);
+        
+        Win32_RenderToBackBuffer($(*renderingInfo), $(renderingInfo->gameCmdBuffer), info->platformMemoryPart, renderingInfo->widthOfScreen_pixels,
+                                 renderingInfo->heightOfScreen_pixels, info->platformServices);
+        
+        IsAllTempMemoryCleared(*info->platformMemoryPart);
+        
+        Win32_DisplayBackBuffer(info->deviceContext, renderingInfo->widthOfScreen_pixels, renderingInfo->heightOfScreen_pixels);
+        
+        ReleaseRenderFrame($(globalRenderFrameQueue), frame);
+    };
+    
+    wglMakeCurrent(NULL, NULL);
+    
+    return 0;
+};
+
 int CALLBACK WinMain(HINSTANCE CurrentProgramInstance, HINSTANCE PrevInstance, LPSTR CommandLine, int ShowCode)
 {
     Win32_UseConsole();
@@ -694,16 +909,20 @@ int CALLBACK WinMain(HINSTANCE CurrentProgramInstance, HINSTANCE PrevInstance, L
     SYSTEM_INFO sysInfo;
     GetSystemInfo(&sysInfo);
     
-    Thread_Info threadInfo[8] = {};
+    Thread_Info threadInfo[16] = {};
     s32 threadCount = ArrayCount(threadInfo);
     
     s32 initialThreadCount = 0;
     globalWorkQueue.semaphoreHandle = CreateSemaphoreExA(0, initialThreadCount, threadCount, 0, 0, SEMAPHORE_ALL_ACCESS);
+    globalWorkQueue.threadCount = threadCount;
+    globalWorkQueue.activeThreadCount = threadCount;
+    globalWorkerThreads = threadInfo;
     
     for (s32 threadIndex {}; threadIndex < ArrayCount(threadInfo); ++threadIndex)
     {
         Thread_Info* info = threadInfo + threadIndex;
         info->logicalThreadIndex = threadIndex;
+        info->wakeEvent = CreateEventA(0, FALSE /*auto reset*/, FALSE, 0);
         
         DWORD threadID;
         HANDLE myThread = CreateThread(0, 0, ThreadProc, info, 0, &threadID);
@@ -763,16 +982,11 @@ int CALLBACK WinMain(HINSTANCE CurrentProgramInstance, HINSTANCE PrevInstance, L
             bgz::CreatePartitionFromMemoryBlock($(gameMemory), Megabytes(100), "frame");
             bgz::CreatePartitionFromMemoryBlock($(gameMemory), Megabytes(100), "level");
             bgz::CreatePartitionFromMemoryBlock($(gameMemory), Megabytes(100), "platform");
-            bgz::CreatePartitionFromMemoryBlock($(gameMemory), Megabytes(10), "RenderCmdBuffer");
+            bgz::CreatePartitionFromMemoryBlock($(gameMemory), Megabytes(10) * RENDER_FRAME_COUNT, "RenderCmdBuffer");
             
             bgz::Memory_Partition* platformMemoryPart = GetMemoryPartition(&gameMemory, "platform");
             
-            { //Init game render command buffer and other render stuff
-                renderingInfo.gameCmdBuffer.baseAddress = (u8*)(GetMemoryPartition(&gameMemory, "RenderCmdBuffer"))->baseAddress;
-                renderingInfo.gameCmdBuffer.size = Megabytes(10);
-                renderingInfo.gameCmdBuffer.entryCount = 0;
-                renderingInfo.gameCmdBuffer.usedAmount = 0;
-                
+            { //Init render stuff. Game command buffers get handed out per frame by the render frame queue
                 renderingInfo._pixelsPerMeter = globalBackBuffer_forSoftwareRendering.height * .10f;
                 renderingInfo.initialWidthOfScreen_pixels = globalWindowWidth;
                 renderingInfo.initialHeightOfScreen_pixels = globalWindowHeight;
@@ -794,7 +1008,50 @@ int CALLBACK WinMain(HINSTANCE CurrentProgramInstance, HINSTANCE PrevInstance, L
                 platformServices.Free = &Win32_Free;
                 platformServices.AddWorkQueueEntry = &AddToWorkQueue;
                 platformServices.FinishAllWork = &FinishAllWork;
+                platformServices.DoNextWorkQueueEntry = &DoWork;
+                platformServices.SetWorkerThreadCount = &SetWorkerThreadCount;
+                platformServices.maxWorkerThreadCount = globalWorkQueue.threadCount;
                 platformServices.Sleep = &Win32_Sleep;
+                platformServices.CurrentTimeInSecs = &Win32_CurrentTimeInSecs;
+                platformServices.PeakMemoryUsage = &Win32_PeakMemoryUsage;
+                platformServices.MapEntireFile = &Win32_MapEntireFile;
+                platformServices.UnmapFile = &Win32_UnmapFile;
+            }
+            
+#if DEVELOPMENT_BUILD
+            if (RUN_SOFTWARE_RENDER_BENCHMARK)
+            {
+                BenchmarkSoftwareRenderer(platformMemoryPart, &platformServices, v2i { 1920, 1080 }, 5000, 10);
+                BenchmarkSoftwareRenderBinning(platformMemoryPart, &platformServices, v2i { 1920, 1080 }, 3);
+            };
+#endif
+            
+            Win32_Render_Thread_Info renderThreadInfo {};
+            HANDLE renderThread {};
+            { //Init render thread. Game records frame N + 1 while the render thread submits frame N
+                Render_Frame_Signals signals {};
+                signals.frameSubmitted = CreateEventA(0, FALSE /*auto reset*/, FALSE, 0);
+                signals.frameReleased = CreateEventA(0, FALSE /*auto reset*/, FALSE, 0);
+                signals.Wait = &Win32_WaitForRenderFrameSignal;
+                signals.Signal = &Win32_SetRenderFrameSignal;
+                
+                bgz::Memory_Partition* renderCmdBufferPart = GetMemoryPartition(&gameMemory, "RenderCmdBuffer");
+                InitRenderFrameQueue($(globalRenderFrameQueue), (u8*)renderCmdBufferPart->baseAddress, Megabytes(10) * RENDER_FRAME_COUNT, RENDER_FRAME_COUNT,
+                                     RENDER_FRAMES_IN_FLIGHT, signals);
+                
+                renderThreadInfo.deviceContext = WindowContext;
+                renderThreadInfo.platformMemoryPart = platformMemoryPart;
+                renderThreadInfo.platformServices = platformServices;
+                
+                //Context was made current on this thread in WM_CREATE. It can only be current on one thread at a time
+                if (RENDER_CAPTURE_FRAMES)
+                {
+                    i64 captureMemorySize = Megabytes(512);
+                    BeginRenderCapture($(globalRenderCapture), (u8*)VirtualAlloc(0, captureMemorySize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE), captureMemorySize);
+                };
+                
+                wglMakeCurrent(NULL, NULL);
+                renderThread = CreateThread(0, 0, RenderThreadProc, &renderThreadInfo, 0, 0);
             }
             
             auto UpdateInput = [window](Game_Input&& Input, Win32_Game_Replay_State&& GameReplayState) -> void {
@@ -963,8 +1220,13 @@ int CALLBACK WinMain(HINSTANCE CurrentProgramInstance, HINSTANCE PrevInstance, L
                 renderingInfo.widthOfScreen_pixels = globalWindowWidth;
                 renderingInfo.heightOfScreen_pixels = globalWindowHeight;
                 
-                HDC deviceContext = GetDC(window);
-                Win32_ResizeDIBSection($(globalBackBuffer_forSoftwareRendering), windowDimension.width, windowDimension.height);
+                //The render thread rasterizes into and blits from the DIB section, so only reallocate it on an actual size change
+                //and only once every frame in flight has been released (frames are displayed before they're released)
+                if (windowDimension.width != globalBackBuffer_forSoftwareRendering.width || windowDimension.height != globalBackBuffer_forSoftwareRendering.height)
+                {
+                    FlushRenderFrames($(globalRenderFrameQueue));
+                    Win32_ResizeDIBSection($(globalBackBuffer_forSoftwareRendering), windowDimension.width, windowDimension.height);
+                };
                 renderingInfo._pixelsPerMeter = globalBackBuffer_forSoftwareRendering.height * .10f;
                 
 #if 1
@@ -981,32 +1243,28 @@ int CALLBACK WinMain(HINSTANCE CurrentProgramInstance, HINSTANCE PrevInstance, L
                 if (GameReplayState.InputPlayBack)
                     Win32_PlayBackInput($(Input), $(GameReplayState));
                 
+                //Blocks here if the game's gotten too far ahead of the render thread
+                Render_Frame* renderFrame = BeginRenderFrame($(globalRenderFrameQueue), $(renderingInfo));
+                
                 GameCode.UpdateFunc(&gameMemory, &platformServices, &renderingInfo, &SoundBuffer, &Input);
                 
                 Input = Input;
                 GameReplayState = GameReplayState;
                 
-                //TODO: Move this out of platform layer. Only hear because I call RendertoBackBuffer twice and this used to be in that function
-                if(renderingInfo.userWantsToClearDepthBuf)
-                {
-                    glClearColor(renderingInfo.clearColor.r, renderingInfo.clearColor.g, renderingInfo.clearColor.b,  0.0f);
-                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-                }
-                else
-                {
-                    glClearColor(renderingInfo.clearColor.r, renderingInfo.clearColor.g, renderingInfo.clearColor.b,  0.0f);
-                    glClear(GL_COLOR_BUFFER_BIT);
-                };
-                
-                Win32_RenderToBackBuffer($(renderingInfo), $(renderingInfo.gameCmdBuffer), platformMemoryPart, windowDimension.width, windowDimension.height, platformServices);
-                
-                IsAllTempMemoryCleared(*platformMemoryPart);
+                //Render thread takes it from here (clear, render and swap)
+                SubmitRenderFrame($(globalRenderFrameQueue), renderFrame, renderingInfo);
                 
                 //BGZ_CONSOLE("frame time secs: %f\n", debugTiming.frameTime_inSeconds);
-                
-                Win32_DisplayBackBuffer(deviceContext, windowDimension.width, windowDimension.height);
             };
             
+            //Let the render thread finish what's been submitted and give up the gl context
+            ShutdownRenderFrameQueue($(globalRenderFrameQueue));
+            WaitForSingleObject(renderThread, INFINITE);
+            
+            //Closed before the capture filled up, keep what there is
+            if (globalRenderCapture.memory)
+                Win32_WriteRenderCapture(&platformServices);
+            
             PostMessage(window, WM_CLOSE, 0, 0);
             
             //Hardware Rendering shutdown procedure
@@ -3,7 +3,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
-#include "boagz\error_context.h"
+#include "boagz/error_context.h"
+
+#ifndef _MSC_VER //Only msvc has the _s versions
+#define fprintf_s fprintf
+#define scanf_s scanf
+#endif
 
 #ifdef BGZ_MAX_CONTEXTS
 #define MAX_CONTEXTS BGZ_MAX_CONTEXTS
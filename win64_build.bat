@@ -9,7 +9,7 @@ set CommonLinkerFlags=-subsystem:windows -machine:x64 -incremental:no -nologo -o
 
 set PlatformIncludePaths=-I %cwd%third_party\boagz\include -I %cwd%third_party\boagz\src -I %cwd%third_party\glew-2.1.0\include -I %cwd%third_party\stb\include
 set PlatformLibraryPaths=-LIBPATH:%cwd%third_party\glew-2.1.0\lib\win64-release
-set PlatformImportLibraries=user32.lib OpenGL32.lib gdi32.lib xinput.lib Winmm.lib
+set PlatformImportLibraries=user32.lib OpenGL32.lib gdi32.lib xinput.lib Winmm.lib psapi.lib
 set PlatformStaticLibraries=glew32s.lib
 
 set GameIncludePaths=-I %cwd%third_party\boagz\include -I %cwd%third_party\boagz\src -I %cwd%third_party\stb\include
@@ -24,6 +24,51 @@ REM Build exe
 cl /c ..\source\win64_test.cpp %CommonCompilerFlags% %PlatformIncludePaths% -DDEVELOPMENT_BUILD=1 -DGLEW_STATIC=1
 link win64_test.obj -OUT:win64_test.exe %CommonLinkerFlags% %PlatformLibraryPaths% %PlatformImportLibraries% %PlatformStaticLibraries%
 
+REM Build rig cooker and re-cook rigs (game falls back to the .json files if a .rig is missing or out of date)
+cl /c ..\source\rig_cooker.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link rig_cooker.obj -OUT:rig_cooker.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+rig_cooker.exe ..\data\yellow_god.atlas ..\data\yellow_god.json ..\data\yellow_god.rig 72
+
+REM Build tile cooker and re-cut the stage background (game falls back to a blank stage if the .tiles file is missing or out of date)
+cl /c ..\source\tile_cooker.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link tile_cooker.obj -OUT:tile_cooker.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+tile_cooker.exe ..\data\4k.jpg ..\data\4k.tiles 256
+
+REM Build render replay tool (replays a capture from the game, see RENDER_CAPTURE_FRAMES in win64_test.cpp, without needing a gpu)
+cl /c ..\source\render_replay.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link render_replay.obj -OUT:render_replay.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+
+REM Build skeleton world transform benchmark (timings only here, cache misses are only counted on linux)
+cl /c ..\source\skeleton_bench.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link skeleton_bench.obj -OUT:skeleton_bench.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+
+REM Build json parsing benchmark (run from the repo root, timings and tree sizes only here, peak RSS is only logged on linux)
+cl /c ..\source\json_bench.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link json_bench.obj -OUT:json_bench.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+
+REM Build and run the render capture round trip check. Leaves a capture of its frames behind for render_replay
+cl /c ..\source\render_capture_check.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link render_capture_check.obj -OUT:render_capture_check.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+render_capture_check.exe ..\data\arial.ttf render_capture_check.rcap
+
+REM Build and run the render sort check (order entries are drawn in, see RenderSortKey)
+cl /c ..\source\render_sort_check.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link render_sort_check.obj -OUT:render_sort_check.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+render_sort_check.exe
+
+REM Build and run the render frame queue check (game/render thread hand off, see render_frame_queue.h)
+cl /c ..\source\render_frame_queue_check.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link render_frame_queue_check.obj -OUT:render_frame_queue_check.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+render_frame_queue_check.exe
+
+REM Build and run the texture mip chain check (levels have to be sized the way gl expects, see texture_cache.h)
+cl /c ..\source\texture_mip_check.cpp %CommonCompilerFlags% %GameIncludePaths% -DDEVELOPMENT_BUILD=1
+link texture_mip_check.obj -OUT:texture_mip_check.exe -subsystem:console -machine:x64 -incremental:no -nologo -opt:ref -debug:FULL -ignore:4099
+texture_mip_check.exe ..\data\4k.jpg ..\data\1080p.jpg
+
+REM Decoded + mipped textures get persisted here on first launch (see texture_cache.h). Safe to delete
+IF NOT EXIST ..\data\texture_cache mkdir ..\data\texture_cache
+
 popd
 
 